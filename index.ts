@@ -4,10 +4,12 @@ import * as https from 'https';
 import { createHmac } from 'crypto';
 import { createRequire } from 'module';
 import { IncomingMessage, Server, ServerResponse } from 'http';
+import { Readable } from 'stream';
 
 import type {
-  JoinParams, SignatureParams, WebhookCallback, RawWebhookCallback,
-  VideoParams, AudioParams, DeskshareParams, TranscriptParams
+  JoinParams, PollingMode, SignatureParams, WebhookCallback, RawWebhookCallback,
+  VideoParams, AudioParams, DeskshareParams, TranscriptParams,
+  Metadata, MediaStreamOptions, SharedRingOptions, ShmRingOptions, SharedRingFrame
 } from "./rtms.d.ts";
 
 const require = createRequire(import.meta.url);
@@ -415,6 +417,11 @@ function isRawWebhookCallback(callback: WebhookCallbackUnion): callback is RawWe
  *
  * @param callback Function to call when webhook events are received
  * @param path The URL path to listen on (e.g., '/zoom/webhook')
+ * @param metricsPath Optional path (e.g., '/metrics') on which GET requests
+ *                    are answered with {@link renderMetrics} output. Anyone
+ *                    who can reach the server can then read per-meeting
+ *                    metrics; see {@link startMetricsServer} for a
+ *                    loopback-only endpoint
  * @returns A request handler function compatible with http.Server
  *
  * @example
@@ -444,10 +451,16 @@ function isRawWebhookCallback(callback: WebhookCallbackUnion): callback is RawWe
  *
  * @category Common Functions
  */
-export function createWebhookHandler(callback: WebhookCallbackUnion, path: string) {
+export function createWebhookHandler(callback: WebhookCallbackUnion, path: string, metricsPath?: string) {
   return (req: IncomingMessage, res: ServerResponse) => {
     const headers = { 'Content-Type': 'application/json' };
 
+    if (metricsPath && req.method === 'GET' && (req.url || '').split('?')[0] === metricsPath) {
+      res.writeHead(200, { 'Content-Type': METRICS_CONTENT_TYPE });
+      res.end(renderMetrics());
+      return;
+    }
+
     if (req.method !== 'POST' || req.url !== path) {
       Logger.debug('webhook', `Rejected request: ${req.method} ${req.url} (expected: POST ${path})`);
       res.writeHead(404, headers);
@@ -536,6 +549,11 @@ export function createWebhookHandler(callback: WebhookCallbackUnion, path: strin
  * - ZM_RTMS_CERT: Path to SSL certificate file
  * - ZM_RTMS_KEY: Path to SSL certificate key file
  * - ZM_RTMS_CA_WEBHOOK: (Optional) Path to CA certificate for client verification
+ *
+ * Set ZM_RTMS_METRICS_PATH (e.g. '/metrics') to also serve Prometheus metrics
+ * from the same server. The server listens on all interfaces and the metrics
+ * are labelled with meeting UUIDs, so only set it when the port is not
+ * publicly reachable; {@link startMetricsServer} binds 127.0.0.1 instead.
  * 
  * @param callback Function to call when webhook events are received
  * 
@@ -548,6 +566,7 @@ export function onWebhookEvent(callback: WebhookCallback | RawWebhookCallback):
 
   const port = parseInt(process.env['ZM_RTMS_PORT'] || '8080');
   const path = process.env['ZM_RTMS_PATH'] || '/';
+  const metricsPath = process.env['ZM_RTMS_METRICS_PATH'] || undefined;
   
   // Check for TLS certificate configuration
   const certPath = process.env['ZM_RTMS_CERT'] || '';
@@ -569,7 +588,7 @@ export function onWebhookEvent(callback: WebhookCallback | RawWebhookCallback):
   const useSecureServer = hasCert && hasKey;
   
   // Create the request handler (works with both WebhookCallback and RawWebhookCallback)
-  const requestHandler = createWebhookHandler(callback as WebhookCallbackUnion, path);
+  const requestHandler = createWebhookHandler(callback as WebhookCallbackUnion, path, metricsPath);
   
   if (useSecureServer) {
     // Set up HTTPS server with the provided certificates
@@ -612,9 +631,98 @@ export function onWebhookEvent(callback: WebhookCallback | RawWebhookCallback):
   webhookServer.listen(port, () => {
     const protocol = useSecureServer ? 'https' : 'http';
     Logger.info('webhook', `Listening for webhook events at ${protocol}://localhost:${port}${path}`);
+    if (metricsPath) {
+      Logger.info('webhook', `Serving Prometheus metrics at ${protocol}://localhost:${port}${metricsPath}`);
+      Logger.warn('webhook', `Metrics at ${metricsPath} include meeting UUIDs and are reachable on every ` +
+                  `interface port ${port} is; use startMetricsServer() for a loopback-only endpoint`);
+    }
   });
 }
 
+const METRICS_CONTENT_TYPE = 'text/plain; version=0.0.4; charset=utf-8';
+
+/**
+ * Renders every live client and event loop in the Prometheus text format
+ *
+ * Includes per-media frame and byte counters, time since each stream's last
+ * frame, and poll/callback latency histograms, labelled by meeting UUID and
+ * stream ID. Serve it from any route of your own application server, or use
+ * {@link startMetricsServer} for a standalone listener.
+ *
+ * @returns Metrics in Prometheus text exposition format 0.0.4
+ *
+ * @category Common Functions
+ */
+export function renderMetrics(): string {
+  return nativeRtms.renderMetrics();
+}
+
+/**
+ * Starts a native HTTP listener serving {@link renderMetrics} at /metrics
+ *
+ * Scrapes are answered from a native thread and never wait on the JavaScript
+ * event loop. Starting again replaces the previous listener.
+ *
+ * @param port Port to listen on (default 9464; 0 picks a free port)
+ * @param host Address to bind (default '127.0.0.1')
+ * @returns The port the listener is bound to
+ *
+ * @category Common Functions
+ */
+export function startMetricsServer(port: number = 9464, host: string = '127.0.0.1'): number {
+  const bound = nativeRtms.startMetricsServer(port, host);
+  Logger.info('rtms', `Serving Prometheus metrics at http://${host}:${bound}/metrics`);
+  return bound;
+}
+
+/**
+ * Stops the listener started by {@link startMetricsServer}
+ *
+ * @returns true if a listener was running
+ *
+ * @category Common Functions
+ */
+export function stopMetricsServer(): boolean {
+  return nativeRtms.stopMetricsServer();
+}
+
+/**
+ * Whether the native addon was built with RTMS_TRACE=ON
+ *
+ * @category Common Functions
+ */
+export function traceEnabled(): boolean {
+  return !!nativeRtms.TRACE_ENABLED;
+}
+
+/**
+ * Exports the hot-path trace recorded by an RTMS_TRACE build
+ *
+ * The trace holds begin/end spans for each SDK sink, poll, config and join
+ * call, the thread-safe function hand-off and the JavaScript callback itself,
+ * in the Chrome trace event format (open in chrome://tracing or
+ * ui.perfetto.dev). Without RTMS_TRACE the trace is always empty.
+ *
+ * @param path File to write the trace to; when omitted the JSON is returned
+ * @returns The trace JSON, or true once it has been written to path
+ *
+ * @category Common Functions
+ */
+export function dumpTrace(): string;
+export function dumpTrace(path: string): boolean;
+export function dumpTrace(path?: string): string | boolean {
+  return path === undefined ? nativeRtms.dumpTrace() : nativeRtms.dumpTrace(path);
+}
+
+/**
+ * Discards every event recorded so far by an RTMS_TRACE build
+ *
+ * @category Common Functions
+ */
+export function clearTrace(): void {
+  nativeRtms.clearTrace();
+}
+
 /**
  * Validates audio parameters and throws helpful errors
  * 
@@ -849,6 +957,99 @@ function setParameters<T>(
   }
 }
 
+type MediaKind = 'audio' | 'video' | 'deskshare' | 'transcript';
+
+// SharedRing layout; see src/shared_ring.h
+const SHARED_RING_MAGIC = 0x524D5452;
+const SHARED_RING_HEADER = 64;
+const SHARED_RING_RECORD_HEADER = 24;
+const SHARED_RING_WRAP = 0xFFFFFFFF;
+const SHARED_RING_CAPACITY = 1;
+const SHARED_RING_COMMIT = 2;
+const SHARED_RING_RESERVE = 3;
+const SHARED_RING_DROPPED = 4;
+const SHARED_RING_CLOSED = 5;
+// Longest a blocked read sleeps between checks when no notification comes,
+// e.g. because the main thread is busy
+const SHARED_RING_WAIT_SLICE_MS = 5;
+// Longest a ShmRingReader blocks in native code at a time
+const SHM_RING_WAIT_SLICE_MS = 100;
+type DataCallback = (buffer: Buffer, size: number, timestamp: number, metadata: Metadata) => void;
+
+const DATA_METHODS: Record<MediaKind, string> = {
+  audio: 'onAudioData',
+  video: 'onVideoData',
+  deskshare: 'onDeskshareData',
+  transcript: 'onTranscriptData'
+};
+
+/**
+ * Everything fed by one media type's native data callback
+ * @private
+ */
+interface MediaSink {
+  callback: DataCallback | null;
+  streams: Set<MediaReadable>;
+  /** Streams whose buffer is full; the native queue is paused while any are */
+  full: Set<MediaReadable>;
+}
+
+/**
+ * Readable over one media type of a Client
+ *
+ * Frames are pushed as the client receives them. When a push finds the
+ * stream's buffer full, the client pauses that media's native delivery
+ * queue until the stream is read again, so a slow consumer pushes back on
+ * the queue instead of frames piling up here. A paused queue drops its
+ * oldest frames once full, whatever its policy, so it never holds up the
+ * poll thread.
+ * @private
+ */
+class MediaReadable extends Readable {
+  private waiting = false;
+  private finished = false;
+
+  constructor(
+    private readonly onFull: (stream: MediaReadable, full: boolean) => void,
+    private readonly onClose: (stream: MediaReadable) => void,
+    private readonly userId: number | undefined,
+    objectMode: boolean,
+    highWaterMark: number | undefined
+  ) {
+    super({ objectMode, highWaterMark });
+  }
+
+  offer(buffer: Buffer, size: number, timestamp: number, metadata: Metadata): void {
+    if (this.finished || this.destroyed) return;
+    if (this.userId !== undefined && metadata.userId !== this.userId) return;
+
+    const more = this.push(this.readableObjectMode ? { buffer, size, timestamp, metadata } : buffer);
+    if (!more && !this.waiting) {
+      this.waiting = true;
+      this.onFull(this, true);
+    }
+  }
+
+  finish(): void {
+    if (this.finished || this.destroyed) return;
+    this.finished = true;
+    this.push(null);
+  }
+
+  _read(): void {
+    if (this.waiting) {
+      this.waiting = false;
+      this.onFull(this, false);
+    }
+  }
+
+  _destroy(error: Error | null, callback: (error?: Error | null) => void): void {
+    this.finished = true;
+    this.onClose(this);
+    callback(error);
+  }
+}
+
 /**
  * Client class for connecting to Zoom RTMS streams
  * 
@@ -860,12 +1061,18 @@ function setParameters<T>(
 class Client extends nativeRtms.Client {
   private pollingInterval: NodeJS.Timeout | null = null;
   private pollRate: number = 0;
+  private eventLoop: EventLoop | null = null;
   private participantEventCallback: ((event: 'join' | 'leave', timestamp: number, participants: Array<{ userId: number; userName?: string }>) => void) | null = null;
   private activeSpeakerEventCallback: ((timestamp: number, userId: number, userName: string) => void) | null = null;
   private sharingEventCallback: ((event: 'start' | 'stop', timestamp: number, userId?: number, userName?: string) => void) | null = null;
   private rawEventCallback: ((eventData: string) => void) | null = null;
   private mediaConnectionInterruptedCallback: ((timestamp: number) => void) | null = null;
   private eventHandlerRegistered: boolean = false;
+  private mediaSinks = new Map<MediaKind, MediaSink>();
+  private leaveCallback: ((reason: number) => void) | null = null;
+  private leaveHooked: boolean = false;
+  private sharedRings = new Map<MediaKind, SharedArrayBuffer>();
+  private shmRings = new Map<MediaKind, string>();
 
   constructor() {
     super();
@@ -961,8 +1168,9 @@ class Client extends nativeRtms.Client {
    * and starts background polling for events.
    * 
    * @param options Object containing join parameters
-   * @returns true if the join operation succeeds
-
+   * @returns With timer polling, whether the SDK join succeeded. With native
+   *          polling or an EventLoop, true once the join is scheduled; a join
+   *          that then fails is reported through onJoinConfirm()
    */
   join(options: JoinParams): boolean {
     let ret = false;
@@ -985,6 +1193,18 @@ class Client extends nativeRtms.Client {
       pollInterval = 0
     } = options;
 
+    // An explicit pollInterval only means something to timer polling, so it
+    // selects the timer unless a polling mode was asked for
+    const requested = options.polling || (process.env['ZM_RTMS_POLLING'] as PollingMode | undefined);
+    const polling: PollingMode = requested || (options.pollInterval !== undefined ? 'timer' : 'native');
+    if (polling !== 'native' && polling !== 'timer') {
+      throw new RangeError(`polling must be 'native' or 'timer', got '${polling}'`);
+    }
+    if (options.pollInterval !== undefined && (polling === 'native' || this.eventLoop)) {
+      Logger.warn('client', `pollInterval is ignored by native polling; use polling: 'timer' or ` +
+                  `an EventLoop created with { pollInterval }`);
+    }
+
     // Use meeting_uuid for Meeting SDK, webinar_uuid for Webinar,
     // session_id for Video SDK, engagement_id for ZCC
     const instance_id = meeting_uuid || webinar_uuid || session_id || engagement_id;
@@ -1010,6 +1230,17 @@ class Client extends nativeRtms.Client {
       streamId: rtms_stream_id
     });
 
+    if (!this.eventLoop && polling === 'native') {
+      sharedEventLoop().add(this);
+    }
+
+    if (this.eventLoop) {
+      // Joined, polled and released on the loop's native thread
+      this.eventLoop._attach(this, instance_id, rtms_stream_id, finalSignature, server_urls, providedTimeout);
+      Logger.info('client', `Join deferred to EventLoop: ${instance_id}`);
+      return true;
+    }
+
     try {
       ret = super.join(instance_id, rtms_stream_id, finalSignature, server_urls, providedTimeout);
 
@@ -1234,6 +1465,221 @@ class Client extends nativeRtms.Client {
     return true;
   }
 
+  onAudioData(callback: DataCallback): boolean {
+    return this.setDataCallback('audio', callback);
+  }
+
+  onVideoData(callback: DataCallback): boolean {
+    return this.setDataCallback('video', callback);
+  }
+
+  onDeskshareData(callback: DataCallback): boolean {
+    return this.setDataCallback('deskshare', callback);
+  }
+
+  onTranscriptData(callback: DataCallback): boolean {
+    return this.setDataCallback('transcript', callback);
+  }
+
+  onLeave(callback: (reason: number) => void): boolean {
+    if (typeof callback !== 'function') {
+      throw new TypeError('Function argument expected');
+    }
+    this.leaveCallback = callback;
+    return this.hookLeave();
+  }
+
+  /**
+   * Readable stream of audio frames
+   *
+   * In object mode (the default) each chunk is a `MediaFrame`; in byte mode
+   * it is the frame's Buffer. Streams are async iterable, and end when the
+   * client leaves.
+   *
+   * @example
+   * ```typescript
+   * for await (const frame of client.audioStream({ userId: 16778240 })) {
+   *   encoder.write(frame.buffer);
+   * }
+   * ```
+   */
+  audioStream(options: MediaStreamOptions = {}): Readable {
+    return this.openStream('audio', options);
+  }
+
+  /** Readable stream of video frames (see audioStream) */
+  videoStream(options: MediaStreamOptions = {}): Readable {
+    return this.openStream('video', options);
+  }
+
+  /** Readable stream of deskshare frames (see audioStream) */
+  deskshareStream(options: MediaStreamOptions = {}): Readable {
+    return this.openStream('deskshare', options);
+  }
+
+  /** Readable stream of transcript frames (see audioStream) */
+  transcriptStream(options: MediaStreamOptions = {}): Readable {
+    return this.openStream('transcript', options);
+  }
+
+  /**
+   * SharedArrayBuffer ring that this client's frames of one media type are
+   * copied into on the polling thread
+   *
+   * Pass the buffer to worker_threads and read it there with
+   * SharedRingReader; every reader sees every frame, with no JS-thread hop or
+   * structured clone. Calling again for the same media type returns the same
+   * ring. Rings are closed when the client leaves.
+   *
+   * @example
+   * ```typescript
+   * const ring = client.sharedRing('audio', { bytes: 8 << 20 });
+   * for (let i = 0; i < 4; i++) new Worker('./mixer.js', { workerData: { ring, shard: i } });
+   * ```
+   */
+  sharedRing(media: MediaKind, options: SharedRingOptions = {}): SharedArrayBuffer {
+    const existing = this.sharedRings.get(media);
+    if (existing) return existing;
+    if (this.shmRings.has(media)) throw new Error(`${media} already has a shared-memory ring`);
+
+    const { bytes = 4 * 1024 * 1024 } = options;
+    const buffer = new SharedArrayBuffer(SHARED_RING_HEADER + bytes);
+    const header = new Int32Array(buffer, 0, SHARED_RING_HEADER / 4);
+    super.attachSharedRing(media, new Uint8Array(buffer), () => {
+      Atomics.notify(header, SHARED_RING_COMMIT);
+    });
+    this.sharedRings.set(media, buffer);
+    return buffer;
+  }
+
+  /**
+   * Ring in a named POSIX shared-memory segment that this client's frames of
+   * one media type are copied into on the polling thread
+   *
+   * Other processes attach with `new rtms.ShmRingReader(name)`, so CPU-heavy
+   * work can be spread over processes without piping or re-serializing each
+   * frame. The segment is named `/rtms-<streamId>-<media>` unless a name is
+   * given, and is removed when the ring is closed or the client leaves;
+   * attached readers can still drain it. Calling again for the same media
+   * type returns the same name.
+   *
+   * @returns The segment name
+   */
+  shmRing(media: MediaKind, options: ShmRingOptions = {}): string {
+    const existing = this.shmRings.get(media);
+    if (existing) return existing;
+    if (this.sharedRings.has(media)) throw new Error(`${media} already has a SharedArrayBuffer ring`);
+
+    const { bytes = 4 * 1024 * 1024, name = '' } = options;
+    const attached: string = super.attachShmRing(media, name, bytes);
+    this.shmRings.set(media, attached);
+    return attached;
+  }
+
+  /**
+   * Stop writing to a media type's shared ring; its readers see it closed
+   *
+   * @returns true if a ring was attached
+   */
+  closeSharedRing(media: MediaKind): boolean {
+    if (this.shmRings.delete(media)) {
+      super.detachSharedRing(media);
+      return true;
+    }
+    const buffer = this.sharedRings.get(media);
+    if (!buffer) return false;
+    this.sharedRings.delete(media);
+    super.detachSharedRing(media);
+    Atomics.notify(new Int32Array(buffer, 0, SHARED_RING_HEADER / 4), SHARED_RING_COMMIT);
+    return true;
+  }
+
+  /**
+   * The dispatcher for one media type, registered with the native client on
+   * first use. The data callback and any streams all hang off it.
+   * @private
+   */
+  private mediaSink(kind: MediaKind): MediaSink {
+    let sink = this.mediaSinks.get(kind);
+    if (!sink) {
+      const created: MediaSink = { callback: null, streams: new Set(), full: new Set() };
+      super[DATA_METHODS[kind]]((buffer: Buffer, size: number, timestamp: number, metadata: Metadata) => {
+        created.callback?.(buffer, size, timestamp, metadata);
+        for (const stream of created.streams) {
+          stream.offer(buffer, size, timestamp, metadata);
+        }
+      });
+      this.mediaSinks.set(kind, created);
+      sink = created;
+    }
+    return sink;
+  }
+
+  /**
+   * @private
+   */
+  private setDataCallback(kind: MediaKind, callback: DataCallback): boolean {
+    if (typeof callback !== 'function') {
+      throw new TypeError('Function argument expected');
+    }
+    this.mediaSink(kind).callback = callback;
+    return true;
+  }
+
+  /**
+   * @private
+   */
+  private openStream(kind: MediaKind, options: MediaStreamOptions): Readable {
+    const { userId, highWaterMark, objectMode = true } = options;
+    const sink = this.mediaSink(kind);
+    this.hookLeave();
+
+    const setFull = (stream: MediaReadable, full: boolean) => {
+      const wasPaused = sink.full.size > 0;
+      if (full) {
+        sink.full.add(stream);
+      } else {
+        sink.full.delete(stream);
+      }
+      const paused = sink.full.size > 0;
+      if (paused !== wasPaused) {
+        super.setDeliveryPaused(kind, paused);
+      }
+    };
+    const stream = new MediaReadable(setFull, (closed) => {
+      setFull(closed, false);
+      sink.streams.delete(closed);
+    }, userId, objectMode, highWaterMark);
+
+    sink.streams.add(stream);
+    return stream;
+  }
+
+  /**
+   * Streams end when the client leaves, so the native leave callback is
+   * registered once streams or onLeave need it.
+   * @private
+   */
+  private hookLeave(): boolean {
+    if (this.leaveHooked) return true;
+    this.leaveHooked = true;
+    return super.onLeave((reason: number) => {
+      this.leaveCallback?.(reason);
+      this.endStreams();
+    });
+  }
+
+  /**
+   * @private
+   */
+  private endStreams(): void {
+    for (const sink of this.mediaSinks.values()) {
+      for (const stream of sink.streams) {
+        stream.finish();
+      }
+    }
+  }
+
   /**
    * Start background polling for events
    * 
@@ -1270,6 +1716,21 @@ class Client extends nativeRtms.Client {
     }
   }
   
+  /**
+   * Milliseconds until this client is next polled
+   *
+   * On an EventLoop this is the interval the loop's schedule chose for this
+   * client; otherwise it is the fixed timer interval.
+   *
+   * @returns null if the client is not being polled
+   */
+  pollInterval(): number | null {
+    if (this.eventLoop) {
+      return this.eventLoop.pollIntervalOf(this);
+    }
+    return this.pollingInterval ? this.pollRate : null;
+  }
+
   /**
    * Leave the current RTMS session and clean up resources
    * 
@@ -1283,7 +1744,15 @@ class Client extends nativeRtms.Client {
     
     try {
       this.stopPolling();
-      const result = super.release();
+      this.endStreams();
+      for (const media of [...this.sharedRings.keys(), ...this.shmRings.keys()]) {
+        this.closeSharedRing(media);
+      }
+      // A loop releases its clients on its own thread; release here only if
+      // no loop owns this client.
+      const loop = this.eventLoop;
+      this.eventLoop = null;
+      const result = (loop !== null && loop.remove(this)) || super.release();
       
       if (result) {
         Logger.info('client', 'Successfully left meeting');
@@ -1300,6 +1769,341 @@ class Client extends nativeRtms.Client {
   }
 }
 
+/**
+ * Options for an EventLoop
+ */
+export interface EventLoopOptions {
+  /** Milliseconds between poll cycles (default: 10); ignored when `mode` is set */
+  pollInterval?: number;
+  /** Native thread name, useful in debuggers and profilers */
+  name?: string;
+  /**
+   * Adaptive poll schedule. Each client is polled soon after it delivers data
+   * and progressively less often while idle:
+   * - `latency`: re-poll immediately (spin, then yield) while busy; at most 1ms idle
+   * - `balanced`: 1ms while busy; backs off to 50ms idle
+   * - `power`: 5ms while busy; backs off to 100ms idle
+   */
+  mode?: 'latency' | 'balanced' | 'power';
+}
+
+/**
+ * Native reactor that drives many clients from one OS thread
+ *
+ * Clients added to an EventLoop are joined, polled and released on the loop's
+ * native thread, and only their callbacks reach the JS thread. Clients that are
+ * not added to one share a default loop, unless they join with
+ * `polling: 'timer'`, which runs a `setInterval` poll timer on the JS thread.
+ *
+ * @example
+ * ```typescript
+ * const loop = new rtms.EventLoop();
+ * const client = new rtms.Client();
+ * client.onAudioData((data) => { ... });
+ * loop.add(client);
+ * client.join(payload);
+ * ```
+ */
+class EventLoop {
+  private native: any;
+  private clients = new Set<Client>();
+
+  constructor(options: EventLoopOptions = {}) {
+    this.native = new nativeRtms.EventLoop(options.pollInterval ?? 10, options.name ?? '', options.mode ?? '');
+  }
+
+  /** Number of clients owned by this loop, including those still joining */
+  get clientCount(): number {
+    return this.native.clientCount();
+  }
+
+  /**
+   * Assign a client to this loop. Call before `client.join()`.
+   */
+  add(client: Client): void {
+    (client as any).eventLoop = this;
+  }
+
+  /**
+   * Release a client on the loop thread and detach it
+   *
+   * @returns false if the client does not belong to this loop
+   */
+  remove(client: Client): boolean {
+    this.clients.delete(client);
+    return this.native.remove(client);
+  }
+
+  /**
+   * Milliseconds until the loop next polls a client
+   *
+   * @returns 0 while the client is re-polled immediately, null if this loop is not polling it
+   */
+  pollIntervalOf(client: Client): number | null {
+    return this.native.pollInterval(client);
+  }
+
+  /** Stop the loop; remaining clients are released on the loop thread */
+  stop(): void {
+    this.native.stop();
+    this.clients.clear();
+  }
+
+  /** @internal Called by Client.join() once the join parameters are known */
+  _attach(client: Client, uuid: string, streamId: string, signature: string, serverUrls: string, timeout: number): void {
+    this.native.add(client, uuid, streamId, signature, serverUrls, timeout);
+    // Keep the client reachable while the native loop polls it
+    this.clients.add(client);
+  }
+}
+
+/**
+ * Options for an EventLoopPool
+ */
+export interface EventLoopPoolOptions extends Omit<EventLoopOptions, 'name'> {
+  /** Number of loop threads (default: 4) */
+  threads?: number;
+  /** How clients are assigned to loops (default: 'least_loaded') */
+  strategy?: 'least_loaded' | 'round_robin';
+}
+
+/**
+ * Fixed set of EventLoops with clients routed to one loop for their lifetime
+ */
+class EventLoopPool {
+  readonly loops: EventLoop[];
+  private strategy: 'least_loaded' | 'round_robin';
+  private next = 0;
+
+  constructor(options: EventLoopPoolOptions = {}) {
+    const threads = options.threads ?? 4;
+    if (threads < 1) {
+      throw new RangeError('threads must be >= 1');
+    }
+    this.strategy = options.strategy ?? 'least_loaded';
+    this.loops = Array.from({ length: threads }, (_, i) =>
+      new EventLoop({ pollInterval: options.pollInterval, mode: options.mode, name: `rtms-pool-${i}` }));
+  }
+
+  /** Total clients across all loops */
+  get clientCount(): number {
+    return this.loops.reduce((total, loop) => total + loop.clientCount, 0);
+  }
+
+  /**
+   * Assign a client to a loop according to the strategy. Call before `client.join()`.
+   *
+   * @returns the loop the client was assigned to
+   */
+  add(client: Client): EventLoop {
+    const loop = this.strategy === 'round_robin'
+      ? this.loops[this.next++ % this.loops.length]
+      : this.loops.reduce((least, loop) => loop.clientCount < least.clientCount ? loop : least);
+    loop.add(client);
+    return loop;
+  }
+
+  /** Release a client on its loop's thread; false if no loop owns it */
+  remove(client: Client): boolean {
+    return this.loops.some((loop) => loop.remove(client));
+  }
+
+  /** Stop every loop */
+  stop(): void {
+    for (const loop of this.loops) loop.stop();
+  }
+}
+
+/**
+ * Reads frames from a Client's shared ring, typically in a worker thread
+ *
+ * Each reader starts at the newest frame and sees every frame after it. A
+ * reader that falls a whole ring behind skips ahead to the writer rather
+ * than slowing it down; `lapped` counts how often that happened and `lost`
+ * how many frames it missed, from gaps in their sequence numbers.
+ *
+ * @example
+ * ```typescript
+ * const reader = new rtms.SharedRingReader(workerData.ring);
+ * for (let frame; (frame = reader.read()) !== null;) {
+ *   if (frame.userId % 4 === workerData.shard) mix(frame.data);
+ * }
+ * ```
+ */
+class SharedRingReader {
+  /** Times this reader was lapped and skipped ahead to the writer */
+  lapped = 0;
+
+  /** Frames skipped between ones this reader returned */
+  lost = 0;
+
+  private header: Int32Array;
+  private view: DataView;
+  private bytes: Uint8Array;
+  private capacity: number;
+  private position: number;
+  private sequence = -1;
+
+  constructor(buffer: SharedArrayBuffer) {
+    this.header = new Int32Array(buffer, 0, SHARED_RING_HEADER / 4);
+    if ((Atomics.load(this.header, 0) >>> 0) !== SHARED_RING_MAGIC ||
+        Atomics.load(this.header, SHARED_RING_CAPACITY) !== buffer.byteLength - SHARED_RING_HEADER) {
+      throw new RangeError('Buffer does not hold an RTMS shared ring');
+    }
+    this.capacity = buffer.byteLength - SHARED_RING_HEADER;
+    this.view = new DataView(buffer, SHARED_RING_HEADER);
+    this.bytes = new Uint8Array(buffer, SHARED_RING_HEADER);
+    this.position = Atomics.load(this.header, SHARED_RING_COMMIT) >>> 0;
+  }
+
+  /** The client has closed the ring; frames already written can still be read */
+  get closed(): boolean {
+    return Atomics.load(this.header, SHARED_RING_CLOSED) !== 0;
+  }
+
+  /** Frames the writer dropped for being larger than the ring */
+  get dropped(): number {
+    return Atomics.load(this.header, SHARED_RING_DROPPED) >>> 0;
+  }
+
+  /**
+   * Wait up to timeout ms for the next frame
+   *
+   * @returns The frame, or null on timeout or once the ring is closed and drained
+   */
+  read(timeout: number = Infinity): SharedRingFrame | null {
+    const deadline = Date.now() + timeout;
+    for (;;) {
+      const frame = this.tryRead();
+      if (frame || this.closed) return frame;
+
+      const remaining = deadline - Date.now();
+      if (remaining <= 0) return null;
+      Atomics.wait(this.header, SHARED_RING_COMMIT, this.position | 0,
+                   Math.min(remaining, SHARED_RING_WAIT_SLICE_MS));
+    }
+  }
+
+  /** The next frame if one is ready, without waiting */
+  tryRead(): SharedRingFrame | null {
+    for (;;) {
+      const commit = Atomics.load(this.header, SHARED_RING_COMMIT) >>> 0;
+      if (this.position === commit) return null;
+
+      const offset = this.position & (this.capacity - 1);
+      const size = this.view.getUint32(offset, true);
+      const wrap = size === SHARED_RING_WRAP;
+      const advance = wrap ? this.capacity - offset : (SHARED_RING_RECORD_HEADER + size + 7) & ~7;
+      const intact = ((commit - this.position) >>> 0) <= this.capacity && advance <= this.capacity - offset;
+
+      let frame: SharedRingFrame | null = null;
+      if (intact && !wrap) {
+        const start = offset + SHARED_RING_RECORD_HEADER;
+        frame = {
+          sequence: this.view.getUint32(offset + 16, true) + this.view.getUint32(offset + 20, true) * 2 ** 32,
+          userId: this.view.getInt32(offset + 4, true),
+          timestamp: this.view.getFloat64(offset + 8, true),
+          data: this.bytes.slice(start, start + size)
+        };
+      }
+
+      // The copy is only good if the writer has not started overwriting it
+      const reserve = Atomics.load(this.header, SHARED_RING_RESERVE) >>> 0;
+      if (!intact || ((reserve - this.position) >>> 0) > this.capacity) {
+        this.position = Atomics.load(this.header, SHARED_RING_COMMIT) >>> 0;
+        this.lapped++;
+        continue;
+      }
+
+      this.position = (this.position + advance) >>> 0;
+      if (frame) {
+        if (this.sequence >= 0 && frame.sequence > this.sequence) this.lost += frame.sequence - this.sequence;
+        this.sequence = frame.sequence + 1;
+        return frame;
+      }
+    }
+  }
+}
+
+/**
+ * Reads frames from another process's shared-memory ring (see
+ * `Client.shmRing()`)
+ *
+ * Behaves like SharedRingReader: each reader starts at the newest frame, and
+ * one that falls a whole ring behind skips ahead, counting `lapped` and
+ * `lost`. The writer wakes blocked readers itself, so `read()` needs no help
+ * from the writing process's JS thread.
+ *
+ * @example
+ * ```typescript
+ * // worker process, started with the name returned by client.shmRing('video')
+ * const reader = new rtms.ShmRingReader(process.argv[2]);
+ * for (let frame; (frame = reader.read()) !== null;) detect(frame.data);
+ * ```
+ */
+class ShmRingReader {
+  private native: any;
+
+  /** @throws Error if no ring has that name */
+  constructor(name: string) {
+    this.native = new nativeRtms.ShmRingReader(name);
+  }
+
+  /** The writer has closed the ring; frames already written can still be read */
+  get closed(): boolean {
+    return this.native.closed();
+  }
+
+  /** Times this reader was lapped and skipped ahead to the writer */
+  get lapped(): number {
+    return this.native.lapped();
+  }
+
+  /** Frames skipped between ones this reader returned */
+  get lost(): number {
+    return this.native.lost();
+  }
+
+  /**
+   * Wait up to timeout ms for the next frame, blocking this thread
+   *
+   * @returns The frame, or null on timeout or once the ring is closed and drained
+   */
+  read(timeout: number = Infinity): SharedRingFrame | null {
+    const deadline = Date.now() + timeout;
+    for (;;) {
+      const frame = this.tryRead();
+      if (frame || this.closed) return frame;
+
+      const remaining = deadline - Date.now();
+      if (remaining <= 0) return null;
+      this.native.wait(Math.min(remaining, SHM_RING_WAIT_SLICE_MS));
+    }
+  }
+
+  /** The next frame if one is ready, without waiting */
+  tryRead(): SharedRingFrame | null {
+    return this.native.tryRead();
+  }
+}
+
+let sharedLoop: EventLoop | null = null;
+
+/**
+ * The native poll thread that clients join by default
+ *
+ * Created on first use. Clients that are not added to an EventLoop of their
+ * own and do not ask for `polling: 'timer'` are joined, polled and released
+ * here, so SDK I/O keeps running while the JS thread is busy or collecting
+ * garbage.
+ */
+function sharedEventLoop(): EventLoop {
+  if (!sharedLoop) {
+    sharedLoop = new EventLoop({ mode: 'balanced', name: 'rtms-poll' });
+  }
+  return sharedLoop;
+}
+
 /**
  * Configure the RTMS logger
  * 
@@ -1322,9 +2126,23 @@ const numberConstants = exposeNumberConstants(nativeRtms);
 export default {
   // Class-based API
   Client,
+  EventLoop,
+  EventLoopPool,
+  SharedRingReader,
+  ShmRingReader,
   onWebhookEvent,
   createWebhookHandler,
 
+  // Prometheus metrics
+  renderMetrics,
+  startMetricsServer,
+  stopMetricsServer,
+
+  // Hot-path tracing (RTMS_TRACE builds)
+  traceEnabled,
+  dumpTrace,
+  clearTrace,
+
   // Utility functions
   generateSignature,
   isInitialized: () => isInitialized,
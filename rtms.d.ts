@@ -9,6 +9,8 @@
  * @module rtms
  */
 
+import type { Readable } from 'stream';
+
 /**
  * Available log levels for RTMS SDK logging
  * 
@@ -231,8 +233,30 @@ export interface Metadata {
   startTs: number;
   /** Stream end timestamp in milliseconds */
   endTs: number;
-  /** AI interpreter metadata (populated when Zoom's AI interpreter is active) */
-  aiInterpreter: AiInterpreter;
+  /**
+   * AI interpreter metadata (populated when Zoom's AI interpreter is active).
+   * Frozen, and shared between frames from the same user while it is unchanged
+   */
+  aiInterpreter: Readonly<AiInterpreter>;
+}
+
+/**
+ * Every frame of one media type delivered during one poll, packed into a
+ * single buffer. Frame `i` is `data.subarray(offsets[i], offsets[i + 1])`.
+ *
+ * @category Data Interfaces
+ */
+export interface MediaBatch {
+  /** Number of frames in the batch */
+  count: number;
+  /** Frame payloads back to back */
+  data: Buffer;
+  /** Start of each frame in `data`, plus a final entry equal to `data.length` */
+  offsets: Uint32Array;
+  /** Timestamp of each frame */
+  timestamps: Float64Array;
+  /** Sender of each frame */
+  metadata: Metadata[];
 }
 
 /**
@@ -400,11 +424,180 @@ export const TranscriptLanguage: {
   readonly VIETNAMESE: number;
 };
 
+/**
+ * Delivery counters for one media type
+ *
+ * @category Data Interfaces
+ */
+export interface MediaStats {
+  /** Frames received from the SDK */
+  frames: number;
+  /** Payload bytes received from the SDK */
+  bytes: number;
+  /** Deliveries dropped because they had no buffer, no metadata or zero size */
+  empty: number;
+  /** Frames discarded because the callback fell behind (see setDeliveryQueue) */
+  dropped: number;
+}
+
+/**
+ * What a media callback's queue does with a frame that arrives while it is full
+ *
+ * - `block`: the polling thread waits for JavaScript to catch up, for up to one
+ *   second per stall, then drops until the queue is drained
+ * - `drop-oldest`: discard the oldest queued frame
+ * - `drop-newest`: discard the arriving frame
+ * - `audio-priority`: audio blocks, every other media type drops its oldest frame
+ *
+ * @category Data Interfaces
+ */
+export type DeliveryPolicy = 'block' | 'drop-oldest' | 'drop-newest' | 'audio-priority';
+
+/**
+ * Queue limits for media callbacks; omitted fields keep their current value
+ *
+ * Depths are in frames for the `on*Data` callbacks and in batches for the
+ * `on*Batch` callbacks. 0 means unbounded.
+ *
+ * @category Data Interfaces
+ */
+export interface DeliveryQueueOptions {
+  /** Default 'block' */
+  policy?: DeliveryPolicy;
+  /** Default 1024 */
+  audio?: number;
+  /** Default 1024 */
+  video?: number;
+  /** Default 1024 */
+  deskshare?: number;
+  /** Default 1024 */
+  transcript?: number;
+}
+
+/**
+ * Options for a media stream such as client.audioStream()
+ *
+ * @category Data Interfaces
+ */
+export interface MediaStreamOptions {
+  /** Only frames from this participant; default all */
+  userId?: number;
+  /** Frames (object mode) or bytes (byte mode) buffered before backpressure applies */
+  highWaterMark?: number;
+  /** Chunks are MediaFrame objects when true (default), the frame Buffers when false */
+  objectMode?: boolean;
+}
+
+/**
+ * Options for client.sharedRing()
+ *
+ * @category Data Interfaces
+ */
+export interface SharedRingOptions {
+  /** Size of the ring's data area; a power of two from 4 KiB to 1 GiB. Default 4 MiB */
+  bytes?: number;
+}
+
+/**
+ * Options for Client.shmRing()
+ *
+ * @category Data Interfaces
+ */
+export interface ShmRingOptions extends SharedRingOptions {
+  /** Segment name, '/' followed by a name without '/'. Default `/rtms-<streamId>-<media>` */
+  name?: string;
+}
+
+/**
+ * One frame read from a shared ring
+ *
+ * @category Data Interfaces
+ */
+export interface SharedRingFrame {
+  /** Frames written to the ring before this one; a gap means frames were missed */
+  sequence: number;
+  userId: number;
+  timestamp: number;
+  /** A copy of the payload, safe to keep after the ring moves on */
+  data: Uint8Array;
+}
+
+/**
+ * One frame from an object-mode media stream
+ *
+ * @category Data Interfaces
+ */
+export interface MediaFrame {
+  buffer: Buffer;
+  size: number;
+  timestamp: number;
+  metadata: Metadata;
+}
+
+/**
+ * Summary of a latency histogram, in microseconds
+ *
+ * Percentiles are accurate to within 12.5%.
+ *
+ * @category Data Interfaces
+ */
+export interface LatencyStats {
+  count: number;
+  meanUs: number;
+  p50Us: number;
+  p90Us: number;
+  p99Us: number;
+  maxUs: number;
+}
+
+/**
+ * Snapshot of a client's native metrics, returned by Client.getStats()
+ *
+ * @category Data Interfaces
+ */
+export interface ClientStats {
+  audio: MediaStats;
+  video: MediaStats;
+  deskshare: MediaStats;
+  transcript: MediaStats;
+  /** Time spent in each SDK poll, including the callbacks it ran */
+  poll: LatencyStats;
+  /** Time spent in each callback on the SDK thread */
+  callbacks: {
+    joinConfirm: LatencyStats;
+    sessionUpdate: LatencyStats;
+    userUpdate: LatencyStats;
+    audio: LatencyStats;
+    video: LatencyStats;
+    deskshare: LatencyStats;
+    transcript: LatencyStats;
+    leave: LatencyStats;
+    eventEx: LatencyStats;
+    participantVideo: LatencyStats;
+    videoSubscribed: LatencyStats;
+    audioBatch: LatencyStats;
+    videoBatch: LatencyStats;
+    deskshareBatch: LatencyStats;
+    transcriptBatch: LatencyStats;
+  };
+}
+
 
 //-----------------------------------------------------------------------------------
 // Parameter interfaces
 //-----------------------------------------------------------------------------------
 
+/**
+ * Where a client's SDK polling runs
+ *
+ * - `native`: on a shared native thread, so media keeps flowing while the JS
+ *   thread is busy; callbacks are still delivered on the JS thread
+ * - `timer`: from a JS `setInterval` every `pollInterval` ms
+ *
+ * @category Common Interfaces
+ */
+export type PollingMode = 'native' | 'timer';
+
 /**
  * Parameters for joining a Zoom RTMS session
  *
@@ -438,8 +631,18 @@ export interface JoinParams {
   ca?: string;
   /** The timeout for the join operation in milliseconds */
   timeout?: number;
-  /** The interval between poll operations in milliseconds */
+  /**
+   * The interval between poll operations in milliseconds (timer polling only).
+   * Passing it without `polling` or ZM_RTMS_POLLING selects timer polling;
+   * with native polling it is ignored and a warning is logged.
+   */
   pollInterval?: number;
+  /**
+   * Where SDK polling runs (defaults to ZM_RTMS_POLLING, else `timer` if
+   * `pollInterval` is given, else `native`). Ignored for clients already
+   * added to an EventLoop.
+   */
+  polling?: PollingMode;
   /** Whether to verify TLS certificates (1 = verify, 0 = don't verify, defaults to 1) */
   is_verify_cert?: number;
   /** User agent string to send in requests */
@@ -583,7 +786,8 @@ export type SharingEventCallback = (
 /**
  * Callback function for receiving deskshare data
  * 
- * @param buffer The raw deskshare data buffer
+ * @param buffer The raw deskshare data buffer, wrapping native memory without a copy;
+ *   it stays valid for as long as it is referenced
  * @param size The size of the deskshare data in bytes
  * @param timestamp The timestamp of the deskshare data
  * @param metadata Metadata about the participant who sent the audio
@@ -595,7 +799,8 @@ export type DeskshareCallback = (buffer: Buffer, size: number, timestamp: number
 /**
  * Callback function for receiving audio data
  * 
- * @param buffer The raw audio data buffer
+ * @param buffer The raw audio data buffer, wrapping native memory without a copy;
+ *   it stays valid for as long as it is referenced
  * @param size The size of the audio data in bytes
  * @param timestamp The timestamp of the audio data
  * @param metadata Metadata about the participant who sent the audio
@@ -607,7 +812,8 @@ export type AudioDataCallback = (buffer: Buffer, size: number, timestamp: number
 /**
  * Callback function for receiving video data
  * 
- * @param buffer The raw video data buffer
+ * @param buffer The raw video data buffer, wrapping native memory without a copy;
+ *   it stays valid for as long as it is referenced
  * @param size The size of the video data in bytes
  * @param timestamp The timestamp of the video data
  * @param metadata Metadata about the participant who sent the video
@@ -619,7 +825,8 @@ export type VideoDataCallback = (buffer: Buffer, size: number, timestamp: number
 /**
  * Callback function for receiving transcript data
  * 
- * @param buffer The raw transcript data buffer
+ * @param buffer The raw transcript data buffer, wrapping native memory without a copy;
+ *   it stays valid for as long as it is referenced
  * @param size The size of the transcript data in bytes
  * @param timestamp The timestamp of the transcript data
  * @param metadata Metadata about the participant who sent the transcript
@@ -628,6 +835,15 @@ export type VideoDataCallback = (buffer: Buffer, size: number, timestamp: number
  */
 export type TranscriptDataCallback = (buffer: Buffer, size: number, timestamp: number, metadata: Metadata) => void;
 
+/**
+ * Callback function for batched media delivery
+ *
+ * @param batch Every frame received during one poll
+ *
+ * @category Callback Types
+ */
+export type MediaBatchCallback = (batch: MediaBatch) => void;
+
 /**
  * Callback function for leave events
  * 
@@ -726,7 +942,9 @@ export class Client {
    * After joining, callback methods will be invoked as events occur.
    * 
    * @param options An object containing join parameters
-   * @returns true if the join operation succeeds
+   * @returns With timer polling, whether the SDK join succeeded. With native
+   *          polling or an EventLoop, true once the join is scheduled; a join
+   *          that then fails is reported through onJoinConfirm()
    * 
    * @example
    * ```typescript
@@ -823,6 +1041,44 @@ export class Client {
    * @returns The RTMS stream ID
    */
   streamId(): string;
+
+  /**
+   * Gets a snapshot of this client's native metrics
+   *
+   * Counters are updated on the SDK thread without locking, so this is cheap
+   * enough to call from a metrics scrape or a periodic logger.
+   *
+   * @returns Frames, bytes and empty deliveries per media type, plus poll and
+   *          callback timings
+   *
+   * @example
+   * ```typescript
+   * const stats = client.getStats();
+   * console.log(`audio: ${stats.audio.frames} frames, p99 ${stats.callbacks.audio.p99Us}us`);
+   * ```
+   */
+  getStats(): ClientStats;
+
+  /**
+   * Bounds the queues between the SDK thread and the media callbacks
+   *
+   * Media frames wait in a queue per callback until the JavaScript event loop
+   * runs it. When a callback falls behind and its queue is full, the policy
+   * decides whether polling waits or frames are dropped; dropped frames are
+   * counted in getStats(). Applies to callbacks already registered and to
+   * those registered later.
+   *
+   * @param options Policy and per-media queue depths
+   * @returns true if the limits were applied
+   * @throws RangeError for an unknown policy or a negative depth
+   *
+   * @example
+   * ```typescript
+   * // Keep speech intact and shed video when the handler can't keep up
+   * client.setDeliveryQueue({ policy: 'audio-priority', video: 30 });
+   * ```
+   */
+  setDeliveryQueue(options: DeliveryQueueOptions): boolean;
   
   /**
    * Sets audio parameters for the client (OPTIONAL)
@@ -1142,6 +1398,138 @@ export class Client {
    * ```
    */
   onTranscriptData(callback: TranscriptDataCallback): boolean;
+
+  /**
+   * Sets a callback for receiving audio in batches
+   *
+   * Instead of one call per frame, all audio frames received during one poll
+   * arrive together in a single call, which cuts the per-frame cost of crossing
+   * into JavaScript when many participants are sending audio. Independent of
+   * onAudioData; register one or the other.
+   *
+   * @param callback The callback function to invoke once per poll with audio
+   * @returns true if the callback was set successfully
+   *
+   * @example
+   * ```typescript
+   * client.onAudioBatch(({ count, data, offsets, metadata }) => {
+   *   for (let i = 0; i < count; i++) {
+   *     const frame = data.subarray(offsets[i], offsets[i + 1]);
+   *     mixer.push(metadata[i].userId, frame);
+   *   }
+   * });
+   * ```
+   */
+  onAudioBatch(callback: MediaBatchCallback): boolean;
+
+  /**
+   * Sets a callback for receiving video in batches (see onAudioBatch)
+   */
+  onVideoBatch(callback: MediaBatchCallback): boolean;
+
+  /**
+   * Sets a callback for receiving deskshare in batches (see onAudioBatch)
+   */
+  onDeskshareBatch(callback: MediaBatchCallback): boolean;
+
+  /**
+   * Sets a callback for receiving transcript in batches (see onAudioBatch)
+   */
+  onTranscriptBatch(callback: MediaBatchCallback): boolean;
+
+  /**
+   * Returns a Readable stream of audio frames
+   *
+   * Streams can be piped or consumed with `for await`, alongside onAudioData.
+   * When a stream's buffer reaches its highWaterMark, audio delivery for the
+   * whole client pauses until the stream is read: frames then wait in the
+   * native queue, which drops its oldest frames once full rather than
+   * blocking the poll thread, whatever setDeliveryQueue() chose.
+   * Streams end when the client leaves.
+   *
+   * @param options Participant filter, buffering and chunk format
+   * @returns A Readable of MediaFrame objects, or of Buffers in byte mode
+   *
+   * @example
+   * ```typescript
+   * for await (const frame of client.audioStream({ userId })) {
+   *   encoder.write(frame.buffer);
+   * }
+   * client.videoStream({ objectMode: false }).pipe(fs.createWriteStream('video.h264'));
+   * ```
+   */
+  audioStream(options?: MediaStreamOptions): Readable;
+
+  /**
+   * Returns a Readable stream of video frames (see audioStream)
+   */
+  videoStream(options?: MediaStreamOptions): Readable;
+
+  /**
+   * Returns a Readable stream of deskshare frames (see audioStream)
+   */
+  deskshareStream(options?: MediaStreamOptions): Readable;
+
+  /**
+   * Returns a Readable stream of transcript frames (see audioStream)
+   */
+  transcriptStream(options?: MediaStreamOptions): Readable;
+
+  /**
+   * Returns a SharedArrayBuffer ring that this client's frames of one media
+   * type are copied into on the polling thread
+   *
+   * Hand the buffer to worker_threads and read it with SharedRingReader; each
+   * reader sees every frame without a hop through the main thread or a
+   * structured clone. The ring never makes polling wait: a reader that falls
+   * a whole ring behind skips ahead. Calling again for the same media type
+   * returns the same ring. Rings are closed when the client leaves.
+   *
+   * @param media 'audio', 'video', 'deskshare' or 'transcript'
+   * @param options Ring size
+   * @throws RangeError if the size is not a power of two from 4 KiB to 1 GiB
+   *
+   * @example
+   * ```typescript
+   * const ring = client.sharedRing('video', { bytes: 32 << 20 });
+   * for (let shard = 0; shard < 4; shard++) {
+   *   new Worker('./detect.js', { workerData: { ring, shard } });
+   * }
+   * ```
+   */
+  sharedRing(media: 'audio' | 'video' | 'deskshare' | 'transcript', options?: SharedRingOptions): SharedArrayBuffer;
+
+  /**
+   * Creates a ring in a named POSIX shared-memory segment that this client's
+   * frames of one media type are copied into on the polling thread
+   *
+   * Worker processes attach with ShmRingReader and read frames without a
+   * pipe or re-serialization; C++ processes use rtms::ShmRing::Reader and
+   * Python processes rtms.ShmRingReader. A media type has either this ring
+   * or a sharedRing(), not both. The segment is removed when the ring is
+   * closed with closeSharedRing() or the client leaves; attached readers can
+   * still drain it. Not available on Windows.
+   *
+   * @param media 'audio', 'video', 'deskshare' or 'transcript'
+   * @param options Ring size and segment name
+   * @returns The segment name
+   * @throws RangeError for a bad size or name; Error if the segment exists, or
+   * no name was given before the client joined
+   *
+   * @example
+   * ```typescript
+   * const name = client.shmRing('video', { bytes: 32 << 20 });
+   * for (let i = 0; i < 4; i++) fork('./detect.js', [name, String(i)]);
+   * ```
+   */
+  shmRing(media: 'audio' | 'video' | 'deskshare' | 'transcript', options?: ShmRingOptions): string;
+
+  /**
+   * Stops writing to a media type's shared ring; its readers see it closed
+   *
+   * @returns true if a ring was attached
+   */
+  closeSharedRing(media: 'audio' | 'video' | 'deskshare' | 'transcript'): boolean;
   
   /**
    * Sets a callback for leave events
@@ -1195,6 +1583,210 @@ export class Client {
    * ```
    */
   unsubscribeEvent(events: number[]): boolean;
+
+  /**
+   * Milliseconds until this client is next polled
+   *
+   * On an EventLoop this is the interval the loop's schedule chose for this
+   * client; otherwise it is the fixed timer interval.
+   *
+   * @returns null if the client is not being polled
+   */
+  pollInterval(): number | null;
+}
+
+//-----------------------------------------------------------------------------------
+// Event loops
+//-----------------------------------------------------------------------------------
+
+/**
+ * Options for an EventLoop
+ */
+export interface EventLoopOptions {
+  /** Milliseconds between poll cycles (default: 10); ignored when `mode` is set */
+  pollInterval?: number;
+  /** Native thread name, useful in debuggers and profilers */
+  name?: string;
+  /**
+   * Adaptive poll schedule. Each client is polled soon after it delivers data
+   * and progressively less often while idle:
+   * - `latency`: re-poll immediately (spin, then yield) while busy; at most 1ms idle
+   * - `balanced`: 1ms while busy; backs off to 50ms idle
+   * - `power`: 5ms while busy; backs off to 100ms idle
+   */
+  mode?: 'latency' | 'balanced' | 'power';
+}
+
+/**
+ * Native reactor that drives many clients from one OS thread
+ *
+ * Clients added to an EventLoop are joined, polled and released on the loop's
+ * native thread instead of each running its own poll timer on the JS thread.
+ * Add the client before calling `join()`; `leave()` removes it again.
+ *
+ * @example
+ * ```typescript
+ * const loop = new rtms.EventLoop({ pollInterval: 5 });
+ * const client = new rtms.Client();
+ * client.onAudioData((data) => { ... });
+ * loop.add(client);
+ * client.join(payload);
+ * ```
+ *
+ * @category Client Instance
+ */
+export class EventLoop {
+  constructor(options?: EventLoopOptions);
+
+  /** Number of clients owned by this loop, including those still joining */
+  readonly clientCount: number;
+
+  /** Assign a client to this loop. Call before `client.join()`. */
+  add(client: Client): void;
+
+  /**
+   * Release a client on the loop thread and detach it
+   *
+   * @returns false if the client does not belong to this loop
+   */
+  remove(client: Client): boolean;
+
+  /**
+   * Milliseconds until the loop next polls a client
+   *
+   * @returns 0 while the client is re-polled immediately, null if this loop is not polling it
+   */
+  pollIntervalOf(client: Client): number | null;
+
+  /** Stop the loop; remaining clients are released on the loop thread */
+  stop(): void;
+}
+
+/**
+ * Options for an EventLoopPool
+ */
+export interface EventLoopPoolOptions {
+  /** Number of loop threads (default: 4) */
+  threads?: number;
+  /** Milliseconds between poll cycles (default: 10); ignored when `mode` is set */
+  pollInterval?: number;
+  /** Adaptive poll schedule for every loop (see EventLoopOptions.mode) */
+  mode?: 'latency' | 'balanced' | 'power';
+  /** How clients are assigned to loops (default: 'least_loaded') */
+  strategy?: 'least_loaded' | 'round_robin';
+}
+
+/**
+ * Fixed set of EventLoops with clients routed to one loop for their lifetime
+ *
+ * @category Client Instance
+ */
+export class EventLoopPool {
+  constructor(options?: EventLoopPoolOptions);
+
+  readonly loops: EventLoop[];
+
+  /** Total clients across all loops */
+  readonly clientCount: number;
+
+  /**
+   * Assign a client to a loop according to the strategy. Call before `client.join()`.
+   *
+   * @returns the loop the client was assigned to
+   */
+  add(client: Client): EventLoop;
+
+  /** Release a client on its loop's thread; false if no loop owns it */
+  remove(client: Client): boolean;
+
+  /** Stop every loop */
+  stop(): void;
+}
+
+/**
+ * Reads frames from a Client's shared ring, typically in a worker thread
+ *
+ * Each reader starts at the newest frame and sees every frame after it.
+ *
+ * @category Client Instance
+ *
+ * @example
+ * ```typescript
+ * // worker.js
+ * const reader = new rtms.SharedRingReader(workerData.ring);
+ * for (let frame; (frame = reader.read()) !== null;) {
+ *   if (frame.userId % 4 === workerData.shard) process(frame.data);
+ * }
+ * ```
+ */
+export class SharedRingReader {
+  /** @throws RangeError if the buffer does not hold a ring */
+  constructor(buffer: SharedArrayBuffer);
+
+  /** Times this reader fell a whole ring behind and skipped ahead to the writer */
+  lapped: number;
+
+  /** Frames skipped between ones this reader returned */
+  lost: number;
+
+  /** The client has closed the ring; frames already written can still be read */
+  readonly closed: boolean;
+
+  /** Frames the writer dropped for being larger than the ring */
+  readonly dropped: number;
+
+  /**
+   * Waits up to timeout ms (default forever) for the next frame, with
+   * Atomics.wait
+   *
+   * @returns The frame, or null on timeout or once the ring is closed and drained
+   */
+  read(timeout?: number): SharedRingFrame | null;
+
+  /** The next frame if one is ready, without waiting */
+  tryRead(): SharedRingFrame | null;
+}
+
+/**
+ * Reads frames from a shared-memory ring written by another process's
+ * Client (see Client.shmRing())
+ *
+ * Each reader starts at the newest frame and sees every frame after it; one
+ * that falls a whole ring behind skips ahead. Frames are copied out and
+ * checked against the writer, so a frame overwritten mid-read is never
+ * returned.
+ *
+ * @category Client Instance
+ *
+ * @example
+ * ```typescript
+ * const reader = new rtms.ShmRingReader(process.argv[2]);
+ * for (let frame; (frame = reader.read()) !== null;) detect(frame.data);
+ * ```
+ */
+export class ShmRingReader {
+  /** @throws Error if no ring has that name; RangeError if the segment is not a ring */
+  constructor(name: string);
+
+  /** Times this reader fell a whole ring behind and skipped ahead to the writer */
+  readonly lapped: number;
+
+  /** Frames skipped between ones this reader returned */
+  readonly lost: number;
+
+  /** The writer has closed the ring; frames already written can still be read */
+  readonly closed: boolean;
+
+  /**
+   * Waits up to timeout ms (default forever) for the next frame, blocking
+   * this thread
+   *
+   * @returns The frame, or null on timeout or once the ring is closed and drained
+   */
+  read(timeout?: number): SharedRingFrame | null;
+
+  /** The next frame if one is ready, without waiting */
+  tryRead(): SharedRingFrame | null;
 }
 
 //-----------------------------------------------------------------------------------
@@ -1213,6 +1805,10 @@ export class Client {
  *
  * @param callback Function to call when webhook events are received (WebhookCallback or RawWebhookCallback)
  * @param path The URL path to listen on (e.g., '/zoom/webhook')
+ * @param metricsPath Optional path (e.g., '/metrics') on which GET requests are
+ *                    answered with {@link renderMetrics} output. Anyone who
+ *                    can reach the server can then read per-meeting metrics;
+ *                    see {@link startMetricsServer} for a loopback-only endpoint
  * @returns A request handler function compatible with http.Server
  *
  * @example
@@ -1260,7 +1856,8 @@ export class Client {
  */
 export function createWebhookHandler(
   callback: WebhookCallback | RawWebhookCallback,
-  path: string
+  path: string,
+  metricsPath?: string
 ): (req: import('http').IncomingMessage, res: import('http').ServerResponse) => void;
 
 /**
@@ -1275,6 +1872,11 @@ export function createWebhookHandler(
  * - ZM_RTMS_KEY: Path to SSL certificate key file
  * - ZM_RTMS_CA_WEBHOOK: (Optional) Path to CA certificate for client verification
  *
+ * Set ZM_RTMS_METRICS_PATH (e.g. '/metrics') to also serve Prometheus metrics
+ * from the same server. The server listens on all interfaces and the metrics
+ * are labelled with meeting UUIDs, so only set it when the port is not
+ * publicly reachable; {@link startMetricsServer} binds 127.0.0.1 instead.
+ *
  * The callback can be either a basic WebhookCallback (receives only the payload)
  * or a RawWebhookCallback (receives payload, request, and response objects for
  * custom handling of webhook validation challenges).
@@ -1300,6 +1902,81 @@ export function createWebhookHandler(
  */
 export function onWebhookEvent(callback: WebhookCallback | RawWebhookCallback): void;
 
+/**
+ * Renders every live client and event loop in the Prometheus text format
+ *
+ * Includes per-media frame and byte counters, time since each stream's last
+ * frame, and poll/callback latency histograms, labelled by `meeting_uuid` and
+ * `stream_id`.
+ *
+ * @returns Metrics in Prometheus text exposition format 0.0.4
+ *
+ * @example
+ * ```typescript
+ * app.get('/metrics', (req, res) => {
+ *   res.type('text/plain; version=0.0.4').send(rtms.renderMetrics());
+ * });
+ * ```
+ *
+ * @category Common Functions
+ */
+export function renderMetrics(): string;
+
+/**
+ * Starts a native HTTP listener serving {@link renderMetrics} at /metrics
+ *
+ * Scrapes are answered from a native thread and never wait on the JavaScript
+ * event loop. Starting again replaces the previous listener.
+ *
+ * @param port Port to listen on (default 9464; 0 picks a free port)
+ * @param host Address to bind (default '127.0.0.1')
+ * @returns The port the listener is bound to
+ *
+ * @category Common Functions
+ */
+export function startMetricsServer(port?: number, host?: string): number;
+
+/**
+ * Stops the listener started by {@link startMetricsServer}
+ *
+ * @returns true if a listener was running
+ *
+ * @category Common Functions
+ */
+export function stopMetricsServer(): boolean;
+
+/**
+ * Whether the native addon was built with RTMS_TRACE=ON
+ *
+ * @category Common Functions
+ */
+export function traceEnabled(): boolean;
+
+/**
+ * Exports the hot-path trace recorded by an RTMS_TRACE build
+ *
+ * The trace holds begin/end spans for each SDK sink, poll, config and join
+ * call, the thread-safe function hand-off and the JavaScript callback itself,
+ * in the Chrome trace event format (open in chrome://tracing or
+ * ui.perfetto.dev). Without RTMS_TRACE the trace is always empty.
+ *
+ * @example
+ * ```typescript
+ * process.on('SIGUSR2', () => rtms.dumpTrace(`/tmp/rtms-${process.pid}.json`));
+ * ```
+ *
+ * @category Common Functions
+ */
+export function dumpTrace(): string;
+export function dumpTrace(path: string): boolean;
+
+/**
+ * Discards every event recorded so far by an RTMS_TRACE build
+ *
+ * @category Common Functions
+ */
+export function clearTrace(): void;
+
 /**
  * Configure the RTMS logger
  * 
@@ -1526,8 +2203,18 @@ export interface StopReason {
 declare const rtms: {
   // Class-based API
   Client: typeof Client;
+  EventLoop: typeof EventLoop;
+  EventLoopPool: typeof EventLoopPool;
+  SharedRingReader: typeof SharedRingReader;
+  ShmRingReader: typeof ShmRingReader;
   onWebhookEvent: typeof onWebhookEvent;
   createWebhookHandler: typeof createWebhookHandler;
+  renderMetrics: typeof renderMetrics;
+  startMetricsServer: typeof startMetricsServer;
+  stopMetricsServer: typeof stopMetricsServer;
+  traceEnabled: typeof traceEnabled;
+  dumpTrace: typeof dumpTrace;
+  clearTrace: typeof clearTrace;
 
   // Utility functions
   generateSignature: typeof generateSignature;
@@ -0,0 +1,60 @@
+#ifndef RTMS_CALLBACK_SLOT_H
+#define RTMS_CALLBACK_SLOT_H
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+namespace rtms {
+
+/**
+ * A binding-side callback handle (such as a pybind11 py::object) that SDK
+ * threads invoke while other threads may replace it.
+ *
+ * get() copies the handle under a mutex, so the caller owns a reference for
+ * the whole call and a concurrent set() cannot free the callback mid-call.
+ * The handle set() replaces is destroyed after the mutex is released, since
+ * its destructor may run user code. empty() reads only an atomic flag, so a
+ * caller can skip work such as taking an interpreter lock without touching
+ * the handle.
+ *
+ * T must be copyable and convert to false when it holds no callback. Copying
+ * and destroying T must be valid on every thread that calls get() or set();
+ * for py::object that means with the interpreter attached.
+ */
+template <typename T>
+class CallbackSlot {
+public:
+    CallbackSlot() = default;
+
+    CallbackSlot(const CallbackSlot&) = delete;
+    CallbackSlot& operator=(const CallbackSlot&) = delete;
+
+    void set(T callback) {
+        const bool present = static_cast<bool>(callback);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::swap(callback_, callback);
+            present_.store(present, std::memory_order_release);
+        }
+        // callback now holds the previous handle, released without the lock
+    }
+
+    void reset() { set(T()); }
+
+    T get() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return callback_;
+    }
+
+    bool empty() const { return !present_.load(std::memory_order_acquire); }
+
+private:
+    mutable std::mutex mutex_;
+    T callback_{};
+    std::atomic<bool> present_{false};
+};
+
+} // namespace rtms
+
+#endif // RTMS_CALLBACK_SLOT_H
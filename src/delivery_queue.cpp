@@ -0,0 +1,29 @@
+#include "delivery_queue.h"
+
+namespace rtms {
+
+const char* name(DeliveryPolicy policy) {
+    switch (policy) {
+        case DeliveryPolicy::Block:         return "block";
+        case DeliveryPolicy::DropOldest:    return "drop-oldest";
+        case DeliveryPolicy::DropNewest:    return "drop-newest";
+        case DeliveryPolicy::AudioPriority: return "audio-priority";
+    }
+    return "unknown";
+}
+
+DeliveryPolicy parseDeliveryPolicy(const std::string& name) {
+    for (DeliveryPolicy policy : {DeliveryPolicy::Block, DeliveryPolicy::DropOldest,
+                                  DeliveryPolicy::DropNewest, DeliveryPolicy::AudioPriority}) {
+        if (name == rtms::name(policy)) return policy;
+    }
+    throw std::invalid_argument("Unknown delivery policy '" + name +
+                                "'; expected block, drop-oldest, drop-newest or audio-priority");
+}
+
+DeliveryPolicy effectivePolicy(DeliveryPolicy policy, ClientMetrics::Media media) {
+    if (policy != DeliveryPolicy::AudioPriority) return policy;
+    return media == ClientMetrics::Media::Audio ? DeliveryPolicy::Block : DeliveryPolicy::DropOldest;
+}
+
+} // namespace rtms
@@ -0,0 +1,244 @@
+#ifndef RTMS_DELIVERY_QUEUE_H
+#define RTMS_DELIVERY_QUEUE_H
+
+#include "metrics.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rtms {
+
+/**
+ * What a DeliveryQueue does with a frame that arrives while it is full.
+ *
+ * AudioPriority is a per-client choice: audio queues block and every other
+ * media type drops its oldest frame, so a slow consumer sheds video before
+ * speech. Use effectivePolicy() to resolve it for one media type.
+ */
+enum class DeliveryPolicy {
+    Block,           // the producer waits for the consumer to catch up
+    DropOldest,      // discard the oldest queued frame to make room
+    DropNewest,      // discard the arriving frame
+    AudioPriority,
+};
+
+/** "block", "drop-oldest", "drop-newest" or "audio-priority". */
+const char* name(DeliveryPolicy policy);
+
+/** Inverse of name(). Throws std::invalid_argument for anything else. */
+DeliveryPolicy parseDeliveryPolicy(const std::string& name);
+
+/** The policy a queue for this media type should apply; never AudioPriority. */
+DeliveryPolicy effectivePolicy(DeliveryPolicy policy, ClientMetrics::Media media);
+
+/**
+ * Bounded hand-off between the thread that polls the SDK and a consumer that
+ * runs elsewhere, typically a JS event loop.
+ *
+ * The producer push()es; when a push finds the queue idle it tells the caller
+ * to schedule one drain(), which takes everything queued at once. Until that
+ * drain runs, further pushes only queue, so the consumer has at most one
+ * wake-up outstanding however many frames arrive.
+ *
+ * A depth of 0 means unbounded. Drops are counted in frames; see frameCount().
+ */
+template <typename T>
+class DeliveryQueue {
+public:
+    static constexpr size_t kDefaultDepth = 1024;
+    static constexpr std::chrono::milliseconds kDefaultBlockTimeout{1000};
+
+    struct PushResult {
+        bool schedule = false;   // the caller must arrange one drain()
+        size_t dropped = 0;      // frames discarded by this push
+    };
+
+    explicit DeliveryQueue(size_t depth = kDefaultDepth, DeliveryPolicy policy = DeliveryPolicy::Block,
+                           std::chrono::milliseconds block_timeout = kDefaultBlockTimeout)
+        : block_timeout_(block_timeout) {
+        configure(depth, policy);
+    }
+
+    DeliveryQueue(const DeliveryQueue&) = delete;
+    DeliveryQueue& operator=(const DeliveryQueue&) = delete;
+
+    /**
+     * Change the depth and policy. Frames already queued are kept even if
+     * the new depth is smaller; the next pushes make room. Throws
+     * std::invalid_argument for AudioPriority, which has to be resolved per
+     * media type first.
+     */
+    void configure(size_t depth, DeliveryPolicy policy) {
+        if (policy == DeliveryPolicy::AudioPriority) {
+            throw std::invalid_argument("DeliveryQueue needs a resolved policy, see effectivePolicy()");
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            depth_ = depth;
+            policy_ = policy;
+        }
+        space_.notify_all();
+    }
+
+    /**
+     * Queue an item. With the Block policy a full queue makes the caller wait
+     * up to the block timeout for a drain(). If none comes the item is
+     * dropped, and so is everything pushed into the full queue until the
+     * consumer drains again, so a stuck consumer (or one that is itself
+     * waiting on the producer) costs one timeout rather than a deadlock.
+     * Without can_wait the item is queued past the depth instead: that is
+     * for pushes from the consumer's own thread, which a drain cannot
+     * interrupt. While the queue is paused, Block drops the oldest items
+     * instead of waiting: the consumer will not drain until it resumes, and
+     * the producer may be a poll thread other clients share. After close()
+     * every push is dropped.
+     */
+    PushResult push(T item, bool can_wait = true) {
+        PushResult result;
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto reject = [&] {
+            result.dropped = frameCount(item);
+            dropped_ += result.dropped;
+            return result;
+        };
+        if (closed_) return reject();
+
+        auto dropOldest = [&] {
+            while (full()) {
+                result.dropped += frameCount(items_.front());
+                items_.pop_front();
+            }
+            dropped_ += result.dropped;
+        };
+
+        if (full()) {
+            switch (policy_) {
+                case DeliveryPolicy::Block:
+                    if (!can_wait) break;
+                    if (paused_) {
+                        dropOldest();
+                        break;
+                    }
+                    if (stalled_ || !space_.wait_for(lock, block_timeout_, [this] { return closed_ || !full(); })) {
+                        stalled_ = true;
+                        return reject();
+                    }
+                    if (closed_) return reject();
+                    break;
+                case DeliveryPolicy::DropNewest:
+                    return reject();
+                case DeliveryPolicy::DropOldest:
+                case DeliveryPolicy::AudioPriority:   // rejected by configure()
+                    dropOldest();
+                    break;
+            }
+        }
+
+        items_.push_back(std::move(item));
+        if (!scheduled_ && !paused_) {
+            scheduled_ = true;
+            result.schedule = true;
+        }
+        return result;
+    }
+
+    /**
+     * Move everything queued into out, in arrival order, and wake blocked
+     * producers. Returns the number of items taken. The next push after a
+     * drain asks for a new one.
+     */
+    size_t drain(std::vector<T>& out) {
+        size_t taken;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            taken = items_.size();
+            out.reserve(out.size() + taken);
+            for (T& item : items_) out.push_back(std::move(item));
+            items_.clear();
+            scheduled_ = false;
+            stalled_ = false;
+        }
+        space_.notify_all();
+        return taken;
+    }
+
+    /**
+     * Stop asking for drains, for a consumer that cannot take more yet.
+     * Items keep queueing up to the depth and then meet the policy, except
+     * that Block drops the oldest rather than making the producer wait (see
+     * push()), so a paused consumer keeps the newest frames without holding
+     * up the poll thread. A drain already requested still runs.
+     */
+    void pause() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        paused_ = true;
+    }
+
+    /**
+     * Undo pause(). Returns true if items queued in the meantime need a
+     * drain, which the caller must then arrange as for push().
+     */
+    bool resume() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        paused_ = false;
+        if (scheduled_ || items_.empty()) return false;
+        scheduled_ = true;
+        return true;
+    }
+
+    /**
+     * Stop accepting items: waiting producers return, later pushes are
+     * dropped. Queued items stay until drained or the queue is destroyed.
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        space_.notify_all();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+
+    /** Frames dropped since construction. */
+    uint64_t dropped() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dropped_;
+    }
+
+    /** Frames an item stands for: a std::vector's size, otherwise one. */
+    template <typename U>
+    static size_t frameCount(const U&) { return 1; }
+    template <typename U>
+    static size_t frameCount(const std::vector<U>& batch) { return batch.size(); }
+
+private:
+
+    bool full() const { return depth_ != 0 && items_.size() >= depth_; }
+
+    mutable std::mutex mutex_;
+    std::condition_variable space_;
+    std::deque<T> items_;
+    size_t depth_ = kDefaultDepth;
+    DeliveryPolicy policy_ = DeliveryPolicy::Block;
+    std::chrono::milliseconds block_timeout_;
+    bool scheduled_ = false;
+    bool stalled_ = false;   // a Block wait timed out; reject until the next drain
+    bool paused_ = false;
+    bool closed_ = false;
+    uint64_t dropped_ = 0;
+};
+
+} // namespace rtms
+
+#endif // RTMS_DELIVERY_QUEUE_H
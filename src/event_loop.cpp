@@ -0,0 +1,522 @@
+#include "event_loop.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+namespace rtms {
+
+// ============================================================================
+// PollPolicy
+// ============================================================================
+
+PollMode parsePollMode(const std::string& name) {
+    if (name == "latency") return PollMode::Latency;
+    if (name == "balanced") return PollMode::Balanced;
+    if (name == "power") return PollMode::Power;
+    throw std::invalid_argument("Unknown poll mode '" + name + "' (expected latency, balanced or power)");
+}
+
+const char* pollModeName(PollMode mode) {
+    switch (mode) {
+        case PollMode::Latency:  return "latency";
+        case PollMode::Balanced: return "balanced";
+        case PollMode::Power:    return "power";
+    }
+    return "unknown";
+}
+
+PollPolicy PollPolicy::fixed(std::chrono::microseconds interval) {
+    PollPolicy policy;
+    policy.min_interval = interval;
+    policy.max_interval = interval;
+    return policy;
+}
+
+PollPolicy PollPolicy::forMode(PollMode mode) {
+    using std::chrono::microseconds;
+    PollPolicy policy;
+    switch (mode) {
+        case PollMode::Latency:
+            policy.spin_polls = 32;
+            policy.yield_polls = 256;
+            policy.min_interval = microseconds(100);
+            policy.max_interval = microseconds(1000);
+            policy.polls_per_doubling = 16;
+            break;
+        case PollMode::Balanced:
+            policy.min_interval = microseconds(1000);
+            policy.max_interval = microseconds(50000);
+            policy.polls_per_doubling = 8;
+            break;
+        case PollMode::Power:
+            policy.min_interval = microseconds(5000);
+            policy.max_interval = microseconds(100000);
+            policy.polls_per_doubling = 4;
+            break;
+    }
+    return policy;
+}
+
+PollPolicy::Step PollPolicy::step(uint32_t idle_polls) const {
+    if (idle_polls < spin_polls) {
+        return {Phase::Spin, std::chrono::microseconds(0)};
+    }
+    idle_polls -= spin_polls;
+    if (idle_polls < yield_polls) {
+        return {Phase::Yield, std::chrono::microseconds(0)};
+    }
+    idle_polls -= yield_polls;
+
+    std::chrono::microseconds interval = min_interval;
+    for (uint32_t doublings = idle_polls / polls_per_doubling;
+         doublings > 0 && interval.count() > 0 && interval < max_interval; --doublings) {
+        interval *= 2;
+    }
+    return {Phase::Sleep, std::min(interval, max_interval)};
+}
+
+void PollPolicy::validate() const {
+    if (min_interval.count() < 0) {
+        throw std::invalid_argument("EventLoop: poll interval must not be negative");
+    }
+    if (max_interval < min_interval) {
+        throw std::invalid_argument("EventLoop: max_interval must not be less than min_interval");
+    }
+    if (polls_per_doubling == 0) {
+        throw std::invalid_argument("EventLoop: polls_per_doubling must be at least 1");
+    }
+}
+
+// ============================================================================
+// ClientSession
+// ============================================================================
+
+ClientSession::ClientSession(std::shared_ptr<Client> client, std::string meeting_uuid,
+                             std::string rtms_stream_id, std::string signature,
+                             std::string server_url, int timeout)
+    : client_(std::move(client)),
+      meeting_uuid_(std::move(meeting_uuid)),
+      rtms_stream_id_(std::move(rtms_stream_id)),
+      signature_(std::move(signature)),
+      server_url_(std::move(server_url)),
+      timeout_(timeout) {
+    if (!client_) {
+        throw std::invalid_argument("ClientSession: client must not be null");
+    }
+}
+
+void ClientSession::start() {
+    try {
+        client_->join(meeting_uuid_, rtms_stream_id_, signature_, server_url_, timeout_);
+    } catch (const Exception& e) {
+        if (on_join_failed_) on_join_failed_(e.code());
+        throw;
+    }
+}
+
+PollResult ClientSession::poll() {
+    return client_->poll() ? PollResult::Delivered : PollResult::Idle;
+}
+
+void ClientSession::stop() noexcept {
+    try {
+        client_->markClosed();
+        client_->release();
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: Failed to release client " << meeting_uuid_ << ": " << e.what() << std::endl;
+    }
+}
+
+// ============================================================================
+// EventLoop
+// ============================================================================
+
+EventLoop::EventLoop(std::chrono::milliseconds poll_interval, std::string name)
+    : EventLoop(PollPolicy::fixed(poll_interval), std::move(name)) {}
+
+EventLoop::EventLoop(PollMode mode, std::string name)
+    : EventLoop(PollPolicy::forMode(mode), std::move(name)) {}
+
+EventLoop::EventLoop(const PollPolicy& policy, std::string name)
+    : policy_(policy), name_(std::move(name)) {
+    policy_.validate();
+    MetricsRegistry::global().add(this);
+}
+
+EventLoop::~EventLoop() {
+    MetricsRegistry::global().remove(this);
+    stop();
+    join();
+}
+
+void EventLoop::add(std::shared_ptr<LoopClient> client) {
+    if (!client) {
+        throw std::invalid_argument("EventLoop::add: client must not be null");
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_requested_) {
+            throw Exception(RTMS_SDK_INVALID_STATUS, "EventLoop has been stopped");
+        }
+        if (!members_.insert(client.get()).second) return;
+        pending_adds_.push_back(std::move(client));
+        client_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    wake_.notify_all();
+}
+
+bool EventLoop::remove(const std::shared_ptr<LoopClient>& client) {
+    if (!client) return false;
+
+    std::future<bool> removed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (members_.count(client.get()) == 0) return false;
+
+        // Not started yet: nothing has touched the SDK, so just drop it
+        auto pending = std::find(pending_adds_.begin(), pending_adds_.end(), client);
+        if (pending != pending_adds_.end()) {
+            pending_adds_.erase(pending);
+            members_.erase(client.get());
+            client_count_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // From inside a callback the client may be mid-poll; detach it at the
+        // start of the next cycle instead of waiting on ourselves.
+        if (loop_thread_ == std::this_thread::get_id()) {
+            pending_removals_.push_back({client, nullptr});
+            return true;
+        }
+
+        auto done = std::make_shared<std::promise<bool>>();
+        removed = done->get_future();
+        pending_removals_.push_back({client, std::move(done)});
+    }
+    wake_.notify_all();
+    return removed.get();
+}
+
+void EventLoop::begin() {
+    if (running_.load(std::memory_order_relaxed) || thread_.joinable()) {
+        throw Exception(RTMS_SDK_INVALID_STATUS, "EventLoop is already running");
+    }
+    if (stop_requested_) {
+        throw Exception(RTMS_SDK_INVALID_STATUS, "EventLoop has been stopped");
+    }
+    running_.store(true, std::memory_order_release);
+}
+
+void EventLoop::start(bool stop_when_empty) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    begin();
+    thread_ = std::thread([this, stop_when_empty] {
+#ifdef __linux__
+        // Thread names are limited to 15 characters plus the terminator
+        std::string thread_name = name_.empty() ? "rtms-eventloop" : name_.substr(0, 15);
+        pthread_setname_np(pthread_self(), thread_name.c_str());
+#endif
+        loop(stop_when_empty);
+    });
+}
+
+void EventLoop::run(bool stop_when_empty) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        begin();
+    }
+    loop(stop_when_empty);
+}
+
+void EventLoop::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+    }
+    wake_.notify_all();
+}
+
+void EventLoop::join() {
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+        thread_.join();
+    }
+}
+
+bool EventLoop::wait(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return wake_.wait_for(lock, timeout, [this] { return !running_.load(std::memory_order_acquire); });
+}
+
+void EventLoop::loop(bool stop_when_empty) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loop_thread_ = std::this_thread::get_id();
+    }
+
+    while (true) {
+        drainCommands();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_requested_) break;
+        }
+
+        bool spin = false;
+        bool delivered = false;
+        Clock::time_point next_due = pollClients(spin, delivered);
+        if (delivered) {
+            if (on_cycle_end_) {
+                try {
+                    on_cycle_end_();
+                } catch (const std::exception& e) {
+                    warn("cycle-end callback failed", e.what());
+                }
+            }
+            notifyReady();
+        }
+        if (stop_when_empty && client_count_.load(std::memory_order_relaxed) == 0) break;
+
+        if (next_due <= Clock::now()) {
+            // A client wants polling again straight away. Give up the CPU
+            // first unless one of them is still in its spin phase.
+            if (!spin) std::this_thread::yield();
+            continue;
+        }
+
+        // Sleep until the next client is due, but wake early for add/remove/stop
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait_until(lock, next_due, [this] {
+            return stop_requested_ || !pending_adds_.empty() || !pending_removals_.empty();
+        });
+    }
+
+    shutdown();
+}
+
+void EventLoop::drainCommands() {
+    std::vector<std::shared_ptr<LoopClient>> adds;
+    std::vector<Removal> removals;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        adds.swap(pending_adds_);
+        removals.swap(pending_removals_);
+    }
+
+    for (auto& client : adds) {
+        try {
+            client->start();
+            client->poll_interval_us_.store(0, std::memory_order_relaxed);
+            clients_.push_back({std::move(client), Clock::now(), 0});
+        } catch (const std::exception& e) {
+            warn("failed to start client", e.what());
+            std::lock_guard<std::mutex> lock(mutex_);
+            members_.erase(client.get());
+            client_count_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    for (auto& removal : removals) {
+        bool removed = detach(removal.client);
+        if (removal.done) removal.done->set_value(removed);
+    }
+}
+
+EventLoop::Clock::time_point EventLoop::pollClients(bool& spin, bool& delivered) {
+    const Clock::time_point now = Clock::now();
+    Clock::time_point next_due = now + policy_.max_interval;
+
+    // poll() cannot add to or remove from clients_: both are deferred to
+    // drainCommands() when called from the loop thread.
+    for (size_t i = 0; i < clients_.size();) {
+        Slot& slot = clients_[i];
+        if (slot.due > now) {
+            next_due = std::min(next_due, slot.due);
+            ++i;
+            continue;
+        }
+
+        PollResult result = PollResult::Detach;
+        polls_.fetch_add(1, std::memory_order_relaxed);
+        try {
+            result = slot.client->poll();
+        } catch (const std::exception& e) {
+            warn("poll failed, detaching client", e.what());
+        }
+
+        if (result == PollResult::Detach) {
+            detach(slot.client);
+            continue;
+        }
+
+        if (result == PollResult::Delivered) {
+            slot.idle_polls = 0;
+            delivered = true;
+        } else if (slot.idle_polls < std::numeric_limits<uint32_t>::max()) {
+            ++slot.idle_polls;
+        }
+
+        PollPolicy::Step step = policy_.step(slot.idle_polls);
+        slot.due = now + step.interval;
+        slot.client->poll_interval_us_.store(step.interval.count(), std::memory_order_relaxed);
+        if (step.phase == PollPolicy::Phase::Spin) spin = true;
+        next_due = std::min(next_due, slot.due);
+        ++i;
+    }
+    return next_due;
+}
+
+bool EventLoop::detach(std::shared_ptr<LoopClient> client) {
+    auto it = std::find_if(clients_.begin(), clients_.end(),
+                           [&](const Slot& slot) { return slot.client == client; });
+    if (it == clients_.end()) return false;
+
+    std::shared_ptr<LoopClient> detached = std::move(it->client);
+    clients_.erase(it);
+    detached->stop();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    members_.erase(detached.get());
+    client_count_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void EventLoop::shutdown() {
+    std::vector<std::shared_ptr<LoopClient>> adds;
+    std::vector<Removal> removals;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+        adds.swap(pending_adds_);
+        removals.swap(pending_removals_);
+    }
+
+    // Clients that never started have no SDK state to release
+    adds.clear();
+    for (auto& removal : removals) {
+        bool removed = detach(removal.client);
+        if (removal.done) removal.done->set_value(removed);
+    }
+    while (!clients_.empty()) detach(clients_.back().client);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Removals that raced with the loop above find their client already stopped
+        removals.swap(pending_removals_);
+        members_.clear();
+        client_count_.store(0, std::memory_order_relaxed);
+        loop_thread_ = std::thread::id();
+        running_.store(false, std::memory_order_release);
+        if (stopped_) stopped_->notify();
+    }
+    wake_.notify_all();
+    notifyReady();
+    for (auto& removal : removals) {
+        if (removal.done) removal.done->set_value(false);
+    }
+}
+
+int EventLoop::readyFd() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!notifier_) {
+        notifier_ = std::make_unique<Notifier>();
+        ready_.store(notifier_.get(), std::memory_order_release);
+        // shutdown() has been and gone; report it like it would have
+        if (stop_requested_ && !running_.load(std::memory_order_acquire)) notifier_->notify();
+    }
+    return notifier_->fd();
+}
+
+bool EventLoop::clearReady() {
+    Notifier* notifier = ready_.load(std::memory_order_acquire);
+    return notifier && notifier->clear();
+}
+
+int EventLoop::stoppedFd() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!stopped_) {
+        stopped_ = std::make_unique<Notifier>();
+        if (stop_requested_ && !running_.load(std::memory_order_acquire)) stopped_->notify();
+    }
+    return stopped_->fd();
+}
+
+void EventLoop::notifyReady() {
+    if (Notifier* notifier = ready_.load(std::memory_order_acquire)) notifier->notify();
+}
+
+void EventLoop::warn(const std::string& what, const char* reason) const {
+    std::cerr << "Warning: EventLoop";
+    if (!name_.empty()) std::cerr << " " << name_;
+    std::cerr << ": " << what << ": " << reason << std::endl;
+}
+
+// ============================================================================
+// EventLoopPool
+// ============================================================================
+
+EventLoopPool::EventLoopPool(size_t threads, std::chrono::milliseconds poll_interval, Strategy strategy)
+    : EventLoopPool(threads, PollPolicy::fixed(poll_interval), strategy) {}
+
+EventLoopPool::EventLoopPool(size_t threads, const PollPolicy& policy, Strategy strategy)
+    : strategy_(strategy) {
+    if (threads == 0) {
+        throw std::invalid_argument("EventLoopPool: threads must be at least 1");
+    }
+    loops_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        loops_.push_back(std::make_unique<EventLoop>(policy, "rtms-pool-" + std::to_string(i)));
+    }
+}
+
+EventLoopPool::~EventLoopPool() {
+    stop();
+    join();
+}
+
+EventLoop& EventLoopPool::pick() {
+    if (strategy_ == Strategy::RoundRobin) {
+        return *loops_[next_.fetch_add(1, std::memory_order_relaxed) % loops_.size()];
+    }
+    auto least = std::min_element(loops_.begin(), loops_.end(),
+        [](const std::unique_ptr<EventLoop>& a, const std::unique_ptr<EventLoop>& b) {
+            return a->clientCount() < b->clientCount();
+        });
+    return **least;
+}
+
+EventLoop& EventLoopPool::add(std::shared_ptr<LoopClient> client) {
+    EventLoop& loop = pick();
+    loop.add(std::move(client));
+    return loop;
+}
+
+bool EventLoopPool::remove(const std::shared_ptr<LoopClient>& client) {
+    for (auto& loop : loops_) {
+        if (loop->remove(client)) return true;
+    }
+    return false;
+}
+
+void EventLoopPool::start() {
+    for (auto& loop : loops_) loop->start();
+}
+
+void EventLoopPool::stop() {
+    for (auto& loop : loops_) loop->stop();
+}
+
+void EventLoopPool::join() {
+    for (auto& loop : loops_) loop->join();
+}
+
+size_t EventLoopPool::clientCount() const {
+    size_t total = 0;
+    for (const auto& loop : loops_) total += loop->clientCount();
+    return total;
+}
+
+} // namespace rtms
@@ -0,0 +1,367 @@
+#ifndef RTMS_EVENT_LOOP_H
+#define RTMS_EVENT_LOOP_H
+
+#include "notifier.h"
+#include "rtms.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace rtms {
+
+/**
+ * Preset poll schedules for EventLoop.
+ *
+ *   Latency   re-polls busy clients immediately, spinning then yielding the
+ *             CPU before falling back to short sleeps.
+ *   Balanced  polls busy clients every millisecond and backs idle ones off
+ *             to 50 ms.
+ *   Power     polls busy clients every 5 ms and backs idle ones off to 100 ms.
+ */
+enum class PollMode {
+    Latency,
+    Balanced,
+    Power,
+};
+
+/** "latency", "balanced" or "power"; throws std::invalid_argument otherwise. */
+PollMode parsePollMode(const std::string& name);
+const char* pollModeName(PollMode mode);
+
+/**
+ * How often an EventLoop polls each of its clients.
+ *
+ * The schedule is driven by how many consecutive polls of a client delivered
+ * nothing. A poll that runs any SDK callback resets the count to zero. With a
+ * count of n the next poll is made:
+ *
+ *   n < spin_polls                  immediately
+ *   n < spin_polls + yield_polls    immediately, after yielding the CPU
+ *   otherwise                       after min_interval, doubled every
+ *                                   polls_per_doubling further idle polls, up
+ *                                   to max_interval
+ */
+struct PollPolicy {
+    uint32_t spin_polls = 0;
+    uint32_t yield_polls = 0;
+    std::chrono::microseconds min_interval{10000};
+    std::chrono::microseconds max_interval{10000};
+    uint32_t polls_per_doubling = 1;
+
+    enum class Phase {
+        Spin,
+        Yield,
+        Sleep,
+    };
+
+    struct Step {
+        Phase phase;
+        std::chrono::microseconds interval;   // zero unless phase is Sleep
+    };
+
+    /** Every client polled every interval regardless of activity. */
+    static PollPolicy fixed(std::chrono::microseconds interval);
+    static PollPolicy forMode(PollMode mode);
+
+    /** The step taken after idle_polls consecutive polls delivered nothing. */
+    Step step(uint32_t idle_polls) const;
+
+    /** Throws std::invalid_argument for negative or inverted intervals. */
+    void validate() const;
+};
+
+/**
+ * What a LoopClient's poll() did, which the loop uses to schedule the next one.
+ */
+enum class PollResult {
+    Idle,        // nothing was delivered
+    Delivered,   // at least one SDK callback ran
+    Detach,      // remove the client from the loop; stop() is then called
+};
+
+/**
+ * A session driven by an EventLoop.
+ *
+ * The loop calls every method on its own thread, which is how the SDK's rule
+ * that alloc, join, poll and release share one OS thread is kept: start()
+ * allocates and joins, poll() drives the SDK, stop() releases.
+ */
+class LoopClient {
+public:
+    virtual ~LoopClient() = default;
+
+    /**
+     * Called once before the first poll(). An exception detaches the client
+     * without calling stop().
+     */
+    virtual void start() = 0;
+
+    /**
+     * Called each time the client is due under the loop's PollPolicy. An
+     * exception is treated like PollResult::Detach.
+     */
+    virtual PollResult poll() = 0;
+
+    /**
+     * Called once when a started client leaves the loop, whether through
+     * remove(), stop() or a failed poll().
+     */
+    virtual void stop() noexcept = 0;
+
+    /**
+     * Delay the loop chose before this client's next poll: zero while it is
+     * re-polled immediately, and whatever the policy dictates once idle.
+     * Safe to read from any thread.
+     */
+    std::chrono::microseconds pollInterval() const {
+        return std::chrono::microseconds(poll_interval_us_.load(std::memory_order_relaxed));
+    }
+
+private:
+    friend class EventLoop;
+    std::atomic<int64_t> poll_interval_us_{0};
+};
+
+/**
+ * LoopClient for a plain rtms::Client. The Client should be constructed
+ * with defer_alloc so that its SDK handle is created by start() on the loop
+ * thread rather than by the constructor.
+ */
+class ClientSession : public LoopClient {
+public:
+    ClientSession(std::shared_ptr<Client> client, std::string meeting_uuid,
+                  std::string rtms_stream_id, std::string signature,
+                  std::string server_url, int timeout = -1);
+
+    void start() override;
+    PollResult poll() override;
+    void stop() noexcept override;
+
+    const std::shared_ptr<Client>& client() const { return client_; }
+
+    /**
+     * Called on the loop thread with the SDK error code when start() fails
+     * to join. Nobody waits on join() for a client on a loop, so this is how
+     * a binding reports the failure. Set it before adding the session.
+     */
+    void setOnJoinFailed(std::function<void(int)> callback) { on_join_failed_ = std::move(callback); }
+
+private:
+    std::shared_ptr<Client> client_;
+    std::function<void(int)> on_join_failed_;
+    std::string meeting_uuid_;
+    std::string rtms_stream_id_;
+    std::string signature_;
+    std::string server_url_;
+    int timeout_;
+};
+
+/**
+ * Reactor that owns a set of clients and polls all of them from one thread.
+ *
+ * add() and remove() may be called from any thread. New clients are started
+ * on the loop thread at the beginning of the next cycle; remove() blocks until
+ * the loop thread has stopped the client, so the caller may tear down any
+ * state the client's callbacks use as soon as it returns. Called from the loop
+ * thread itself (e.g. inside a callback), remove() only schedules the removal.
+ *
+ * The loop runs either on a thread it owns (start()) or on the caller's thread
+ * (run()). On exit every remaining client is stopped on the loop thread.
+ *
+ * Each client is polled on its own schedule set by the loop's PollPolicy, and
+ * the loop sleeps until the earliest client is due.
+ */
+class EventLoop {
+public:
+    static constexpr std::chrono::milliseconds kDefaultPollInterval{10};
+
+    /** Poll every client every poll_interval (PollPolicy::fixed). */
+    explicit EventLoop(std::chrono::milliseconds poll_interval = kDefaultPollInterval,
+                       std::string name = "");
+    explicit EventLoop(PollMode mode, std::string name = "");
+    explicit EventLoop(const PollPolicy& policy, std::string name = "");
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /**
+     * Hand a client to the loop. Throws std::invalid_argument for a null
+     * client and rtms::Exception if the loop has been stopped.
+     */
+    void add(std::shared_ptr<LoopClient> client);
+
+    /**
+     * Detach a client, calling its stop() on the loop thread. Returns false if
+     * the client does not belong to this loop (or has already left it).
+     */
+    bool remove(const std::shared_ptr<LoopClient>& client);
+
+    /**
+     * Run the loop on a new thread. Throws rtms::Exception if the loop is
+     * already running or has been stopped.
+     */
+    void start(bool stop_when_empty = false);
+
+    /**
+     * Run the loop on the calling thread until stop() is called or, with
+     * stop_when_empty, until no clients are left.
+     */
+    void run(bool stop_when_empty = false);
+
+    /**
+     * Ask the loop to exit after the current cycle. Safe from any thread. A
+     * stopped loop cannot be restarted and rejects further add() calls.
+     */
+    void stop();
+
+    /** Wait for the thread started by start() to exit. */
+    void join();
+
+    /**
+     * Called on the loop thread after every cycle in which at least one
+     * client's poll() returned PollResult::Delivered, once all due clients
+     * have been polled. Lets a binding hand over a whole cycle's results at
+     * once, e.g. under a single interpreter lock. Exceptions are logged and
+     * ignored. Set it before start() or run().
+     */
+    void setOnCycleEnd(std::function<void()> callback) { on_cycle_end_ = std::move(callback); }
+
+    /**
+     * A descriptor that becomes readable after each cycle in which a client
+     * delivered, and once the loop has shut down, so asyncio (add_reader())
+     * or libuv (uv_poll) can wait on the loop instead of a timer. Created on
+     * first call; -1 on Windows. Throws rtms::Exception if it cannot be
+     * created. Call clearReady() when woken, before looking at what changed.
+     */
+    int readyFd();
+
+    /** Make readyFd() unreadable again. Returns whether it was readable. */
+    bool clearReady();
+
+    /**
+     * A descriptor that becomes readable once the loop has shut down and
+     * stays readable, for a waiter that only cares about the loop exiting
+     * (asyncio's run_async()) and should not be woken by every delivering
+     * cycle. Created on first call; -1 on Windows. Throws rtms::Exception if
+     * it cannot be created.
+     */
+    int stoppedFd();
+
+    /**
+     * Wait up to timeout for the loop to finish shutting down, however it was
+     * started. Returns true once it is no longer running.
+     */
+    bool wait(std::chrono::milliseconds timeout);
+
+    /** Clients owned by the loop, including those waiting to be started. */
+    size_t clientCount() const { return client_count_.load(std::memory_order_relaxed); }
+
+    /** True from start()/run() until every client has been stopped on exit. */
+    bool running() const { return running_.load(std::memory_order_acquire); }
+
+    /** LoopClient::poll() calls made since the loop was created. */
+    uint64_t pollCount() const { return polls_.load(std::memory_order_relaxed); }
+
+    const PollPolicy& policy() const { return policy_; }
+    const std::string& name() const { return name_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Slot {
+        std::shared_ptr<LoopClient> client;
+        Clock::time_point due;
+        uint32_t idle_polls = 0;
+    };
+
+    struct Removal {
+        std::shared_ptr<LoopClient> client;
+        std::shared_ptr<std::promise<bool>> done;   // null when scheduled from the loop thread
+    };
+
+    void begin();                       // called with mutex_ held
+    void loop(bool stop_when_empty);
+    Clock::time_point pollClients(bool& spin, bool& delivered);   // returns when the next client is due
+    void drainCommands();
+    void shutdown();
+    bool detach(std::shared_ptr<LoopClient> client);
+    void warn(const std::string& what, const char* reason) const;
+    void notifyReady();
+
+    const PollPolicy policy_;
+    const std::string name_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<std::shared_ptr<LoopClient>> pending_adds_;    // guarded by mutex_
+    std::vector<Removal> pending_removals_;                    // guarded by mutex_
+    std::unordered_set<const LoopClient*> members_;            // guarded by mutex_
+    bool stop_requested_ = false;                              // guarded by mutex_
+    std::thread::id loop_thread_;                              // guarded by mutex_
+    std::unique_ptr<Notifier> notifier_;                       // guarded by mutex_
+    std::atomic<Notifier*> ready_{nullptr};                    // notifier_, once created
+    std::unique_ptr<Notifier> stopped_;                        // guarded by mutex_
+
+    std::vector<Slot> clients_;                                // loop thread only
+    std::function<void()> on_cycle_end_;
+    std::atomic<size_t> client_count_{0};
+    std::atomic<uint64_t> polls_{0};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+/**
+ * Fixed set of EventLoops, each on its own thread, with clients routed to
+ * one loop for their whole lifetime.
+ */
+class EventLoopPool {
+public:
+    enum class Strategy {
+        LeastLoaded,
+        RoundRobin,
+    };
+
+    explicit EventLoopPool(size_t threads = 4,
+                           std::chrono::milliseconds poll_interval = EventLoop::kDefaultPollInterval,
+                           Strategy strategy = Strategy::LeastLoaded);
+    EventLoopPool(size_t threads, const PollPolicy& policy,
+                  Strategy strategy = Strategy::LeastLoaded);
+    ~EventLoopPool();
+
+    EventLoopPool(const EventLoopPool&) = delete;
+    EventLoopPool& operator=(const EventLoopPool&) = delete;
+
+    /** Route a client to a loop according to the strategy and return that loop. */
+    EventLoop& add(std::shared_ptr<LoopClient> client);
+    bool remove(const std::shared_ptr<LoopClient>& client);
+
+    void start();   // start every loop on its own thread
+    void stop();
+    void join();
+
+    size_t size() const { return loops_.size(); }
+    size_t clientCount() const;
+    EventLoop& loop(size_t index) { return *loops_.at(index); }
+
+private:
+    EventLoop& pick();
+
+    std::vector<std::unique_ptr<EventLoop>> loops_;
+    const Strategy strategy_;
+    std::atomic<size_t> next_{0};
+};
+
+} // namespace rtms
+
+#endif // RTMS_EVENT_LOOP_H
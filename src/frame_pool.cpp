@@ -0,0 +1,211 @@
+#include "frame_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace rtms {
+
+// ============================================================================
+// FrameBuffer
+// ============================================================================
+
+void FrameBuffer::setSize(size_t size) {
+    if (size > capacity_) {
+        throw std::length_error("FrameBuffer: size " + std::to_string(size) +
+                                " exceeds capacity " + std::to_string(capacity_));
+    }
+    size_ = size;
+}
+
+void FrameBuffer::release() noexcept {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        pool_->recycle(this);
+    }
+}
+
+// ============================================================================
+// FrameRef
+// ============================================================================
+
+FrameRef::FrameRef(const FrameRef& other) noexcept : buffer_(other.buffer_) {
+    if (buffer_) buffer_->addRef();
+}
+
+FrameRef::FrameRef(FrameRef&& other) noexcept : buffer_(other.buffer_) {
+    other.buffer_ = nullptr;
+}
+
+FrameRef& FrameRef::operator=(const FrameRef& other) noexcept {
+    if (this != &other) {
+        if (other.buffer_) other.buffer_->addRef();
+        reset();
+        buffer_ = other.buffer_;
+    }
+    return *this;
+}
+
+FrameRef& FrameRef::operator=(FrameRef&& other) noexcept {
+    if (this != &other) {
+        reset();
+        buffer_ = other.buffer_;
+        other.buffer_ = nullptr;
+    }
+    return *this;
+}
+
+FrameRef::~FrameRef() {
+    reset();
+}
+
+FrameRef FrameRef::adopt(FrameBuffer* buffer) noexcept {
+    return FrameRef(buffer);
+}
+
+FrameBuffer* FrameRef::detach() noexcept {
+    FrameBuffer* buffer = buffer_;
+    buffer_ = nullptr;
+    return buffer;
+}
+
+void FrameRef::reset() noexcept {
+    if (buffer_) {
+        buffer_->release();
+        buffer_ = nullptr;
+    }
+}
+
+// ============================================================================
+// FramePool
+// ============================================================================
+
+FramePool::FramePool() : FramePool(Options{}) {}
+
+FramePool::FramePool(const Options& options) : options_(options) {
+    if (options_.maxBuffersPerClass == 0) {
+        throw std::invalid_argument("FramePool: maxBuffersPerClass must be greater than 0");
+    }
+    for (auto& cls : classes_) {
+        cls = std::make_unique<SizeClass>(options_.maxBuffersPerClass);
+    }
+}
+
+FramePool::~FramePool() = default;
+
+size_t FramePool::classSize(size_t size_class) {
+    return kMinClassSize << (2 * size_class);
+}
+
+int FramePool::classFor(size_t size) {
+    for (size_t c = 0; c < kNumClasses; ++c) {
+        if (size <= classSize(c)) return static_cast<int>(c);
+    }
+    return -1;
+}
+
+FrameRef FramePool::acquire(size_t size) {
+    FrameBuffer* buffer = nullptr;
+    int cls = classFor(size);
+
+    if (cls < 0) {
+        oversize_.fetch_add(1, std::memory_order_relaxed);
+        buffer = allocateHeap(size);
+    } else if (classes_[cls]->free.tryPop(buffer)) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        buffer = grow(cls);
+        if (!buffer) buffer = allocateHeap(classSize(cls));
+    }
+
+    buffer->size_ = size;
+    buffer->refs_.store(1, std::memory_order_relaxed);
+    outstanding_.fetch_add(1, std::memory_order_relaxed);
+    return FrameRef(buffer);
+}
+
+FrameRef FramePool::copy(const uint8_t* data, size_t size) {
+    FrameRef ref = acquire(size);
+    if (size > 0) std::memcpy(ref->data(), data, size);
+    return ref;
+}
+
+FrameBuffer* FramePool::grow(int size_class) {
+    std::lock_guard<std::mutex> lock(grow_mutex_);
+
+    SizeClass& cls = *classes_[size_class];
+    if (cls.buffers >= options_.maxBuffersPerClass) return nullptr;
+
+    // Another thread may have grown the class while we waited on the lock.
+    FrameBuffer* recycled = nullptr;
+    if (cls.free.tryPop(recycled)) return recycled;
+
+    const size_t capacity = classSize(size_class);
+    size_t count = std::max<size_t>(1, options_.slabBytes / capacity);
+    count = std::min(count, options_.maxBuffersPerClass - cls.buffers);
+
+    Slab slab;
+    slab.headers.reset(new FrameBuffer[count]);
+    slab.payload.reset(new uint8_t[count * capacity]);
+
+    for (size_t i = 0; i < count; ++i) {
+        FrameBuffer& buffer = slab.headers[i];
+        buffer.pool_ = this;
+        buffer.size_class_ = size_class;
+        buffer.data_ = slab.payload.get() + i * capacity;
+        buffer.capacity_ = capacity;
+        if (i > 0) cls.free.tryPush(&buffer);
+    }
+
+    FrameBuffer* first = &slab.headers[0];
+    cls.buffers += count;
+    reserved_bytes_ += count * capacity;
+    slabs_.push_back(std::move(slab));
+    return first;
+}
+
+FrameBuffer* FramePool::allocateHeap(size_t size) {
+    // Header and payload share one allocation; freed in recycle().
+    void* mem = ::operator new(sizeof(FrameBuffer) + size);
+    FrameBuffer* buffer = new (mem) FrameBuffer();
+    buffer->pool_ = this;
+    buffer->size_class_ = -1;
+    buffer->data_ = reinterpret_cast<uint8_t*>(buffer + 1);
+    buffer->capacity_ = size;
+    return buffer;
+}
+
+void FramePool::recycle(FrameBuffer* buffer) noexcept {
+    outstanding_.fetch_sub(1, std::memory_order_relaxed);
+
+    if (buffer->size_class_ < 0) {
+        buffer->~FrameBuffer();
+        ::operator delete(static_cast<void*>(buffer));
+        return;
+    }
+
+    // Cannot fail: each queue is sized for every buffer its class can own.
+    classes_[buffer->size_class_]->free.tryPush(buffer);
+}
+
+FramePool::Stats FramePool::stats() const {
+    Stats s;
+    s.hits = hits_.load(std::memory_order_relaxed);
+    s.misses = misses_.load(std::memory_order_relaxed);
+    s.oversize = oversize_.load(std::memory_order_relaxed);
+    s.outstanding = static_cast<uint64_t>(std::max<int64_t>(0, outstanding_.load(std::memory_order_relaxed)));
+
+    std::lock_guard<std::mutex> lock(grow_mutex_);
+    for (const auto& cls : classes_) s.pooledBuffers += cls->buffers;
+    s.reservedBytes = reserved_bytes_;
+    return s;
+}
+
+FramePool& FramePool::shared() {
+    // Intentionally leaked: bindings may release frames from finalizers that
+    // run during process teardown, after static destructors.
+    static FramePool* pool = new FramePool();
+    return *pool;
+}
+
+} // namespace rtms
@@ -0,0 +1,187 @@
+#ifndef RTMS_FRAME_POOL_H
+#define RTMS_FRAME_POOL_H
+
+#include "mpmc_queue.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rtms {
+
+class FramePool;
+
+/**
+ * Reference-counted byte buffer handed out by a FramePool.
+ *
+ * The reference count is intrusive, so passing a buffer between threads or
+ * into a binding costs one atomic increment instead of a copy. When the last
+ * reference is released the buffer goes back to its pool's free list (or to
+ * the heap for oversize buffers). Use FrameRef rather than calling
+ * addRef()/release() by hand.
+ */
+class FrameBuffer {
+public:
+    FrameBuffer(const FrameBuffer&) = delete;
+    FrameBuffer& operator=(const FrameBuffer&) = delete;
+
+    uint8_t* data() noexcept { return data_; }
+    const uint8_t* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return capacity_; }
+
+    /**
+     * Set the number of valid bytes in the buffer.
+     * Throws std::length_error if size exceeds capacity().
+     */
+    void setSize(size_t size);
+
+    void addRef() noexcept { refs_.fetch_add(1, std::memory_order_relaxed); }
+    void release() noexcept;
+    uint32_t refCount() const noexcept { return refs_.load(std::memory_order_acquire); }
+
+private:
+    friend class FramePool;
+
+    FrameBuffer() = default;
+
+    FramePool* pool_ = nullptr;
+    int size_class_ = -1;     // -1: heap-backed, freed on last release
+    uint8_t* data_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    std::atomic<uint32_t> refs_{0};
+};
+
+/**
+ * Owning handle to a FrameBuffer. Copying adds a reference; destruction or
+ * reset() drops one.
+ */
+class FrameRef {
+public:
+    FrameRef() noexcept = default;
+    FrameRef(const FrameRef& other) noexcept;
+    FrameRef(FrameRef&& other) noexcept;
+    FrameRef& operator=(const FrameRef& other) noexcept;
+    FrameRef& operator=(FrameRef&& other) noexcept;
+    ~FrameRef();
+
+    /**
+     * Take ownership of one reference that the caller already holds, e.g. a
+     * pointer previously returned by detach().
+     */
+    static FrameRef adopt(FrameBuffer* buffer) noexcept;
+
+    /**
+     * Give up ownership without dropping the reference. The caller becomes
+     * responsible for calling release() on the returned buffer.
+     */
+    FrameBuffer* detach() noexcept;
+
+    void reset() noexcept;
+
+    FrameBuffer* get() const noexcept { return buffer_; }
+    FrameBuffer* operator->() const noexcept { return buffer_; }
+    explicit operator bool() const noexcept { return buffer_ != nullptr; }
+
+    const uint8_t* data() const noexcept { return buffer_ ? buffer_->data() : nullptr; }
+    size_t size() const noexcept { return buffer_ ? buffer_->size() : 0; }
+
+private:
+    explicit FrameRef(FrameBuffer* buffer) noexcept : buffer_(buffer) {}
+    FrameBuffer* buffer_ = nullptr;
+
+    friend class FramePool;
+};
+
+/**
+ * Size-classed pool of FrameBuffers.
+ *
+ * Buffers are carved out of slabs, one slab per growth step, and recycled
+ * through a lock-free free list per size class. Once a class has grown to
+ * its working set, acquire() and release are allocation-free. Requests
+ * larger than the biggest class, or beyond maxBuffersPerClass, fall back to
+ * a one-off heap allocation and are counted in stats().
+ *
+ * Buffers must not outlive the pool that issued them; FramePool::shared()
+ * lives for the whole process and is what the Client uses.
+ */
+class FramePool {
+public:
+    static constexpr size_t kMinClassSize = 256;
+    static constexpr size_t kNumClasses = 7;   // 256 B, 1 KiB, ... 1 MiB
+
+    struct Options {
+        size_t maxBuffersPerClass = 1024;
+        size_t slabBytes = 256 * 1024;        // target bytes per slab growth step
+    };
+
+    struct Stats {
+        uint64_t hits = 0;          // served from a free list
+        uint64_t misses = 0;        // free list empty, slab grown or heap fallback
+        uint64_t oversize = 0;      // larger than the biggest size class
+        uint64_t outstanding = 0;   // buffers currently referenced
+        uint64_t pooledBuffers = 0; // buffers owned by slabs across all classes
+        uint64_t reservedBytes = 0; // payload bytes owned by slabs
+    };
+
+    FramePool();
+    explicit FramePool(const Options& options);
+    ~FramePool();
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    /**
+     * Get a buffer with capacity for at least size bytes; size() is set to size.
+     */
+    FrameRef acquire(size_t size);
+
+    /**
+     * Acquire a buffer and copy size bytes from data into it.
+     */
+    FrameRef copy(const uint8_t* data, size_t size);
+
+    Stats stats() const;
+
+    static size_t classSize(size_t size_class);
+    static FramePool& shared();
+
+private:
+    friend class FrameBuffer;
+
+    struct SizeClass {
+        explicit SizeClass(size_t capacity) : free(capacity) {}
+        MpmcQueue<FrameBuffer*> free;
+        size_t buffers = 0;  // guarded by grow_mutex_
+    };
+
+    struct Slab {
+        std::unique_ptr<FrameBuffer[]> headers;
+        std::unique_ptr<uint8_t[]> payload;
+    };
+
+    static int classFor(size_t size);
+    FrameBuffer* grow(int size_class);
+    FrameBuffer* allocateHeap(size_t size);
+    void recycle(FrameBuffer* buffer) noexcept;
+
+    Options options_;
+    std::array<std::unique_ptr<SizeClass>, kNumClasses> classes_;
+
+    mutable std::mutex grow_mutex_;
+    std::vector<Slab> slabs_;
+    uint64_t reserved_bytes_ = 0;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> oversize_{0};
+    std::atomic<int64_t> outstanding_{0};
+};
+
+} // namespace rtms
+
+#endif // RTMS_FRAME_POOL_H
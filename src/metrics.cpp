@@ -0,0 +1,179 @@
+#include "metrics.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace rtms {
+
+// ============================================================================
+// LatencyHistogram
+// ============================================================================
+
+int LatencyHistogram::bucketFor(uint64_t value_ns) {
+    if (value_ns < static_cast<uint64_t>(kSubBuckets)) {
+        return static_cast<int>(value_ns);
+    }
+    if (value_ns >= (uint64_t(1) << kMaxMagnitude)) {
+        return kBuckets - 1;
+    }
+    int magnitude = static_cast<int>(std::bit_width(value_ns)) - 1;
+    int shift = magnitude - kSubBucketBits;
+    int sub = static_cast<int>((value_ns >> shift) & (kSubBuckets - 1));
+    return (shift + 1) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::bucketLow(int bucket) {
+    if (bucket < kSubBuckets) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int shift = bucket / kSubBuckets - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % kSubBuckets);
+    return (uint64_t(kSubBuckets) + sub) << shift;
+}
+
+uint64_t LatencyHistogram::bucketHigh(int bucket) {
+    if (bucket < kSubBuckets) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int shift = bucket / kSubBuckets - 1;
+    return bucketLow(bucket) + (uint64_t(1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value_ns) {
+    buckets_[bucketFor(value_ns)].fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(value_ns, std::memory_order_relaxed);
+
+    uint64_t max = max_ns_.load(std::memory_order_relaxed);
+    while (value_ns > max && !max_ns_.compare_exchange_weak(max, value_ns, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snap;
+    // The count is the bucket total so that percentiles always add up, even
+    // when a writer lands between the reads
+    for (int i = 0; i < kBuckets; ++i) {
+        snap.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        snap.count += snap.buckets[i];
+    }
+    snap.sum_ns = sum_ns_.load(std::memory_order_relaxed);
+    snap.max_ns = max_ns_.load(std::memory_order_relaxed);
+    return snap;
+}
+
+uint64_t LatencyHistogram::Snapshot::percentileNs(double quantile) const {
+    if (count == 0) return 0;
+    quantile = std::clamp(quantile, 0.0, 1.0);
+
+    // Rank of the requested value, 1-based, so quantile 0 is the first value
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(quantile * static_cast<double>(count) + 0.5));
+    uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(bucketHigh(i), max_ns);
+        }
+    }
+    return max_ns;
+}
+
+uint64_t LatencyHistogram::Snapshot::countAtOrBelow(uint64_t value_ns) const {
+    uint64_t total = 0;
+    for (int i = 0; i < kBuckets && bucketHigh(i) <= value_ns; ++i) {
+        total += buckets[i];
+    }
+    return total;
+}
+
+// ============================================================================
+// ClientMetrics
+// ============================================================================
+
+const char* ClientMetrics::name(Media media) {
+    switch (media) {
+        case Media::Audio:      return "audio";
+        case Media::Video:      return "video";
+        case Media::Deskshare:  return "deskshare";
+        case Media::Transcript: return "transcript";
+    }
+    return "unknown";
+}
+
+ClientMetrics::Media ClientMetrics::parse(const std::string& name) {
+    for (size_t i = 0; i < kMediaCount; ++i) {
+        auto media = static_cast<Media>(i);
+        if (name == ClientMetrics::name(media)) return media;
+    }
+    throw std::invalid_argument("Unknown media type '" + name +
+                                "'; expected audio, video, deskshare or transcript");
+}
+
+const char* ClientMetrics::name(Callback callback) {
+    switch (callback) {
+        case Callback::JoinConfirm:      return "join_confirm";
+        case Callback::SessionUpdate:    return "session_update";
+        case Callback::UserUpdate:       return "user_update";
+        case Callback::Audio:            return "audio";
+        case Callback::Video:            return "video";
+        case Callback::Deskshare:        return "deskshare";
+        case Callback::Transcript:       return "transcript";
+        case Callback::Leave:            return "leave";
+        case Callback::EventEx:          return "event_ex";
+        case Callback::ParticipantVideo: return "participant_video";
+        case Callback::VideoSubscribed:  return "video_subscribed";
+        case Callback::AudioBatch:       return "audio_batch";
+        case Callback::VideoBatch:       return "video_batch";
+        case Callback::DeskshareBatch:   return "deskshare_batch";
+        case Callback::TranscriptBatch:  return "transcript_batch";
+    }
+    return "unknown";
+}
+
+ClientMetrics::Snapshot ClientMetrics::snapshot() const {
+    Snapshot snap;
+    for (size_t i = 0; i < kMediaCount; ++i) {
+        snap.media[i].frames = media_[i].frames.load(std::memory_order_relaxed);
+        snap.media[i].bytes = media_[i].bytes.load(std::memory_order_relaxed);
+        snap.media[i].empty = media_[i].empty.load(std::memory_order_relaxed);
+        snap.media[i].dropped = media_[i].dropped.load(std::memory_order_relaxed);
+        snap.media[i].last_frame_ns = media_[i].last_frame_ns.load(std::memory_order_relaxed);
+    }
+    snap.poll = poll_.snapshot();
+    for (size_t i = 0; i < kCallbackCount; ++i) {
+        snap.callbacks[i] = callbacks_[i].snapshot();
+    }
+    return snap;
+}
+
+// ============================================================================
+// MetricsRegistry
+// ============================================================================
+
+MetricsRegistry& MetricsRegistry::global() {
+    // Leaked on purpose: clients owned by other statics may unregister after
+    // a function-local static would have been destroyed.
+    static MetricsRegistry* registry = new MetricsRegistry();
+    return *registry;
+}
+
+void MetricsRegistry::add(const Client* client) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    clients_.push_back(client);
+}
+
+void MetricsRegistry::remove(const Client* client) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    clients_.erase(std::remove(clients_.begin(), clients_.end(), client), clients_.end());
+}
+
+void MetricsRegistry::add(const EventLoop* loop) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    loops_.push_back(loop);
+}
+
+void MetricsRegistry::remove(const EventLoop* loop) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    loops_.erase(std::remove(loops_.begin(), loops_.end(), loop), loops_.end());
+}
+
+} // namespace rtms
@@ -0,0 +1,214 @@
+#ifndef RTMS_METRICS_H
+#define RTMS_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rtms {
+
+class Client;
+class EventLoop;
+
+/**
+ * Log-linear latency histogram in the style of HdrHistogram.
+ *
+ * Values are nanoseconds. Each power of two is split into eight linear
+ * buckets, so any recorded value is reported to within 12.5%. Values beyond
+ * the top bucket (about 18 minutes) are counted in it.
+ *
+ * record() is wait-free apart from the max update and may be called from any
+ * number of threads; snapshot() reads the counters without stopping writers.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 3;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kMaxMagnitude = 40;   // 2^40 ns
+    static constexpr int kBuckets = (kMaxMagnitude - kSubBucketBits + 1) * kSubBuckets;
+
+    /** Bucket a value falls in. */
+    static int bucketFor(uint64_t value_ns);
+
+    /** Smallest and largest values counted in a bucket. */
+    static uint64_t bucketLow(int bucket);
+    static uint64_t bucketHigh(int bucket);
+
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+        uint64_t max_ns = 0;
+        std::array<uint64_t, kBuckets> buckets{};
+
+        double meanNs() const { return count ? static_cast<double>(sum_ns) / count : 0.0; }
+
+        /**
+         * Upper bound of the bucket holding the given quantile (0.0 - 1.0),
+         * clamped to max_ns. Returns 0 when nothing has been recorded.
+         */
+        uint64_t percentileNs(double quantile) const;
+
+        /** Recorded values no greater than value_ns, to bucket precision. */
+        uint64_t countAtOrBelow(uint64_t value_ns) const;
+    };
+
+    /** Records the elapsed time into a histogram when it goes out of scope. */
+    class Timer {
+    public:
+        explicit Timer(LatencyHistogram& histogram)
+            : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+        ~Timer() {
+            histogram_.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start_).count()));
+        }
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+    private:
+        LatencyHistogram& histogram_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    void record(uint64_t value_ns);
+    Snapshot snapshot() const;
+
+private:
+    std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+    std::atomic<uint64_t> sum_ns_{0};
+    std::atomic<uint64_t> max_ns_{0};
+};
+
+/**
+ * Per-client delivery counters, kept by rtms::Client and read with snapshot().
+ *
+ * Counters are relaxed atomics written from the SDK sinks, so recording never
+ * takes a lock. A snapshot reads each counter separately; taken while frames
+ * are arriving it may disagree with itself by the frames in flight.
+ */
+class ClientMetrics {
+public:
+    enum class Media {
+        Audio,
+        Video,
+        Deskshare,
+        Transcript,
+    };
+    static constexpr size_t kMediaCount = 4;
+
+    enum class Callback {
+        JoinConfirm,
+        SessionUpdate,
+        UserUpdate,
+        Audio,
+        Video,
+        Deskshare,
+        Transcript,
+        Leave,
+        EventEx,
+        ParticipantVideo,
+        VideoSubscribed,
+        AudioBatch,
+        VideoBatch,
+        DeskshareBatch,
+        TranscriptBatch,
+    };
+    static constexpr size_t kCallbackCount = 15;
+
+    static const char* name(Media media);
+    static const char* name(Callback callback);
+
+    /** Inverse of name(Media). Throws std::invalid_argument for anything else. */
+    static Media parse(const std::string& name);
+
+    struct MediaSnapshot {
+        uint64_t frames = 0;
+        uint64_t bytes = 0;
+        uint64_t empty = 0;   // deliveries with no buffer, no metadata or zero size
+        uint64_t dropped = 0;   // frames a binding discarded because its consumer fell behind
+        uint64_t last_frame_ns = 0;   // steady_clock time of the latest frame; 0 if none
+    };
+
+    struct Snapshot {
+        std::array<MediaSnapshot, kMediaCount> media{};
+        LatencyHistogram::Snapshot poll;
+        std::array<LatencyHistogram::Snapshot, kCallbackCount> callbacks{};
+
+        const MediaSnapshot& of(Media m) const { return media[static_cast<size_t>(m)]; }
+        const LatencyHistogram::Snapshot& of(Callback c) const { return callbacks[static_cast<size_t>(c)]; }
+    };
+
+    void recordFrame(Media media, size_t bytes) {
+        MediaCounters& counters = media_[static_cast<size_t>(media)];
+        counters.frames.fetch_add(1, std::memory_order_relaxed);
+        counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        counters.last_frame_ns.store(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count()), std::memory_order_relaxed);
+    }
+
+    void recordEmpty(Media media) {
+        media_[static_cast<size_t>(media)].empty.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void recordDropped(Media media, uint64_t frames) {
+        media_[static_cast<size_t>(media)].dropped.fetch_add(frames, std::memory_order_relaxed);
+    }
+
+    LatencyHistogram& poll() { return poll_; }
+    LatencyHistogram& callback(Callback callback) { return callbacks_[static_cast<size_t>(callback)]; }
+
+    Snapshot snapshot() const;
+
+private:
+    struct MediaCounters {
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> empty{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> last_frame_ns{0};
+    };
+
+    std::array<MediaCounters, kMediaCount> media_{};
+    LatencyHistogram poll_;
+    std::array<LatencyHistogram, kCallbackCount> callbacks_{};
+};
+
+/**
+ * Process-wide list of live clients and event loops, which register
+ * themselves on construction and leave on destruction. The Prometheus
+ * exporter walks it on every scrape.
+ */
+class MetricsRegistry {
+public:
+    static MetricsRegistry& global();
+
+    void add(const Client* client);
+    void remove(const Client* client);
+    void add(const EventLoop* loop);
+    void remove(const EventLoop* loop);
+
+    /**
+     * Call fn(clients, loops) with the registry locked. Anything listed stays
+     * alive until fn returns, since its destructor waits in remove().
+     */
+    template <typename Fn>
+    void visit(Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fn(clients_, loops_);
+    }
+
+private:
+    MetricsRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::vector<const Client*> clients_;     // in creation order
+    std::vector<const EventLoop*> loops_;
+};
+
+} // namespace rtms
+
+#endif // RTMS_METRICS_H
@@ -1,5 +1,12 @@
 #include <napi.h>
 #include "rtms.h"
+#include "event_loop.h"
+#include "delivery_queue.h"
+#include "shared_ring.h"
+#include "shm_ring.h"
+#include "frame_pool.h"
+#include "prometheus.h"
+#include "trace.h"
 #include <string>
 #include <functional>
 #include <memory>
@@ -7,18 +14,18 @@
 #include <thread>
 #include <chrono>
 #include <iostream>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstring>
 
 using namespace Napi;
 using namespace std;
 
-static Napi::Object buildMetadataObj(Napi::Env env, const rtms::Metadata& metadata) {
-    Napi::Object obj = Napi::Object::New(env);
-    obj.Set("userName", Napi::String::New(env, metadata.userName()));
-    obj.Set("userId", Napi::Number::New(env, metadata.userId()));
-    obj.Set("startTs", Napi::Number::New(env, static_cast<double>(metadata.startTs())));
-    obj.Set("endTs", Napi::Number::New(env, static_cast<double>(metadata.endTs())));
-
-    const auto& aii = metadata.aiInterpreter();
+// Builds an aiInterpreter object, frozen because MetadataCache shares it
+// between frames
+static Napi::Object buildAiInterpreterObj(Napi::Env env, const rtms::AiInterpreter& aii) {
     Napi::Object aiObj = Napi::Object::New(env);
     aiObj.Set("lid", Napi::Number::New(env, aii.lid()));
     aiObj.Set("timestamp", Napi::Number::New(env, static_cast<double>(aii.timestamp())));
@@ -33,13 +40,208 @@ static Napi::Object buildMetadataObj(Napi::Env env, const rtms::Metadata& metada
         tObj.Set("toneId", Napi::Number::New(env, t.toneId()));
         tObj.Set("voiceId", Napi::String::New(env, t.voiceId()));
         tObj.Set("engine", Napi::String::New(env, t.engine()));
+        tObj.Freeze();
         targets.Set(i, tObj);
     }
+    targets.Freeze();
     aiObj.Set("targets", targets);
-    obj.Set("aiInterpreter", aiObj);
+    aiObj.Freeze();
+    return aiObj;
+}
+
+// Per-client cache of the metadata that repeats from frame to frame. Each
+// frame still gets its own small metadata object, since startTs and endTs
+// change, but a user's name string and aiInterpreter graph are built once
+// and reused until they change, instead of 3 + N objects and 2N + 1 strings
+// per frame. Used on the JS thread only.
+class MetadataCache {
+public:
+    // Users are forgotten all at once past this many, which only costs a
+    // rebuild for the ones still sending
+    static constexpr size_t kMaxUsers = 1024;
+
+    Napi::Object build(Napi::Env env, const rtms::Metadata& metadata) {
+        string name = metadata.userName();
+        auto it = users_.find(metadata.userId());
+        if (it == users_.end() || it->second.name != name || it->second.ai != metadata.aiInterpreter()) {
+            if (it == users_.end() && users_.size() >= kMaxUsers) users_.clear();
+            User user{name, metadata.aiInterpreter(),
+                      Napi::Persistent(Napi::String::New(env, name)),
+                      Napi::Persistent(buildAiInterpreterObj(env, metadata.aiInterpreter()))};
+            it = users_.insert_or_assign(metadata.userId(), std::move(user)).first;
+        }
+
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("userName", it->second.name_value.Value());
+        obj.Set("userId", Napi::Number::New(env, metadata.userId()));
+        obj.Set("startTs", Napi::Number::New(env, static_cast<double>(metadata.startTs())));
+        obj.Set("endTs", Napi::Number::New(env, static_cast<double>(metadata.endTs())));
+        obj.Set("aiInterpreter", it->second.ai_value.Value());
+        return obj;
+    }
+
+private:
+    struct User {
+        string name;
+        rtms::AiInterpreter ai;
+        Napi::Reference<Napi::String> name_value;
+        Napi::ObjectReference ai_value;
+    };
+
+    unordered_map<int, User> users_;
+};
+
+// Packs the frames of one poll into a single Buffer with an offsets table, so
+// delivering a batch costs one JS call and one Buffer however many frames it
+// holds. Frame i is data.subarray(offsets[i], offsets[i + 1]).
+static Napi::Object buildBatchObj(Napi::Env env, MetadataCache& cache, const vector<rtms::MediaFrame>& frames) {
+    size_t total = 0;
+    for (const auto& frame : frames) total += frame.size();
+
+    Napi::Buffer<uint8_t> data = Napi::Buffer<uint8_t>::New(env, total);
+    Napi::Uint32Array offsets = Napi::Uint32Array::New(env, frames.size() + 1);
+    Napi::Float64Array timestamps = Napi::Float64Array::New(env, frames.size());
+    Napi::Array metadata = Napi::Array::New(env, frames.size());
+
+    size_t offset = 0;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const auto& frame = frames[i];
+        memcpy(data.Data() + offset, frame.data(), frame.size());
+        offsets[i] = static_cast<uint32_t>(offset);
+        timestamps[i] = static_cast<double>(frame.timestamp());
+        metadata.Set(i, cache.build(env, frame.metadata()));
+        offset += frame.size();
+    }
+    offsets[frames.size()] = static_cast<uint32_t>(offset);
+
+    Napi::Object batch = Napi::Object::New(env);
+    batch.Set("count", Napi::Number::New(env, static_cast<double>(frames.size())));
+    batch.Set("data", data);
+    batch.Set("offsets", offsets);
+    batch.Set("timestamps", timestamps);
+    batch.Set("metadata", metadata);
+    return batch;
+}
+
+// Metric names are snake_case in the core; JS properties are camelCase
+static string camelCaseName(const char* name) {
+    string out;
+    bool upper = false;
+    for (const char* c = name; *c; ++c) {
+        if (*c == '_') {
+            upper = true;
+        } else {
+            out += upper ? static_cast<char>(toupper(static_cast<unsigned char>(*c))) : *c;
+            upper = false;
+        }
+    }
+    return out;
+}
+
+static Napi::Object buildHistogramObj(Napi::Env env, const rtms::LatencyHistogram::Snapshot& h) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("count", Napi::Number::New(env, static_cast<double>(h.count)));
+    obj.Set("meanUs", Napi::Number::New(env, h.meanNs() / 1000.0));
+    obj.Set("p50Us", Napi::Number::New(env, h.percentileNs(0.50) / 1000.0));
+    obj.Set("p90Us", Napi::Number::New(env, h.percentileNs(0.90) / 1000.0));
+    obj.Set("p99Us", Napi::Number::New(env, h.percentileNs(0.99) / 1000.0));
+    obj.Set("maxUs", Napi::Number::New(env, h.max_ns / 1000.0));
+    return obj;
+}
+
+static Napi::Object buildStatsObj(Napi::Env env, const rtms::ClientMetrics::Snapshot& stats) {
+    using Metrics = rtms::ClientMetrics;
+    Napi::Object obj = Napi::Object::New(env);
+
+    for (size_t i = 0; i < Metrics::kMediaCount; ++i) {
+        const auto& media = stats.media[i];
+        Napi::Object mediaObj = Napi::Object::New(env);
+        mediaObj.Set("frames", Napi::Number::New(env, static_cast<double>(media.frames)));
+        mediaObj.Set("bytes", Napi::Number::New(env, static_cast<double>(media.bytes)));
+        mediaObj.Set("empty", Napi::Number::New(env, static_cast<double>(media.empty)));
+        mediaObj.Set("dropped", Napi::Number::New(env, static_cast<double>(media.dropped)));
+        obj.Set(Metrics::name(static_cast<Metrics::Media>(i)), mediaObj);
+    }
+
+    obj.Set("poll", buildHistogramObj(env, stats.poll));
+
+    Napi::Object callbacks = Napi::Object::New(env);
+    for (size_t i = 0; i < Metrics::kCallbackCount; ++i) {
+        callbacks.Set(camelCaseName(Metrics::name(static_cast<Metrics::Callback>(i))),
+                      buildHistogramObj(env, stats.callbacks[i]));
+    }
+    obj.Set("callbacks", callbacks);
     return obj;
 }
 
+// Wraps a frame's pooled buffer in an external Buffer instead of copying it
+// into the JS heap. The Buffer holds one reference, dropped by its finalizer,
+// so the memory returns to the FramePool once JS garbage-collects it. Runtimes
+// that forbid external buffers get a copy (and the reference back) at once.
+static Napi::Buffer<uint8_t> frameBuffer(Napi::Env env, const rtms::MediaFrame& frame) {
+    rtms::FrameRef ref = frame.buffer();
+    if (!ref || ref.size() == 0) return Napi::Buffer<uint8_t>::New(env, 0);
+
+    size_t size = ref.size();
+    rtms::FrameBuffer* buffer = ref.detach();
+    // Let V8 see the native memory a Buffer keeps alive, or large video frames
+    // behind small wrappers would not make it collect any sooner
+    Napi::MemoryManagement::AdjustExternalMemory(env, static_cast<int64_t>(size));
+    try {
+        return Napi::Buffer<uint8_t>::NewOrCopy(env, buffer->data(), size,
+            [](Napi::Env env, uint8_t*, rtms::FrameBuffer* buffer) {
+                Napi::MemoryManagement::AdjustExternalMemory(env, -static_cast<int64_t>(buffer->size()));
+                rtms::FrameRef::adopt(buffer);
+            }, buffer);
+    } catch (...) {
+        Napi::MemoryManagement::AdjustExternalMemory(env, -static_cast<int64_t>(size));
+        rtms::FrameRef::adopt(buffer);
+        throw;
+    }
+}
+
+static vector<napi_value> frameArgs(Napi::Env env, MetadataCache& cache, const rtms::MediaFrame& frame) {
+    return {frameBuffer(env, frame), Napi::Number::New(env, frame.size()),
+            Napi::Number::New(env, frame.timestamp()), cache.build(env, frame.metadata())};
+}
+
+static vector<napi_value> batchArgs(Napi::Env env, MetadataCache& cache, const vector<rtms::MediaFrame>& frames) {
+    return {buildBatchObj(env, cache, frames)};
+}
+
+// Wraps ClientMetrics::parse(), returning false instead of throwing so callers raise their own JS error
+static bool parseMedia(const string& name, rtms::ClientMetrics::Media& media) {
+    try {
+        media = rtms::ClientMetrics::parse(name);
+        return true;
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+}
+
+// A SharedArrayBuffer ring that frames are copied into on the polling thread,
+// for worker_threads to read directly. Native code cannot Atomics.notify(),
+// so after a write one coalesced call asks the JS thread to do it; readers
+// also wake on their own timeout when that thread is busy. A shared-memory
+// ring for other processes wakes its readers itself and has no notify.
+struct RingChannel {
+    shared_ptr<rtms::SharedRing> ring;
+    Napi::ThreadSafeFunction notify;
+    shared_ptr<atomic<bool>> notify_pending;
+};
+
+// A media callback's way into JS: frames wait in a bounded DeliveryQueue and
+// one NonBlockingCall at a time drains it on the JS thread, so a busy event
+// loop costs queue space (and the queue's drop policy) instead of stalling
+// the poll thread or growing without limit.
+template <typename T>
+struct MediaChannel {
+    rtms::ClientMetrics::Media media = rtms::ClientMetrics::Media::Audio;
+    Napi::ThreadSafeFunction tsfn;
+    shared_ptr<rtms::DeliveryQueue<T>> queue;
+    vector<napi_value> (*args)(Napi::Env, MetadataCache&, const T&) = nullptr;
+};
+
 class NodeClient : public Napi::ObjectWrap<NodeClient> {
 public:
     static Napi::Object init(Napi::Env env, Napi::Object exports);
@@ -47,6 +249,8 @@ public:
     ~NodeClient();
 
 private:
+    friend class NodeEventLoop;
+
     static Napi::Value initialize(const Napi::CallbackInfo& info);
     static Napi::Value uninitialize(const Napi::CallbackInfo& info);
 
@@ -55,6 +259,7 @@ private:
     Napi::Value release(const Napi::CallbackInfo& info);
     Napi::Value uuid(const Napi::CallbackInfo& info);
     Napi::Value streamId(const Napi::CallbackInfo& info);
+    Napi::Value getStats(const Napi::CallbackInfo& info);
 
     Napi::Value enableVideo(const Napi::CallbackInfo& info);
     Napi::Value enableAudio(const Napi::CallbackInfo& info);
@@ -67,6 +272,7 @@ private:
     Napi::Value setProxy(const Napi::CallbackInfo& info);
 
     Napi::Value setOnJoinConfirm(const Napi::CallbackInfo& info);
+    void reportJoinConfirm(int reason);
     Napi::Value setOnSessionUpdate(const Napi::CallbackInfo& info);
     Napi::Value setOnUserUpdate(const Napi::CallbackInfo& info);
     Napi::Value setOnDeskshareData(const Napi::CallbackInfo& info);
@@ -76,6 +282,39 @@ private:
     Napi::Value setOnLeave(const Napi::CallbackInfo& info);
     Napi::Value setOnEventEx(const Napi::CallbackInfo& info);
 
+    Napi::Value setOnDeskshareBatch(const Napi::CallbackInfo& info);
+    Napi::Value setOnAudioBatch(const Napi::CallbackInfo& info);
+    Napi::Value setOnVideoBatch(const Napi::CallbackInfo& info);
+    Napi::Value setOnTranscriptBatch(const Napi::CallbackInfo& info);
+
+    using Media = rtms::ClientMetrics::Media;
+    using FrameChannel = MediaChannel<rtms::MediaFrame>;
+    using BatchChannel = MediaChannel<vector<rtms::MediaFrame>>;
+
+    Napi::Value setDeliveryQueue(const Napi::CallbackInfo& info);
+    Napi::Value setOnData(const Napi::CallbackInfo& info, FrameChannel& channel, Media media, const char* name);
+    void installFrameSink(Media media);
+    Napi::Value attachSharedRing(const Napi::CallbackInfo& info);
+    Napi::Value attachShmRing(const Napi::CallbackInfo& info);
+    Napi::Value detachSharedRing(const Napi::CallbackInfo& info);
+    void detachRing(Media media);
+    static void notifyRing(const RingChannel& ring);
+    Napi::Value setOnBatch(const Napi::CallbackInfo& info, BatchChannel& channel, Media media, const char* name,
+                           void (rtms::Client::*setter)(rtms::Client::MediaBatchFn));
+    Napi::Value setDeliveryPaused(const Napi::CallbackInfo& info);
+    template <typename T>
+    void openChannel(Napi::Env env, Napi::Function callback, MediaChannel<T>& channel, Media media, const char* name,
+                     vector<napi_value> (*args)(Napi::Env, MetadataCache&, const T&));
+    template <typename T>
+    void deliver(const MediaChannel<T>& channel, T item);
+    template <typename T>
+    void scheduleDrain(const MediaChannel<T>& channel);
+    template <typename Fn>
+    void forEachChannel(Fn&& fn) {
+        fn(ds_data_); fn(audio_data_); fn(video_data_); fn(transcript_data_);
+        fn(ds_batch_); fn(audio_batch_); fn(video_batch_); fn(transcript_batch_);
+    }
+
     Napi::Value subscribeEvent(const Napi::CallbackInfo& info);
     Napi::Value unsubscribeEvent(const Napi::CallbackInfo& info);
 
@@ -83,24 +322,55 @@ private:
     Napi::Value setOnParticipantVideo(const Napi::CallbackInfo& info);
     Napi::Value setOnVideoSubscribed(const Napi::CallbackInfo& info);
 
-    unique_ptr<rtms::Client> client_;
+    shared_ptr<rtms::Client> client_;
+
+    // Set while an EventLoop drives this client; join/poll/release then run
+    // on the loop's thread instead of the JS thread.
+    shared_ptr<rtms::EventLoop> loop_;
+    shared_ptr<rtms::LoopClient> loop_session_;
+
     Napi::ThreadSafeFunction tsfn_join_confirm_;
     Napi::ThreadSafeFunction tsfn_session_update_;
     Napi::ThreadSafeFunction tsfn_user_update_;
-    Napi::ThreadSafeFunction tsfn_ds_data_;
-    Napi::ThreadSafeFunction tsfn_audio_data_;
-    Napi::ThreadSafeFunction tsfn_video_data_;
-    Napi::ThreadSafeFunction tsfn_transcript_data_;
     Napi::ThreadSafeFunction tsfn_leave_;
     Napi::ThreadSafeFunction tsfn_event_ex_;
     Napi::ThreadSafeFunction tsfn_participant_video_;
     Napi::ThreadSafeFunction tsfn_video_subscribed_;
+
+    FrameChannel ds_data_;
+    FrameChannel audio_data_;
+    FrameChannel video_data_;
+    FrameChannel transcript_data_;
+    BatchChannel ds_batch_;
+    BatchChannel audio_batch_;
+    BatchChannel video_batch_;
+    BatchChannel transcript_batch_;
+
+    // Applied to every media channel, including ones opened later
+    rtms::DeliveryPolicy delivery_policy_ = rtms::DeliveryPolicy::Block;
+    array<size_t, rtms::ClientMetrics::kMediaCount> delivery_depth_;
+    array<bool, rtms::ClientMetrics::kMediaCount> delivery_paused_{};
+
+    array<RingChannel, rtms::ClientMetrics::kMediaCount> rings_;
+    array<Napi::ObjectReference, rtms::ClientMetrics::kMediaCount> ring_memory_;   // keeps each SAB alive
+
+    // Shared with every pending drain, which may still run after this
+    // client is finalized
+    shared_ptr<MetadataCache> metadata_ = make_shared<MetadataCache>();
+
+    // Frames pushed from here cannot wait for a drain, which also runs here
+    thread::id js_thread_;
 };
 
 Napi::Value NodeClient::poll(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
 
+    if (loop_session_) {
+        Napi::Error::New(env, "Client is polled by an EventLoop").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
     try {
         client_->poll();
         return Napi::Boolean::New(env, true);
@@ -114,6 +384,11 @@ Napi::Value NodeClient::release(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
 
+    if (loop_session_) {
+        Napi::Error::New(env, "Client is owned by an EventLoop; remove it from the loop instead").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
     try {
         client_->release();
         return Napi::Boolean::New(env, true);
@@ -136,6 +411,12 @@ Napi::Value NodeClient::uuid(const Napi::CallbackInfo& info) {
     }
 }
 
+Napi::Value NodeClient::getStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::HandleScope scope(env);
+    return buildStatsObj(env, client_->metrics().snapshot());
+}
+
 Napi::Value NodeClient::streamId(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
@@ -378,16 +659,21 @@ Napi::Value NodeClient::setOnJoinConfirm(const Napi::CallbackInfo& info) {
         env, callback, "JoinConfirmCallback", 0, 1
     );
 
-    client_->setOnJoinConfirm([this](int reason) {
-        auto callback = [reason](Napi::Env env, Napi::Function jsCallback) {
-            jsCallback.Call({Napi::Number::New(env, reason)});
-        };
-        tsfn_join_confirm_.BlockingCall(callback);
-    });
+    client_->setOnJoinConfirm([this](int reason) { reportJoinConfirm(reason); });
 
     return Napi::Boolean::New(env, true);
 }
 
+void NodeClient::reportJoinConfirm(int reason) {
+    if (!tsfn_join_confirm_) return;
+    auto callback = [reason](Napi::Env env, Napi::Function jsCallback) {
+        RTMS_TRACE_SCOPE("node.js_callback");
+        jsCallback.Call({Napi::Number::New(env, reason)});
+    };
+    RTMS_TRACE_SCOPE("node.tsfn_call");
+    tsfn_join_confirm_.BlockingCall(callback);
+}
+
 Napi::Value NodeClient::setOnSessionUpdate(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
@@ -410,6 +696,7 @@ Napi::Value NodeClient::setOnSessionUpdate(const Napi::CallbackInfo& info) {
     client_->setOnSessionUpdate([this](int op, const rtms::Session& session) {
         auto callback = [op, sessionId = session.sessionId(), streamId = session.streamId(), meetingId = session.meetingId(), statTime = session.statTime(), status = session.status()]
                         (Napi::Env env, Napi::Function jsCallback) {
+            RTMS_TRACE_SCOPE("node.js_callback");
             Napi::Object sessionObj = Napi::Object::New(env);
             sessionObj.Set("sessionId", Napi::String::New(env, sessionId));
             sessionObj.Set("streamId", Napi::String::New(env, streamId));
@@ -421,6 +708,7 @@ Napi::Value NodeClient::setOnSessionUpdate(const Napi::CallbackInfo& info) {
 
             jsCallback.Call({Napi::Number::New(env, op), sessionObj});
         };
+        RTMS_TRACE_SCOPE("node.tsfn_call");
         tsfn_session_update_.BlockingCall(callback);
     });
 
@@ -449,12 +737,14 @@ Napi::Value NodeClient::setOnUserUpdate(const Napi::CallbackInfo& info) {
     client_->setOnUserUpdate([this](int op, const rtms::Participant& participant) {
         auto callback = [op, id = participant.id(), name = participant.name()]
                         (Napi::Env env, Napi::Function jsCallback) {
+            RTMS_TRACE_SCOPE("node.js_callback");
             Napi::Object participantObj = Napi::Object::New(env);
             participantObj.Set("id", Napi::Number::New(env, id));
             participantObj.Set("name", Napi::String::New(env, name));
 
             jsCallback.Call({Napi::Number::New(env, op), participantObj});
         };
+        RTMS_TRACE_SCOPE("node.tsfn_call");
         tsfn_user_update_.BlockingCall(callback);
     });
 
@@ -462,6 +752,69 @@ Napi::Value NodeClient::setOnUserUpdate(const Napi::CallbackInfo& info) {
 }
 
 Napi::Value NodeClient::setOnDeskshareData(const Napi::CallbackInfo& info) {
+    return setOnData(info, ds_data_, Media::Deskshare, "DeskshareDataCallback");
+}
+
+Napi::Value NodeClient::setOnAudioData(const Napi::CallbackInfo& info) {
+    return setOnData(info, audio_data_, Media::Audio, "AudioDataCallback");
+}
+
+Napi::Value NodeClient::setOnVideoData(const Napi::CallbackInfo& info) {
+    return setOnData(info, video_data_, Media::Video, "VideoDataCallback");
+}
+
+Napi::Value NodeClient::setOnTranscriptData(const Napi::CallbackInfo& info) {
+    return setOnData(info, transcript_data_, Media::Transcript, "TranscriptDataCallback");
+}
+
+template <typename T>
+void NodeClient::openChannel(Napi::Env env, Napi::Function callback, MediaChannel<T>& channel, Media media, const char* name,
+                             vector<napi_value> (*args)(Napi::Env, MetadataCache&, const T&)) {
+    if (channel.queue) channel.queue->close();
+    if (channel.tsfn) channel.tsfn.Release();
+
+    channel.media = media;
+    channel.args = args;
+    channel.queue = make_shared<rtms::DeliveryQueue<T>>(delivery_depth_[static_cast<size_t>(media)],
+                                                        rtms::effectivePolicy(delivery_policy_, media));
+    if (delivery_paused_[static_cast<size_t>(media)]) channel.queue->pause();
+    // deliver() never has more than one drain outstanding
+    channel.tsfn = Napi::ThreadSafeFunction::New(env, callback, name, 1, 1);
+}
+
+template <typename T>
+void NodeClient::deliver(const MediaChannel<T>& channel, T item) {
+    auto result = channel.queue->push(std::move(item), this_thread::get_id() != js_thread_);
+    if (result.dropped) client_->recordDropped(channel.media, result.dropped);
+    if (result.schedule) scheduleDrain(channel);
+}
+
+template <typename T>
+void NodeClient::scheduleDrain(const MediaChannel<T>& channel) {
+    auto queue = channel.queue;
+    auto metadata = metadata_;
+    auto args = channel.args;
+    auto drain = [queue, metadata, args](Napi::Env env, Napi::Function jsCallback) {
+        RTMS_TRACE_SCOPE("node.js_callback");
+        vector<T> items;
+        queue->drain(items);
+        for (const T& item : items) {
+            jsCallback.Call(args(env, *metadata, item));
+        }
+    };
+    RTMS_TRACE_SCOPE("node.tsfn_call");
+    if (channel.tsfn.NonBlockingCall(drain) != napi_ok) {
+        // The callback is being released; nothing will drain this queue again
+        queue->close();
+        vector<T> items;
+        queue->drain(items);
+        uint64_t frames = 0;
+        for (const T& pending : items) frames += rtms::DeliveryQueue<T>::frameCount(pending);
+        client_->recordDropped(channel.media, frames);
+    }
+}
+
+Napi::Value NodeClient::setOnData(const Napi::CallbackInfo& info, FrameChannel& channel, Media media, const char* name) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
 
@@ -470,60 +823,160 @@ Napi::Value NodeClient::setOnDeskshareData(const Napi::CallbackInfo& info) {
         return env.Null();
     }
 
-    Napi::Function callback = info[0].As<Napi::Function>();
-
-    if (tsfn_ds_data_) {
-        tsfn_ds_data_.Release();
-    }
+    openChannel(env, info[0].As<Napi::Function>(), channel, media, name, frameArgs);
+    installFrameSink(media);
 
-    tsfn_ds_data_ = Napi::ThreadSafeFunction::New(
-        env, callback, "DeskshareDataCallback", 0, 1
-    );
+    return Napi::Boolean::New(env, true);
+}
 
-    client_->setOnDeskshareData([this](const vector<uint8_t>& data, uint64_t timestamp, const rtms::Metadata& metadata) {
-        auto callback = [data, timestamp, metadata]
-                       (Napi::Env env, Napi::Function jsCallback) {
-            Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::Copy(env, data.data(), data.size());
-            jsCallback.Call({buffer, Napi::Number::New(env, data.size()), Napi::Number::New(env, timestamp), buildMetadataObj(env, metadata)});
-        };
-        tsfn_ds_data_.BlockingCall(callback);
+// The core has one frame callback per media type, shared by the data
+// callback's queue and the shared ring; reinstalled whenever either changes
+void NodeClient::installFrameSink(Media media) {
+    FrameChannel* data = nullptr;
+    void (rtms::Client::*setter)(rtms::Client::MediaFrameFn) = nullptr;
+    switch (media) {
+        case Media::Audio:      data = &audio_data_;      setter = &rtms::Client::setOnAudioFrame; break;
+        case Media::Video:      data = &video_data_;      setter = &rtms::Client::setOnVideoFrame; break;
+        case Media::Deskshare:  data = &ds_data_;         setter = &rtms::Client::setOnDeskshareFrame; break;
+        case Media::Transcript: data = &transcript_data_; setter = &rtms::Client::setOnTranscriptFrame; break;
+    }
+
+    RingChannel ring = rings_[static_cast<size_t>(media)];
+    ((*client_).*setter)([this, channel = *data, ring](const rtms::MediaFrameView& view) {
+        if (ring.ring && ring.ring->write(view.data(), view.size(), view.timestamp(), view.userId()) && ring.notify) {
+            notifyRing(ring);
+        }
+        if (channel.queue) deliver(channel, view.retain());
     });
+}
+
+void NodeClient::notifyRing(const RingChannel& ring) {
+    if (ring.notify_pending->exchange(true)) return;
+    auto pending = ring.notify_pending;
+    auto notify = [pending](Napi::Env, Napi::Function jsNotify) {
+        pending->store(false);
+        jsNotify.Call({});
+    };
+    if (ring.notify.NonBlockingCall(notify) != napi_ok) pending->store(false);
+}
+
+Napi::Value NodeClient::attachSharedRing(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::HandleScope scope(env);
+
+    if (info.Length() < 3 || !info[0].IsString() || !info[1].IsTypedArray() || !info[2].IsFunction()) {
+        Napi::TypeError::New(env, "Media name, Uint8Array and function expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Media media;
+    string name = info[0].As<Napi::String>().Utf8Value();
+    if (!parseMedia(name, media)) {
+        Napi::RangeError::New(env, "Unknown media type: " + name).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    // A view of a SharedArrayBuffer; its memory is written from the polling
+    // thread while this client holds a reference to it
+    Napi::Uint8Array memory = info[1].As<Napi::Uint8Array>();
+    RingChannel channel;
+    try {
+        channel.ring = make_shared<rtms::SharedRing>(memory.Data(), memory.ByteLength());
+    } catch (const std::invalid_argument& e) {
+        Napi::RangeError::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    channel.notify = Napi::ThreadSafeFunction::New(env, info[2].As<Napi::Function>(), "SharedRingNotify", 1, 1);
+    // Pending notifications must not keep the process alive on their own
+    channel.notify.Unref(env);
+    channel.notify_pending = make_shared<atomic<bool>>(false);
 
+    detachRing(media);
+    size_t index = static_cast<size_t>(media);
+    rings_[index] = channel;
+    ring_memory_[index] = Napi::Persistent(static_cast<Napi::Object>(memory));
+    installFrameSink(media);
     return Napi::Boolean::New(env, true);
 }
 
-Napi::Value NodeClient::setOnAudioData(const Napi::CallbackInfo& info) {
+// A ring in a named shared-memory segment, for worker processes to attach
+// with ShmRingReader. Returns the segment's name; without one, the name is
+// derived from the stream id.
+Napi::Value NodeClient::attachShmRing(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
 
-    if (info.Length() < 1 || !info[0].IsFunction()) {
-        Napi::TypeError::New(env, "Function argument expected").ThrowAsJavaScriptException();
+    if (info.Length() < 3 || !info[0].IsString() || !info[1].IsString() || !info[2].IsNumber()) {
+        Napi::TypeError::New(env, "Media name, segment name and size expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Media media;
+    string media_name = info[0].As<Napi::String>().Utf8Value();
+    if (!parseMedia(media_name, media)) {
+        Napi::RangeError::New(env, "Unknown media type: " + media_name).ThrowAsJavaScriptException();
         return env.Null();
     }
+    string name = info[1].As<Napi::String>().Utf8Value();
+    if (name.empty()) {
+        string stream_id = client_ ? client_->streamId() : "";
+        if (stream_id.empty()) {
+            Napi::Error::New(env, "A segment name is needed until the client has joined").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        name = rtms::ShmRing::nameFor(stream_id, media);
+    }
+    double bytes = info[2].As<Napi::Number>().DoubleValue();
 
-    Napi::Function callback = info[0].As<Napi::Function>();
-    
-    if (tsfn_audio_data_) {
-        tsfn_audio_data_.Release();
+    RingChannel channel;
+    try {
+        if (bytes < 0 || bytes > static_cast<double>(rtms::SharedRing::kMaxCapacity)) {
+            throw std::invalid_argument("Ring size must be a power of two from 4 KiB to 1 GiB");
+        }
+        auto shm = make_shared<rtms::ShmRing>(name, static_cast<size_t>(bytes));
+        // Writes go through the ring; the segment lives as long as the channel
+        channel.ring = shared_ptr<rtms::SharedRing>(shm, &shm->ring());
+    } catch (const std::invalid_argument& e) {
+        Napi::RangeError::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (const rtms::Exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
     }
 
-    tsfn_audio_data_ = Napi::ThreadSafeFunction::New(
-        env, callback, "AudioDataCallback", 0, 1
-    );
+    detachRing(media);
+    rings_[static_cast<size_t>(media)] = channel;
+    installFrameSink(media);
+    return Napi::String::New(env, name);
+}
 
-    client_->setOnAudioData([this](const vector<uint8_t>& data, uint64_t timestamp, const rtms::Metadata& metadata) {
-        auto callback = [data, timestamp, metadata]
-                       (Napi::Env env, Napi::Function jsCallback) {
-            Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::Copy(env, data.data(), data.size());
-            jsCallback.Call({buffer, Napi::Number::New(env, data.size()), Napi::Number::New(env, timestamp), buildMetadataObj(env, metadata)});
-        };
-        tsfn_audio_data_.BlockingCall(callback);
-    });
+Napi::Value NodeClient::detachSharedRing(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::HandleScope scope(env);
 
-    return Napi::Boolean::New(env, true);
+    Media media;
+    if (info.Length() < 1 || !info[0].IsString() || !parseMedia(info[0].As<Napi::String>().Utf8Value(), media)) {
+        Napi::TypeError::New(env, "Media name expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    bool attached = static_cast<bool>(rings_[static_cast<size_t>(media)].ring);
+    detachRing(media);
+    installFrameSink(media);
+    return Napi::Boolean::New(env, attached);
 }
 
-Napi::Value NodeClient::setOnVideoData(const Napi::CallbackInfo& info) {
+// After close() the polling thread no longer writes to the ring's memory,
+// even through a frame callback that still holds it, so the SAB can go
+void NodeClient::detachRing(Media media) {
+    size_t index = static_cast<size_t>(media);
+    RingChannel& channel = rings_[index];
+    if (!channel.ring) return;
+    channel.ring->close();
+    if (channel.notify) channel.notify.Release();
+    channel = RingChannel();
+    ring_memory_[index].Reset();
+}
+
+Napi::Value NodeClient::setOnBatch(const Napi::CallbackInfo& info, BatchChannel& channel, Media media, const char* name,
+                                   void (rtms::Client::*setter)(rtms::Client::MediaBatchFn)) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
 
@@ -532,59 +985,110 @@ Napi::Value NodeClient::setOnVideoData(const Napi::CallbackInfo& info) {
         return env.Null();
     }
 
-    Napi::Function callback = info[0].As<Napi::Function>();
-    
-    if (tsfn_video_data_) {
-        tsfn_video_data_.Release();
-    }
-
-    tsfn_video_data_ = Napi::ThreadSafeFunction::New(
-        env, callback, "VideoDataCallback", 0, 1
-    );
+    openChannel(env, info[0].As<Napi::Function>(), channel, media, name, batchArgs);
 
-    client_->setOnVideoData([this](const vector<uint8_t>& data, uint64_t timestamp, const rtms::Metadata& metadata) {
-        auto callback = [data, timestamp, metadata]
-                       (Napi::Env env, Napi::Function jsCallback) {
-            Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::Copy(env, data.data(), data.size());
-            jsCallback.Call({buffer, Napi::Number::New(env, data.size()), Napi::Number::New(env, timestamp), buildMetadataObj(env, metadata)});
-        };
-        tsfn_video_data_.BlockingCall(callback);
+    // One JS call per poll: the frames are moved out of the core's batch, not copied
+    ((*client_).*setter)([this, channel](vector<rtms::MediaFrame>& frames) {
+        deliver(channel, std::move(frames));
     });
 
     return Napi::Boolean::New(env, true);
 }
 
-Napi::Value NodeClient::setOnTranscriptData(const Napi::CallbackInfo& info) {
+Napi::Value NodeClient::setDeliveryQueue(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
 
-    if (info.Length() < 1 || !info[0].IsFunction()) {
-        Napi::TypeError::New(env, "Function argument expected").ThrowAsJavaScriptException();
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "Object argument expected").ThrowAsJavaScriptException();
         return env.Null();
     }
+    Napi::Object options = info[0].As<Napi::Object>();
 
-    Napi::Function callback = info[0].As<Napi::Function>();
-    
-    if (tsfn_transcript_data_) {
-        tsfn_transcript_data_.Release();
+    rtms::DeliveryPolicy policy = delivery_policy_;
+    auto depth = delivery_depth_;
+    try {
+        if (options.Has("policy")) {
+            Napi::Value value = options.Get("policy");
+            if (!value.IsString()) throw std::invalid_argument("policy must be a string");
+            policy = rtms::parseDeliveryPolicy(value.As<Napi::String>().Utf8Value());
+        }
+        for (size_t i = 0; i < depth.size(); ++i) {
+            const char* key = rtms::ClientMetrics::name(static_cast<Media>(i));
+            if (!options.Has(key)) continue;
+            Napi::Value value = options.Get(key);
+            double frames = value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : -1;
+            if (!(frames >= 0) || frames != floor(frames)) {
+                throw std::invalid_argument(string(key) + " must be a non-negative integer");
+            }
+            depth[i] = static_cast<size_t>(frames);
+        }
+    } catch (const std::invalid_argument& e) {
+        Napi::RangeError::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
     }
 
-    tsfn_transcript_data_ = Napi::ThreadSafeFunction::New(
-        env, callback, "TranscriptDataCallback", 0, 1
-    );
-
-    client_->setOnTranscriptData([this](const vector<uint8_t>& data, uint64_t timestamp, const rtms::Metadata& metadata) {
-        auto callback = [data, timestamp, metadata]
-                       (Napi::Env env, Napi::Function jsCallback) {
-            Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::Copy(env, data.data(), data.size());
-            jsCallback.Call({buffer, Napi::Number::New(env, data.size()), Napi::Number::New(env, timestamp), buildMetadataObj(env, metadata)});
-        };
-        tsfn_transcript_data_.BlockingCall(callback);
+    delivery_policy_ = policy;
+    delivery_depth_ = depth;
+    forEachChannel([this](auto& channel) {
+        if (!channel.queue) return;
+        channel.queue->configure(delivery_depth_[static_cast<size_t>(channel.media)],
+                                 rtms::effectivePolicy(delivery_policy_, channel.media));
     });
+    return Napi::Boolean::New(env, true);
+}
+
+// Backpressure from a consumer such as a Readable stream: while a media type
+// is paused its queues stop scheduling drains and fill up to their depth,
+// after which they drop frames. A paused queue never makes the poll thread
+// wait, even under "block": that thread may be an EventLoop shared with other
+// clients, and nothing drains the queue until the stream is read.
+Napi::Value NodeClient::setDeliveryPaused(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::HandleScope scope(env);
+
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsBoolean()) {
+        Napi::TypeError::New(env, "Media name and boolean expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
 
+    Media media;
+    string name = info[0].As<Napi::String>().Utf8Value();
+    bool paused = info[1].As<Napi::Boolean>().Value();
+    if (!parseMedia(name, media)) {
+        Napi::RangeError::New(env, "Unknown media type: " + name).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    size_t index = static_cast<size_t>(media);
+
+    delivery_paused_[index] = paused;
+    forEachChannel([this, index, paused](auto& channel) {
+        if (!channel.queue || static_cast<size_t>(channel.media) != index) return;
+        if (paused) {
+            channel.queue->pause();
+        } else if (channel.queue->resume()) {
+            scheduleDrain(channel);
+        }
+    });
     return Napi::Boolean::New(env, true);
 }
 
+Napi::Value NodeClient::setOnDeskshareBatch(const Napi::CallbackInfo& info) {
+    return setOnBatch(info, ds_batch_, Media::Deskshare, "DeskshareBatchCallback", &rtms::Client::setOnDeskshareBatch);
+}
+
+Napi::Value NodeClient::setOnAudioBatch(const Napi::CallbackInfo& info) {
+    return setOnBatch(info, audio_batch_, Media::Audio, "AudioBatchCallback", &rtms::Client::setOnAudioBatch);
+}
+
+Napi::Value NodeClient::setOnVideoBatch(const Napi::CallbackInfo& info) {
+    return setOnBatch(info, video_batch_, Media::Video, "VideoBatchCallback", &rtms::Client::setOnVideoBatch);
+}
+
+Napi::Value NodeClient::setOnTranscriptBatch(const Napi::CallbackInfo& info) {
+    return setOnBatch(info, transcript_batch_, Media::Transcript, "TranscriptBatchCallback", &rtms::Client::setOnTranscriptBatch);
+}
+
 Napi::Value NodeClient::setOnLeave(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
@@ -606,8 +1110,10 @@ Napi::Value NodeClient::setOnLeave(const Napi::CallbackInfo& info) {
 
     client_->setOnLeave([this](int reason) {
         auto callback = [reason](Napi::Env env, Napi::Function jsCallback) {
+            RTMS_TRACE_SCOPE("node.js_callback");
             jsCallback.Call({Napi::Number::New(env, reason)});
         };
+        RTMS_TRACE_SCOPE("node.tsfn_call");
         tsfn_leave_.BlockingCall(callback);
     });
 
@@ -635,8 +1141,10 @@ Napi::Value NodeClient::setOnEventEx(const Napi::CallbackInfo& info) {
 
     client_->setOnEventEx([this](const string& eventData) {
         auto callback = [eventData](Napi::Env env, Napi::Function jsCallback) {
+            RTMS_TRACE_SCOPE("node.js_callback");
             jsCallback.Call({Napi::String::New(env, eventData)});
         };
+        RTMS_TRACE_SCOPE("node.tsfn_call");
         tsfn_event_ex_.BlockingCall(callback);
     });
 
@@ -733,12 +1241,14 @@ Napi::Value NodeClient::setOnParticipantVideo(const Napi::CallbackInfo& info) {
 
     client_->setOnParticipantVideo([this](const std::vector<int>& users, bool is_on) {
         auto callback = [users, is_on](Napi::Env env, Napi::Function jsCallback) {
+            RTMS_TRACE_SCOPE("node.js_callback");
             Napi::Array arr = Napi::Array::New(env, users.size());
             for (size_t i = 0; i < users.size(); i++) {
                 arr.Set(static_cast<uint32_t>(i), Napi::Number::New(env, users[i]));
             }
             jsCallback.Call({arr, Napi::Boolean::New(env, is_on)});
         };
+        RTMS_TRACE_SCOPE("node.tsfn_call");
         tsfn_participant_video_.BlockingCall(callback);
     });
 
@@ -766,12 +1276,14 @@ Napi::Value NodeClient::setOnVideoSubscribed(const Napi::CallbackInfo& info) {
 
     client_->setOnVideoSubscribed([this](int user_id, int status, const std::string& error) {
         auto callback = [user_id, status, error](Napi::Env env, Napi::Function jsCallback) {
+            RTMS_TRACE_SCOPE("node.js_callback");
             jsCallback.Call({
                 Napi::Number::New(env, user_id),
                 Napi::Number::New(env, status),
                 Napi::String::New(env, error)
             });
         };
+        RTMS_TRACE_SCOPE("node.tsfn_call");
         tsfn_video_subscribed_.BlockingCall(callback);
     });
 
@@ -824,26 +1336,44 @@ Napi::Value NodeClient::enableTranscript(const Napi::CallbackInfo& info) {
 }
 
 NodeClient::NodeClient(const Napi::CallbackInfo& info)
-    : Napi::ObjectWrap<NodeClient>(info) {
+    : Napi::ObjectWrap<NodeClient>(info), js_thread_(this_thread::get_id()) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
 
+    delivery_depth_.fill(rtms::DeliveryQueue<rtms::MediaFrame>::kDefaultDepth);
+
+    // The SDK handle is allocated by join(), on whichever thread joins: the JS
+    // thread, or an EventLoop's thread when the client is added to one.
     try {
-        client_ = make_unique<rtms::Client>();
+        client_ = make_shared<rtms::Client>(true);
     } catch (const rtms::Exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
     }
 }
 
 NodeClient::~NodeClient() {
+    // Release a loop thread waiting on a full queue, since nothing will drain
+    // it now, then stop the loop from polling us before the thread-safe
+    // functions go away
+    forEachChannel([](auto& channel) {
+        if (channel.queue) channel.queue->close();
+    });
+    for (auto& ring : rings_) {
+        if (ring.ring) ring.ring->close();
+    }
+    if (loop_ && loop_session_) loop_->remove(loop_session_);
+
     if (tsfn_join_confirm_) tsfn_join_confirm_.Release();
     if (tsfn_session_update_) tsfn_session_update_.Release();
     if (tsfn_user_update_) tsfn_user_update_.Release();
-    if (tsfn_audio_data_) tsfn_audio_data_.Release();
-    if (tsfn_video_data_) tsfn_video_data_.Release();
-    if (tsfn_transcript_data_) tsfn_transcript_data_.Release();
     if (tsfn_leave_) tsfn_leave_.Release();
     if (tsfn_event_ex_) tsfn_event_ex_.Release();
+    forEachChannel([](auto& channel) {
+        if (channel.tsfn) channel.tsfn.Release();
+    });
+    for (auto& ring : rings_) {
+        if (ring.notify) ring.notify.Release();
+    }
 }
 
 Napi::Value NodeClient::initialize(const Napi::CallbackInfo& info) {
@@ -930,6 +1460,12 @@ Napi::Object NodeClient::init(Napi::Env env, Napi::Object exports) {
         InstanceMethod("release", &NodeClient::release),
         InstanceMethod("uuid", &NodeClient::uuid),
         InstanceMethod("streamId", &NodeClient::streamId),
+        InstanceMethod("getStats", &NodeClient::getStats),
+        InstanceMethod("setDeliveryQueue", &NodeClient::setDeliveryQueue),
+        InstanceMethod("setDeliveryPaused", &NodeClient::setDeliveryPaused),
+        InstanceMethod("attachSharedRing", &NodeClient::attachSharedRing),
+        InstanceMethod("attachShmRing", &NodeClient::attachShmRing),
+        InstanceMethod("detachSharedRing", &NodeClient::detachSharedRing),
         InstanceMethod("enableAudio", &NodeClient::enableAudio),
         InstanceMethod("enableVideo", &NodeClient::enableVideo),
         InstanceMethod("enableTranscript", &NodeClient::enableTranscript),
@@ -947,6 +1483,10 @@ Napi::Object NodeClient::init(Napi::Env env, Napi::Object exports) {
         InstanceMethod("onTranscriptData", &NodeClient::setOnTranscriptData),
         InstanceMethod("onLeave", &NodeClient::setOnLeave),
         InstanceMethod("onEventEx", &NodeClient::setOnEventEx),
+        InstanceMethod("onDeskshareBatch", &NodeClient::setOnDeskshareBatch),
+        InstanceMethod("onAudioBatch", &NodeClient::setOnAudioBatch),
+        InstanceMethod("onVideoBatch", &NodeClient::setOnVideoBatch),
+        InstanceMethod("onTranscriptBatch", &NodeClient::setOnTranscriptBatch),
         InstanceMethod("subscribeEvent", &NodeClient::subscribeEvent),
         InstanceMethod("unsubscribeEvent", &NodeClient::unsubscribeEvent),
         InstanceMethod("subscribeVideo", &NodeClient::subscribeVideo),
@@ -1249,8 +1789,366 @@ Napi::Object NodeClient::init(Napi::Env env, Napi::Object exports) {
     return exports;
 }
 
+// ============================================================================
+// EventLoop
+// ============================================================================
+
+/**
+ * JS handle to an rtms::EventLoop running on its own thread. Clients handed to
+ * add() are joined, polled and released on that thread, so no timer runs on
+ * the JS thread; callbacks still arrive through each client's thread-safe
+ * functions.
+ */
+class NodeEventLoop : public Napi::ObjectWrap<NodeEventLoop> {
+public:
+    static Napi::Object init(Napi::Env env, Napi::Object exports);
+    NodeEventLoop(const Napi::CallbackInfo& info);
+    ~NodeEventLoop();
+
+private:
+    Napi::Value add(const Napi::CallbackInfo& info);
+    Napi::Value remove(const Napi::CallbackInfo& info);
+    Napi::Value pollInterval(const Napi::CallbackInfo& info);
+    Napi::Value stop(const Napi::CallbackInfo& info);
+    Napi::Value clientCount(const Napi::CallbackInfo& info);
+    Napi::Value running(const Napi::CallbackInfo& info);
+
+    shared_ptr<rtms::EventLoop> loop_;
+};
+
+NodeEventLoop::NodeEventLoop(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<NodeEventLoop>(info) {
+    Napi::Env env = info.Env();
+    Napi::HandleScope scope(env);
+
+    int poll_interval = 10;
+    string name = "";
+    string mode = "";
+    if (info.Length() > 0 && info[0].IsNumber()) {
+        poll_interval = info[0].As<Napi::Number>().Int32Value();
+    }
+    if (info.Length() > 1 && info[1].IsString()) {
+        name = info[1].As<Napi::String>().Utf8Value();
+    }
+    if (info.Length() > 2 && info[2].IsString()) {
+        mode = info[2].As<Napi::String>().Utf8Value();
+    }
+
+    try {
+        // Without a mode every client is polled at the fixed interval
+        rtms::PollPolicy policy = mode.empty()
+            ? rtms::PollPolicy::fixed(chrono::milliseconds(poll_interval))
+            : rtms::PollPolicy::forMode(rtms::parsePollMode(mode));
+        loop_ = make_shared<rtms::EventLoop>(policy, name);
+        loop_->start();
+    } catch (const std::invalid_argument& e) {
+        Napi::RangeError::New(env, e.what()).ThrowAsJavaScriptException();
+    } catch (const rtms::Exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+    }
+}
+
+NodeEventLoop::~NodeEventLoop() {
+    if (loop_) {
+        loop_->stop();
+        loop_->join();
+    }
+}
+
+Napi::Value NodeEventLoop::add(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::HandleScope scope(env);
+
+    if (info.Length() < 5 || !info[0].IsObject() || !info[1].IsString() || !info[2].IsString() ||
+        !info[3].IsString() || !info[4].IsString()) {
+        Napi::TypeError::New(env, "Expected (client, meetingUuid, streamId, signature, serverUrls[, timeout])").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    NodeClient* client = NodeClient::Unwrap(info[0].As<Napi::Object>());
+    if (!client || !client->client_) {
+        Napi::TypeError::New(env, "First argument must be an RTMS Client").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (client->loop_session_) {
+        Napi::Error::New(env, "Client already belongs to an EventLoop").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    int timeout = -1;
+    if (info.Length() > 5 && info[5].IsNumber()) {
+        timeout = info[5].As<Napi::Number>().Int32Value();
+    }
+
+    try {
+        auto session = make_shared<rtms::ClientSession>(
+            client->client_,
+            info[1].As<Napi::String>().Utf8Value(),
+            info[2].As<Napi::String>().Utf8Value(),
+            info[3].As<Napi::String>().Utf8Value(),
+            info[4].As<Napi::String>().Utf8Value(),
+            timeout);
+        // join() already returned true to JS; a failure on the loop thread
+        // arrives through onJoinConfirm like one the SDK reports
+        session->setOnJoinFailed([client](int reason) { client->reportJoinConfirm(reason); });
+        loop_->add(session);
+        client->loop_ = loop_;
+        client->loop_session_ = std::move(session);
+        return Napi::Boolean::New(env, true);
+    } catch (const rtms::Exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+Napi::Value NodeEventLoop::remove(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::HandleScope scope(env);
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "Client argument expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    NodeClient* client = NodeClient::Unwrap(info[0].As<Napi::Object>());
+    if (!client || client->loop_ != loop_ || !client->loop_session_) {
+        return Napi::Boolean::New(env, false);
+    }
+
+    // Blocks until the loop thread has released the client. The loop waits
+    // on the JS thread only while a full "block" delivery queue times out,
+    // so this cannot deadlock.
+    bool removed = loop_->remove(client->loop_session_);
+    client->loop_session_.reset();
+    client->loop_.reset();
+    return Napi::Boolean::New(env, removed);
+}
+
+Napi::Value NodeEventLoop::pollInterval(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "Client argument expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    NodeClient* client = NodeClient::Unwrap(info[0].As<Napi::Object>());
+    if (!client || client->loop_ != loop_ || !client->loop_session_) {
+        return env.Null();
+    }
+
+    // Milliseconds, fractional while the loop is polling at sub-millisecond rates
+    auto interval = chrono::duration<double, milli>(client->loop_session_->pollInterval());
+    return Napi::Number::New(env, interval.count());
+}
+
+Napi::Value NodeEventLoop::stop(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    loop_->stop();
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value NodeEventLoop::clientCount(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), static_cast<double>(loop_->clientCount()));
+}
+
+Napi::Value NodeEventLoop::running(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), loop_->running());
+}
+
+Napi::Object NodeEventLoop::init(Napi::Env env, Napi::Object exports) {
+    Napi::HandleScope scope(env);
+
+    Napi::Function func = DefineClass(env, "EventLoop", {
+        InstanceMethod("add", &NodeEventLoop::add),
+        InstanceMethod("remove", &NodeEventLoop::remove),
+        InstanceMethod("pollInterval", &NodeEventLoop::pollInterval),
+        InstanceMethod("stop", &NodeEventLoop::stop),
+        InstanceMethod("clientCount", &NodeEventLoop::clientCount),
+        InstanceMethod("running", &NodeEventLoop::running),
+    });
+
+    exports.Set("EventLoop", func);
+    return exports;
+}
+
+// ============================================================================
+// Shared-memory ring reader
+// ============================================================================
+
+/**
+ * JS handle to an rtms::ShmRing::Reader, for a worker process to follow a
+ * ring that another process's client writes. Frames are copied out of the
+ * ring into a Buffer, which is checked against the writer before it is
+ * returned, so a lapped read is never handed to JS.
+ */
+class NodeShmRingReader : public Napi::ObjectWrap<NodeShmRingReader> {
+public:
+    static Napi::Object init(Napi::Env env, Napi::Object exports);
+    NodeShmRingReader(const Napi::CallbackInfo& info);
+
+private:
+    Napi::Value tryRead(const Napi::CallbackInfo& info);
+    Napi::Value wait(const Napi::CallbackInfo& info);
+    Napi::Value closed(const Napi::CallbackInfo& info);
+    Napi::Value lapped(const Napi::CallbackInfo& info);
+    Napi::Value lost(const Napi::CallbackInfo& info);
+
+    unique_ptr<rtms::ShmRing::Reader> reader_;
+};
+
+NodeShmRingReader::NodeShmRingReader(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<NodeShmRingReader>(info) {
+    Napi::Env env = info.Env();
+    Napi::HandleScope scope(env);
+
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Segment name expected").ThrowAsJavaScriptException();
+        return;
+    }
+    try {
+        reader_ = make_unique<rtms::ShmRing::Reader>(info[0].As<Napi::String>().Utf8Value());
+    } catch (const std::invalid_argument& e) {
+        Napi::RangeError::New(env, e.what()).ThrowAsJavaScriptException();
+    } catch (const rtms::Exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+    }
+}
+
+Napi::Value NodeShmRingReader::tryRead(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    rtms::SharedRing::Reader::View view;
+    while (reader_->peek(view)) {
+        Napi::Buffer<uint8_t> data = Napi::Buffer<uint8_t>::Copy(env, view.data, view.size);
+        if (!reader_->consume()) continue;
+
+        Napi::Object frame = Napi::Object::New(env);
+        frame.Set("sequence", Napi::Number::New(env, static_cast<double>(view.sequence)));
+        frame.Set("userId", Napi::Number::New(env, view.user_id));
+        frame.Set("timestamp", Napi::Number::New(env, static_cast<double>(view.timestamp)));
+        frame.Set("data", data);
+        return frame;
+    }
+    return env.Null();
+}
+
+// Blocks the calling thread, as Atomics.wait() does for SharedRingReader
+Napi::Value NodeShmRingReader::wait(const Napi::CallbackInfo& info) {
+    double timeout = info.Length() > 0 && info[0].IsNumber() ? info[0].As<Napi::Number>().DoubleValue() : 0;
+    bool ready = reader_->wait(chrono::milliseconds(static_cast<int64_t>(max(0.0, timeout))));
+    return Napi::Boolean::New(info.Env(), ready);
+}
+
+Napi::Value NodeShmRingReader::closed(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), reader_->closed());
+}
+
+Napi::Value NodeShmRingReader::lapped(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), static_cast<double>(reader_->lapped()));
+}
+
+Napi::Value NodeShmRingReader::lost(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), static_cast<double>(reader_->lost()));
+}
+
+Napi::Object NodeShmRingReader::init(Napi::Env env, Napi::Object exports) {
+    Napi::HandleScope scope(env);
+
+    Napi::Function func = DefineClass(env, "ShmRingReader", {
+        InstanceMethod("tryRead", &NodeShmRingReader::tryRead),
+        InstanceMethod("wait", &NodeShmRingReader::wait),
+        InstanceMethod("closed", &NodeShmRingReader::closed),
+        InstanceMethod("lapped", &NodeShmRingReader::lapped),
+        InstanceMethod("lost", &NodeShmRingReader::lost),
+    });
+
+    exports.Set("ShmRingReader", func);
+    return exports;
+}
+
+// ============================================================================
+// Prometheus metrics
+// ============================================================================
+
+// One process-wide listener; scrapes run on its own thread, never the JS thread
+static unique_ptr<rtms::MetricsServer> g_metrics_server;
+
+static Napi::Value renderMetrics(const Napi::CallbackInfo& info) {
+    return Napi::String::New(info.Env(), rtms::renderPrometheus());
+}
+
+static Napi::Value startMetricsServer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    uint16_t port = rtms::MetricsServer::kDefaultPort;
+    string host = "127.0.0.1";
+    if (info.Length() > 0 && info[0].IsNumber()) {
+        int value = info[0].As<Napi::Number>().Int32Value();
+        if (value < 0 || value > 65535) {
+            Napi::RangeError::New(env, "port must be between 0 and 65535").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        port = static_cast<uint16_t>(value);
+    }
+    if (info.Length() > 1 && info[1].IsString()) {
+        host = info[1].As<Napi::String>();
+    }
+
+    try {
+        if (g_metrics_server) g_metrics_server->stop();
+        g_metrics_server = make_unique<rtms::MetricsServer>(host, port);
+        g_metrics_server->start();
+        return Napi::Number::New(env, g_metrics_server->port());
+    } catch (const rtms::Exception& e) {
+        g_metrics_server.reset();
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+static Napi::Value stopMetricsServer(const Napi::CallbackInfo& info) {
+    bool was_running = g_metrics_server && g_metrics_server->running();
+    g_metrics_server.reset();
+    return Napi::Boolean::New(info.Env(), was_running);
+}
+
+// ============================================================================
+// Tracing (RTMS_TRACE builds)
+// ============================================================================
+
+// Returns the Chrome trace JSON, or writes it to the given path and returns true
+static Napi::Value dumpTrace(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() > 0 && info[0].IsString()) {
+        try {
+            rtms::trace::writeChromeJson(info[0].As<Napi::String>());
+            return Napi::Boolean::New(env, true);
+        } catch (const rtms::Exception& e) {
+            Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+            return env.Null();
+        }
+    }
+    return Napi::String::New(env, rtms::trace::chromeJson());
+}
+
+static Napi::Value clearTrace(const Napi::CallbackInfo& info) {
+    rtms::trace::clear();
+    return info.Env().Undefined();
+}
+
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
-    return NodeClient::init(env, exports);
+    NodeClient::init(env, exports);
+    NodeEventLoop::init(env, exports);
+    NodeShmRingReader::init(env, exports);
+
+    exports.Set("renderMetrics", Napi::Function::New(env, renderMetrics, "renderMetrics"));
+    exports.Set("startMetricsServer", Napi::Function::New(env, startMetricsServer, "startMetricsServer"));
+    exports.Set("stopMetricsServer", Napi::Function::New(env, stopMetricsServer, "stopMetricsServer"));
+
+    exports.Set("TRACE_ENABLED", Napi::Boolean::New(env, rtms::trace::enabled()));
+    exports.Set("dumpTrace", Napi::Function::New(env, dumpTrace, "dumpTrace"));
+    exports.Set("clearTrace", Napi::Function::New(env, clearTrace, "clearTrace"));
+    return exports;
 }
 
 NODE_API_MODULE(rtms, Init)
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "notifier.h"
+#include "rtms.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+namespace rtms {
+
+#ifdef _WIN32
+
+Notifier::Notifier() = default;
+Notifier::~Notifier() = default;
+void Notifier::notify() {}
+bool Notifier::clear() { return false; }
+
+#else
+
+#ifndef __linux__
+namespace {
+
+void setNonBlocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+
+} // namespace
+#endif
+
+Notifier::Notifier() {
+#ifdef __linux__
+    read_fd_ = write_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (read_fd_ < 0) {
+        throw Exception(RTMS_SDK_FAILURE, std::string("Notifier: eventfd failed: ") + std::strerror(errno));
+    }
+#else
+    int fds[2];
+    if (pipe(fds) != 0) {
+        throw Exception(RTMS_SDK_FAILURE, std::string("Notifier: pipe failed: ") + std::strerror(errno));
+    }
+    read_fd_ = fds[0];
+    write_fd_ = fds[1];
+    setNonBlocking(read_fd_);
+    setNonBlocking(write_fd_);
+#endif
+}
+
+Notifier::~Notifier() {
+    close(read_fd_);
+    if (write_fd_ != read_fd_) close(write_fd_);
+}
+
+void Notifier::notify() {
+    // Only the first notify() since the last clear() needs a system call
+    if (pending_.exchange(true, std::memory_order_acq_rel)) return;
+    uint64_t one = 1;
+    // A full pipe or a saturated counter is already readable
+    ssize_t written;
+    do {
+        written = write(write_fd_, &one, write_fd_ == read_fd_ ? sizeof(one) : 1);
+    } while (written < 0 && errno == EINTR);
+}
+
+bool Notifier::clear() {
+    // Clear the flag first: a notify() from here on writes again
+    bool was_pending = pending_.exchange(false, std::memory_order_acq_rel);
+    uint64_t buffer[8];
+    while (true) {
+        ssize_t n = read(read_fd_, buffer, sizeof(buffer));
+        if (n > 0 && read_fd_ != write_fd_ && n == static_cast<ssize_t>(sizeof(buffer))) continue;
+        if (n < 0 && errno == EINTR) continue;
+        break;
+    }
+    return was_pending;
+}
+
+#endif // _WIN32
+
+} // namespace rtms
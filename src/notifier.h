@@ -0,0 +1,48 @@
+#ifndef RTMS_NOTIFIER_H
+#define RTMS_NOTIFIER_H
+
+#include <atomic>
+
+namespace rtms {
+
+/**
+ * A file descriptor that becomes readable when notify() is called, so an
+ * event loop that waits on descriptors (asyncio's add_reader(), libuv's
+ * uv_poll) can be woken by a native thread instead of polling on a timer.
+ *
+ * Notifications coalesce: any number of notify() calls before the consumer
+ * calls clear() leave the descriptor readable once. A consumer should call
+ * clear() before looking for work, so that a notify() racing with it leaves
+ * the descriptor readable again rather than being lost.
+ *
+ * Backed by an eventfd on Linux and a non-blocking pipe on other POSIX
+ * systems. Windows has neither: fd() is -1 there, notify() and clear() do
+ * nothing, and callers fall back to polling.
+ */
+class Notifier {
+public:
+    /** Throws rtms::Exception if the descriptor cannot be created. */
+    Notifier();
+    ~Notifier();
+
+    Notifier(const Notifier&) = delete;
+    Notifier& operator=(const Notifier&) = delete;
+
+    /** The descriptor to wait on for readability; owned by the Notifier. */
+    int fd() const { return read_fd_; }
+
+    /** Make fd() readable. Safe from any thread; never blocks. */
+    void notify();
+
+    /** Make fd() unreadable again. Returns whether notify() had been called. */
+    bool clear();
+
+private:
+    int read_fd_ = -1;
+    int write_fd_ = -1;   // same as read_fd_ for an eventfd
+    std::atomic<bool> pending_{false};
+};
+
+} // namespace rtms
+
+#endif // RTMS_NOTIFIER_H
@@ -0,0 +1,53 @@
+#include "pcm.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RTMS_PCM_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define RTMS_PCM_NEON 1
+#endif
+
+namespace rtms {
+
+namespace {
+
+constexpr float kScale = 1.0f / 32768.0f;
+
+} // namespace
+
+void pcm16ToFloat(const void* src, float* dst, size_t samples) {
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    size_t i = 0;
+
+#if defined(RTMS_PCM_SSE2)
+    const __m128 scale = _mm_set1_ps(kScale);
+    for (; i + 8 <= samples; i += 8) {
+        __m128i s16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 2));
+        // Widen with sign extension: put each sample in the high half, shift down
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s16, s16), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s16, s16), 16);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+#elif defined(RTMS_PCM_NEON)
+    for (; i + 8 <= samples; i += 8) {
+        int16x8_t s16 = vreinterpretq_s16_u8(vld1q_u8(in + i * 2));
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s16)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s16)));
+        vst1q_f32(dst + i, vmulq_n_f32(lo, kScale));
+        vst1q_f32(dst + i + 4, vmulq_n_f32(hi, kScale));
+    }
+#endif
+
+    for (; i < samples; ++i) {
+        int16_t sample;
+        std::memcpy(&sample, in + i * 2, sizeof(sample));
+        dst[i] = static_cast<float>(sample) * kScale;
+    }
+}
+
+} // namespace rtms
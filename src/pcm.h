@@ -0,0 +1,21 @@
+#ifndef RTMS_PCM_H
+#define RTMS_PCM_H
+
+#include <cstddef>
+
+namespace rtms {
+
+/**
+ * Convert signed 16-bit PCM samples (host byte order, as L16 audio arrives)
+ * to float, scaled by 1/32768 so the result lies in [-1, 1).
+ *
+ * src may be unaligned, as SDK payloads are; dst is a float array. They
+ * must not overlap. Uses SSE2 on x86-64 and NEON on AArch64, eight samples
+ * at a time, with a scalar loop for the remainder and on other targets;
+ * every path gives identical results.
+ */
+void pcm16ToFloat(const void* src, float* dst, size_t samples);
+
+} // namespace rtms
+
+#endif // RTMS_PCM_H
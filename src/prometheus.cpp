@@ -0,0 +1,352 @@
+#include "prometheus.h"
+#include "event_loop.h"
+#include "rtms.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace rtms {
+
+namespace {
+
+// Upper bounds, in seconds, of the buckets exported for each latency histogram
+constexpr double kLatencyBounds[] = {1e-5, 5e-5, 1e-4, 5e-4, 1e-3, 5e-3, 0.01, 0.05, 0.1, 0.5, 1.0};
+
+std::string escapeLabel(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '"':  out += "\\\""; break;
+            case '\n': out += "\\n"; break;
+            default:   out += c;
+        }
+    }
+    return out;
+}
+
+std::string formatDouble(double value) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.9g", value);
+    return buf;
+}
+
+struct ClientRow {
+    std::string labels;   // meeting_uuid="...",stream_id="..."
+    ClientMetrics::Snapshot stats;
+};
+
+void writeHeader(std::ostream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << ' ' << help << '\n';
+    out << "# TYPE " << name << ' ' << type << '\n';
+}
+
+void writeHistogram(std::ostream& out, const char* name, const std::string& labels,
+                    const LatencyHistogram::Snapshot& snap) {
+    const std::string prefix = labels.empty() ? "" : labels + ",";
+    for (double bound : kLatencyBounds) {
+        uint64_t ns = static_cast<uint64_t>(bound * 1e9);
+        out << name << "_bucket{" << prefix << "le=\"" << formatDouble(bound) << "\"} "
+            << snap.countAtOrBelow(ns) << '\n';
+    }
+    out << name << "_bucket{" << prefix << "le=\"+Inf\"} " << snap.count << '\n';
+    const std::string braces = labels.empty() ? "" : "{" + labels + "}";
+    out << name << "_sum" << braces << ' ' << formatDouble(snap.sum_ns / 1e9) << '\n';
+    out << name << "_count" << braces << ' ' << snap.count << '\n';
+}
+
+} // namespace
+
+std::string renderPrometheus() {
+    std::vector<ClientRow> clients;
+    size_t live_clients = 0;
+
+    struct LoopRow {
+        std::string labels;
+        size_t clients;
+        bool running;
+        uint64_t polls;
+    };
+    std::vector<LoopRow> loops;
+
+    // Copy everything out under the registry lock, then format without it
+    MetricsRegistry::global().visit([&](const std::vector<const Client*>& live,
+                                        const std::vector<const EventLoop*>& live_loops) {
+        live_clients = live.size();
+        for (const Client* client : live) {
+            std::string uuid = client->uuid();
+            if (uuid.empty()) continue;   // not joined yet
+            clients.push_back({"meeting_uuid=\"" + escapeLabel(uuid) + "\",stream_id=\"" +
+                                   escapeLabel(client->streamId()) + "\"",
+                               client->metrics().snapshot()});
+        }
+        for (size_t i = 0; i < live_loops.size(); ++i) {
+            const EventLoop* loop = live_loops[i];
+            std::string name = loop->name().empty() ? "eventloop-" + std::to_string(i) : loop->name();
+            loops.push_back({"loop=\"" + escapeLabel(name) + "\"", loop->clientCount(),
+                             loop->running(), loop->pollCount()});
+        }
+    });
+
+    const uint64_t now_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+
+    std::ostringstream out;
+    writeHeader(out, "rtms_clients", "gauge", "Live RTMS client objects.");
+    out << "rtms_clients " << live_clients << '\n';
+
+    struct MediaCounter {
+        const char* name;
+        const char* help;
+        uint64_t ClientMetrics::MediaSnapshot::*field;
+    };
+    const MediaCounter counters[] = {
+        {"rtms_media_frames_total", "Media frames delivered.", &ClientMetrics::MediaSnapshot::frames},
+        {"rtms_media_bytes_total", "Media payload bytes delivered.", &ClientMetrics::MediaSnapshot::bytes},
+        {"rtms_media_empty_total", "Media deliveries dropped for a missing buffer or metadata.",
+         &ClientMetrics::MediaSnapshot::empty},
+        {"rtms_media_dropped_total", "Media frames dropped because the consumer fell behind.",
+         &ClientMetrics::MediaSnapshot::dropped},
+    };
+    for (const MediaCounter& counter : counters) {
+        writeHeader(out, counter.name, "counter", counter.help);
+        for (const ClientRow& row : clients) {
+            for (size_t m = 0; m < ClientMetrics::kMediaCount; ++m) {
+                out << counter.name << '{' << row.labels << ",media=\""
+                    << ClientMetrics::name(static_cast<ClientMetrics::Media>(m)) << "\"} "
+                    << row.stats.media[m].*counter.field << '\n';
+            }
+        }
+    }
+
+    writeHeader(out, "rtms_media_last_frame_age_seconds", "gauge",
+                "Seconds since the latest frame of each media type; absent until the first frame.");
+    for (const ClientRow& row : clients) {
+        for (size_t m = 0; m < ClientMetrics::kMediaCount; ++m) {
+            uint64_t last = row.stats.media[m].last_frame_ns;
+            if (last == 0) continue;
+            double age = now_ns > last ? (now_ns - last) / 1e9 : 0.0;
+            out << "rtms_media_last_frame_age_seconds{" << row.labels << ",media=\""
+                << ClientMetrics::name(static_cast<ClientMetrics::Media>(m)) << "\"} "
+                << formatDouble(age) << '\n';
+        }
+    }
+
+    writeHeader(out, "rtms_poll_duration_seconds", "histogram", "Time spent in Client::poll().");
+    for (const ClientRow& row : clients) {
+        writeHistogram(out, "rtms_poll_duration_seconds", row.labels, row.stats.poll);
+    }
+
+    writeHeader(out, "rtms_callback_duration_seconds", "histogram",
+                "Time spent in registered callbacks, by callback.");
+    for (const ClientRow& row : clients) {
+        for (size_t c = 0; c < ClientMetrics::kCallbackCount; ++c) {
+            const LatencyHistogram::Snapshot& snap = row.stats.callbacks[c];
+            if (snap.count == 0) continue;
+            std::string labels = row.labels + ",callback=\"" +
+                                 ClientMetrics::name(static_cast<ClientMetrics::Callback>(c)) + "\"";
+            writeHistogram(out, "rtms_callback_duration_seconds", labels, snap);
+        }
+    }
+
+    writeHeader(out, "rtms_eventloop_clients", "gauge", "Clients owned by each event loop.");
+    for (const LoopRow& loop : loops) {
+        out << "rtms_eventloop_clients{" << loop.labels << "} " << loop.clients << '\n';
+    }
+    writeHeader(out, "rtms_eventloop_running", "gauge", "1 while the event loop is running.");
+    for (const LoopRow& loop : loops) {
+        out << "rtms_eventloop_running{" << loop.labels << "} " << (loop.running ? 1 : 0) << '\n';
+    }
+    writeHeader(out, "rtms_eventloop_polls_total", "counter", "Client polls made by each event loop.");
+    for (const LoopRow& loop : loops) {
+        out << "rtms_eventloop_polls_total{" << loop.labels << "} " << loop.polls << '\n';
+    }
+
+    return out.str();
+}
+
+// ============================================================================
+// MetricsServer
+// ============================================================================
+
+MetricsServer::MetricsServer(std::string host, uint16_t port)
+    : host_(std::move(host)), port_(port) {}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+#ifdef _WIN32
+
+void MetricsServer::start() {
+    throw Exception(RTMS_SDK_FAILURE, "MetricsServer is not supported on Windows; serve renderPrometheus() instead");
+}
+
+void MetricsServer::stop() {}
+void MetricsServer::serve() {}
+void MetricsServer::handle(int) {}
+
+#else
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+void sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, kSendFlags);
+        if (n <= 0) return;   // client went away
+        sent += static_cast<size_t>(n);
+    }
+}
+
+void sendResponse(int fd, const char* status, const char* content_type, const std::string& body) {
+    std::string response = std::string("HTTP/1.1 ") + status + "\r\n" +
+                           "Content-Type: " + content_type + "\r\n" +
+                           "Content-Length: " + std::to_string(body.size()) + "\r\n" +
+                           "Connection: close\r\n\r\n" + body;
+    sendAll(fd, response);
+}
+
+} // namespace
+
+void MetricsServer::start() {
+    if (running() || thread_.joinable()) {
+        throw Exception(RTMS_SDK_INVALID_STATUS, "MetricsServer is already running");
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+    addrinfo* addrs = nullptr;
+    std::string service = std::to_string(port_);
+    int rc = ::getaddrinfo(host_.c_str(), service.c_str(), &hints, &addrs);
+    if (rc != 0) {
+        throw Exception(RTMS_SDK_FAILURE, "MetricsServer: cannot resolve " + host_ + ": " + gai_strerror(rc));
+    }
+
+    int fd = -1;
+    std::string error = "no usable address";
+    for (addrinfo* ai = addrs; ai; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) {
+            error = std::strerror(errno);
+            continue;
+        }
+        int yes = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+#ifdef SO_NOSIGPIPE
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &yes, sizeof(yes));
+#endif
+        if (::bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 && ::listen(fd, 16) == 0) break;
+        error = std::strerror(errno);
+        ::close(fd);
+        fd = -1;
+    }
+    ::freeaddrinfo(addrs);
+    if (fd < 0) {
+        throw Exception(RTMS_SDK_FAILURE, "MetricsServer: cannot listen on " + host_ + ":" +
+                                              std::to_string(port_) + ": " + error);
+    }
+
+    sockaddr_storage bound{};
+    socklen_t len = sizeof(bound);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&bound), &len) == 0) {
+        if (bound.ss_family == AF_INET) {
+            port_ = ntohs(reinterpret_cast<sockaddr_in*>(&bound)->sin_port);
+        } else if (bound.ss_family == AF_INET6) {
+            port_ = ntohs(reinterpret_cast<sockaddr_in6*>(&bound)->sin6_port);
+        }
+    }
+
+    listener_ = fd;
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this] { serve(); });
+}
+
+void MetricsServer::stop() {
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+        thread_.join();
+    }
+    if (listener_ >= 0) {
+        ::close(listener_);
+        listener_ = -1;
+    }
+}
+
+void MetricsServer::serve() {
+    // Wake up regularly to notice stop(); closing a socket another thread is
+    // blocked on does not reliably interrupt it.
+    while (running()) {
+        pollfd pfd{listener_, POLLIN, 0};
+        int ready = ::poll(&pfd, 1, 100);
+        if (ready <= 0 || !(pfd.revents & POLLIN)) continue;
+
+        int connection = ::accept(listener_, nullptr, nullptr);
+        if (connection < 0) continue;
+#ifdef SO_NOSIGPIPE
+        int yes = 1;
+        ::setsockopt(connection, SOL_SOCKET, SO_NOSIGPIPE, &yes, sizeof(yes));
+#endif
+        try {
+            handle(connection);
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: MetricsServer: " << e.what() << std::endl;
+        }
+        ::close(connection);
+    }
+}
+
+void MetricsServer::handle(int connection) {
+    // Only the request line matters; read until the end of the headers, a size
+    // cap or a short timeout so one slow client cannot stall the scraper.
+    std::string request;
+    char buf[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+        pollfd pfd{connection, POLLIN, 0};
+        if (::poll(&pfd, 1, 1000) <= 0) break;
+        ssize_t n = ::recv(connection, buf, sizeof(buf), 0);
+        if (n <= 0) break;
+        request.append(buf, static_cast<size_t>(n));
+    }
+
+    std::istringstream line(request.substr(0, request.find("\r\n")));
+    std::string method, target;
+    line >> method >> target;
+    std::string path = target.substr(0, target.find('?'));
+
+    if (method.empty()) return;
+    if (method != "GET") {
+        sendResponse(connection, "405 Method Not Allowed", "text/plain", "Method not allowed\n");
+    } else if (path != "/metrics") {
+        sendResponse(connection, "404 Not Found", "text/plain", "Not found\n");
+    } else {
+        sendResponse(connection, "200 OK", kPrometheusContentType, renderPrometheus());
+    }
+}
+
+#endif // _WIN32
+
+} // namespace rtms
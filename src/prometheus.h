@@ -0,0 +1,78 @@
+#ifndef RTMS_PROMETHEUS_H
+#define RTMS_PROMETHEUS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace rtms {
+
+/**
+ * Render every live Client and EventLoop in the Prometheus text exposition
+ * format (version 0.0.4), which OpenMetrics scrapers also accept.
+ *
+ * Families:
+ *   rtms_clients                              live Client objects
+ *   rtms_media_frames_total                   frames delivered, per client and media
+ *   rtms_media_bytes_total                    payload bytes delivered
+ *   rtms_media_empty_total                    empty deliveries dropped by the sinks
+ *   rtms_media_last_frame_age_seconds         time since the latest frame
+ *   rtms_poll_duration_seconds                histogram of Client::poll()
+ *   rtms_callback_duration_seconds            histogram per registered callback
+ *   rtms_eventloop_clients                    clients owned by each loop
+ *   rtms_eventloop_running                    1 while the loop is running
+ *   rtms_eventloop_polls_total                client polls made by each loop
+ *
+ * Clients are labelled with meeting_uuid and stream_id and only appear once
+ * they have joined. Safe to call from any thread.
+ */
+std::string renderPrometheus();
+
+/** Content-Type to serve renderPrometheus() output with. */
+constexpr const char* kPrometheusContentType = "text/plain; version=0.0.4; charset=utf-8";
+
+/**
+ * Minimal HTTP listener answering GET /metrics with renderPrometheus().
+ *
+ * Binds to localhost by default; put it behind a proxy rather than exposing it
+ * directly. Requests are served one at a time on the server's own thread.
+ */
+class MetricsServer {
+public:
+    static constexpr uint16_t kDefaultPort = 9464;
+
+    explicit MetricsServer(std::string host = "127.0.0.1", uint16_t port = kDefaultPort);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /**
+     * Bind, listen and start serving. Port 0 picks a free port, which port()
+     * then returns. Throws rtms::Exception if the socket cannot be set up or
+     * the server is already running.
+     */
+    void start();
+
+    /** Stop serving and close the socket. Safe to call more than once. */
+    void stop();
+
+    bool running() const { return running_.load(std::memory_order_acquire); }
+    uint16_t port() const { return port_; }
+    const std::string& host() const { return host_; }
+
+private:
+    void serve();
+    void handle(int connection);
+
+    const std::string host_;
+    uint16_t port_;
+    int listener_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+} // namespace rtms
+
+#endif // RTMS_PROMETHEUS_H
@@ -1,12 +1,232 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/functional.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 
 #include "rtms.h"
+#include "event_loop.h"
+#include "prometheus.h"
+#include "trace.h"
+#include "pcm.h"
+#include "callback_slot.h"
+#include "shm_ring.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
 
 namespace py = pybind11;
 using namespace rtms;
 
+// ============================================================================
+// Callback GIL
+// ============================================================================
+
+// Times a native callback has taken the GIL, for rtms.gil_acquisitions()
+static std::atomic<uint64_t> g_gil_acquisitions{0};
+
+#ifdef RTMS_TRACE
+// Takes the GIL for an SDK callback, recording the wait for it and the Python
+// call that follows as separate trace spans.
+class CallbackGil {
+public:
+    CallbackGil() {
+        RTMS_TRACE_BEGIN("python.gil_acquire");
+        acquire_.emplace();
+        RTMS_TRACE_END("python.gil_acquire");
+        g_gil_acquisitions.fetch_add(1, std::memory_order_relaxed);
+        RTMS_TRACE_BEGIN("python.callback");
+    }
+    ~CallbackGil() { RTMS_TRACE_END("python.callback"); }
+
+    CallbackGil(const CallbackGil&) = delete;
+    CallbackGil& operator=(const CallbackGil&) = delete;
+
+private:
+    std::optional<py::gil_scoped_acquire> acquire_;
+};
+#else
+class CallbackGil : public py::gil_scoped_acquire {
+public:
+    CallbackGil() { g_gil_acquisitions.fetch_add(1, std::memory_order_relaxed); }
+};
+#endif
+
+// ============================================================================
+// Metrics conversion
+// ============================================================================
+
+static py::dict histogramToDict(const LatencyHistogram::Snapshot& h) {
+    py::dict d;
+    d["count"] = h.count;
+    d["mean_us"] = h.meanNs() / 1000.0;
+    d["p50_us"] = h.percentileNs(0.50) / 1000.0;
+    d["p90_us"] = h.percentileNs(0.90) / 1000.0;
+    d["p99_us"] = h.percentileNs(0.99) / 1000.0;
+    d["max_us"] = h.max_ns / 1000.0;
+    return d;
+}
+
+static py::dict statsToDict(const ClientMetrics::Snapshot& stats) {
+    py::dict d;
+    for (size_t i = 0; i < ClientMetrics::kMediaCount; ++i) {
+        const auto& media = stats.media[i];
+        py::dict m;
+        m["frames"] = media.frames;
+        m["bytes"] = media.bytes;
+        m["empty"] = media.empty;
+        m["dropped"] = media.dropped;
+        d[ClientMetrics::name(static_cast<ClientMetrics::Media>(i))] = m;
+    }
+
+    d["poll"] = histogramToDict(stats.poll);
+
+    py::dict callbacks;
+    for (size_t i = 0; i < ClientMetrics::kCallbackCount; ++i) {
+        callbacks[ClientMetrics::name(static_cast<ClientMetrics::Callback>(i))] =
+            histogramToDict(stats.callbacks[i]);
+    }
+    d["callbacks"] = callbacks;
+    return d;
+}
+
+// ============================================================================
+// Frames
+// ============================================================================
+
+/**
+ * Media payload handed to the audio, video and deskshare data callbacks and
+ * to every batch callback.
+ *
+ * The payload stays in its pooled FrameBuffer and is exported read-only
+ * through the buffer protocol, so memoryview(frame), numpy.frombuffer(frame)
+ * and file or socket writes read the native memory without a copy. The
+ * buffer goes back to the pool when the Frame is collected, or earlier on
+ * release(), which is refused while a memoryview or array still uses it.
+ *
+ * Every read of the payload holds a pin, counted with the buffer exports, so
+ * on free-threaded builds a release() on another thread cannot free the
+ * buffer mid-read.
+ */
+class PyFrame {
+public:
+    PyFrame(FrameRef buffer, uint64_t timestamp, py::object metadata, std::optional<uint64_t> sequence)
+        : buffer_(std::move(buffer)), timestamp_(timestamp), metadata_(std::move(metadata)), sequence_(sequence) {}
+
+    // Copies the SDK's payload into the pool; it is only valid during the callback
+    static py::object from(const MediaFrameView& frame, py::object metadata) {
+        return make(FramePool::shared().copy(frame.data(), frame.size()), frame.timestamp(), std::move(metadata));
+    }
+
+    // Shares a retained frame's buffer
+    static py::object from(const MediaFrame& frame) {
+        return make(frame.buffer(), frame.timestamp(), py::cast(frame.metadata()));
+    }
+
+    // A frame read from a shared-memory ring carries the writer's sequence number
+    static py::object from(FrameRef buffer, uint64_t timestamp, py::object metadata,
+                           std::optional<uint64_t> sequence = std::nullopt) {
+        return make(std::move(buffer), timestamp, std::move(metadata), sequence);
+    }
+
+    size_t size() const {
+        Pin pin(*this);
+        return buffer_.size();
+    }
+
+    bool released() const { return exports_.load(std::memory_order_acquire) == kReleased; }
+    uint64_t timestamp() const { return timestamp_; }
+    py::object metadata() const { return metadata_; }
+    std::optional<uint64_t> sequence() const { return sequence_; }
+
+    py::bytes toBytes() const {
+        Pin pin(*this);
+        return py::bytes(reinterpret_cast<const char*>(buffer_.data()), buffer_.size());
+    }
+
+    void release() {
+        Py_ssize_t exports = 0;
+        if (exports_.compare_exchange_strong(exports, kReleased, std::memory_order_acq_rel)) {
+            buffer_.reset();
+        } else if (exports != kReleased) {
+            throw py::buffer_error("Frame has " + std::to_string(exports) +
+                                   " exported buffer(s); release memoryviews and arrays first");
+        }
+    }
+
+    std::string repr() const {
+        if (!pin()) return "<rtms.Frame released>";
+        std::string text = "<rtms.Frame " + std::to_string(buffer_.size()) + " bytes>";
+        unpin();
+        return text;
+    }
+
+    // bf_getbuffer / bf_releasebuffer slots, installed by custom_type_setup
+    static int getBuffer(PyObject* self, Py_buffer* view, int flags) {
+        auto& frame = py::handle(self).cast<PyFrame&>();
+        if (!frame.pin()) {
+            PyErr_SetString(PyExc_ValueError, "operation forbidden on released Frame");
+            view->obj = nullptr;
+            return -1;
+        }
+        void* data = const_cast<uint8_t*>(frame.buffer_.data());
+        if (PyBuffer_FillInfo(view, self, data, static_cast<Py_ssize_t>(frame.buffer_.size()), 1, flags) < 0) {
+            frame.unpin();
+            return -1;
+        }
+        return 0;
+    }
+
+    static void releaseBuffer(PyObject* self, Py_buffer*) {
+        py::handle(self).cast<PyFrame&>().unpin();
+    }
+
+private:
+    static constexpr Py_ssize_t kReleased = -1;
+
+    class Pin {
+    public:
+        explicit Pin(const PyFrame& frame) : frame_(frame) {
+            if (!frame_.pin()) throw py::value_error("operation forbidden on released Frame");
+        }
+        ~Pin() { frame_.unpin(); }
+
+    private:
+        const PyFrame& frame_;
+    };
+
+    // std::atomic is not movable, so the instance is built in place
+    static py::object make(FrameRef buffer, uint64_t timestamp, py::object metadata,
+                           std::optional<uint64_t> sequence = std::nullopt) {
+        return py::cast(new PyFrame(std::move(buffer), timestamp, std::move(metadata), sequence),
+                        py::return_value_policy::take_ownership);
+    }
+
+    // Counts a reader unless the frame has been released
+    bool pin() const {
+        Py_ssize_t exports = exports_.load(std::memory_order_acquire);
+        do {
+            if (exports == kReleased) return false;
+        } while (!exports_.compare_exchange_weak(exports, exports + 1, std::memory_order_acq_rel));
+        return true;
+    }
+
+    void unpin() const { exports_.fetch_sub(1, std::memory_order_release); }
+
+    FrameRef buffer_;
+    uint64_t timestamp_;
+    py::object metadata_;
+    std::optional<uint64_t> sequence_;
+    mutable std::atomic<Py_ssize_t> exports_{0};   // pins and buffer exports, or kReleased
+};
+
 // ============================================================================
 // Python Client Wrapper
 // ============================================================================
@@ -36,21 +256,25 @@ public:
     // Replays all callbacks and params that were buffered before alloc() so
     // that the caller can set up the client fully before calling alloc()+join().
     void alloc() {
+        std::lock_guard<std::mutex> lk(client_mutex_);
         if (client_) return;  // idempotent
         client_ = std::make_unique<Client>();
 
         // Replay buffered callbacks
-        if (!join_confirm_callback_.is_none())   _registerJoinConfirm();
-        if (!session_update_callback_.is_none()) _registerSessionUpdate();
-        if (!user_update_callback_.is_none())    _registerUserUpdate();
-        if (!audio_data_callback_.is_none())     _registerAudioData();
-        if (!video_data_callback_.is_none())     _registerVideoData();
-        if (!deskshare_data_callback_.is_none()) _registerDeskshareData();
-        if (!transcript_data_callback_.is_none()) _registerTranscriptData();
-        if (!leave_callback_.is_none())          _registerLeave();
-        if (!event_ex_callback_.is_none())       _registerEventEx();
-        if (!participant_video_callback_.is_none()) _registerParticipantVideo();
-        if (!video_subscribed_callback_.is_none())  _registerVideoSubscribed();
+        if (!join_confirm_callback_.empty())   _registerJoinConfirm();
+        if (!session_update_callback_.empty()) _registerSessionUpdate();
+        if (!user_update_callback_.empty())    _registerUserUpdate();
+        if (!audio_data_callback_.empty() || shmRingOf(ClientMetrics::Media::Audio))         _registerAudioData();
+        if (!video_data_callback_.empty() || shmRingOf(ClientMetrics::Media::Video))         _registerVideoData();
+        if (!deskshare_data_callback_.empty() || shmRingOf(ClientMetrics::Media::Deskshare)) _registerDeskshareData();
+        if (!transcript_data_callback_.empty() || shmRingOf(ClientMetrics::Media::Transcript)) _registerTranscriptData();
+        if (!leave_callback_.empty())          _registerLeave();
+        if (!event_ex_callback_.empty())       _registerEventEx();
+        if (!participant_video_callback_.empty()) _registerParticipantVideo();
+        if (!video_subscribed_callback_.empty())  _registerVideoSubscribed();
+        for (size_t i = 0; i < ClientMetrics::kMediaCount; ++i) {
+            if (!batch_callbacks_[i].empty()) _registerBatch(static_cast<ClientMetrics::Media>(i));
+        }
 
         // Replay buffered params
         if (pending_audio_params_)      client_->setAudioParams(*pending_audio_params_);
@@ -60,7 +284,10 @@ public:
         if (!pending_proxy_type_.empty()) client_->setProxy(pending_proxy_type_, pending_proxy_url_);
     }
 
-    bool isAllocated() const { return client_ != nullptr; }
+    bool isAllocated() const {
+        std::lock_guard<std::mutex> lk(client_mutex_);
+        return client_ != nullptr;
+    }
 
     // ========================================================================
     // Core Methods
@@ -69,8 +296,17 @@ public:
     void join(const std::string& uuid, const std::string& stream_id,
              const std::string& signature, const std::string& server_urls,
              int timeout = -1) {
-        if (!client_) throw std::runtime_error("alloc() must be called before join()");
-        client_->join(uuid, stream_id, signature, server_urls, timeout);
+        Client* client;
+        {
+            std::lock_guard<std::mutex> lk(client_mutex_);
+            if (!client_) throw std::runtime_error("alloc() must be called before join()");
+            checkAudioOutput(audio_data_callback_.get().output, audioCodec());
+            joined_ = true;
+            client = client_.get();
+        }
+        // Only alloc() and release() replace client_, and they run on this
+        // (the owning) thread, so the join need not block other threads' setters
+        client->join(uuid, stream_id, signature, server_urls, timeout);
     }
 
     void poll() {
@@ -83,25 +319,75 @@ public:
         if (client_) client_->poll();
     }
 
+    // Poll on behalf of a native EventLoop. Runs without the GIL; callbacks
+    // acquire it themselves. Asks to be detached once the client has been released.
+    PollResult pollFromLoop() {
+        std::lock_guard<std::mutex> lk(poll_mutex_);
+        if (!client_) return PollResult::Detach;
+        return client_->poll() ? PollResult::Delivered : PollResult::Idle;
+    }
+
+    // On a native EventLoop a poll only parks its batches; the loop delivers
+    // every client's batches together at the end of the cycle, under one GIL
+    // acquisition. These are called on the loop thread only.
+    void deferBatches() { defer_batches_ = true; }
+    bool takeBatchesReady() { return std::exchange(batches_ready_, false); }
+
+    // Requires the GIL
+    void dispatchBatches() {
+        for (size_t i = 0; i < ClientMetrics::kMediaCount; ++i) {
+            auto& frames = batch_pending_[i];
+            if (frames.empty()) continue;
+            py::list batch(frames.size());
+            for (size_t j = 0; j < frames.size(); ++j) batch[j] = PyFrame::from(frames[j]);
+            frames.clear();   // the Frames share the buffers; capacity is kept for the next poll
+            py::object callback = batch_callbacks_[i].get();
+            if (!callback) continue;
+            try { callback(batch); }
+            catch (const py::error_already_set& e) {
+                py::print(std::string("Error in ") + ClientMetrics::name(static_cast<ClientMetrics::Media>(i)) +
+                          "_batch callback:", e.what());
+            }
+        }
+    }
+
     void release() {
         if (!client_) return;
         // Hold poll_mutex_ for the entire release sequence so that any in-flight
         // poll() completes before we tear down the C SDK handle.
         std::lock_guard<std::mutex> lk(poll_mutex_);
+        std::lock_guard<std::mutex> client_lk(client_mutex_);
         // markClosed() sets sdk_opened_=false so that stopCallbacks() calls
-        // setOnAudioData/Video/etc. with empty lambdas without triggering
+        // setOnAudioFrame/Video/etc. with empty lambdas without triggering
         // configure() on an already-dead session (avoids 4 spurious warnings).
         client_->markClosed();
         stopCallbacks();
+        closeShmRings();
         client_->release();
+        // Keep the final counters readable through stats after the client is gone
+        final_stats_ = std::make_unique<ClientMetrics::Snapshot>(client_->metrics().snapshot());
         client_.reset();  // prevent subsequent poll() from calling into released SDK
+        joined_ = false;
+        for (auto& frames : batch_pending_) frames.clear();
+    }
+
+    py::dict stats() const {
+        ClientMetrics::Snapshot snapshot{};
+        {
+            std::lock_guard<std::mutex> lk(client_mutex_);
+            if (client_) snapshot = client_->metrics().snapshot();
+            else if (final_stats_) snapshot = *final_stats_;
+        }
+        return statsToDict(snapshot);
     }
 
     std::string uuid() const {
+        std::lock_guard<std::mutex> lk(client_mutex_);
         return client_ ? client_->uuid() : "";
     }
 
     std::string streamId() const {
+        std::lock_guard<std::mutex> lk(client_mutex_);
         return client_ ? client_->streamId() : "";
     }
 
@@ -110,19 +396,19 @@ public:
     // ========================================================================
 
     void enableAudio(bool enable) {
-        if (client_) client_->enableAudio(enable);
+        withClient([&] { client_->enableAudio(enable); });
     }
 
     void enableVideo(bool enable) {
-        if (client_) client_->enableVideo(enable);
+        withClient([&] { client_->enableVideo(enable); });
     }
 
     void enableTranscript(bool enable) {
-        if (client_) client_->enableTranscript(enable);
+        withClient([&] { client_->enableTranscript(enable); });
     }
 
     void enableDeskshare(bool enable) {
-        if (client_) client_->enableDeskshare(enable);
+        withClient([&] { client_->enableDeskshare(enable); });
     }
 
     // ========================================================================
@@ -131,26 +417,34 @@ public:
     // ========================================================================
 
     void setAudioParams(const AudioParams& params) {
+        std::lock_guard<std::mutex> lk(client_mutex_);
+        // onAudioData() replaces the callback under client_mutex_, so this sees the current dtype
+        if (joined_) checkAudioOutput(audio_data_callback_.get().output, params.codec());
         pending_audio_params_ = std::make_unique<AudioParams>(params);
+        audio_channels_ = std::max(1, params.channel());
         if (client_) client_->setAudioParams(params);
     }
 
     void setVideoParams(const VideoParams& params) {
+        std::lock_guard<std::mutex> lk(client_mutex_);
         pending_video_params_ = std::make_unique<VideoParams>(params);
         if (client_) client_->setVideoParams(params);
     }
 
     void setDeskshareParams(const DeskshareParams& params) {
+        std::lock_guard<std::mutex> lk(client_mutex_);
         pending_deskshare_params_ = std::make_unique<DeskshareParams>(params);
         if (client_) client_->setDeskshareParams(params);
     }
 
     void setTranscriptParams(const TranscriptParams& params) {
+        std::lock_guard<std::mutex> lk(client_mutex_);
         pending_transcript_params_ = std::make_unique<TranscriptParams>(params);
         if (client_) client_->setTranscriptParams(params);
     }
 
     void setProxy(const std::string& proxy_type, const std::string& proxy_url) {
+        std::lock_guard<std::mutex> lk(client_mutex_);
         pending_proxy_type_ = proxy_type;
         pending_proxy_url_ = proxy_url;
         if (client_) client_->setProxy(proxy_type, proxy_url);
@@ -162,48 +456,75 @@ public:
     // ========================================================================
 
     void onJoinConfirm(py::function callback) {
-        join_confirm_callback_ = callback;
-        if (client_) _registerJoinConfirm();
+        join_confirm_callback_.set(std::move(callback));
+        withClient([this] { _registerJoinConfirm(); });
     }
 
     void onSessionUpdate(py::function callback) {
-        session_update_callback_ = callback;
-        if (client_) _registerSessionUpdate();
+        session_update_callback_.set(std::move(callback));
+        withClient([this] { _registerSessionUpdate(); });
     }
 
     void onUserUpdate(py::function callback) {
-        user_update_callback_ = callback;
-        if (client_) _registerUserUpdate();
+        user_update_callback_.set(std::move(callback));
+        withClient([this] { _registerUserUpdate(); });
     }
 
-    void onAudioData(py::function callback) {
-        audio_data_callback_ = callback;
+    // dtype "int16" or "float32" delivers L16 audio as a (frames, channels)
+    // ndarray instead of a Frame
+    void onAudioData(py::function callback, std::optional<std::string> dtype) {
+        AudioOutput output = AudioOutput::Frame;
+        if (dtype && *dtype == "int16") {
+            output = AudioOutput::Int16;
+        } else if (dtype && *dtype == "float32") {
+            output = AudioOutput::Float32;
+        } else if (dtype) {
+            throw std::invalid_argument("Audio dtype must be 'int16' or 'float32', got '" + *dtype + "'");
+        }
+        // Keeps the callback being replaced alive until client_mutex_ is released
+        AudioCallback previous = audio_data_callback_.get();
+        std::lock_guard<std::mutex> lk(client_mutex_);
+        if (joined_) checkAudioOutput(output, audioCodec());
+        audio_data_callback_.set({std::move(callback), output});
         if (client_) _registerAudioData();
     }
 
     void onVideoData(py::function callback) {
-        video_data_callback_ = callback;
-        if (client_) _registerVideoData();
+        video_data_callback_.set(std::move(callback));
+        withClient([this] { _registerVideoData(); });
     }
 
     void onDeskshareData(py::function callback) {
-        deskshare_data_callback_ = callback;
-        if (client_) _registerDeskshareData();
+        deskshare_data_callback_.set(std::move(callback));
+        withClient([this] { _registerDeskshareData(); });
     }
 
     void onTranscriptData(py::function callback) {
-        transcript_data_callback_ = callback;
-        if (client_) _registerTranscriptData();
+        transcript_data_callback_.set(std::move(callback));
+        withClient([this] { _registerTranscriptData(); });
+    }
+
+    // Batched delivery: every frame of the media type from one poll() in a
+    // single call, with the GIL taken once per poll for all media types (once
+    // per cycle for every client on a native EventLoop)
+    void onBatch(ClientMetrics::Media media, py::function callback) {
+        batch_callbacks_[static_cast<size_t>(media)].set(std::move(callback));
+        withClient([this, media] { _registerBatch(media); });
     }
 
+    void onAudioBatch(py::function callback) { onBatch(ClientMetrics::Media::Audio, std::move(callback)); }
+    void onVideoBatch(py::function callback) { onBatch(ClientMetrics::Media::Video, std::move(callback)); }
+    void onDeskshareBatch(py::function callback) { onBatch(ClientMetrics::Media::Deskshare, std::move(callback)); }
+    void onTranscriptBatch(py::function callback) { onBatch(ClientMetrics::Media::Transcript, std::move(callback)); }
+
     void onLeave(py::function callback) {
-        leave_callback_ = callback;
-        if (client_) _registerLeave();
+        leave_callback_.set(std::move(callback));
+        withClient([this] { _registerLeave(); });
     }
 
     void onEventEx(py::function callback) {
-        event_ex_callback_ = callback;
-        if (client_) _registerEventEx();
+        event_ex_callback_.set(std::move(callback));
+        withClient([this] { _registerEventEx(); });
     }
 
     // ========================================================================
@@ -211,18 +532,19 @@ public:
     // ========================================================================
 
     void subscribeVideo(int user_id, bool subscribe) {
+        std::lock_guard<std::mutex> lk(client_mutex_);
         if (!client_) throw std::runtime_error("alloc() must be called before subscribeVideo()");
         client_->subscribeVideo(user_id, subscribe);
     }
 
     void onParticipantVideo(py::function callback) {
-        participant_video_callback_ = callback;
-        if (client_) _registerParticipantVideo();
+        participant_video_callback_.set(std::move(callback));
+        withClient([this] { _registerParticipantVideo(); });
     }
 
     void onVideoSubscribed(py::function callback) {
-        video_subscribed_callback_ = callback;
-        if (client_) _registerVideoSubscribed();
+        video_subscribed_callback_.set(std::move(callback));
+        withClient([this] { _registerVideoSubscribed(); });
     }
 
     // ========================================================================
@@ -230,6 +552,7 @@ public:
     // ========================================================================
 
     void subscribeEvent(const std::vector<int>& events) {
+        std::lock_guard<std::mutex> lk(client_mutex_);
         if (!client_) {
             // Buffer for replay after alloc
             pending_subscriptions_.insert(pending_subscriptions_.end(), events.begin(), events.end());
@@ -239,25 +562,117 @@ public:
     }
 
     void unsubscribeEvent(const std::vector<int>& events) {
-        if (client_) client_->unsubscribeEvent(events);
+        withClient([&] { client_->unsubscribeEvent(events); });
+    }
+
+    // ========================================================================
+    // Shared-memory rings: frames of a media type are also copied into a
+    // named segment on the polling thread, for other processes to read
+    // ========================================================================
+
+    std::string shmRing(const std::string& media_name, size_t bytes, const std::string& name) {
+        ClientMetrics::Media media = ClientMetrics::parse(media_name);
+        std::lock_guard<std::mutex> lk(client_mutex_);
+        auto& ring = shm_rings_[static_cast<size_t>(media)];
+        if (ring) return ring->name();
+
+        std::string segment = name;
+        if (segment.empty()) {
+            std::string stream_id = client_ ? client_->streamId() : "";
+            if (stream_id.empty()) throw std::runtime_error("A segment name is needed until the client has joined");
+            segment = ShmRing::nameFor(stream_id, media);
+        }
+        ring = std::make_shared<ShmRing>(segment, bytes);
+        if (client_) _registerFrameSink(media);
+        return segment;
+    }
+
+    bool closeShmRing(const std::string& media_name) {
+        ClientMetrics::Media media = ClientMetrics::parse(media_name);
+        std::lock_guard<std::mutex> lk(client_mutex_);
+        auto& ring = shm_rings_[static_cast<size_t>(media)];
+        if (!ring) return false;
+        // Readers see the ring closed now, though a frame sink may hold it a while longer
+        ring->close();
+        ring.reset();
+        if (client_) _registerFrameSink(media);
+        return true;
     }
 
 private:
+    // Runs f() if the client is allocated, holding client_mutex_. f must not
+    // call into Python.
+    template <typename F>
+    void withClient(F&& f) {
+        std::lock_guard<std::mutex> lk(client_mutex_);
+        if (client_) f();
+    }
+
+    // The GIL used to serialise Python threads against the polling thread. On
+    // free-threaded builds client_mutex_ does: client_ (replaced by alloc()
+    // and release() on the owning thread), final_stats_ and the pending
+    // params are read by other threads only under it. The owning thread
+    // reads client_ without it. Lock order: poll_mutex_, then client_mutex_.
     std::unique_ptr<Client> client_;
     std::mutex poll_mutex_;  // guards poll() vs release() race
+    mutable std::mutex client_mutex_;
+    std::unique_ptr<ClientMetrics::Snapshot> final_stats_;  // set by release()
+
+    // What the audio data callback receives. Stored in one slot with the
+    // callable, so the polling thread never pairs a callable with another's dtype.
+    enum class AudioOutput { Frame, Int16, Float32 };
+    struct AudioCallback {
+        py::object callable;
+        AudioOutput output = AudioOutput::Frame;
+        explicit operator bool() const { return static_cast<bool>(callable); }
+    };
+    std::atomic<int> audio_channels_{AudioParams().channel()};
+    bool joined_ = false;   // under client_mutex_; from join() until release()
+
+    // Python callback storage (buffered pre-alloc, registered post-alloc).
+    // Slots rather than bare py::objects so a callback replaced on one thread
+    // is never freed while the polling thread is calling it.
+    CallbackSlot<py::object> join_confirm_callback_;
+    CallbackSlot<py::object> session_update_callback_;
+    CallbackSlot<py::object> user_update_callback_;
+    CallbackSlot<AudioCallback> audio_data_callback_;
+    CallbackSlot<py::object> video_data_callback_;
+    CallbackSlot<py::object> deskshare_data_callback_;
+    CallbackSlot<py::object> transcript_data_callback_;
+    CallbackSlot<py::object> leave_callback_;
+    CallbackSlot<py::object> event_ex_callback_;
+    CallbackSlot<py::object> participant_video_callback_;
+    CallbackSlot<py::object> video_subscribed_callback_;
+    std::array<CallbackSlot<py::object>, ClientMetrics::kMediaCount> batch_callbacks_;   // indexed by ClientMetrics::Media
+
+    // Under client_mutex_; each frame sink holds its own reference
+    std::array<std::shared_ptr<ShmRing>, ClientMetrics::kMediaCount> shm_rings_;
+
+    std::shared_ptr<ShmRing> shmRingOf(ClientMetrics::Media media) const {
+        return shm_rings_[static_cast<size_t>(media)];
+    }
+
+    void closeShmRings() {
+        for (auto& ring : shm_rings_) {
+            if (ring) ring->close();
+            ring.reset();
+        }
+    }
+
+    void _registerFrameSink(ClientMetrics::Media media) {
+        switch (media) {
+            case ClientMetrics::Media::Audio:      _registerAudioData(); break;
+            case ClientMetrics::Media::Video:      _registerVideoData(); break;
+            case ClientMetrics::Media::Deskshare:  _registerDeskshareData(); break;
+            case ClientMetrics::Media::Transcript: _registerTranscriptData(); break;
+        }
+    }
 
-    // Python callback storage (buffered pre-alloc, registered post-alloc)
-    py::object join_confirm_callback_ = py::none();
-    py::object session_update_callback_ = py::none();
-    py::object user_update_callback_ = py::none();
-    py::object audio_data_callback_ = py::none();
-    py::object video_data_callback_ = py::none();
-    py::object deskshare_data_callback_ = py::none();
-    py::object transcript_data_callback_ = py::none();
-    py::object leave_callback_ = py::none();
-    py::object event_ex_callback_ = py::none();
-    py::object participant_video_callback_ = py::none();
-    py::object video_subscribed_callback_ = py::none();
+    // Batches parked by the core's batch callbacks until its batches-done
+    // callback; only the polling thread touches them
+    std::array<std::vector<MediaFrame>, ClientMetrics::kMediaCount> batch_pending_;
+    bool defer_batches_ = false;   // set once the client is on a native EventLoop
+    bool batches_ready_ = false;   // batch_pending_ awaits the end of the loop cycle
 
     // Param buffers (applied on alloc)
     std::unique_ptr<AudioParams>      pending_audio_params_;
@@ -274,134 +689,224 @@ private:
 
     void _registerJoinConfirm() {
         client_->setOnJoinConfirm([this](int reason) {
-            if (!join_confirm_callback_.is_none()) {
-                py::gil_scoped_acquire acquire;
-                try { join_confirm_callback_(reason); }
-                catch (const py::error_already_set& e) { py::print("Error in join_confirm callback:", e.what()); }
+            if (!join_confirm_callback_.empty()) {
+                CallbackGil acquire;
+                if (py::object callback = join_confirm_callback_.get()) {
+                    try { callback(reason); }
+                    catch (const py::error_already_set& e) { py::print("Error in join_confirm callback:", e.what()); }
+                }
             }
         });
     }
 
     void _registerSessionUpdate() {
         client_->setOnSessionUpdate([this](int op, const Session& session) {
-            if (!session_update_callback_.is_none()) {
-                py::gil_scoped_acquire acquire;
-                try { session_update_callback_(op, session); }
-                catch (const py::error_already_set& e) { py::print("Error in session_update callback:", e.what()); }
+            if (!session_update_callback_.empty()) {
+                CallbackGil acquire;
+                if (py::object callback = session_update_callback_.get()) {
+                    try { callback(op, session); }
+                    catch (const py::error_already_set& e) { py::print("Error in session_update callback:", e.what()); }
+                }
             }
         });
     }
 
     void _registerUserUpdate() {
         client_->setOnUserUpdate([this](int op, const Participant& participant) {
-            if (!user_update_callback_.is_none()) {
-                py::gil_scoped_acquire acquire;
-                try { user_update_callback_(op, participant); }
-                catch (const py::error_already_set& e) { py::print("Error in user_update callback:", e.what()); }
+            if (!user_update_callback_.empty()) {
+                CallbackGil acquire;
+                if (py::object callback = user_update_callback_.get()) {
+                    try { callback(op, participant); }
+                    catch (const py::error_already_set& e) { py::print("Error in user_update callback:", e.what()); }
+                }
             }
         });
     }
 
     void _registerAudioData() {
-        client_->setOnAudioData([this](const std::vector<uint8_t>& data, uint64_t timestamp, const Metadata& metadata) {
-            if (!audio_data_callback_.is_none()) {
-                py::gil_scoped_acquire acquire;
+        client_->setOnAudioFrame([this, ring = shmRingOf(ClientMetrics::Media::Audio)](const MediaFrameView& frame) {
+            if (ring) ring->write(frame);
+            if (!audio_data_callback_.empty()) {
+                CallbackGil acquire;
+                AudioCallback callback = audio_data_callback_.get();
+                if (!callback) return;
                 try {
-                    py::bytes py_data(reinterpret_cast<const char*>(data.data()), data.size());
-                    audio_data_callback_(py_data, data.size(), timestamp, metadata);
+                    py::object metadata = py::cast(frame.metadata());
+                    py::object data = callback.output == AudioOutput::Frame ? PyFrame::from(frame, metadata)
+                                                                            : _pcmArray(frame, callback.output);
+                    callback.callable(data, frame.size(), frame.timestamp(), metadata);
                 } catch (const py::error_already_set& e) { py::print("Error in audio_data callback:", e.what()); }
             }
         });
     }
 
+    // The payload as int16 or float32 samples, shape (frames, channels),
+    // written straight from the SDK buffer into the array
+    py::object _pcmArray(const MediaFrameView& frame, AudioOutput output) const {
+        const int channel_count = audio_channels_.load(std::memory_order_relaxed);
+        const auto channels = static_cast<py::ssize_t>(channel_count);
+        const auto frames = static_cast<py::ssize_t>(frame.size() / (sizeof(int16_t) * channel_count));
+        const auto samples = static_cast<size_t>(frames * channels);
+        if (output == AudioOutput::Float32) {
+            py::array_t<float> pcm({frames, channels});
+            pcm16ToFloat(frame.data(), pcm.mutable_data(), samples);
+            return pcm;
+        }
+        py::array_t<int16_t> pcm({frames, channels});
+        std::memcpy(pcm.mutable_data(), frame.data(), samples * sizeof(int16_t));
+        return pcm;
+    }
+
+    // Called with client_mutex_ held
+    int audioCodec() const {
+        return pending_audio_params_ ? pending_audio_params_->codec() : AudioParams().codec();
+    }
+
+    // Array output reinterprets the payload as samples, which only L16 is.
+    // Checked by join(), and afterwards whenever the dtype or codec changes.
+    static void checkAudioOutput(AudioOutput output, int codec) {
+        if (output == AudioOutput::Frame) return;
+        if (codec != static_cast<int>(MEDIA_PAYLOAD_TYPE::L16)) {
+            throw std::invalid_argument("Audio as an int16/float32 array needs L16 audio: "
+                                        "set_audio_params() with codec=AudioCodec.L16");
+        }
+    }
+
     void _registerVideoData() {
-        client_->setOnVideoData([this](const std::vector<uint8_t>& data, uint64_t timestamp, const Metadata& metadata) {
-            if (!video_data_callback_.is_none()) {
-                py::gil_scoped_acquire acquire;
+        client_->setOnVideoFrame([this, ring = shmRingOf(ClientMetrics::Media::Video)](const MediaFrameView& frame) {
+            if (ring) ring->write(frame);
+            if (!video_data_callback_.empty()) {
+                CallbackGil acquire;
+                py::object callback = video_data_callback_.get();
+                if (!callback) return;
                 try {
-                    py::bytes py_data(reinterpret_cast<const char*>(data.data()), data.size());
-                    video_data_callback_(py_data, data.size(), timestamp, metadata);
+                    py::object metadata = py::cast(frame.metadata());
+                    callback(PyFrame::from(frame, metadata), frame.size(), frame.timestamp(), metadata);
                 } catch (const py::error_already_set& e) { py::print("Error in video_data callback:", e.what()); }
             }
         });
     }
 
     void _registerDeskshareData() {
-        client_->setOnDeskshareData([this](const std::vector<uint8_t>& data, uint64_t timestamp, const Metadata& metadata) {
-            if (!deskshare_data_callback_.is_none()) {
-                py::gil_scoped_acquire acquire;
+        client_->setOnDeskshareFrame([this, ring = shmRingOf(ClientMetrics::Media::Deskshare)](const MediaFrameView& frame) {
+            if (ring) ring->write(frame);
+            if (!deskshare_data_callback_.empty()) {
+                CallbackGil acquire;
+                py::object callback = deskshare_data_callback_.get();
+                if (!callback) return;
                 try {
-                    py::bytes py_data(reinterpret_cast<const char*>(data.data()), data.size());
-                    deskshare_data_callback_(py_data, data.size(), timestamp, metadata);
+                    py::object metadata = py::cast(frame.metadata());
+                    callback(PyFrame::from(frame, metadata), frame.size(), frame.timestamp(), metadata);
                 } catch (const py::error_already_set& e) { py::print("Error in deskshare_data callback:", e.what()); }
             }
         });
     }
 
     void _registerTranscriptData() {
-        client_->setOnTranscriptData([this](const std::vector<uint8_t>& data, uint64_t timestamp, const Metadata& metadata) {
-            if (!transcript_data_callback_.is_none()) {
-                py::gil_scoped_acquire acquire;
+        client_->setOnTranscriptFrame([this, ring = shmRingOf(ClientMetrics::Media::Transcript)](const MediaFrameView& frame) {
+            if (ring) ring->write(frame);
+            if (!transcript_data_callback_.empty()) {
+                CallbackGil acquire;
+                py::object callback = transcript_data_callback_.get();
+                if (!callback) return;
                 try {
-                    py::bytes py_data(reinterpret_cast<const char*>(data.data()), data.size());
-                    transcript_data_callback_(py_data, data.size(), timestamp, metadata);
+                    py::bytes py_data(reinterpret_cast<const char*>(frame.data()), frame.size());
+                    callback(py_data, frame.size(), frame.timestamp(), frame.metadata());
                 } catch (const py::error_already_set& e) { py::print("Error in transcript_data callback:", e.what()); }
             }
         });
     }
 
+    void _registerBatch(ClientMetrics::Media media) {
+        // Parking needs no GIL; _deliverBatches() takes it once for the poll
+        auto park = [this, media](std::vector<MediaFrame>& frames) {
+            auto& pending = batch_pending_[static_cast<size_t>(media)];
+            if (pending.empty()) {
+                pending.swap(frames);
+            } else {
+                pending.insert(pending.end(), std::make_move_iterator(frames.begin()),
+                               std::make_move_iterator(frames.end()));
+            }
+        };
+        switch (media) {
+            case ClientMetrics::Media::Audio:      client_->setOnAudioBatch(park); break;
+            case ClientMetrics::Media::Video:      client_->setOnVideoBatch(park); break;
+            case ClientMetrics::Media::Deskshare:  client_->setOnDeskshareBatch(park); break;
+            case ClientMetrics::Media::Transcript: client_->setOnTranscriptBatch(park); break;
+        }
+        client_->setOnBatchesDone([this] { _deliverBatches(); });
+    }
+
+    void _deliverBatches() {
+        if (defer_batches_) {
+            batches_ready_ = true;
+            return;
+        }
+        CallbackGil acquire;
+        dispatchBatches();
+    }
+
     void _registerLeave() {
         client_->setOnLeave([this](int reason) {
-            if (!leave_callback_.is_none()) {
-                py::gil_scoped_acquire acquire;
-                try { leave_callback_(reason); }
-                catch (const py::error_already_set& e) { py::print("Error in leave callback:", e.what()); }
+            if (!leave_callback_.empty()) {
+                CallbackGil acquire;
+                if (py::object callback = leave_callback_.get()) {
+                    try { callback(reason); }
+                    catch (const py::error_already_set& e) { py::print("Error in leave callback:", e.what()); }
+                }
             }
         });
     }
 
     void _registerEventEx() {
         client_->setOnEventEx([this](const std::string& event_data) {
-            if (!event_ex_callback_.is_none()) {
-                py::gil_scoped_acquire acquire;
-                try { event_ex_callback_(event_data); }
-                catch (const py::error_already_set& e) { py::print("Error in event_ex callback:", e.what()); }
+            if (!event_ex_callback_.empty()) {
+                CallbackGil acquire;
+                if (py::object callback = event_ex_callback_.get()) {
+                    try { callback(event_data); }
+                    catch (const py::error_already_set& e) { py::print("Error in event_ex callback:", e.what()); }
+                }
             }
         });
     }
 
     void _registerParticipantVideo() {
         client_->setOnParticipantVideo([this](const std::vector<int>& users, bool is_on) {
-            if (!participant_video_callback_.is_none()) {
-                py::gil_scoped_acquire acquire;
-                try { participant_video_callback_(users, is_on); }
-                catch (const py::error_already_set& e) { py::print("Error in participant_video callback:", e.what()); }
+            if (!participant_video_callback_.empty()) {
+                CallbackGil acquire;
+                if (py::object callback = participant_video_callback_.get()) {
+                    try { callback(users, is_on); }
+                    catch (const py::error_already_set& e) { py::print("Error in participant_video callback:", e.what()); }
+                }
             }
         });
     }
 
     void _registerVideoSubscribed() {
         client_->setOnVideoSubscribed([this](int user_id, int status, const std::string& error) {
-            if (!video_subscribed_callback_.is_none()) {
-                py::gil_scoped_acquire acquire;
-                try { video_subscribed_callback_(user_id, status, error); }
-                catch (const py::error_already_set& e) { py::print("Error in video_subscribed callback:", e.what()); }
+            if (!video_subscribed_callback_.empty()) {
+                CallbackGil acquire;
+                if (py::object callback = video_subscribed_callback_.get()) {
+                    try { callback(user_id, status, error); }
+                    catch (const py::error_already_set& e) { py::print("Error in video_subscribed callback:", e.what()); }
+                }
             }
         });
     }
 
     void clearCallbacks() {
-        join_confirm_callback_ = py::none();
-        session_update_callback_ = py::none();
-        user_update_callback_ = py::none();
-        audio_data_callback_ = py::none();
-        video_data_callback_ = py::none();
-        deskshare_data_callback_ = py::none();
-        transcript_data_callback_ = py::none();
-        leave_callback_ = py::none();
-        event_ex_callback_ = py::none();
-        participant_video_callback_ = py::none();
-        video_subscribed_callback_ = py::none();
+        join_confirm_callback_.reset();
+        session_update_callback_.reset();
+        user_update_callback_.reset();
+        audio_data_callback_.reset();
+        video_data_callback_.reset();
+        deskshare_data_callback_.reset();
+        transcript_data_callback_.reset();
+        leave_callback_.reset();
+        event_ex_callback_.reset();
+        participant_video_callback_.reset();
+        video_subscribed_callback_.reset();
+        for (auto& callback : batch_callbacks_) callback.reset();
     }
 
     void stopCallbacks() {
@@ -409,23 +914,327 @@ private:
             client_->setOnJoinConfirm([](int) {});
             client_->setOnSessionUpdate([](int, const Session&) {});
             client_->setOnUserUpdate([](int, const Participant&) {});
-            client_->setOnAudioData([](const std::vector<uint8_t>&, uint64_t, const Metadata&) {});
-            client_->setOnVideoData([](const std::vector<uint8_t>&, uint64_t, const Metadata&) {});
-            client_->setOnDeskshareData([](const std::vector<uint8_t>&, uint64_t, const Metadata&) {});
-            client_->setOnTranscriptData([](const std::vector<uint8_t>&, uint64_t, const Metadata&) {});
+            client_->setOnAudioFrame([](const MediaFrameView&) {});
+            client_->setOnVideoFrame([](const MediaFrameView&) {});
+            client_->setOnDeskshareFrame([](const MediaFrameView&) {});
+            client_->setOnTranscriptFrame([](const MediaFrameView&) {});
             client_->setOnLeave([](int) {});
             client_->setOnEventEx([](const std::string&) {});
             client_->setOnParticipantVideo([](const std::vector<int>&, bool) {});
             client_->setOnVideoSubscribed([](int, int, const std::string&) {});
+            client_->setOnAudioBatch(nullptr);
+            client_->setOnVideoBatch(nullptr);
+            client_->setOnDeskshareBatch(nullptr);
+            client_->setOnTranscriptBatch(nullptr);
+            client_->setOnBatchesDone(nullptr);
+        }
+    }
+};
+
+// ============================================================================
+// Native EventLoop
+// ============================================================================
+
+/**
+ * LoopClient adapter for a Python Client.
+ *
+ * start() runs the Python-side Client._do_alloc_and_join() (SDK init, alloc,
+ * join) on the loop thread; poll() calls straight into the C++ client without
+ * touching the interpreter, and queues the session on ready when the poll
+ * parked batches for the end of the cycle. Holds a reference to the Python
+ * object while attached and drops it in stop() so the client can be collected.
+ */
+class PyLoopSession : public LoopClient {
+public:
+    PyLoopSession(py::object owner, PyClient& client, std::vector<PyLoopSession*>& ready)
+        : owner_(std::move(owner)), client_(client), ready_(ready) {
+        client_.deferBatches();
+    }
+
+    ~PyLoopSession() override {
+        if (owner_) {
+            py::gil_scoped_acquire acquire;
+            owner_ = py::object();
+        }
+    }
+
+    void start() override {
+        py::gil_scoped_acquire acquire;
+        try {
+            owner_.attr("_do_alloc_and_join")();
+        } catch (py::error_already_set& e) {
+            // error_already_set must not outlive the GIL; rethrow as a plain exception
+            std::string message = e.what();
+            attached_.store(false, std::memory_order_release);
+            owner_ = py::object();
+            throw std::runtime_error(message);
+        }
+    }
+
+    PollResult poll() override {
+        PollResult result = client_.pollFromLoop();
+        if (client_.takeBatchesReady()) ready_.push_back(this);
+        return result;
+    }
+
+    // Requires the GIL
+    void deliverBatches() { client_.dispatchBatches(); }
+
+    void stop() noexcept override {
+        py::gil_scoped_acquire acquire;
+        try {
+            client_.release();
+        } catch (const std::exception& e) {
+            PySys_WriteStderr("Warning: Failed to release client: %s\n", e.what());
+        }
+        attached_.store(false, std::memory_order_release);
+        owner_ = py::object();
+    }
+
+    // Read by PyEventLoop on Python threads; owner_ itself is loop-thread only
+    bool attached() const { return attached_.load(std::memory_order_acquire); }
+
+private:
+    py::object owner_;
+    std::atomic<bool> attached_{true};
+    PyClient& client_;
+    std::vector<PyLoopSession*>& ready_;
+};
+
+/**
+ * Python handle to an rtms::EventLoop. Every call that can wait on the loop
+ * thread releases the GIL first, since that thread needs it to start and stop
+ * Python clients.
+ *
+ * The loop polls with the GIL released and takes it once at the end of each
+ * cycle to deliver the batches of every client it polled.
+ */
+class PyEventLoop {
+public:
+    // An empty mode polls every client at the fixed interval
+    PyEventLoop(int poll_interval_ms, const std::string& name, const std::string& mode)
+        : loop_(mode.empty() ? PollPolicy::fixed(std::chrono::milliseconds(poll_interval_ms))
+                             : PollPolicy::forMode(parsePollMode(mode)),
+                name) {
+        loop_.setOnCycleEnd([this] { deliverBatches(); });
+    }
+
+    ~PyEventLoop() {
+        py::gil_scoped_release release;
+        loop_.stop();
+        loop_.join();
+    }
+
+    void add(py::object client) {
+        PyClient& native = client.cast<PyClient&>();
+        auto session = std::make_shared<PyLoopSession>(client, native, ready_);
+
+        std::lock_guard<std::mutex> lk(sessions_mutex_);
+        for (auto it = sessions_.begin(); it != sessions_.end();) {
+            it = it->second->attached() ? std::next(it) : sessions_.erase(it);
+        }
+        loop_.add(session);
+        sessions_[&native] = std::move(session);
+    }
+
+    bool remove(py::object client) {
+        PyClient& native = client.cast<PyClient&>();
+        std::shared_ptr<PyLoopSession> session;
+        {
+            std::lock_guard<std::mutex> lk(sessions_mutex_);
+            auto it = sessions_.find(&native);
+            if (it == sessions_.end()) return false;
+            session = std::move(it->second);
+            sessions_.erase(it);
+        }
+        py::gil_scoped_release release;
+        return loop_.remove(session);
+    }
+
+    // Seconds until the client's next poll, or None if it is not on this loop
+    py::object pollIntervalOf(py::object client) {
+        PyClient& native = client.cast<PyClient&>();
+        std::lock_guard<std::mutex> lk(sessions_mutex_);
+        auto it = sessions_.find(&native);
+        if (it == sessions_.end() || !it->second->attached()) return py::none();
+        return py::float_(std::chrono::duration<double>(it->second->pollInterval()).count());
+    }
+
+    void start(bool stop_when_empty) { loop_.start(stop_when_empty); }
+
+    void stop() { loop_.stop(); }
+
+    void join() {
+        py::gil_scoped_release release;
+        loop_.join();
+    }
+
+    bool wait(double timeout) {
+        py::gil_scoped_release release;
+        return loop_.wait(std::chrono::milliseconds(static_cast<int64_t>(timeout * 1000)));
+    }
+
+    int fileno() { return loop_.readyFd(); }
+    bool clearReady() { return loop_.clearReady(); }
+    int stoppedFileno() { return loop_.stoppedFd(); }
+
+    bool running() const { return loop_.running(); }
+    size_t clientCount() const { return loop_.clientCount(); }
+    const std::string& name() const { return loop_.name(); }
+
+private:
+    // Sessions queued in ready_ are detached only by the next cycle's
+    // drainCommands(), so the raw pointers are valid until this runs.
+    void deliverBatches() {
+        if (ready_.empty()) return;
+        struct Clear {
+            std::vector<PyLoopSession*>& sessions;
+            ~Clear() { sessions.clear(); }
+        } clear{ready_};
+        CallbackGil acquire;
+        for (PyLoopSession* session : ready_) session->deliverBatches();
+    }
+
+    EventLoop loop_;
+    std::mutex sessions_mutex_;
+    std::unordered_map<const PyClient*, std::shared_ptr<PyLoopSession>> sessions_;
+    std::vector<PyLoopSession*> ready_;   // loop thread only
+};
+
+// ============================================================================
+// Shared-memory ring reader
+// ============================================================================
+
+/**
+ * Follows a ring that another process's Client writes (Client.shm_ring()).
+ * Each frame is copied once, from the ring into a pooled Frame, and checked
+ * against the writer before Python sees it, so a frame overwritten mid-copy
+ * is skipped rather than returned torn. Waiting releases the GIL.
+ */
+class PyShmRingReader {
+public:
+    explicit PyShmRingReader(const std::string& name) : reader_(name) {}
+
+    // The next frame, waiting up to timeout seconds (forever if None); None
+    // on timeout or once the ring is closed and drained
+    py::object read(std::optional<double> timeout) {
+        using namespace std::chrono;
+        auto deadline = timeout ? steady_clock::now() + duration_cast<steady_clock::duration>(duration<double>(*timeout))
+                                : steady_clock::time_point::max();
+        for (;;) {
+            std::optional<Copied> frame;
+            bool closed;
+            {
+                py::gil_scoped_release release;
+                std::lock_guard<std::mutex> lk(mutex_);
+                // Closed is read first, so a frame written just before close() is still taken
+                closed = reader_.closed();
+                frame = take();
+                auto now = steady_clock::now();
+                if (!frame && !closed && now < deadline) {
+                    reader_.wait(std::min(duration_cast<milliseconds>(deadline - now), kWaitSlice));
+                }
+            }
+            if (frame) return toPython(*frame);
+            if (closed || steady_clock::now() >= deadline) return py::none();
+            // Between slices, so Ctrl-C interrupts an unbounded read
+            if (PyErr_CheckSignals() != 0) throw py::error_already_set();
         }
     }
+
+    py::object tryRead() {
+        std::optional<Copied> frame;
+        {
+            py::gil_scoped_release release;
+            std::lock_guard<std::mutex> lk(mutex_);
+            frame = take();
+        }
+        return frame ? toPython(*frame) : py::none();
+    }
+
+    bool closed() const { return reader_.closed(); }
+    const std::string& name() const { return reader_.name(); }
+
+    uint64_t lapped() {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return reader_.lapped();
+    }
+
+    uint64_t lost() {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return reader_.lost();
+    }
+
+private:
+    static constexpr std::chrono::milliseconds kWaitSlice{100};
+
+    struct Copied {
+        FrameRef buffer;
+        uint64_t timestamp;
+        uint64_t sequence;
+        int user_id;
+    };
+
+    // With mutex_ held and without the GIL
+    std::optional<Copied> take() {
+        SharedRing::Reader::View view;
+        while (reader_.peek(view)) {
+            FrameRef buffer = FramePool::shared().copy(view.data, view.size);
+            if (reader_.consume()) return Copied{std::move(buffer), view.timestamp, view.sequence, view.user_id};
+        }
+        return std::nullopt;
+    }
+
+    // The ring only carries the user id; the rest of Metadata is left empty
+    static py::object toPython(Copied& frame) {
+        rtms_metadata raw{};
+        raw.user_id = frame.user_id;
+        return PyFrame::from(std::move(frame.buffer), frame.timestamp, py::cast(Metadata(raw)), frame.sequence);
+    }
+
+    ShmRing::Reader reader_;
+    std::mutex mutex_;   // one Python thread at a time in the reader
 };
 
+// ============================================================================
+// Prometheus metrics
+// ============================================================================
+
+// One process-wide listener; scrapes are served from its own thread without the GIL
+static std::unique_ptr<MetricsServer> g_metrics_server;
+static std::mutex g_metrics_server_mutex;
+
+static std::string renderMetrics() {
+    py::gil_scoped_release release;
+    return renderPrometheus();
+}
+
+static uint16_t startMetricsServer(int port, const std::string& host) {
+    if (port < 0 || port > 65535) {
+        throw py::value_error("port must be between 0 and 65535");
+    }
+    py::gil_scoped_release release;
+    std::lock_guard<std::mutex> lk(g_metrics_server_mutex);
+    g_metrics_server.reset();
+    auto server = std::make_unique<MetricsServer>(host, static_cast<uint16_t>(port));
+    server->start();
+    g_metrics_server = std::move(server);
+    return g_metrics_server->port();
+}
+
+static bool stopMetricsServer() {
+    py::gil_scoped_release release;
+    std::lock_guard<std::mutex> lk(g_metrics_server_mutex);
+    bool was_running = g_metrics_server && g_metrics_server->running();
+    g_metrics_server.reset();
+    return was_running;
+}
+
 // ============================================================================
 // Module Definition
 // ============================================================================
 
-PYBIND11_MODULE(_rtms, m) {
+PYBIND11_MODULE(_rtms, m, py::mod_gil_not_used()) {
     m.doc() = "Zoom RTMS Python Bindings - Real-Time Media Streaming SDK";
 
     // ========================================================================
@@ -471,6 +1280,36 @@ PYBIND11_MODULE(_rtms, m) {
         .def_property_readonly("endTs", &Metadata::endTs)
         .def_property_readonly("aiInterpreter", &Metadata::aiInterpreter);
 
+    py::class_<PyFrame>(m, "Frame", py::custom_type_setup([](PyHeapTypeObject* heap_type) {
+            heap_type->as_buffer.bf_getbuffer = &PyFrame::getBuffer;
+            heap_type->as_buffer.bf_releasebuffer = &PyFrame::releaseBuffer;
+            heap_type->ht_type.tp_as_buffer = &heap_type->as_buffer;
+        }),
+        "Read-only media payload backed by pooled native memory (buffer protocol)")
+        .def("__len__", &PyFrame::size)
+        .def("__bytes__", &PyFrame::toBytes)
+        .def("__repr__", &PyFrame::repr)
+        .def("tobytes", &PyFrame::toBytes, "Copy the payload into a bytes object")
+        .def("release", &PyFrame::release,
+             "Return the payload to the native pool now. Raises BufferError while "
+             "a memoryview or array still refers to it")
+        .def_property_readonly("released", &PyFrame::released)
+        .def_property_readonly("timestamp", &PyFrame::timestamp)
+        .def_property_readonly("metadata", &PyFrame::metadata)
+        .def_property_readonly("sequence", &PyFrame::sequence,
+                               "Writer's sequence number for a frame read from a ShmRingReader, else None")
+        .def("__enter__", [](py::object self) { return self; })
+        .def("__exit__", [](PyFrame& frame, py::args) { frame.release(); });
+
+    // Test-only: a Frame over a pooled copy of data, as a media callback would get it
+    m.def("_frame_from_bytes", [](const py::bytes& data, uint64_t timestamp, int user_id) {
+        std::string payload = data;
+        rtms_metadata raw{};
+        raw.user_id = user_id;
+        FrameRef buffer = FramePool::shared().copy(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+        return PyFrame::from(std::move(buffer), timestamp, py::cast(Metadata(raw)));
+    }, py::arg("data"), py::arg("timestamp") = 0, py::arg("user_id") = 0);
+
     // ========================================================================
     // Parameter Classes
     // ========================================================================
@@ -611,6 +1450,9 @@ PYBIND11_MODULE(_rtms, m) {
              "Get stream ID")
         .def("streamId", &PyClient::streamId,
              "Get stream ID")
+        .def_property_readonly("stats", &PyClient::stats,
+             "Snapshot of native delivery metrics: frames/bytes/empty/dropped per media type, "
+             "plus poll and per-callback timings in microseconds")
         .def("enable_audio", &PyClient::enableAudio,
              "Enable/disable audio streaming")
         .def("enableAudio", &PyClient::enableAudio,
@@ -662,9 +1504,11 @@ PYBIND11_MODULE(_rtms, m) {
         .def("onUserUpdate", &PyClient::onUserUpdate,
              "Register user update callback")
         .def("on_audio_data", &PyClient::onAudioData,
-             "Register audio data callback")
+             "Register audio data callback; dtype 'int16' or 'float32' delivers L16 audio as a numpy array",
+             py::arg("callback"), py::arg("dtype") = py::none())
         .def("onAudioData", &PyClient::onAudioData,
-             "Register audio data callback")
+             "Register audio data callback; dtype 'int16' or 'float32' delivers L16 audio as a numpy array",
+             py::arg("callback"), py::arg("dtype") = py::none())
         .def("on_video_data", &PyClient::onVideoData,
              "Register video data callback")
         .def("onVideoData", &PyClient::onVideoData,
@@ -677,6 +1521,22 @@ PYBIND11_MODULE(_rtms, m) {
              "Register transcript data callback")
         .def("onTranscriptData", &PyClient::onTranscriptData,
              "Register transcript data callback")
+        .def("on_audio_batch", &PyClient::onAudioBatch,
+             "Register a callback for each poll's audio frames as a list of Frame")
+        .def("onAudioBatch", &PyClient::onAudioBatch,
+             "Register a callback for each poll's audio frames as a list of Frame")
+        .def("on_video_batch", &PyClient::onVideoBatch,
+             "Register a callback for each poll's video frames as a list of Frame")
+        .def("onVideoBatch", &PyClient::onVideoBatch,
+             "Register a callback for each poll's video frames as a list of Frame")
+        .def("on_deskshare_batch", &PyClient::onDeskshareBatch,
+             "Register a callback for each poll's deskshare frames as a list of Frame")
+        .def("onDeskshareBatch", &PyClient::onDeskshareBatch,
+             "Register a callback for each poll's deskshare frames as a list of Frame")
+        .def("on_transcript_batch", &PyClient::onTranscriptBatch,
+             "Register a callback for each poll's transcript frames as a list of Frame")
+        .def("onTranscriptBatch", &PyClient::onTranscriptBatch,
+             "Register a callback for each poll's transcript frames as a list of Frame")
         .def("on_leave", &PyClient::onLeave,
              "Register leave callback")
         .def("onLeave", &PyClient::onLeave,
@@ -710,7 +1570,123 @@ PYBIND11_MODULE(_rtms, m) {
              py::arg("events"))
         .def("unsubscribeEvent", &PyClient::unsubscribeEvent,
              "Unsubscribe from specific event types",
-             py::arg("events"));
+             py::arg("events"))
+        .def("shm_ring", &PyClient::shmRing,
+             "Copy this client's frames of one media type into a named shared-memory ring "
+             "for other processes to read; returns the segment name",
+             py::arg("media"), py::arg("bytes") = size_t(4) << 20, py::arg("name") = "")
+        .def("close_shm_ring", &PyClient::closeShmRing,
+             "Stop writing a media type's shared-memory ring and remove its name. "
+             "Returns False if there was none",
+             py::arg("media"));
+
+    // ========================================================================
+    // ShmRingReader Class
+    // ========================================================================
+
+    py::class_<PyShmRingReader>(m, "ShmRingReader")
+        .def(py::init<const std::string&>(),
+             "Attach to a shared-memory ring by name, starting at the newest frame",
+             py::arg("name"))
+        .def("read", &PyShmRingReader::read,
+             "The next Frame, waiting up to timeout seconds (forever if None). Its metadata "
+             "holds only userId, and its sequence is set. None on timeout or once the ring "
+             "is closed and drained",
+             py::arg("timeout") = py::none())
+        .def("try_read", &PyShmRingReader::tryRead,
+             "The next Frame if one is ready, else None")
+        .def("__iter__", [](py::object self) { return self; })
+        .def("__next__", [](PyShmRingReader& reader) {
+            py::object frame = reader.read(std::nullopt);
+            if (frame.is_none()) throw py::stop_iteration();
+            return frame;
+        })
+        .def_property_readonly("name", &PyShmRingReader::name)
+        .def_property_readonly("closed", &PyShmRingReader::closed,
+             "The writer has closed the ring; frames already written can still be read")
+        .def_property_readonly("lapped", &PyShmRingReader::lapped,
+             "Times this reader fell a whole ring behind and skipped ahead to the writer")
+        .def_property_readonly("lost", &PyShmRingReader::lost,
+             "Frames skipped between ones this reader returned");
+
+    // ========================================================================
+    // EventLoop Class
+    // ========================================================================
+
+    py::class_<PyEventLoop>(m, "EventLoop")
+        .def(py::init<int, const std::string&, const std::string&>(),
+             "Create a native event loop that polls its clients from one OS thread. "
+             "mode is 'latency', 'balanced' or 'power'; empty polls every poll_interval_ms",
+             py::arg("poll_interval_ms") = 10, py::arg("name") = "", py::arg("mode") = "")
+        .def("add", &PyEventLoop::add,
+             "Hand a client to the loop; alloc() and join() run on the loop thread",
+             py::arg("client"))
+        .def("remove", &PyEventLoop::remove,
+             "Release a client on the loop thread and detach it. Returns False if the "
+             "client does not belong to this loop",
+             py::arg("client"))
+        .def("poll_interval_of", &PyEventLoop::pollIntervalOf,
+             "Seconds the loop will wait before polling the client again, or None",
+             py::arg("client"))
+        .def("start", &PyEventLoop::start,
+             "Start the loop on its own thread",
+             py::arg("stop_when_empty") = false)
+        .def("stop", &PyEventLoop::stop,
+             "Stop the loop after the current cycle, releasing remaining clients")
+        .def("join", &PyEventLoop::join,
+             "Wait for the loop thread to exit")
+        .def("wait", &PyEventLoop::wait,
+             "Wait up to timeout seconds for the loop to exit. Returns True once it has",
+             py::arg("timeout"))
+        .def("fileno", &PyEventLoop::fileno,
+             "Descriptor that becomes readable after each cycle that delivered data and "
+             "once the loop has shut down; -1 where unsupported")
+        .def("clear_ready", &PyEventLoop::clearReady,
+             "Make fileno() unreadable again. Returns True if it was readable")
+        .def("stopped_fileno", &PyEventLoop::stoppedFileno,
+             "Descriptor that becomes readable once the loop has shut down, and only then; "
+             "-1 where unsupported")
+        .def_property_readonly("running", &PyEventLoop::running)
+        .def_property_readonly("client_count", &PyEventLoop::clientCount)
+        .def_property_readonly("name", &PyEventLoop::name);
+
+    // ========================================================================
+    // Prometheus Metrics
+    // ========================================================================
+
+    m.def("render_metrics", &renderMetrics,
+          "Render every live client and event loop in the Prometheus text format");
+    m.def("start_metrics_server", &startMetricsServer,
+          "Serve render_metrics() at http://host:port/metrics from a native thread. Returns the bound port",
+          py::arg("port") = static_cast<int>(MetricsServer::kDefaultPort), py::arg("host") = "127.0.0.1");
+    m.def("stop_metrics_server", &stopMetricsServer,
+          "Stop the listener started by start_metrics_server(). Returns True if one was running");
+    m.def("gil_acquisitions", [] { return g_gil_acquisitions.load(std::memory_order_relaxed); },
+          "Number of times native callbacks have taken the GIL since the module was loaded");
+
+    // ========================================================================
+    // Tracing (RTMS_TRACE builds)
+    // ========================================================================
+
+    m.attr("TRACE_ENABLED") = trace::enabled();
+    m.def("dump_trace", [](std::optional<std::string> path) -> py::object {
+              if (!path) {
+                  std::string json;
+                  {
+                      py::gil_scoped_release release;
+                      json = trace::chromeJson();
+                  }
+                  return py::str(json);
+              }
+              {
+                  py::gil_scoped_release release;
+                  trace::writeChromeJson(*path);
+              }
+              return py::bool_(true);
+          },
+          "Return the hot-path trace as Chrome trace JSON, or write it to path and return True",
+          py::arg("path") = py::none());
+    m.def("clear_trace", &trace::clear, "Discard every buffered trace event");
 
     // ========================================================================
     // Constants - Media Types
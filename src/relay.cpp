@@ -0,0 +1,442 @@
+#include "relay.h"
+#include "rtms.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace rtms {
+
+Relay::Relay(std::string path, size_t queue_bytes) : path_(std::move(path)), queue_bytes_(queue_bytes) {}
+
+Relay::~Relay() {
+    stop();
+}
+
+size_t Relay::publish(const std::string& meeting_uuid, ClientMetrics::Media media, const MediaFrameView& frame) {
+    return publish(meeting_uuid, media, frame.data(), frame.size(), frame.timestamp(), frame.userId());
+}
+
+size_t Relay::subscribers() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return subscribers_.size();
+}
+
+Relay::Stats Relay::stats() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return stats_;
+}
+
+Relay::Record Relay::makeRecord(FrameRef body, size_t meeting_size, uint8_t media, int user_id,
+                                uint64_t timestamp, uint32_t dropped) {
+    Record record;
+    uint8_t* h = record.header.data();
+    uint32_t size = static_cast<uint32_t>(body.size() - meeting_size);
+    int32_t user = user_id;
+    uint16_t meeting = static_cast<uint16_t>(meeting_size);
+    std::memcpy(h, &size, 4);
+    std::memcpy(h + 4, &user, 4);
+    std::memcpy(h + 8, &timestamp, 8);
+    std::memcpy(h + 16, &meeting, 2);
+    h[18] = media;
+    h[19] = 0;
+    std::memcpy(h + 20, &dropped, 4);
+    record.body = std::move(body);
+    return record;
+}
+
+#ifdef _WIN32
+
+void Relay::start() {
+    throw Exception(RTMS_SDK_FAILURE, "Relay is not supported on Windows");
+}
+
+void Relay::stop() {}
+
+size_t Relay::publish(const std::string&, ClientMetrics::Media, const uint8_t*, size_t, uint64_t, int) {
+    return 0;
+}
+
+void Relay::serve() {}
+void Relay::accept() {}
+bool Relay::receive(Subscriber&) { return false; }
+bool Relay::flush(Subscriber&) { return false; }
+std::string Relay::handle(Subscriber&, const std::string&) { return ""; }
+void Relay::reply(Subscriber&, const std::string&) {}
+
+#else
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+// Two per record; well under IOV_MAX (1024 on Linux and macOS)
+constexpr int kMaxIov = 64;
+
+// A command line longer than this is refused and the subscriber dropped
+constexpr size_t kMaxLine = 4096;
+
+bool setNonBlocking(int fd) {
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+std::vector<std::string> split(const std::string& line) {
+    std::istringstream in(line);
+    std::vector<std::string> words;
+    for (std::string word; in >> word;) words.push_back(std::move(word));
+    return words;
+}
+
+uint32_t parseMediaList(const std::string& list) {
+    uint32_t mask = 0;
+    std::istringstream in(list);
+    for (std::string item; std::getline(in, item, ',');) {
+        mask |= 1u << static_cast<size_t>(ClientMetrics::parse(item));
+    }
+    return mask;
+}
+
+} // namespace
+
+void Relay::start() {
+    if (running() || thread_.joinable()) {
+        throw Exception(RTMS_SDK_INVALID_STATUS, "Relay is already running");
+    }
+
+    sockaddr_un addr{};
+    if (path_.empty() || path_.size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument("Relay socket path must be 1 to " + std::to_string(sizeof(addr.sun_path) - 1) +
+                                    " bytes, got '" + path_ + "'");
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path_.c_str(), path_.size() + 1);
+    auto address = reinterpret_cast<sockaddr*>(&addr);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw Exception(RTMS_SDK_FAILURE, std::string("Relay: socket() failed: ") + std::strerror(errno));
+    }
+    auto fail = [&](const std::string& what) {
+        std::string message = "Relay: cannot listen on " + path_ + ": " + what;
+        ::close(fd);
+        throw Exception(RTMS_SDK_FAILURE, message);
+    };
+
+    if (::bind(fd, address, sizeof(addr)) != 0) {
+        if (errno != EADDRINUSE) fail(std::strerror(errno));
+        // Replace the socket file only if nothing is accepting on it
+        struct stat st;
+        int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        bool live = probe >= 0 && ::connect(probe, address, sizeof(addr)) == 0;
+        if (probe >= 0) ::close(probe);
+        if (live) fail("another process is listening");
+        if (::lstat(path_.c_str(), &st) != 0 || !S_ISSOCK(st.st_mode)) fail("the path exists and is not a socket");
+        ::unlink(path_.c_str());
+        if (::bind(fd, address, sizeof(addr)) != 0) fail(std::strerror(errno));
+    }
+    // Frames are meeting content; other users get access through a group-owned
+    // directory or an explicit chmod, not by default
+    if (::chmod(path_.c_str(), 0600) != 0 || ::listen(fd, 64) != 0 || !setNonBlocking(fd)) {
+        std::string error = std::strerror(errno);
+        ::unlink(path_.c_str());
+        fail(error);
+    }
+
+    listener_ = fd;
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&Relay::serve, this);
+}
+
+void Relay::stop() {
+    running_.store(false, std::memory_order_release);
+    wake_.notify();
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+        thread_.join();
+    }
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        for (auto& subscriber : subscribers_) ::close(subscriber->fd);
+        subscribers_.clear();
+        subscribed_.store(0, std::memory_order_release);
+    }
+    if (listener_ >= 0) {
+        ::close(listener_);
+        ::unlink(path_.c_str());
+        listener_ = -1;
+    }
+}
+
+size_t Relay::publish(const std::string& meeting_uuid, ClientMetrics::Media media, const uint8_t* data,
+                      size_t size, uint64_t timestamp, int user_id) {
+    if (subscribed_.load(std::memory_order_acquire) == 0) return 0;
+    if (meeting_uuid.size() > UINT16_MAX || size > UINT32_MAX) {
+        throw std::invalid_argument("Relay: meeting uuid or frame too large for a record");
+    }
+
+    const size_t record_size = kRecordHeaderSize + meeting_uuid.size() + size;
+    const uint32_t bit = 1u << static_cast<size_t>(media);
+    FrameRef body;   // copied on the first match, then shared
+    size_t queued = 0;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        for (auto& subscriber : subscribers_) {
+            Subscriber& s = *subscriber;
+            if (!s.subscribed || !(s.media_mask & bit)) continue;
+            if (!s.meeting.empty() && s.meeting != meeting_uuid) continue;
+            if (!s.any_user && s.user_id != user_id) continue;
+
+            if (s.queued_bytes + record_size > queue_bytes_) {
+                ++s.dropped;
+                ++stats_.dropped;
+                continue;
+            }
+            if (!body) {
+                body = FramePool::shared().acquire(meeting_uuid.size() + size);
+                if (!meeting_uuid.empty()) std::memcpy(body->data(), meeting_uuid.data(), meeting_uuid.size());
+                if (size) std::memcpy(body->data() + meeting_uuid.size(), data, size);
+            }
+            s.queue.push_back(makeRecord(body, meeting_uuid.size(), static_cast<uint8_t>(media), user_id,
+                                         timestamp, s.dropped));
+            s.dropped = 0;
+            s.queued_bytes += record_size;
+            ++stats_.frames;
+            ++queued;
+        }
+    }
+    if (queued) wake_.notify();
+    return queued;
+}
+
+void Relay::serve() {
+    std::vector<std::shared_ptr<Subscriber>> current;
+    std::vector<pollfd> fds;
+    while (running()) {
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            current = subscribers_;
+        }
+        fds.clear();
+        fds.push_back({wake_.fd(), POLLIN, 0});
+        fds.push_back({listener_, POLLIN, 0});
+        for (auto& subscriber : current) {
+            // POLLOUT only while a write is blocked; otherwise it is always ready
+            short events = subscriber->sending.empty() ? POLLIN : POLLIN | POLLOUT;
+            fds.push_back({subscriber->fd, events, 0});
+        }
+
+        // The timeout only bounds how long stop() takes if a wakeup is missed
+        ::poll(fds.data(), fds.size(), 100);
+        if (!running()) break;
+        // Before looking at the queues, so a publish() racing with this cycle wakes the next one
+        wake_.clear();
+
+        if (fds[1].revents & POLLIN) accept();
+        for (size_t i = 0; i < current.size(); ++i) {
+            Subscriber& s = *current[i];
+            bool alive = true;
+            if (fds[i + 2].revents & (POLLIN | POLLHUP | POLLERR)) alive = receive(s);
+            if (alive) alive = flush(s);
+            if (alive && !s.closing) continue;
+
+            std::lock_guard<std::mutex> lk(mutex_);
+            if (s.subscribed) subscribed_.fetch_sub(1, std::memory_order_acq_rel);
+            subscribers_.erase(std::remove(subscribers_.begin(), subscribers_.end(), current[i]), subscribers_.end());
+            ::close(s.fd);
+        }
+        current.clear();
+    }
+}
+
+void Relay::accept() {
+    for (;;) {
+        int fd = ::accept(listener_, nullptr, nullptr);
+        if (fd < 0) return;
+        if (!setNonBlocking(fd)) {
+            ::close(fd);
+            continue;
+        }
+#ifdef SO_NOSIGPIPE
+        int yes = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &yes, sizeof(yes));
+#endif
+        std::lock_guard<std::mutex> lk(mutex_);
+        subscribers_.push_back(std::make_shared<Subscriber>(fd));
+    }
+}
+
+bool Relay::receive(Subscriber& s) {
+    char buf[4096];
+    for (;;) {
+        ssize_t n = ::recv(s.fd, buf, sizeof(buf), 0);
+        if (n == 0) return false;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        s.input.append(buf, static_cast<size_t>(n));
+    }
+
+    size_t start = 0;
+    for (size_t end; !s.closing && (end = s.input.find('\n', start)) != std::string::npos; start = end + 1) {
+        std::string line = s.input.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.find_first_not_of(" \t") == std::string::npos) continue;
+        reply(s, handle(s, line));
+    }
+    s.input.erase(0, start);
+    if (!s.closing && s.input.size() > kMaxLine) {
+        // Sent before the connection closes, as far as the socket takes it
+        reply(s, "ERR command too long");
+        s.closing = true;
+    }
+    return true;
+}
+
+std::string Relay::handle(Subscriber& s, const std::string& line) {
+    std::vector<std::string> words = split(line);
+    try {
+        if (words[0] == "SUBSCRIBE") {
+            std::string meeting;
+            bool any_user = true;
+            int user_id = 0;
+            uint32_t mask = (1u << ClientMetrics::kMediaCount) - 1;
+            for (size_t i = 1; i < words.size(); ++i) {
+                size_t eq = words[i].find('=');
+                std::string key = words[i].substr(0, eq);
+                std::string value = eq == std::string::npos ? "" : words[i].substr(eq + 1);
+                if (value.empty()) throw std::invalid_argument("expected key=value, got '" + words[i] + "'");
+                if (key == "meeting") {
+                    meeting = value;
+                } else if (key == "user") {
+                    char* end = nullptr;
+                    errno = 0;
+                    long id = std::strtol(value.c_str(), &end, 10);
+                    if (*end || errno || id < INT_MIN || id > INT_MAX) {
+                        throw std::invalid_argument("bad user id '" + value + "'");
+                    }
+                    any_user = false;
+                    user_id = static_cast<int>(id);
+                } else if (key == "media") {
+                    mask = parseMediaList(value);
+                } else {
+                    throw std::invalid_argument("unknown key '" + key + "'");
+                }
+            }
+            std::lock_guard<std::mutex> lk(mutex_);
+            if (!s.subscribed) subscribed_.fetch_add(1, std::memory_order_acq_rel);
+            s.subscribed = true;
+            s.meeting = std::move(meeting);
+            s.any_user = any_user;
+            s.user_id = user_id;
+            s.media_mask = mask;
+            return "OK";
+        }
+        if (words[0] == "UNSUBSCRIBE") {
+            std::lock_guard<std::mutex> lk(mutex_);
+            if (s.subscribed) subscribed_.fetch_sub(1, std::memory_order_acq_rel);
+            s.subscribed = false;
+            return "OK";
+        }
+        if (on_command_) return on_command_(words);
+        return "ERR unknown command " + words[0];
+    } catch (const std::exception& e) {
+        return std::string("ERR ") + e.what();
+    }
+}
+
+void Relay::reply(Subscriber& s, const std::string& text) {
+    const size_t record_size = kRecordHeaderSize + text.size();
+    std::lock_guard<std::mutex> lk(mutex_);
+    // Every command is owed a reply, so rather than drop one, disconnect a
+    // subscriber that keeps sending commands without reading the answers
+    if (s.reply_bytes + record_size > queue_bytes_) {
+        s.closing = true;
+        return;
+    }
+    FrameRef body = FramePool::shared().copy(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    s.queue.push_back(makeRecord(std::move(body), 0, kReplyMedia, 0, 0, s.dropped));
+    s.dropped = 0;
+    s.queued_bytes += record_size;
+    s.reply_bytes += record_size;
+}
+
+bool Relay::flush(Subscriber& s) {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        std::move(s.queue.begin(), s.queue.end(), std::back_inserter(s.sending));
+        s.queue.clear();
+    }
+
+    while (!s.sending.empty()) {
+        // Gather as many queued records as fit into one call
+        iovec iov[kMaxIov];
+        int count = 0;
+        size_t skip = s.sent;
+        for (const Record& record : s.sending) {
+            if (count + 2 > kMaxIov) break;
+            if (skip < kRecordHeaderSize) {
+                iov[count++] = {const_cast<uint8_t*>(record.header.data()) + skip, kRecordHeaderSize - skip};
+            }
+            size_t body_skip = skip > kRecordHeaderSize ? skip - kRecordHeaderSize : 0;
+            if (record.body.size() > body_skip) {
+                iov[count++] = {const_cast<uint8_t*>(record.body.data()) + body_skip, record.body.size() - body_skip};
+            }
+            skip = 0;
+        }
+
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        ssize_t written = ::sendmsg(s.fd, &msg, kSendFlags);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        size_t done = s.sent + static_cast<size_t>(written);
+        size_t released = 0;
+        size_t replies_released = 0;
+        while (!s.sending.empty()) {
+            const Record& record = s.sending.front();
+            size_t record_size = kRecordHeaderSize + record.body.size();
+            if (done < record_size) break;
+            done -= record_size;
+            released += record_size;
+            if (record.header[18] == kReplyMedia) replies_released += record_size;
+            s.sending.pop_front();
+        }
+        s.sent = done;
+
+        std::lock_guard<std::mutex> lk(mutex_);
+        s.queued_bytes -= released;
+        s.reply_bytes -= replies_released;
+        stats_.bytes += static_cast<uint64_t>(written);
+        ++stats_.writes;
+    }
+    return true;
+}
+
+#endif // _WIN32
+
+} // namespace rtms
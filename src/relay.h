@@ -0,0 +1,167 @@
+#ifndef RTMS_RELAY_H
+#define RTMS_RELAY_H
+
+#include "frame_pool.h"
+#include "metrics.h"
+#include "notifier.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rtms {
+
+class MediaFrameView;
+
+/**
+ * Fans the frames of one ingest process out to local subscribers over a
+ * Unix domain socket, so several services can consume a meeting that was
+ * joined once.
+ *
+ * Subscribers connect and send newline-terminated commands:
+ *
+ *   SUBSCRIBE [meeting=<uuid>] [user=<id>] [media=audio,video,deskshare,transcript]
+ *   UNSUBSCRIBE
+ *
+ * A SUBSCRIBE replaces the connection's filter; omitted keys match
+ * anything. Other commands go to the handler set with setOnCommand(), if
+ * any. Everything the relay sends is a record: a kRecordHeaderSize header of
+ *
+ *   0  uint32  payload size
+ *   4  int32   user id
+ *   8  uint64  timestamp
+ *   16 uint16  meeting uuid length
+ *   18 uint8   media (ClientMetrics::Media, or kReplyMedia)
+ *   19 uint8   reserved, 0
+ *   20 uint32  frames dropped for this subscriber since its previous record
+ *
+ * in host byte order, followed by the meeting uuid and the payload. Each
+ * command is answered by a kReplyMedia record whose payload is "OK ..." or
+ * "ERR ...".
+ *
+ * publish() never blocks the polling thread: it copies the frame once and
+ * queues a reference to it for every matching subscriber. The relay thread
+ * drains each queue with one gathering sendmsg() per batch of records. A
+ * subscriber whose queue reaches queue_bytes has further frames dropped, and
+ * counted in its next record, rather than slowing anyone else down. Replies
+ * count towards queue_bytes too, but are never dropped: a subscriber whose
+ * unsent replies alone would exceed queue_bytes is disconnected instead.
+ *
+ * The socket is created with mode 0600. Not available on Windows.
+ */
+class Relay {
+public:
+    static constexpr size_t kDefaultQueueBytes = 8 << 20;
+    static constexpr size_t kRecordHeaderSize = 24;
+    static constexpr uint8_t kReplyMedia = 0xff;
+
+    /**
+     * Handles a command other than SUBSCRIBE/UNSUBSCRIBE, split on
+     * whitespace, on the relay thread. Returns the reply payload; an
+     * exception becomes "ERR <what()>".
+     */
+    using CommandFn = std::function<std::string(const std::vector<std::string>& words)>;
+
+    struct Stats {
+        uint64_t frames = 0;    // frames queued, counted once per subscriber
+        uint64_t bytes = 0;     // record bytes written to subscribers
+        uint64_t dropped = 0;   // frames dropped because a subscriber fell behind
+        uint64_t writes = 0;    // sendmsg() calls that wrote something
+    };
+
+    explicit Relay(std::string path, size_t queue_bytes = kDefaultQueueBytes);
+    ~Relay();
+
+    Relay(const Relay&) = delete;
+    Relay& operator=(const Relay&) = delete;
+
+    /** Set before start(). */
+    void setOnCommand(CommandFn callback) { on_command_ = std::move(callback); }
+
+    /**
+     * Bind, listen and start serving. A socket file left by a relay that is
+     * no longer running is replaced. Throws std::invalid_argument if the path
+     * is too long, and rtms::Exception if it is in use, the socket cannot be
+     * set up or the relay is already running.
+     */
+    void start();
+
+    /** Stop serving, disconnect subscribers and remove the socket file. Safe to call more than once. */
+    void stop();
+
+    /**
+     * Queue a frame for every subscriber whose filter matches it. Safe from
+     * any thread, including a frame callback. Returns the number of
+     * subscribers it was queued for.
+     */
+    size_t publish(const std::string& meeting_uuid, ClientMetrics::Media media, const MediaFrameView& frame);
+    size_t publish(const std::string& meeting_uuid, ClientMetrics::Media media, const uint8_t* data,
+                   size_t size, uint64_t timestamp, int user_id);
+
+    bool running() const { return running_.load(std::memory_order_acquire); }
+    const std::string& path() const { return path_; }
+
+    /** Connected subscribers, whether or not they have subscribed. */
+    size_t subscribers() const;
+    Stats stats() const;
+
+private:
+    struct Record {
+        std::array<uint8_t, kRecordHeaderSize> header;
+        FrameRef body;   // meeting uuid then payload, shared by every subscriber it went to
+    };
+
+    struct Subscriber {
+        explicit Subscriber(int fd) : fd(fd) {}
+        int fd;
+        // Guarded by mutex_
+        bool subscribed = false;
+        std::string meeting;          // empty: any
+        bool any_user = true;
+        int user_id = 0;
+        uint32_t media_mask = 0;
+        std::deque<Record> queue;
+        size_t queued_bytes = 0;      // includes records being sent
+        size_t reply_bytes = 0;       // the part of queued_bytes that is replies
+        uint32_t dropped = 0;         // since the last queued record
+        // Relay thread only
+        std::string input;
+        std::deque<Record> sending;
+        size_t sent = 0;              // bytes of sending.front() already written
+        bool closing = false;
+    };
+
+    void serve();
+    void accept();
+    bool receive(Subscriber& subscriber);
+    bool flush(Subscriber& subscriber);
+    std::string handle(Subscriber& subscriber, const std::string& line);
+    void reply(Subscriber& subscriber, const std::string& text);
+    static Record makeRecord(FrameRef body, size_t meeting_size, uint8_t media, int user_id,
+                             uint64_t timestamp, uint32_t dropped);
+
+    const std::string path_;
+    const size_t queue_bytes_;
+    CommandFn on_command_;
+    int listener_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    Notifier wake_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<Subscriber>> subscribers_;
+    std::atomic<size_t> subscribed_{0};   // lets publish() skip copying when nobody listens
+    Stats stats_;
+};
+
+} // namespace rtms
+
+#endif // RTMS_RELAY_H
@@ -0,0 +1,222 @@
+/**
+ * rtms-relay: joins each meeting once and serves its media to any number of
+ * local subscribers over a Unix domain socket (see Relay in relay.h).
+ *
+ *   rtms-relay [--socket PATH] [--media audio,video,deskshare,transcript]
+ *              [--queue-bytes N] [--ca PATH]
+ *
+ * Besides SUBSCRIBE and UNSUBSCRIBE, the socket accepts
+ *
+ *   JOIN <meeting_uuid> <rtms_stream_id> <server_url> <signature>
+ *   LEAVE <meeting_uuid>
+ *   MEETINGS
+ *
+ * so a webhook handler in any language can start and stop streams, signing
+ * the join as it would for its own Client. A JOIN for a meeting that is
+ * already joined is answered without joining again.
+ */
+
+#include "event_loop.h"
+#include "relay.h"
+#include "rtms.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <unistd.h>
+
+using namespace rtms;
+
+namespace {
+
+constexpr const char* kDefaultSocket = "/tmp/rtms-relay.sock";
+
+struct Options {
+    std::string socket = kDefaultSocket;
+    std::string ca;
+    size_t queue_bytes = Relay::kDefaultQueueBytes;
+    std::vector<ClientMetrics::Media> media = {ClientMetrics::Media::Audio, ClientMetrics::Media::Video,
+                                               ClientMetrics::Media::Deskshare,
+                                               ClientMetrics::Media::Transcript};
+};
+
+[[noreturn]] void usage(const char* error = nullptr) {
+    if (error) std::cerr << "rtms-relay: " << error << "\n";
+    std::cerr << "usage: rtms-relay [--socket PATH] [--media audio,video,deskshare,transcript]\n"
+                 "                  [--queue-bytes N] [--ca PATH]\n";
+    std::exit(error ? 2 : 0);
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    if (const char* socket = std::getenv("ZM_RTMS_RELAY_SOCKET")) options.socket = socket;
+    if (const char* ca = std::getenv("ZM_RTMS_CA")) options.ca = ca;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") usage();
+        if (i + 1 >= argc) usage(("missing value for " + arg).c_str());
+        std::string value = argv[++i];
+        if (arg == "--socket") {
+            options.socket = value;
+        } else if (arg == "--ca") {
+            options.ca = value;
+        } else if (arg == "--queue-bytes") {
+            char* end = nullptr;
+            unsigned long long bytes = std::strtoull(value.c_str(), &end, 10);
+            if (*end || bytes == 0) usage(("bad --queue-bytes " + value).c_str());
+            options.queue_bytes = static_cast<size_t>(bytes);
+        } else if (arg == "--media") {
+            options.media.clear();
+            std::istringstream in(value);
+            for (std::string item; std::getline(in, item, ',');) {
+                try {
+                    options.media.push_back(ClientMetrics::parse(item));
+                } catch (const std::invalid_argument& e) {
+                    usage(e.what());
+                }
+            }
+        } else {
+            usage(("unknown option " + arg).c_str());
+        }
+    }
+    return options;
+}
+
+/** The meetings the relay has joined, keyed by meeting uuid. */
+class Meetings {
+public:
+    Meetings(EventLoop& loop, Relay& relay, std::vector<ClientMetrics::Media> media)
+        : loop_(loop), relay_(relay), media_(std::move(media)) {}
+
+    // Relay thread
+    std::string join(const std::vector<std::string>& words) {
+        if (words.size() != 5) return "ERR usage: JOIN <meeting_uuid> <rtms_stream_id> <server_url> <signature>";
+        const std::string& uuid = words[1];
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (sessions_.count(uuid)) return "OK already joined";
+
+        auto client = std::make_shared<Client>(true);
+        for (ClientMetrics::Media media : media_) {
+            auto publish = [this, uuid, media](const MediaFrameView& frame) { relay_.publish(uuid, media, frame); };
+            switch (media) {
+                case ClientMetrics::Media::Audio:      client->setOnAudioFrame(publish); break;
+                case ClientMetrics::Media::Video:      client->setOnVideoFrame(publish); break;
+                case ClientMetrics::Media::Deskshare:  client->setOnDeskshareFrame(publish); break;
+                case ClientMetrics::Media::Transcript: client->setOnTranscriptFrame(publish); break;
+            }
+        }
+        auto session = std::make_shared<ClientSession>(client, uuid, words[2], words[4], words[3]);
+        std::weak_ptr<ClientSession> weak = session;
+        client->setOnLeave([this, uuid, weak](int reason) {
+            std::cerr << "rtms-relay: left " << uuid << " (reason " << reason << ")" << std::endl;
+            forget(uuid, weak.lock());
+        });
+        session->setOnJoinFailed([this, uuid, weak](int error) {
+            std::cerr << "rtms-relay: failed to join " << uuid << " (error " << error << ")" << std::endl;
+            forget(uuid, weak.lock());
+        });
+
+        loop_.add(session);
+        sessions_[uuid] = session;
+        return "OK";
+    }
+
+    // Relay thread
+    std::string leave(const std::vector<std::string>& words) {
+        if (words.size() != 2) return "ERR usage: LEAVE <meeting_uuid>";
+        std::shared_ptr<ClientSession> session;
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            auto it = sessions_.find(words[1]);
+            if (it == sessions_.end()) return "ERR not joined: " + words[1];
+            session = it->second;
+            sessions_.erase(it);
+        }
+        loop_.remove(session);
+        return "OK";
+    }
+
+    std::string list() {
+        std::lock_guard<std::mutex> lk(mutex_);
+        std::string reply = "OK";
+        for (const auto& entry : sessions_) reply += " " + entry.first;
+        return reply;
+    }
+
+private:
+    // Loop thread, so remove() only schedules the removal
+    void forget(const std::string& uuid, const std::shared_ptr<ClientSession>& session) {
+        if (!session) return;
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            auto it = sessions_.find(uuid);
+            if (it != sessions_.end() && it->second == session) sessions_.erase(it);
+        }
+        loop_.remove(session);
+    }
+
+    EventLoop& loop_;
+    Relay& relay_;
+    const std::vector<ClientMetrics::Media> media_;
+    std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<ClientSession>> sessions_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options = parseOptions(argc, argv);
+
+    // Every thread started from here on leaves these to the signal thread
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    EventLoop loop(PollMode::Balanced, "rtms-relay");
+    Relay relay(options.socket, options.queue_bytes);
+    Meetings meetings(loop, relay, options.media);
+    relay.setOnCommand([&meetings](const std::vector<std::string>& words) -> std::string {
+        if (words[0] == "JOIN") return meetings.join(words);
+        if (words[0] == "LEAVE") return meetings.leave(words);
+        if (words[0] == "MEETINGS") return meetings.list();
+        return "ERR unknown command " + words[0];
+    });
+
+    try {
+        // The SDK is initialized on the thread that joins and polls: this one
+        Client::initialize(options.ca, 1, "rtms-relay");
+        relay.start();
+    } catch (const std::exception& e) {
+        std::cerr << "rtms-relay: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cerr << "rtms-relay: listening on " << relay.path() << std::endl;
+
+    std::thread waiter([&] {
+        int signal = 0;
+        sigwait(&signals, &signal);
+        loop.stop();
+    });
+
+    loop.run();
+    relay.stop();
+    // Wakes the signal thread if the loop stopped on its own
+    ::kill(::getpid(), SIGTERM);
+    waiter.join();
+    Client::uninitialize();
+    return 0;
+}
@@ -1,7 +1,9 @@
 #include "rtms.h"
+#include "trace.h"
 #include <cstring>
 #include <iostream>
 #include <algorithm>
+#include <unordered_map>
 
 namespace rtms {
 
@@ -23,6 +25,11 @@ int AiTargetLanguage::toneId() const { return tone_id_; }
 string AiTargetLanguage::voiceId() const { return voice_id_; }
 string AiTargetLanguage::engine() const { return engine_; }
 
+bool AiTargetLanguage::matches(const ai_target_lan& atl) const {
+    return lid_ == atl.lid && tone_id_ == atl.toneid &&
+           voice_id_ == atl.voice_id && engine_ == atl.engine;
+}
+
 AiInterpreter::AiInterpreter(const ai_interpreter& aii)
     : lid_(aii.lid),
       timestamp_(aii.timestamp),
@@ -40,18 +47,85 @@ int AiInterpreter::channelNum() const { return channel_num_; }
 int AiInterpreter::sampleRate() const { return sample_rate_; }
 const vector<AiTargetLanguage>& AiInterpreter::targets() const { return targets_; }
 
+bool AiInterpreter::matches(const ai_interpreter& aii) const {
+    size_t count = (aii.target_size > 0 && aii.target_size < 100) ? aii.target_size : 0;
+    if (lid_ != aii.lid || timestamp_ != aii.timestamp || channel_num_ != aii.channel_num ||
+        sample_rate_ != aii.sample_rate || targets_.size() != count)
+        return false;
+    for (size_t i = 0; i < count; ++i)
+        if (!targets_[i].matches(aii.atl[i]))
+            return false;
+    return true;
+}
+
+Metadata::Details::Details(const rtms_metadata& metadata)
+    : user_name(metadata.user_name ? metadata.user_name : ""),
+      ai_interpreter(metadata.aii) {}
+
+bool Metadata::Details::matches(const rtms_metadata& metadata) const {
+    return user_name == (metadata.user_name ? metadata.user_name : "") &&
+           ai_interpreter.matches(metadata.aii);
+}
+
 Metadata::Metadata(const rtms_metadata& metadata)
-    : user_name_(metadata.user_name ? metadata.user_name : ""),
-      user_id_(metadata.user_id),
+    : Metadata(metadata, make_shared<const Details>(metadata)) {}
+
+Metadata::Metadata(const rtms_metadata& metadata, shared_ptr<const Details> details)
+    : user_id_(metadata.user_id),
       start_ts_(metadata.start_ts),
       end_ts_(metadata.end_ts),
-      ai_interpreter_(metadata.aii) {}
+      details_(std::move(details)) {}
+
+shared_ptr<const Metadata::Details> Metadata::sharedDetails(const rtms_metadata& metadata) {
+    // Per thread, so the SDK callback threads of different clients never contend
+    thread_local unordered_map<int, shared_ptr<const Details>> users;
 
-string Metadata::userName() const { return user_name_; }
+    auto it = users.find(metadata.user_id);
+    if (it != users.end() && it->second->matches(metadata))
+        return it->second;
+
+    auto details = make_shared<const Details>(metadata);
+    if (it != users.end()) {
+        it->second = details;
+    } else {
+        if (users.size() >= kMaxSharedUsers)
+            users.clear();
+        users.emplace(metadata.user_id, details);
+    }
+    return details;
+}
+
+string Metadata::userName() const { return details_->user_name; }
 int Metadata::userId() const { return user_id_; }
 uint64_t Metadata::startTs() const { return start_ts_; }
 uint64_t Metadata::endTs() const { return end_ts_; }
-const AiInterpreter& Metadata::aiInterpreter() const { return ai_interpreter_; }
+const AiInterpreter& Metadata::aiInterpreter() const { return details_->ai_interpreter; }
+
+MediaFrameView::MediaFrameView(const uint8_t* data, size_t size, uint64_t timestamp, const rtms_metadata& metadata)
+    : data_(data),
+      size_(size),
+      timestamp_(timestamp),
+      metadata_(&metadata) {}
+
+const uint8_t* MediaFrameView::data() const { return data_; }
+size_t MediaFrameView::size() const { return size_; }
+uint64_t MediaFrameView::timestamp() const { return timestamp_; }
+int MediaFrameView::userId() const { return metadata_->user_id; }
+const char* MediaFrameView::userName() const { return metadata_->user_name ? metadata_->user_name : ""; }
+const rtms_metadata& MediaFrameView::rawMetadata() const { return *metadata_; }
+Metadata MediaFrameView::metadata() const { return Metadata(*metadata_); }
+MediaFrame MediaFrameView::retain() const { return MediaFrame(*this); }
+
+MediaFrame::MediaFrame(const MediaFrameView& view)
+    : buffer_(FramePool::shared().copy(view.data(), view.size())),
+      timestamp_(view.timestamp()),
+      metadata_(view.rawMetadata(), Metadata::sharedDetails(view.rawMetadata())) {}
+
+const uint8_t* MediaFrame::data() const { return buffer_.data(); }
+size_t MediaFrame::size() const { return buffer_.size(); }
+uint64_t MediaFrame::timestamp() const { return timestamp_; }
+const Metadata& MediaFrame::metadata() const { return metadata_; }
+const FrameRef& MediaFrame::buffer() const { return buffer_; }
 
 Session::Session(const session_info& info)
     : stat_time_(info.stat_time),
@@ -504,19 +578,33 @@ media_parameters MediaParams::toNative() const {
     return params;
 }
 
-Client::Client()
+Client::Client() : Client(false) {}
+
+Client::Client(bool defer_alloc)
     : sdk_(nullptr),
+      awaiting_alloc_(defer_alloc),
       enabled_media_types_(0),
       media_params_updated_(false),
       sdk_opened_(false),
+      callbacks_(nullptr),
+      dispatching_(0),
+      has_retired_callbacks_(false),
+      sink_calls_(0),
       join_confirmed_(false) {
-    sdk_ = rtms_sdk_provider::instance()->create_sdk();
-    if (!sdk_) {
-        throw Exception(RTMS_SDK_FAILURE, "Failed to allocate RTMS SDK instance");
+    if (!defer_alloc) {
+        sdk_ = rtms_sdk_provider::instance()->create_sdk();
+        if (!sdk_) {
+            throw Exception(RTMS_SDK_FAILURE, "Failed to allocate RTMS SDK instance");
+        }
     }
+    callbacks_.store(new CallbackTable(), memory_order_release);
+    MetricsRegistry::global().add(this);
 }
 
 Client::~Client() {
+    // Leave the registry first so a concurrent scrape never sees a half-destroyed client
+    MetricsRegistry::global().remove(this);
+
     try {
         if (sdk_) {
             rtms_sdk_provider::instance()->release_sdk(sdk_);
@@ -525,6 +613,10 @@ Client::~Client() {
     } catch (const exception& e) {
         cerr << "Error during Client destruction: " << e.what() << endl;
     }
+
+    // The SDK handle is gone, so no sink can be dispatching any more
+    for (const CallbackTable* table : retired_callbacks_) delete table;
+    delete callbacks_.load(memory_order_acquire);
 }
 
 void Client::initialize(const string& ca_path, int is_verify_cert, const char* agent) {
@@ -581,7 +673,11 @@ void Client::configure(const MediaParams& params, int media_types, bool enable_a
 #ifdef RTMS_DEBUG
         cerr << "[DEBUG CONFIG] Calling config with NULL params, media_types=" << media_types << endl;
 #endif
-        int result = sdk_->config(nullptr, media_types, enable_application_layer_encryption ? 1 : 0);
+        int result;
+        {
+            RTMS_TRACE_SCOPE("sdk.config");
+            result = sdk_->config(nullptr, media_types, enable_application_layer_encryption ? 1 : 0);
+        }
         throwIfError(result, "configure with null params");
         return;
     }
@@ -599,7 +695,11 @@ void Client::configure(const MediaParams& params, int media_types, bool enable_a
     }
 #endif
 
-    int result = sdk_->config(&native_params, media_types, enable_application_layer_encryption ? 1 : 0);
+    int result;
+    {
+        RTMS_TRACE_SCOPE("sdk.config");
+        result = sdk_->config(&native_params, media_types, enable_application_layer_encryption ? 1 : 0);
+    }
 
     if (native_params.audio_param) {
         delete native_params.audio_param;
@@ -649,18 +749,24 @@ void Client::updateMediaConfiguration(int mediaType, bool enable) {
 
 void Client::setOnJoinConfirm(JoinConfirmFn callback) {
     lock_guard<mutex> lock(mutex_);
-    join_confirm_callback_ = std::move(callback);
+    auto next = copyCallbacks();
+    next->join_confirm = std::move(callback);
+    publishCallbacks(std::move(next));
 }
 
 void Client::setOnSessionUpdate(SessionUpdateFn callback) {
     lock_guard<mutex> lock(mutex_);
-    session_update_callback_ = std::move(callback);
+    auto next = copyCallbacks();
+    next->session_update = std::move(callback);
+    publishCallbacks(std::move(next));
 }
 
 void Client::setOnUserUpdate(UserUpdateFn callback) {
     {
         lock_guard<mutex> lock(mutex_);
-        user_update_callback_ = std::move(callback);
+        auto next = copyCallbacks();
+        next->user_update = std::move(callback);
+        publishCallbacks(std::move(next));
     }
     subscribeEvent({
         (int)EVENT_TYPE::ACTIVE_SPEAKER_CHANGE,
@@ -669,47 +775,136 @@ void Client::setOnUserUpdate(UserUpdateFn callback) {
     });
 }
 
+// Adapts a legacy vector-based data callback onto the frame callback path.
+// The copy into a vector only happens for callers that asked for one.
+static Client::MediaFrameFn toFrameCallback(Client::AudioDataFn callback) {
+    if (!callback) return nullptr;
+    return [callback = std::move(callback)](const MediaFrameView& frame) {
+        vector<uint8_t> data(frame.data(), frame.data() + frame.size());
+        callback(data, frame.timestamp(), frame.metadata());
+    };
+}
+
 void Client::setOnDeskshareData(DsDataFn callback){
+    setOnDeskshareFrame(toFrameCallback(std::move(callback)));
+}
+
+void Client::setOnAudioData(AudioDataFn callback) {
+    setOnAudioFrame(toFrameCallback(std::move(callback)));
+}
+
+void Client::setOnVideoData(VideoDataFn callback) {
+    setOnVideoFrame(toFrameCallback(std::move(callback)));
+}
+
+void Client::setOnTranscriptData(TranscriptDataFn callback) {
+    setOnTranscriptFrame(toFrameCallback(std::move(callback)));
+}
+
+void Client::setOnDeskshareFrame(MediaFrameFn callback) {
     lock_guard<mutex> lock(mutex_);
-    ds_data_callback_ = std::move(callback);
+    auto next = copyCallbacks();
+    next->ds_frame = std::move(callback);
+    publishCallbacks(std::move(next));
 
     updateMediaConfiguration(MediaType::DESKSHARE);
 }
 
-void Client::setOnAudioData(AudioDataFn callback) {
+void Client::setOnAudioFrame(MediaFrameFn callback) {
     lock_guard<mutex> lock(mutex_);
-    audio_data_callback_ = std::move(callback);
+    auto next = copyCallbacks();
+    next->audio_frame = std::move(callback);
+    publishCallbacks(std::move(next));
 
     updateMediaConfiguration(MediaType::AUDIO);
 }
 
-void Client::setOnVideoData(VideoDataFn callback) {
+void Client::setOnVideoFrame(MediaFrameFn callback) {
     lock_guard<mutex> lock(mutex_);
-    video_data_callback_ = std::move(callback);
+    auto next = copyCallbacks();
+    next->video_frame = std::move(callback);
+    publishCallbacks(std::move(next));
 
     updateMediaConfiguration(MediaType::VIDEO);
 }
 
-void Client::setOnTranscriptData(TranscriptDataFn callback) {
+void Client::setOnTranscriptFrame(MediaFrameFn callback) {
     lock_guard<mutex> lock(mutex_);
-    transcript_data_callback_ = std::move(callback);
+    auto next = copyCallbacks();
+    next->transcript_frame = std::move(callback);
+    publishCallbacks(std::move(next));
 
     updateMediaConfiguration(MediaType::TRANSCRIPT);
 }
 
+static size_t batchSlot(ClientMetrics::Media media) {
+    return static_cast<size_t>(media);
+}
+
+static ClientMetrics::Callback batchCallback(ClientMetrics::Media media) {
+    switch (media) {
+        case ClientMetrics::Media::Audio:      return ClientMetrics::Callback::AudioBatch;
+        case ClientMetrics::Media::Video:      return ClientMetrics::Callback::VideoBatch;
+        case ClientMetrics::Media::Deskshare:  return ClientMetrics::Callback::DeskshareBatch;
+        case ClientMetrics::Media::Transcript: return ClientMetrics::Callback::TranscriptBatch;
+    }
+    return ClientMetrics::Callback::AudioBatch;
+}
+
+void Client::setOnBatch(ClientMetrics::Media media, MediaBatchFn callback) {
+    lock_guard<mutex> lock(mutex_);
+    auto next = copyCallbacks();
+    next->batch[batchSlot(media)] = std::move(callback);
+    publishCallbacks(std::move(next));
+
+    switch (media) {
+        case ClientMetrics::Media::Audio:      updateMediaConfiguration(MediaType::AUDIO); break;
+        case ClientMetrics::Media::Video:      updateMediaConfiguration(MediaType::VIDEO); break;
+        case ClientMetrics::Media::Deskshare:  updateMediaConfiguration(MediaType::DESKSHARE); break;
+        case ClientMetrics::Media::Transcript: updateMediaConfiguration(MediaType::TRANSCRIPT); break;
+    }
+}
+
+void Client::setOnDeskshareBatch(MediaBatchFn callback) {
+    setOnBatch(ClientMetrics::Media::Deskshare, std::move(callback));
+}
+
+void Client::setOnAudioBatch(MediaBatchFn callback) {
+    setOnBatch(ClientMetrics::Media::Audio, std::move(callback));
+}
+
+void Client::setOnVideoBatch(MediaBatchFn callback) {
+    setOnBatch(ClientMetrics::Media::Video, std::move(callback));
+}
+
+void Client::setOnTranscriptBatch(MediaBatchFn callback) {
+    setOnBatch(ClientMetrics::Media::Transcript, std::move(callback));
+}
+
+void Client::setOnBatchesDone(BatchesDoneFn callback) {
+    lock_guard<mutex> lock(mutex_);
+    auto next = copyCallbacks();
+    next->batches_done = std::move(callback);
+    publishCallbacks(std::move(next));
+}
+
 void Client::setOnLeave(LeaveFn callback) {
     lock_guard<mutex> lock(mutex_);
-    leave_callback_ = std::move(callback);
+    auto next = copyCallbacks();
+    next->leave = std::move(callback);
+    publishCallbacks(std::move(next));
 }
 
 void Client::setOnEventEx(EventExFn callback) {
     lock_guard<mutex> lock(mutex_);
-    event_ex_callback_ = std::move(callback);
+    auto next = copyCallbacks();
+    next->event_ex = std::move(callback);
+    publishCallbacks(std::move(next));
 }
 
 void Client::subscribeEvent(const std::vector<int>& events) {
     if (events.empty()) return;
-    if (!sdk_) {
+    if (!sdk_ && !awaiting_alloc_) {
         throw Exception(RTMS_SDK_INVALID_STATUS, "SDK not initialized");
     }
 
@@ -833,6 +1028,12 @@ void Client::setTranscriptParams(const TranscriptParams& transcript_params)
 
 void Client::setProxy(const string& proxy_type, const string& proxy_url)
 {
+    if (!sdk_ && awaiting_alloc_) {
+        pending_proxy_type_ = proxy_type;
+        pending_proxy_url_ = proxy_url;
+        return;
+    }
+
     int result = sdk_->set_proxy(proxy_type.c_str(), proxy_url.c_str());
     if (result != 0) {
         throw Exception(result, "setProxy failed: Operation failed");
@@ -841,6 +1042,10 @@ void Client::setProxy(const string& proxy_type, const string& proxy_url)
 
 void Client::subscribeVideo(int user_id, bool subscribe)
 {
+    if (!sdk_) {
+        throw Exception(RTMS_SDK_INVALID_STATUS, "SDK not initialized");
+    }
+
     int result = sdk_->send_subscript_video(user_id, subscribe);
     throwIfError(result, "subscribeVideo");
 }
@@ -849,7 +1054,9 @@ void Client::setOnParticipantVideo(ParticipantVideoFn callback)
 {
     {
         lock_guard<mutex> lock(mutex_);
-        participant_video_callback_ = std::move(callback);
+        auto next = copyCallbacks();
+        next->participant_video = std::move(callback);
+        publishCallbacks(std::move(next));
     }
     subscribeEvent({
         (int)EVENT_TYPE::PARTICIPANT_VIDEO_ON,
@@ -860,11 +1067,38 @@ void Client::setOnParticipantVideo(ParticipantVideoFn callback)
 void Client::setOnVideoSubscribed(VideoSubscribedFn callback)
 {
     lock_guard<mutex> lock(mutex_);
-    video_subscribed_callback_ = std::move(callback);
+    auto next = copyCallbacks();
+    next->video_subscribed = std::move(callback);
+    publishCallbacks(std::move(next));
+}
+
+void Client::alloc() {
+    if (sdk_) return;
+    if (!awaiting_alloc_) {
+        throw Exception(RTMS_SDK_INVALID_STATUS, "Client has already been released");
+    }
+
+    sdk_ = rtms_sdk_provider::instance()->create_sdk();
+    if (!sdk_) {
+        throw Exception(RTMS_SDK_FAILURE, "Failed to allocate RTMS SDK instance");
+    }
+    awaiting_alloc_ = false;
+
+    if (!pending_proxy_type_.empty()) {
+        setProxy(pending_proxy_type_, pending_proxy_url_);
+        pending_proxy_type_.clear();
+        pending_proxy_url_.clear();
+    }
+}
+
+bool Client::allocated() const {
+    return sdk_ != nullptr;
 }
 
 void Client::join(const string& meeting_uuid, const string& rtms_stream_id,
                     const string& signature, const string& server_url, int timeout) {
+    alloc();
+
     // Register this client as the sink — replaces the old static callback registry
     int result = sdk_->open(this);
     throwIfError(result, "open");
@@ -882,8 +1116,11 @@ void Client::join(const string& meeting_uuid, const string& rtms_stream_id,
         }
     }
 
-    result = sdk_->join(meeting_uuid.c_str(), rtms_stream_id.c_str(),
-                        signature.c_str(), server_url.c_str(), timeout);
+    {
+        RTMS_TRACE_SCOPE("sdk.join");
+        result = sdk_->join(meeting_uuid.c_str(), rtms_stream_id.c_str(),
+                            signature.c_str(), server_url.c_str(), timeout);
+    }
     throwIfError(result, "join");
 
     lock_guard<mutex> lock(mutex_);
@@ -891,9 +1128,25 @@ void Client::join(const string& meeting_uuid, const string& rtms_stream_id,
     rtms_stream_id_ = rtms_stream_id;
 }
 
-void Client::poll() {
-    int result = sdk_->poll();
+bool Client::poll() {
+    uint64_t sink_calls = sink_calls_.load(memory_order_relaxed);
+    int result;
+    {
+        RTMS_TRACE_SCOPE("sdk.poll");
+        LatencyHistogram::Timer timer(metrics_.poll());
+        result = sdk_->poll();
+        deliverBatches();
+    }
+
+    // poll() is where the sinks run, so its return is a quiescent point for
+    // freeing callback tables replaced while frames were being dispatched.
+    if (has_retired_callbacks_.load(memory_order_acquire)) {
+        lock_guard<mutex> lock(mutex_);
+        reclaimRetiredCallbacks();
+    }
+
     throwIfError(result, "poll");
+    return sink_calls_.load(memory_order_relaxed) != sink_calls;
 }
 
 void Client::markClosed() {
@@ -902,6 +1155,12 @@ void Client::markClosed() {
 }
 
 void Client::release() {
+    if (!sdk_) {
+        // Never allocated (deferred) or already released
+        awaiting_alloc_ = false;
+        return;
+    }
+
     sdk_->leave(0);
 
     {
@@ -914,6 +1173,8 @@ void Client::release() {
 
     rtms_sdk_provider::instance()->release_sdk(sdk_);
     sdk_ = nullptr;
+
+    for (auto& frames : batches_) frames.clear();
 }
 
 string Client::uuid() const {
@@ -956,6 +1217,30 @@ void Client::throwIfError(int result, const string& operation) const {
     }
 }
 
+unique_ptr<Client::CallbackTable> Client::copyCallbacks() const {
+    // Called with mutex_ held, so no other writer can swap the table under us
+    return make_unique<CallbackTable>(*callbacks_.load(memory_order_acquire));
+}
+
+void Client::publishCallbacks(unique_ptr<CallbackTable> next) {
+    // Called with mutex_ held
+    const CallbackTable* previous = callbacks_.exchange(next.release(), memory_order_seq_cst);
+    retired_callbacks_.push_back(previous);
+    has_retired_callbacks_.store(true, memory_order_release);
+    reclaimRetiredCallbacks();
+}
+
+void Client::reclaimRetiredCallbacks() {
+    // Called with mutex_ held. A sink bumps dispatching_ before loading
+    // callbacks_, so once the count reads zero every retired table has been
+    // swapped out before any in-flight reader could have loaded it.
+    if (retired_callbacks_.empty() || dispatching_.load(memory_order_seq_cst) != 0) return;
+
+    for (const CallbackTable* table : retired_callbacks_) delete table;
+    retired_callbacks_.clear();
+    has_retired_callbacks_.store(false, memory_order_release);
+}
+
 void Client::processPendingSubscriptions() {
     // Called with mutex_ already held
     if (pending_event_subscriptions_.empty()) return;
@@ -982,120 +1267,213 @@ void Client::processPendingSubscriptions() {
 // rtms_sdk_sink virtual overrides
 // ============================================================================
 
+// Pins the current callback table for the duration of one dispatch. Lock-free:
+// registration on another thread never waits on a running callback, and the
+// table seen here stays alive until the snapshot is destroyed.
+class Client::CallbackSnapshot {
+public:
+    explicit CallbackSnapshot(const Client& client) : client_(client) {
+        client_.dispatching_.fetch_add(1, memory_order_seq_cst);
+        table_ = client_.callbacks_.load(memory_order_seq_cst);
+        client_.sink_calls_.fetch_add(1, memory_order_relaxed);
+    }
+    ~CallbackSnapshot() {
+        client_.dispatching_.fetch_sub(1, memory_order_release);
+    }
+    CallbackSnapshot(const CallbackSnapshot&) = delete;
+    CallbackSnapshot& operator=(const CallbackSnapshot&) = delete;
+
+    const CallbackTable* operator->() const { return table_; }
+
+private:
+    const Client& client_;
+    const CallbackTable* table_;
+};
+
+void Client::deliverBatches() {
+    bool pending = false;
+    for (const auto& frames : batches_) pending = pending || !frames.empty();
+    if (!pending) return;
+
+    CallbackSnapshot callbacks(*this);
+    bool delivered = false;
+    for (size_t i = 0; i < batches_.size(); ++i) {
+        auto& frames = batches_[i];
+        if (frames.empty()) continue;
+        // Cleared even if the callback throws; the capacity is kept for the next poll
+        struct Clear {
+            vector<MediaFrame>& frames;
+            ~Clear() { frames.clear(); }
+        } clear{frames};
+        if (callbacks->batch[i]) {
+            RTMS_TRACE_SCOPE("client.batch");
+            LatencyHistogram::Timer timer(metrics_.callback(batchCallback(static_cast<ClientMetrics::Media>(i))));
+            callbacks->batch[i](frames);
+            delivered = true;
+        }
+    }
+    if (delivered && callbacks->batches_done) callbacks->batches_done();
+}
+
 void Client::on_join_confirm(int reason) {
-    lock_guard<mutex> lock(mutex_);
+    RTMS_TRACE_SCOPE("sink.join_confirm");
+    {
+        lock_guard<mutex> lock(mutex_);
 
-    // Mark as joined FIRST
-    join_confirmed_ = true;
+        // Mark as joined FIRST
+        join_confirmed_ = true;
 
-    // Process any pending event subscriptions before user callback
-    processPendingSubscriptions();
+        // Process any pending event subscriptions before user callback
+        processPendingSubscriptions();
+    }
 
-    // Then invoke user callback
-    if (join_confirm_callback_) {
-        join_confirm_callback_(reason);
+    // Then invoke user callback, outside the lock so it may call back into the client
+    CallbackSnapshot callbacks(*this);
+    if (callbacks->join_confirm) {
+        LatencyHistogram::Timer timer(metrics_.callback(ClientMetrics::Callback::JoinConfirm));
+        callbacks->join_confirm(reason);
     }
 }
 
 void Client::on_session_update(int op, struct session_info* sess) {
+    RTMS_TRACE_SCOPE("sink.session_update");
     if (sess) {
-        lock_guard<mutex> lock(mutex_);
-        if (session_update_callback_) {
+        CallbackSnapshot callbacks(*this);
+        if (callbacks->session_update) {
+            LatencyHistogram::Timer timer(metrics_.callback(ClientMetrics::Callback::SessionUpdate));
             Session session(*sess);
-            session_update_callback_(op, session);
+            callbacks->session_update(op, session);
         }
     }
 }
 
 void Client::on_user_update(int op, struct participant_info* pi) {
+    RTMS_TRACE_SCOPE("sink.user_update");
     if (pi) {
-        lock_guard<mutex> lock(mutex_);
-        if (user_update_callback_) {
+        CallbackSnapshot callbacks(*this);
+        if (callbacks->user_update) {
+            LatencyHistogram::Timer timer(metrics_.callback(ClientMetrics::Callback::UserUpdate));
             Participant participant(*pi);
-            user_update_callback_(op, participant);
+            callbacks->user_update(op, participant);
         }
     }
 }
 
 void Client::on_ds_data(unsigned char* data_buf, int size, uint64_t timestamp, struct rtms_metadata* md) {
+    RTMS_TRACE_SCOPE("sink.deskshare");
     if (data_buf && size > 0 && md) {
-        lock_guard<mutex> lock(mutex_);
-        if (ds_data_callback_) {
-            vector<uint8_t> data(data_buf, data_buf + size);
-            Metadata metadata(*md);
-            ds_data_callback_(data, timestamp, metadata);
+        metrics_.recordFrame(ClientMetrics::Media::Deskshare, static_cast<size_t>(size));
+        CallbackSnapshot callbacks(*this);
+        MediaFrameView frame(data_buf, static_cast<size_t>(size), timestamp, *md);
+        if (callbacks->ds_frame) {
+            LatencyHistogram::Timer timer(metrics_.callback(ClientMetrics::Callback::Deskshare));
+            callbacks->ds_frame(frame);
+        }
+        if (callbacks->batch[batchSlot(ClientMetrics::Media::Deskshare)]) {
+            batches_[batchSlot(ClientMetrics::Media::Deskshare)].emplace_back(frame);
         }
+    } else {
+        metrics_.recordEmpty(ClientMetrics::Media::Deskshare);
     }
 }
 
 void Client::on_audio_data(unsigned char* data_buf, int size, uint64_t timestamp, struct rtms_metadata* md) {
+    RTMS_TRACE_SCOPE("sink.audio");
     if (data_buf && size > 0 && md) {
+        metrics_.recordFrame(ClientMetrics::Media::Audio, static_cast<size_t>(size));
 #ifdef RTMS_DEBUG
         cerr << "[DEBUG AUDIO] md->user_id=" << md->user_id
              << " md->user_name=" << (md->user_name ? md->user_name : "(null)") << endl;
 #endif
-        lock_guard<mutex> lock(mutex_);
-        if (audio_data_callback_) {
-            vector<uint8_t> data(data_buf, data_buf + size);
-            Metadata metadata(*md);
-            audio_data_callback_(data, timestamp, metadata);
+        CallbackSnapshot callbacks(*this);
+        MediaFrameView frame(data_buf, static_cast<size_t>(size), timestamp, *md);
+        if (callbacks->audio_frame) {
+            LatencyHistogram::Timer timer(metrics_.callback(ClientMetrics::Callback::Audio));
+            callbacks->audio_frame(frame);
         }
+        if (callbacks->batch[batchSlot(ClientMetrics::Media::Audio)]) {
+            batches_[batchSlot(ClientMetrics::Media::Audio)].emplace_back(frame);
+        }
+    } else {
+        metrics_.recordEmpty(ClientMetrics::Media::Audio);
     }
 }
 
 void Client::on_video_data(unsigned char* data_buf, int size, uint64_t timestamp, struct rtms_metadata* md) {
+    RTMS_TRACE_SCOPE("sink.video");
     if (data_buf && size > 0 && md) {
-        lock_guard<mutex> lock(mutex_);
-        if (video_data_callback_) {
-            vector<uint8_t> data(data_buf, data_buf + size);
-            Metadata metadata(*md);
-            video_data_callback_(data, timestamp, metadata);
+        metrics_.recordFrame(ClientMetrics::Media::Video, static_cast<size_t>(size));
+        CallbackSnapshot callbacks(*this);
+        MediaFrameView frame(data_buf, static_cast<size_t>(size), timestamp, *md);
+        if (callbacks->video_frame) {
+            LatencyHistogram::Timer timer(metrics_.callback(ClientMetrics::Callback::Video));
+            callbacks->video_frame(frame);
+        }
+        if (callbacks->batch[batchSlot(ClientMetrics::Media::Video)]) {
+            batches_[batchSlot(ClientMetrics::Media::Video)].emplace_back(frame);
         }
+    } else {
+        metrics_.recordEmpty(ClientMetrics::Media::Video);
     }
 }
 
 void Client::on_transcript_data(unsigned char* data_buf, int size, uint64_t timestamp, struct rtms_metadata* md) {
+    RTMS_TRACE_SCOPE("sink.transcript");
     if (data_buf && size > 0 && md) {
+        metrics_.recordFrame(ClientMetrics::Media::Transcript, static_cast<size_t>(size));
 #ifdef RTMS_DEBUG
         cerr << "[DEBUG TRANSCRIPT] md->user_id=" << md->user_id
              << " md->user_name=" << (md->user_name ? md->user_name : "(null)") << endl;
 #endif
-        lock_guard<mutex> lock(mutex_);
-        if (transcript_data_callback_) {
-            vector<uint8_t> data(data_buf, data_buf + size);
-            Metadata metadata(*md);
-            transcript_data_callback_(data, timestamp, metadata);
+        CallbackSnapshot callbacks(*this);
+        MediaFrameView frame(data_buf, static_cast<size_t>(size), timestamp, *md);
+        if (callbacks->transcript_frame) {
+            LatencyHistogram::Timer timer(metrics_.callback(ClientMetrics::Callback::Transcript));
+            callbacks->transcript_frame(frame);
         }
+        if (callbacks->batch[batchSlot(ClientMetrics::Media::Transcript)]) {
+            batches_[batchSlot(ClientMetrics::Media::Transcript)].emplace_back(frame);
+        }
+    } else {
+        metrics_.recordEmpty(ClientMetrics::Media::Transcript);
     }
 }
 
 void Client::on_leave(int reason) {
-    lock_guard<mutex> lock(mutex_);
-    if (leave_callback_) {
-        leave_callback_(reason);
+    RTMS_TRACE_SCOPE("sink.leave");
+    CallbackSnapshot callbacks(*this);
+    if (callbacks->leave) {
+        LatencyHistogram::Timer timer(metrics_.callback(ClientMetrics::Callback::Leave));
+        callbacks->leave(reason);
     }
 }
 
 void Client::on_event_ex(const std::string& compact_str) {
+    RTMS_TRACE_SCOPE("sink.event_ex");
     if (!compact_str.empty()) {
-        lock_guard<mutex> lock(mutex_);
-        if (event_ex_callback_) {
-            event_ex_callback_(compact_str);
+        CallbackSnapshot callbacks(*this);
+        if (callbacks->event_ex) {
+            LatencyHistogram::Timer timer(metrics_.callback(ClientMetrics::Callback::EventEx));
+            callbacks->event_ex(compact_str);
         }
     }
 }
 
 void Client::on_participant_video(std::vector<int> users, bool is_on) {
-    lock_guard<mutex> lock(mutex_);
-    if (participant_video_callback_) {
-        participant_video_callback_(users, is_on);
+    RTMS_TRACE_SCOPE("sink.participant_video");
+    CallbackSnapshot callbacks(*this);
+    if (callbacks->participant_video) {
+        LatencyHistogram::Timer timer(metrics_.callback(ClientMetrics::Callback::ParticipantVideo));
+        callbacks->participant_video(users, is_on);
     }
 }
 
 void Client::on_video_subscript_resp(int user_id, int status, std::string error) {
-    lock_guard<mutex> lock(mutex_);
-    if (video_subscribed_callback_) {
-        video_subscribed_callback_(user_id, status, error);
+    RTMS_TRACE_SCOPE("sink.video_subscribed");
+    CallbackSnapshot callbacks(*this);
+    if (callbacks->video_subscribed) {
+        LatencyHistogram::Timer timer(metrics_.callback(ClientMetrics::Callback::VideoSubscribed));
+        callbacks->video_subscribed(user_id, status, error);
     }
 }
 
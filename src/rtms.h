@@ -2,7 +2,12 @@
 #define RTMS_H
 
 #include "rtms_sdk.h"
+#include "frame_pool.h"
+#include "metrics.h"
+#include <array>
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <sstream>
 #include <thread>
 #include <mutex>
@@ -62,6 +67,9 @@ public:
     string voiceId() const;
     string engine() const;
 
+    bool operator==(const AiTargetLanguage&) const = default;
+    bool matches(const ai_target_lan& atl) const;   // equal to AiTargetLanguage(atl), without building it
+
 private:
     int lid_;
     int tone_id_;
@@ -79,6 +87,9 @@ public:
     int sampleRate() const;
     const vector<AiTargetLanguage>& targets() const;
 
+    bool operator==(const AiInterpreter&) const = default;
+    bool matches(const ai_interpreter& aii) const;   // equal to AiInterpreter(aii), without building it
+
 private:
     int lid_;
     uint64_t timestamp_;
@@ -87,6 +98,13 @@ private:
     vector<AiTargetLanguage> targets_;
 };
 
+/**
+ * A participant's metadata for one frame.
+ *
+ * The user name and interpreter details, which repeat from frame to frame,
+ * are held in an immutable object shared between copies, so copying a
+ * Metadata never allocates.
+ */
 class Metadata {
 public:
     explicit Metadata(const rtms_metadata& metadata);
@@ -98,11 +116,91 @@ public:
     const AiInterpreter& aiInterpreter() const;
 
 private:
-    string user_name_;
+    friend class MediaFrame;
+
+    struct Details {
+        explicit Details(const rtms_metadata& metadata);
+        bool matches(const rtms_metadata& metadata) const;
+
+        string user_name;
+        AiInterpreter ai_interpreter;
+    };
+
+    // Users remembered per thread by sharedDetails(); all are forgotten past this
+    static constexpr size_t kMaxSharedUsers = 1024;
+
+    Metadata(const rtms_metadata& metadata, shared_ptr<const Details> details);
+
+    // Reuses the Details last built on this thread for the user if they still match
+    static shared_ptr<const Details> sharedDetails(const rtms_metadata& metadata);
+
     int user_id_;
     uint64_t start_ts_;
     uint64_t end_ts_;
-    AiInterpreter ai_interpreter_;
+    shared_ptr<const Details> details_;
+};
+
+class MediaFrame;
+
+/**
+ * Non-owning view of a single media frame as delivered by the SDK.
+ *
+ * The payload and raw metadata are borrowed from the SDK and are only valid
+ * for the duration of the callback that received the view. Nothing is copied
+ * or allocated to construct it; the Metadata object graph is only built when
+ * metadata() is called. Use retain() to keep a frame beyond the callback.
+ */
+class MediaFrameView {
+public:
+    MediaFrameView(const uint8_t* data, size_t size, uint64_t timestamp, const rtms_metadata& metadata);
+
+    const uint8_t* data() const;
+    size_t size() const;
+    uint64_t timestamp() const;
+
+    int userId() const;
+    const char* userName() const;  // never null; empty string when the SDK sends none
+    const rtms_metadata& rawMetadata() const;
+    Metadata metadata() const;
+
+    /**
+     * Copy the payload into a pooled FrameBuffer and return an owning
+     * MediaFrame that may be stored or handed to another thread after the
+     * callback returns.
+     */
+    MediaFrame retain() const;
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    uint64_t timestamp_;
+    const rtms_metadata* metadata_;
+};
+
+/**
+ * Owning copy of a media frame, produced by MediaFrameView::retain().
+ *
+ * The payload lives in a FrameBuffer from FramePool::shared(), and the user
+ * name and interpreter details in metadata() are shared with the frames
+ * retained before it on the same thread for the same user, while they stay
+ * unchanged. Retaining a frame therefore allocates only when a user is new
+ * or their details change, and copying a MediaFrame only adds references;
+ * bindings can hold buffer() directly.
+ */
+class MediaFrame {
+public:
+    explicit MediaFrame(const MediaFrameView& view);
+
+    const uint8_t* data() const;
+    size_t size() const;
+    uint64_t timestamp() const;
+    const Metadata& metadata() const;
+    const FrameRef& buffer() const;
+
+private:
+    FrameRef buffer_;
+    uint64_t timestamp_;
+    Metadata metadata_;
 };
 
 class BaseMediaParams {
@@ -543,6 +641,9 @@ public:
     using AudioDataFn = function<void(const vector<uint8_t>&, uint64_t, const Metadata&)>;
     using VideoDataFn = function<void(const vector<uint8_t>&, uint64_t,  const Metadata&)>;
     using TranscriptDataFn = function<void(const vector<uint8_t>&, uint64_t, const Metadata&)>;
+    using MediaFrameFn = function<void(const MediaFrameView&)>;
+    using MediaBatchFn = function<void(vector<MediaFrame>&)>;
+    using BatchesDoneFn = function<void()>;
     using LeaveFn = function<void(int)>;
     using EventExFn = function<void(const string&)>;
     using ParticipantVideoFn = function<void(const vector<int>&, bool)>;
@@ -562,6 +663,11 @@ public:
 
 
     Client();
+    // With defer_alloc, the SDK handle is not created until alloc() or join()
+    // runs, so a Client can be set up on one thread and handed to the thread
+    // that will own it (see EventLoop). Callbacks, media params, proxy and
+    // event subscriptions set before then are applied when it is allocated.
+    explicit Client(bool defer_alloc);
     ~Client();
 
     static void initialize(const string& ca, int is_verify_cert = 1, const char* agent = nullptr);
@@ -580,6 +686,32 @@ public:
     void setOnAudioData(AudioDataFn callback);
     void setOnVideoData(VideoDataFn callback);
     void setOnTranscriptData(TranscriptDataFn callback);
+
+    // Zero-copy variants of the data callbacks above. The view passed to the
+    // callback borrows SDK memory; call MediaFrameView::retain() to keep it.
+    // Registering a frame callback replaces the matching *Data callback and
+    // vice versa.
+    void setOnDeskshareFrame(MediaFrameFn callback);
+    void setOnAudioFrame(MediaFrameFn callback);
+    void setOnVideoFrame(MediaFrameFn callback);
+    void setOnTranscriptFrame(MediaFrameFn callback);
+
+    // Batched delivery. Every frame of the media type that arrives during a
+    // poll() is retained and handed over in a single call when that poll()
+    // returns, in arrival order; frames from sink calls made outside poll()
+    // wait for the next one. The callback may move frames out of the vector.
+    // Independent of the frame/data callbacks, which still run per frame.
+    void setOnDeskshareBatch(MediaBatchFn callback);
+    void setOnAudioBatch(MediaBatchFn callback);
+    void setOnVideoBatch(MediaBatchFn callback);
+    void setOnTranscriptBatch(MediaBatchFn callback);
+
+    // Runs once after the last batch callback of a poll(), if any ran. Lets a
+    // binding collect each media type's batch and hand them all to user code
+    // together, e.g. taking the Python GIL once per poll instead of once per
+    // media type.
+    void setOnBatchesDone(BatchesDoneFn callback);
+
     void setOnLeave(LeaveFn callback);
     void setOnEventEx(EventExFn callback);
 
@@ -596,15 +728,28 @@ public:
     void setOnParticipantVideo(ParticipantVideoFn callback);
     void setOnVideoSubscribed(VideoSubscribedFn callback);
 
+    void alloc();        // create the SDK handle if it does not exist yet; join() calls this
+    bool allocated() const;
+
     void join(const string& meeting_uuid, const string& rtms_stream_id, const string& signature, const string& server_url, int timeout = -1);
 
-    void poll();
+    // Runs the SDK's sinks; returns true if any of them delivered something,
+    // which EventLoop uses to decide how soon to poll again.
+    bool poll();
     void markClosed();   // mark sdk_opened_=false before teardown so configure() becomes a no-op
     void release();
 
     string uuid() const;
     string streamId() const;
 
+    // Delivery counters and timings, updated without locking by the sinks and
+    // poll(); call metrics().snapshot() from any thread.
+    const ClientMetrics& metrics() const { return metrics_; }
+
+    // For bindings that queue frames on their way to user code: counts frames
+    // discarded because the consumer fell behind. Safe from any thread.
+    void recordDropped(ClientMetrics::Media media, uint64_t frames) { metrics_.recordDropped(media, frames); }
+
     // rtms_sdk_sink overrides — called by the SDK from within poll()
     void on_join_confirm(int reason) override;
     void on_session_update(int op, struct session_info* sess) override;
@@ -621,6 +766,10 @@ public:
 private:
     mutable mutex mutex_;
     rtms_sdk* sdk_;
+    bool awaiting_alloc_;   // constructed with defer_alloc and alloc() not yet called
+
+    string pending_proxy_type_;
+    string pending_proxy_url_;
 
     string meeting_uuid_;
     string rtms_stream_id_;
@@ -630,17 +779,44 @@ private:
     bool sdk_opened_;
     MediaParams media_params_;
 
-    JoinConfirmFn join_confirm_callback_;
-    SessionUpdateFn session_update_callback_;
-    UserUpdateFn user_update_callback_;
-    DsDataFn ds_data_callback_;
-    AudioDataFn audio_data_callback_;
-    VideoDataFn video_data_callback_;
-    TranscriptDataFn transcript_data_callback_;
-    LeaveFn leave_callback_;
-    EventExFn event_ex_callback_;
-    ParticipantVideoFn participant_video_callback_;
-    VideoSubscribedFn video_subscribed_callback_;
+    // User callbacks live in an immutable table. The setOn* methods copy the
+    // current table, modify the copy and publish it with an atomic swap while
+    // holding mutex_; the SDK sinks read the current table without locking.
+    // Replaced tables are retired and freed once no sink is mid-dispatch,
+    // checked at the end of poll(), on the next publish and in ~Client().
+    struct CallbackTable {
+        JoinConfirmFn join_confirm;
+        SessionUpdateFn session_update;
+        UserUpdateFn user_update;
+        MediaFrameFn ds_frame;
+        MediaFrameFn audio_frame;
+        MediaFrameFn video_frame;
+        MediaFrameFn transcript_frame;
+        LeaveFn leave;
+        EventExFn event_ex;
+        ParticipantVideoFn participant_video;
+        VideoSubscribedFn video_subscribed;
+        array<MediaBatchFn, ClientMetrics::kMediaCount> batch;   // indexed by ClientMetrics::Media
+        BatchesDoneFn batches_done;
+    };
+    class CallbackSnapshot;
+
+    atomic<const CallbackTable*> callbacks_;
+    mutable atomic<int> dispatching_;
+    atomic<bool> has_retired_callbacks_;
+    std::vector<const CallbackTable*> retired_callbacks_;  // guarded by mutex_
+    mutable atomic<uint64_t> sink_calls_;                   // sinks entered, for poll()'s return
+    ClientMetrics metrics_;
+
+    // Frames held for the batch callbacks until poll() returns; only the
+    // polling thread touches them.
+    array<vector<MediaFrame>, ClientMetrics::kMediaCount> batches_;
+    void setOnBatch(ClientMetrics::Media media, MediaBatchFn callback);
+    void deliverBatches();
+
+    unique_ptr<CallbackTable> copyCallbacks() const;           // called with mutex_ held
+    void publishCallbacks(unique_ptr<CallbackTable> next);     // called with mutex_ held
+    void reclaimRetiredCallbacks();                            // called with mutex_ held
 
     std::vector<int> subscribed_events_;
 
@@ -8,6 +8,8 @@ import sys
 import traceback
 import asyncio
 import inspect
+import atexit
+import weakref
 from http.server import BaseHTTPRequestHandler, HTTPServer
 from typing import Callable, Dict, Any, Optional, Union, List, Tuple
 from enum import IntEnum, Enum
@@ -15,7 +17,17 @@ from pathlib import Path
 
 from ._rtms import (
     # Classes
-    Client as _ClientBase, Session, Participant, Metadata,
+    Client as _ClientBase, EventLoop as _NativeEventLoop, ShmRingReader,
+
+    # Prometheus metrics
+    render_metrics, start_metrics_server, stop_metrics_server,
+
+    # Callback GIL counter
+    gil_acquisitions,
+
+    # Hot-path tracing (RTMS_TRACE builds)
+    TRACE_ENABLED, dump_trace, clear_trace,
+    Frame, Session, Participant, Metadata,
     AiTargetLanguage, AiInterpreter,
     AudioParams, VideoParams, DeskshareParams, TranscriptParams,
 
@@ -293,6 +305,22 @@ class WebhookResponse:
         self._sent = True
 
 class WebhookHandler(BaseHTTPRequestHandler):
+    def do_GET(self):
+        # Only the optional Prometheus endpoint answers GET
+        metrics_path = getattr(self.server, 'metrics_path', None)
+        if not metrics_path or self.path.split('?', 1)[0] != metrics_path:
+            self.send_response(404)
+            self.end_headers()
+            self.wfile.write(b"Not Found")
+            return
+
+        body = render_metrics().encode('utf-8')
+        self.send_response(200)
+        self.send_header('Content-Type', 'text/plain; version=0.0.4; charset=utf-8')
+        self.send_header('Content-Length', str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
     def do_POST(self):
         # Validate request path
         if self.path != self.server.webhook_path:
@@ -362,9 +390,20 @@ class WebhookHandler(BaseHTTPRequestHandler):
         pass
 
 class WebhookServer:
-    def __init__(self, port=8080, path='/'):
+    """HTTP server for Zoom webhook events, listening on all interfaces.
+
+    With metrics_path set, GET requests on that path are answered with
+    render_metrics() output on the same public listener. Those metrics are
+    labelled with meeting UUIDs and stream IDs, so anyone who can reach the
+    webhook port can read them; prefer start_metrics_server(), which binds
+    127.0.0.1, unless the port is firewalled or behind a proxy that blocks
+    the path.
+    """
+
+    def __init__(self, port=8080, path='/', metrics_path=None):
         self.port = port
         self.path = path
+        self.metrics_path = metrics_path
         self.server = None
         self.server_thread = None
         self.callback = None
@@ -375,19 +414,27 @@ class WebhookServer:
         
         try:
             class CustomWebhookServer(HTTPServer):
-                def __init__(self, server_address, RequestHandlerClass, webhook_callback, webhook_path):
+                def __init__(self, server_address, RequestHandlerClass, webhook_callback, webhook_path,
+                             metrics_path=None):
                     super().__init__(server_address, RequestHandlerClass)
                     self.webhook_callback = webhook_callback
                     self.webhook_path = webhook_path
+                    self.metrics_path = metrics_path
             
             self.callback = callback
-            self.server = CustomWebhookServer(('0.0.0.0', self.port), WebhookHandler, callback, self.path)
+            self.server = CustomWebhookServer(('0.0.0.0', self.port), WebhookHandler, callback, self.path,
+                                              self.metrics_path)
             
             log_debug("webhook", f"Starting webhook server on port {self.port} path {self.path}")
             self.server_thread = threading.Thread(target=self.server.serve_forever, daemon=True)
             self.server_thread.start()
 
             log_info("webhook", f"Listening for webhook events at http://localhost:{self.port}{self.path}")
+            if self.metrics_path:
+                log_info("webhook", f"Serving Prometheus metrics at http://localhost:{self.port}{self.metrics_path}")
+                log_warn("webhook", f"Metrics at {self.metrics_path} include meeting UUIDs and are reachable on "
+                                    f"every interface port {self.port} is; use start_metrics_server() for a "
+                                    f"loopback-only endpoint")
             return True
         except Exception as e:
             log_error("webhook", f"Error starting webhook server: {e}")
@@ -408,6 +455,20 @@ class WebhookServer:
             log_error("webhook", f"Error shutting down webhook server: {e}")
 
 # Parameter validation functions
+def _pcm_dtype(dtype):
+    """Normalize an on_audio_data() dtype to 'int16', 'float32' or None."""
+    if dtype is None:
+        return None
+    try:
+        import numpy
+    except ImportError as e:
+        raise ImportError("Audio as a numpy array requires numpy: pip install numpy") from e
+    name = numpy.dtype(dtype).name
+    if name not in ('int16', 'float32'):
+        raise ValueError(f"Audio dtype must be int16 or float32, got {name}")
+    return name
+
+
 def _validate_audio_params(params):
     """
     Validate audio parameters and provide helpful error messages
@@ -581,8 +642,11 @@ class EventLoop:
     An SDK I/O thread that owns one or more Client lifecycles.
 
     The Zoom C SDK requires that alloc(), join(), poll(), and release() all run
-    on the same OS thread. EventLoop is that thread. Clients assigned to a loop
-    via add() will have their entire lifecycle managed on the loop's thread.
+    on the same OS thread. EventLoop is that thread. It is a native reactor
+    (rtms::EventLoop in the C++ core): the poll cycle runs entirely in C++ and
+    only enters the interpreter to start a client and to deliver callbacks.
+    Clients assigned to a loop via add() have their entire lifecycle managed on
+    the loop's thread.
 
     Usage::
 
@@ -601,118 +665,141 @@ class EventLoop:
     - No executor: callback runs inline on the loop's thread (simple, low latency)
     - executor=ThreadPoolExecutor(...): heavy work offloaded to worker pool
     - async def callback: bridged to the asyncio event loop via run_coroutine_threadsafe
+
+    By default every client is polled every poll_interval. With a mode, each
+    client is polled on its own schedule: soon after it delivered data, and
+    progressively less often while it stays idle (see Client.poll_interval).
+
+    A loop runs once: after stop() it cannot be restarted and rejects new clients.
     """
 
-    def __init__(self, poll_interval: float = 0.01, name: str = None):
+    def __init__(self, poll_interval: float = 0.01, name: str = None, mode: str = None):
         """
         Args:
-            poll_interval: Seconds between poll cycles (default: 0.01 = 10ms)
+            poll_interval: Seconds between poll cycles (default: 0.01 = 10ms).
+                Rounded to whole milliseconds. Ignored when mode is set.
             name: Optional thread name for debugging
+            mode: Adaptive poll schedule — 'latency' (spin/yield while busy,
+                at most 1ms idle), 'balanced' (1ms busy, up to 50ms idle) or
+                'power' (5ms busy, up to 100ms idle)
+
+        Raises:
+            ValueError: If mode is not one of the above
         """
         self._poll_interval = poll_interval
         self._name = name
-        self._clients: List['Client'] = []
-        self._clients_lock = threading.Lock()
-        self._pending: List['Client'] = []   # clients waiting for alloc+join on this thread
-        self._pending_lock = threading.Lock()
-        self._running = False
-        self._stop_event = threading.Event()
-        self._thread: Optional[threading.Thread] = None
+        self._mode = mode
+        self._native = _NativeEventLoop(max(0, int(round(poll_interval * 1000))), name or '', mode or '')
+        _live_loops.add(self)
 
     @property
     def client_count(self) -> int:
         """Number of clients currently owned by this loop."""
-        with self._clients_lock:
-            return len(self._clients)
+        return self._native.client_count
+
+    @property
+    def running(self) -> bool:
+        """True while the loop thread is running."""
+        return self._native.running
 
     def add(self, client: 'Client') -> None:
         """
         Assign a client to this loop's thread.
 
-        Must be called before client.join(). The loop's thread will call
-        alloc() and join() on behalf of the client.
+        Call before client.join(). The loop's thread will call alloc() and
+        join() on behalf of the client once join parameters are available.
 
         Args:
             client: A Client whose join() will be deferred to this loop's thread
         """
         client._assigned_loop = self
-        with self._pending_lock:
-            self._pending.append(client)
+        if client._pending_join_params is not None:
+            self._attach(client)
 
-    def _drain_pending(self) -> None:
-        """Called from the loop's thread — alloc and join all waiting clients."""
-        with self._pending_lock:
-            pending = self._pending[:]
-            self._pending.clear()
+    def _attach(self, client: 'Client') -> None:
+        """Hand a client with pending join params to the native loop."""
+        self._native.add(client)
 
-        for client in pending:
-            try:
-                client._do_alloc_and_join()
-                with self._clients_lock:
-                    self._clients.append(client)
-            except Exception as e:
-                log_error('eventloop', f'Failed to alloc/join client: {e}')
-                traceback.print_exc()
-
-    def _poll_all(self) -> None:
-        """Poll all active clients. Removes clients that have left."""
-        with self._clients_lock:
-            active = self._clients[:]
-
-        to_remove = []
-        for client in active:
-            if client._running:
-                try:
-                    client.poll()
-                except Exception as e:
-                    log_error('eventloop', f'Error polling client: {e}')
-                    to_remove.append(client)
-            else:
-                to_remove.append(client)
+    def remove(self, client: 'Client') -> bool:
+        """
+        Release a client on the loop's thread and detach it.
+
+        Blocks until the client has been released, unless called from one of
+        this loop's callbacks, in which case the release happens at the start
+        of the next cycle.
+
+        Returns:
+            bool: False if the client does not belong to this loop
+        """
+        return self._native.remove(client)
+
+    def poll_interval_of(self, client: 'Client') -> Optional[float]:
+        """Seconds until the loop next polls client, or None if the loop is not polling it."""
+        return self._native.poll_interval_of(client)
+
+    def fileno(self) -> int:
+        """
+        A file descriptor that becomes readable after each poll cycle in which
+        a client delivered data, and once the loop has stopped.
+
+        Lets an asyncio loop wake on data instead of a timer, e.g. to drain a
+        queue filled by callbacks running on the loop thread. Call
+        clear_ready() when woken, before looking for work::
+
+            def on_ready():
+                loop.clear_ready()
+                while frames:
+                    handle(frames.popleft())
+
+            asyncio.get_running_loop().add_reader(loop.fileno(), on_ready)
+
+        Works alongside start() or run_async(), which waits on a separate
+        descriptor that only signals shutdown. Returns -1 on Windows.
+        """
+        return self._native.fileno()
+
+    def clear_ready(self) -> bool:
+        """Make fileno() unreadable again. Returns True if it was readable."""
+        return self._native.clear_ready()
 
-        if to_remove:
-            with self._clients_lock:
-                for c in to_remove:
-                    self._clients.discard(c) if hasattr(self._clients, 'discard') else None
-            with self._clients_lock:
-                self._clients = [c for c in self._clients if c not in to_remove]
+    def _log_start(self, kind: str) -> None:
+        schedule = f'mode={self._mode}' if self._mode else f'poll_interval={self._poll_interval}s'
+        log_info('eventloop', f'Starting {kind}event loop{" (" + self._name + ")" if self._name else ""} '
+                              f'({schedule})')
 
     def run(self, stop_on_empty: bool = False) -> None:
         """
-        Run the event loop on the current thread (blocking).
+        Run the event loop and block the current thread until it stops.
 
-        The current thread becomes the SDK I/O thread. Use this when you want
-        explicit control of which thread drives the loop.
+        Polling happens on the loop's native thread; the calling thread only
+        waits, so Ctrl-C stops the loop.
 
         Args:
             stop_on_empty: Stop automatically when all clients have left
         """
-        self._running = True
-        self._stop_event.clear()
-        log_info('eventloop', f'Starting event loop{" (" + self._name + ")" if self._name else ""} '
-                              f'(poll_interval={self._poll_interval}s)')
+        self._log_start('')
+        self._native.start(stop_on_empty)
         try:
-            while self._running and not self._stop_event.is_set():
-                self._drain_pending()
-                self._poll_all()
-                if stop_on_empty:
-                    with self._clients_lock:
-                        if not self._clients and not self._pending:
-                            break
-                time.sleep(self._poll_interval)
+            while not self._native.wait(0.1):
+                pass
         except KeyboardInterrupt:
             pass
         finally:
-            self._running = False
+            self._native.stop()
+            self._native.join()
             log_debug('eventloop', 'Event loop stopped')
 
     async def run_async(self, stop_on_empty: bool = False) -> None:
         """
         Run the event loop as an asyncio coroutine.
 
-        Yields to the asyncio event loop between poll cycles so other coroutines
-        (aiohttp, FastAPI, asyncpg, etc.) run freely. Async callbacks registered
-        on clients are automatically bridged to this event loop.
+        The loop polls on its native thread; this coroutine only waits for it
+        to finish, so other coroutines (aiohttp, FastAPI, asyncpg, etc.) run
+        freely. It waits on a descriptor the loop signals only when it shuts
+        down, rather than on a timer or fileno(), so it returns as soon as the
+        loop stops without waking for every poll cycle that delivered data.
+        Async callbacks registered on clients are
+        automatically bridged to this event loop.
 
         Args:
             stop_on_empty: Stop automatically when all clients have left
@@ -725,53 +812,77 @@ class EventLoop:
 
             asyncio.run(main())
         """
-        self._running = True
-        self._stop_event.clear()
-        log_info('eventloop', f'Starting async event loop{" (" + self._name + ")" if self._name else ""} '
-                              f'(poll_interval={self._poll_interval}s)')
+        self._log_start('async ')
+        self._native.start(stop_on_empty)
         try:
-            while self._running and not self._stop_event.is_set():
-                self._drain_pending()
-                self._poll_all()
-                if stop_on_empty:
-                    with self._clients_lock:
-                        if not self._clients and not self._pending:
-                            break
-                await asyncio.sleep(self._poll_interval)
+            await self._wait_async()
         except asyncio.CancelledError:
             log_info('eventloop', 'Async event loop cancelled')
         finally:
-            self._running = False
+            self._native.stop()
+            self._native.join()
             log_debug('eventloop', 'Async event loop stopped')
 
+    async def _wait_async(self) -> None:
+        """Wait for the loop thread to finish without blocking the asyncio loop."""
+        aio_loop = asyncio.get_running_loop()
+        fd = self._native.stopped_fileno()
+        stopped = aio_loop.create_future()
+
+        def on_stopped():
+            if not self._native.running and not stopped.done():
+                stopped.set_result(None)
+
+        try:
+            if fd < 0:
+                raise NotImplementedError
+            aio_loop.add_reader(fd, on_stopped)
+        except NotImplementedError:
+            # Windows: no descriptor, and the Proactor loop has no add_reader()
+            while not self._native.wait(0):
+                await asyncio.sleep(0.1)
+            return
+        try:
+            on_stopped()   # the loop may have stopped before the reader was added
+            await stopped
+        finally:
+            aio_loop.remove_reader(fd)
+
     def start(self) -> 'EventLoop':
         """
-        Start the event loop in a background daemon thread.
+        Start the event loop on its own native thread.
 
         Returns self for chaining::
 
             loop = rtms.EventLoop().start()
 
-        The thread runs until stop() is called or the process exits.
+        The thread runs until stop() is called or the interpreter exits.
         """
-        self._thread = threading.Thread(
-            target=self.run,
-            name=self._name or 'rtms-eventloop',
-            daemon=True,
-        )
-        self._thread.start()
-        log_debug('eventloop', f'Background thread started: {self._thread.name}')
+        self._native.start(False)
+        log_debug('eventloop', f'Background thread started: {self._name or "rtms-eventloop"}')
         return self
 
     def stop(self) -> None:
         """Signal the event loop to stop after the current poll cycle."""
-        self._running = False
-        self._stop_event.set()
+        self._native.stop()
 
     def join(self, timeout: float = None) -> None:
-        """Wait for the background thread to finish (only valid after start())."""
-        if self._thread:
-            self._thread.join(timeout=timeout)
+        """Wait for the loop thread to finish (only valid after start())."""
+        if timeout is None:
+            self._native.join()
+        else:
+            self._native.wait(timeout)
+
+
+def _stop_live_loops() -> None:
+    """Release every client still attached to a loop before the interpreter goes away."""
+    for loop in list(_live_loops):
+        loop.stop()
+        loop.join()
+
+
+_live_loops: 'weakref.WeakSet[EventLoop]' = weakref.WeakSet()
+atexit.register(_stop_live_loops)
 
 
 # ============================================================================
@@ -810,19 +921,21 @@ class EventLoopPool:
         threads: int = 4,
         poll_interval: float = 0.01,
         strategy: str = 'least_loaded',
+        mode: str = None,
     ):
         """
         Args:
             threads: Number of SDK I/O threads (default: 4)
             poll_interval: Seconds between poll cycles per loop (default: 0.01)
             strategy: Client routing strategy — 'least_loaded' or 'round_robin'
+            mode: Adaptive poll schedule for every loop (see EventLoop)
         """
         if threads < 1:
             raise ValueError("threads must be >= 1")
         if strategy not in ('least_loaded', 'round_robin'):
             raise ValueError("strategy must be 'least_loaded' or 'round_robin'")
         self._loops = [
-            EventLoop(poll_interval=poll_interval, name=f'rtms-pool-{i}')
+            EventLoop(poll_interval=poll_interval, name=f'rtms-pool-{i}', mode=mode)
             for i in range(threads)
         ]
         self._strategy = strategy
@@ -854,6 +967,10 @@ class EventLoopPool:
         loop.add(client)
         return loop
 
+    def remove(self, client: 'Client') -> bool:
+        """Release a client on its loop's thread. Returns False if no loop in the pool owns it."""
+        return any(loop.remove(client) for loop in self._loops)
+
     def run(self, stop_on_empty: bool = False) -> None:
         """
         Run all loops. Starts N-1 loops as background daemon threads and runs
@@ -991,10 +1108,11 @@ class Client(_ClientBase):
         # Store params for the loop thread to consume
         self._pending_join_params = params
 
-        # If the client has been assigned to an explicit EventLoop, it will be
-        # picked up by that loop's _drain_pending() call — nothing else to do.
+        # If the client has been assigned to an explicit EventLoop, hand it to
+        # the loop now that the join params are known.
         if self._assigned_loop is not None:
             log_debug("client", "join() deferred to assigned EventLoop thread")
+            self._assigned_loop._attach(self)
             return True
 
         # If rtms.run() / rtms.run_async() is active, route to the default loop.
@@ -1016,7 +1134,7 @@ class Client(_ClientBase):
 
     def _do_alloc_and_join(self) -> None:
         """
-        Called by EventLoop._drain_pending() on the loop's own thread.
+        Called by the native EventLoop on the loop's own thread.
 
         Performs the two operations that must share an OS thread:
           1. alloc()  — creates the C SDK handle (rtms_alloc)
@@ -1114,6 +1232,16 @@ class Client(_ClientBase):
             except Exception as e:
                 log_error("client", f"Error during polling: {e}")
 
+    @property
+    def poll_interval(self) -> Optional[float]:
+        """
+        Seconds the owning EventLoop will wait before polling this client
+        again, or None if no loop is polling it. Zero while the loop re-polls
+        it immediately.
+        """
+        loop = self._assigned_loop
+        return loop.poll_interval_of(self) if loop is not None else None
+
     # ========================================================================
     # Callback Dispatch
     # ========================================================================
@@ -1155,9 +1283,17 @@ class Client(_ClientBase):
     # Data Callbacks (Python-level so _wrap_callback applies and aliases work)
     # ========================================================================
 
-    def on_audio_data(self, callback) -> None:
-        """Register audio data callback. Supports executor and async coroutines."""
-        super().on_audio_data(self._wrap_callback(callback))
+    def on_audio_data(self, callback, dtype=None) -> None:
+        """Register audio data callback. Supports executor and async coroutines.
+
+        By default the callback receives a Frame. With dtype ``'int16'`` or
+        ``'float32'`` (or the numpy types) L16 audio arrives as a numpy array
+        of shape (frames, channels), converted natively from the SDK buffer;
+        float32 samples are scaled to [-1, 1). Requires numpy and L16 audio
+        params: join() raises ValueError otherwise, and once joined so does
+        this call or a set_audio_params() that picks another codec.
+        """
+        super().on_audio_data(self._wrap_callback(callback), _pcm_dtype(dtype))
 
     onAudioData = on_audio_data
 
@@ -1179,6 +1315,35 @@ class Client(_ClientBase):
 
     onTranscriptData = on_transcript_data
 
+    # ========================================================================
+    # Batch Callbacks: one call per poll with a list of Frame, and one GIL
+    # acquisition per poll for all of them
+    # ========================================================================
+
+    def on_audio_batch(self, callback) -> None:
+        """Register a callback for each poll's audio frames, as a list of Frame."""
+        super().on_audio_batch(self._wrap_callback(callback))
+
+    onAudioBatch = on_audio_batch
+
+    def on_video_batch(self, callback) -> None:
+        """Register a callback for each poll's video frames, as a list of Frame."""
+        super().on_video_batch(self._wrap_callback(callback))
+
+    onVideoBatch = on_video_batch
+
+    def on_deskshare_batch(self, callback) -> None:
+        """Register a callback for each poll's deskshare frames, as a list of Frame."""
+        super().on_deskshare_batch(self._wrap_callback(callback))
+
+    onDeskshareBatch = on_deskshare_batch
+
+    def on_transcript_batch(self, callback) -> None:
+        """Register a callback for each poll's transcript frames, as a list of Frame."""
+        super().on_transcript_batch(self._wrap_callback(callback))
+
+    onTranscriptBatch = on_transcript_batch
+
     # ========================================================================
     # Context Manager
     # ========================================================================
@@ -1561,8 +1726,9 @@ class Client(_ClientBase):
         """
         Leave the RTMS session.
 
-        Signals the owning EventLoop to stop polling this client and releases
-        the C SDK handle. Safe to call from any thread.
+        Detaches the client from its EventLoop, which releases the C SDK handle
+        on the loop's thread. Safe to call from any thread, including from
+        inside one of this client's callbacks.
 
         Returns:
             bool: True if left successfully
@@ -1582,8 +1748,11 @@ class Client(_ClientBase):
             self._webhook_server = None
 
         try:
-            # Release RTMS resources
-            super().release()
+            # The loop releases its clients on its own thread; only release
+            # here if no loop owns this client (never joined, or loop stopped).
+            loop = self._assigned_loop
+            if loop is None or not loop.remove(self):
+                super().release()
             return True
         except Exception as e:
             log_error("client", f"Error releasing RTMS resources: {e}")
@@ -1634,7 +1803,7 @@ class Client(_ClientBase):
             port = port or int(os.getenv('ZM_RTMS_PORT', '8080'))
             path = path or os.getenv('ZM_RTMS_PATH', '/')
 
-            self._webhook_server = WebhookServer(port, path)
+            self._webhook_server = WebhookServer(port, path, os.getenv('ZM_RTMS_METRICS_PATH'))
 
         self._webhook_server.start(callback)
 
@@ -1684,6 +1853,12 @@ def onWebhookEvent(callback=None, port=None, path=None):
     When a webhook event is received, it parses the JSON payload and passes it to
     the provided callback function.
 
+    Set ZM_RTMS_METRICS_PATH (e.g. '/metrics') to also serve render_metrics()
+    output to GET requests on that path. The webhook server listens on all
+    interfaces and the metrics are labelled with meeting UUIDs, so only set
+    it when the port is not publicly reachable; start_metrics_server()
+    serves the same output on 127.0.0.1.
+
     Can be used as a decorator or a direct function call:
 
     @rtms.onWebhookEvent(port=8080, path='/webhook')
@@ -1706,11 +1881,12 @@ def onWebhookEvent(callback=None, port=None, path=None):
     # Determine port and path
     webhook_port = port or int(os.getenv('ZM_RTMS_PORT', '8080'))
     webhook_path = path or os.getenv('ZM_RTMS_PATH', '/')
+    metrics_path = os.getenv('ZM_RTMS_METRICS_PATH')
 
     # If used as a decorator without arguments
     if callback is not None and callable(callback):
         if _webhook_server is None:
-            _webhook_server = WebhookServer(webhook_port, webhook_path)
+            _webhook_server = WebhookServer(webhook_port, webhook_path, metrics_path)
         _webhook_server.start(callback)
         return callback
 
@@ -1718,7 +1894,7 @@ def onWebhookEvent(callback=None, port=None, path=None):
     def decorator(func):
         global _webhook_server
         if _webhook_server is None:
-            _webhook_server = WebhookServer(webhook_port, webhook_path)
+            _webhook_server = WebhookServer(webhook_port, webhook_path, metrics_path)
         _webhook_server.start(func)
         return func
 
@@ -1817,6 +1993,8 @@ __all__ = [
     "Client",
     "EventLoop",
     "EventLoopPool",
+    "Frame",
+    "ShmRingReader",
     "Session",
     "Participant",
     "AiTargetLanguage",
@@ -1909,6 +2087,17 @@ __all__ = [
     "onWebhookEvent",
     "on_webhook_event",
 
+    # Prometheus metrics
+    "render_metrics",
+    "start_metrics_server",
+    "stop_metrics_server",
+    "gil_acquisitions",
+
+    # Hot-path tracing
+    "TRACE_ENABLED",
+    "dump_trace",
+    "clear_trace",
+
     # Event loop functions
     "run",
     "run_async",
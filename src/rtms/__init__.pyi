@@ -3,7 +3,7 @@ Zoom RTMS SDK - Python Type Stubs
 Real-Time Media Streaming SDK for Python
 """
 
-from typing import Callable, Dict, Any, Optional, List, Literal, TypedDict
+from typing import Callable, Dict, Any, Optional, List, Literal, TypedDict, overload
 from concurrent.futures import Executor
 from typing import Awaitable, Coroutine
 
@@ -72,6 +72,91 @@ class Metadata:
     @property
     def aiInterpreter(self) -> AiInterpreter: ...
 
+class Frame:
+    """Media payload passed to the audio, video and deskshare data callbacks
+    and, in lists, to the batch callbacks.
+
+    The bytes stay in pooled native memory and are exposed read-only through
+    the buffer protocol: use memoryview(frame), numpy.frombuffer(frame), or
+    pass the frame straight to file.write() / socket.send(). bytes(frame)
+    makes a copy. Frames are not created from Python.
+
+    The memory returns to the pool when the frame is garbage collected, or
+    immediately on release() (also called by ``with frame:``).
+    """
+    def __len__(self) -> int: ...
+    def __bytes__(self) -> bytes: ...
+    def __buffer__(self, flags: int) -> memoryview: ...
+    def tobytes(self) -> bytes:
+        """Copy the payload into a bytes object"""
+        ...
+    def release(self) -> None:
+        """Return the payload to the native pool now.
+
+        Raises BufferError while a memoryview or array still refers to it.
+        Any later access to the data raises ValueError.
+        """
+        ...
+    @property
+    def released(self) -> bool: ...
+    @property
+    def timestamp(self) -> int: ...
+    @property
+    def metadata(self) -> Metadata:
+        """The sender. Frames from a ShmRingReader only carry userId."""
+        ...
+    @property
+    def sequence(self) -> Optional[int]:
+        """The writer's sequence number for a frame from a ShmRingReader, else None"""
+        ...
+    def __enter__(self) -> Frame: ...
+    def __exit__(self, *args: Any) -> None: ...
+
+class ShmRingReader:
+    """Reads frames from a shared-memory ring written by another process's
+    Client (see Client.shm_ring()).
+
+    Each reader starts at the newest frame and sees every frame after it.
+    One that falls a whole ring behind skips ahead to the writer rather than
+    slowing it down; lapped and lost count that. Every frame is copied once
+    into pooled memory and checked against the writer, so a frame that was
+    overwritten while being copied is skipped, never returned torn.
+
+    Iterating yields frames until the ring is closed and drained::
+
+        for frame in rtms.ShmRingReader(name):
+            process(memoryview(frame))
+    """
+    def __init__(self, name: str) -> None:
+        """Attach by segment name. Raises RTMSException if there is no such
+        segment and ValueError if it does not hold a ring."""
+        ...
+    def read(self, timeout: Optional[float] = None) -> Optional[Frame]:
+        """The next frame, waiting up to timeout seconds (forever if None)
+        with the GIL released. Its metadata holds only userId, and its
+        sequence is set. None on timeout or once the ring is closed and
+        drained."""
+        ...
+    def try_read(self) -> Optional[Frame]:
+        """The next frame if one is ready, else None"""
+        ...
+    def __iter__(self) -> ShmRingReader: ...
+    def __next__(self) -> Frame: ...
+    @property
+    def name(self) -> str: ...
+    @property
+    def closed(self) -> bool:
+        """The writer has closed the ring; frames already written can still be read"""
+        ...
+    @property
+    def lapped(self) -> int:
+        """Times this reader fell a whole ring behind and skipped ahead"""
+        ...
+    @property
+    def lost(self) -> int:
+        """Frames skipped between ones this reader returned"""
+        ...
+
 # ============================================================================
 # Parameter Classes
 # ============================================================================
@@ -203,6 +288,53 @@ class DeskshareParams:
     @fps.setter
     def fps(self, value: int) -> None: ...
 
+# ============================================================================
+# Metrics
+# ============================================================================
+
+class MediaStats(TypedDict):
+    """Delivery counters for one media type"""
+    frames: int
+    bytes: int
+    empty: int  # deliveries with no buffer, no metadata or zero size
+    dropped: int  # frames discarded because the consumer fell behind
+
+class LatencyStats(TypedDict):
+    """Latency histogram summary in microseconds; percentiles within 12.5%"""
+    count: int
+    mean_us: float
+    p50_us: float
+    p90_us: float
+    p99_us: float
+    max_us: float
+
+CallbackStats = TypedDict('CallbackStats', {
+    'join_confirm': LatencyStats,
+    'session_update': LatencyStats,
+    'user_update': LatencyStats,
+    'audio': LatencyStats,
+    'video': LatencyStats,
+    'deskshare': LatencyStats,
+    'transcript': LatencyStats,
+    'leave': LatencyStats,
+    'event_ex': LatencyStats,
+    'participant_video': LatencyStats,
+    'video_subscribed': LatencyStats,
+    'audio_batch': LatencyStats,
+    'video_batch': LatencyStats,
+    'deskshare_batch': LatencyStats,
+    'transcript_batch': LatencyStats,
+})
+
+class ClientStats(TypedDict):
+    """Snapshot of a client's native metrics (Client.stats)"""
+    audio: MediaStats
+    video: MediaStats
+    deskshare: MediaStats
+    transcript: MediaStats
+    poll: LatencyStats
+    callbacks: CallbackStats
+
 # ============================================================================
 # Callback Types
 # ============================================================================
@@ -238,20 +370,48 @@ class EventLoop:
     """
     An SDK I/O thread that owns one or more Client lifecycles.
 
-    Manages alloc/join/poll/release on a single dedicated OS thread, satisfying
-    the C SDK's thread-affinity requirement.
+    Manages alloc/join/poll/release on a single dedicated native OS thread,
+    satisfying the C SDK's thread-affinity requirement. The poll cycle runs in
+    C++; a stopped loop cannot be restarted.
+
+    With a mode, clients are polled soon after delivering data and
+    progressively less often while idle, instead of every poll_interval.
     """
-    def __init__(self, poll_interval: float = 0.01, name: Optional[str] = None) -> None: ...
+    def __init__(
+        self,
+        poll_interval: float = 0.01,
+        name: Optional[str] = None,
+        mode: Optional[Literal['latency', 'balanced', 'power']] = None,
+    ) -> None: ...
 
     @property
     def client_count(self) -> int: ...
 
+    @property
+    def running(self) -> bool: ...
+
     def add(self, client: 'Client') -> None:
         """Assign a client to this loop. Must be called before client.join()."""
         ...
 
+    def remove(self, client: 'Client') -> bool:
+        """Release a client on the loop thread and detach it. False if not owned by this loop."""
+        ...
+
+    def poll_interval_of(self, client: 'Client') -> Optional[float]:
+        """Seconds until the loop next polls client, or None if the loop is not polling it."""
+        ...
+
+    def fileno(self) -> int:
+        """Descriptor readable after each cycle that delivered data and once stopped; -1 on Windows."""
+        ...
+
+    def clear_ready(self) -> bool:
+        """Make fileno() unreadable again. True if it was readable."""
+        ...
+
     def run(self, stop_on_empty: bool = False) -> None:
-        """Run the event loop on the current thread (blocking)."""
+        """Run the event loop and block the current thread until it stops."""
         ...
 
     async def run_async(self, stop_on_empty: bool = False) -> None:
@@ -259,7 +419,7 @@ class EventLoop:
         ...
 
     def start(self) -> 'EventLoop':
-        """Start the event loop in a background daemon thread. Returns self."""
+        """Start the event loop on its own native thread. Returns self."""
         ...
 
     def stop(self) -> None:
@@ -293,6 +453,7 @@ class EventLoopPool:
         threads: int = 4,
         poll_interval: float = 0.01,
         strategy: Literal['least_loaded', 'round_robin'] = 'least_loaded',
+        mode: Optional[Literal['latency', 'balanced', 'power']] = None,
     ) -> None: ...
 
     @property
@@ -305,6 +466,10 @@ class EventLoopPool:
         """Route client to a loop per the strategy. Returns the assigned EventLoop."""
         ...
 
+    def remove(self, client: 'Client') -> bool:
+        """Release a client on its loop's thread. False if no loop in the pool owns it."""
+        ...
+
     def run(self, stop_on_empty: bool = False) -> None:
         """Run all loops. Starts N-1 as background threads, runs last on current thread."""
         ...
@@ -367,6 +532,11 @@ class Client:
         """Poll for events (call periodically)"""
         ...
 
+    @property
+    def poll_interval(self) -> Optional[float]:
+        """Seconds until the owning EventLoop next polls this client, or None if no loop is polling it."""
+        ...
+
     def release(self) -> None:
         """Release client resources"""
         ...
@@ -390,6 +560,15 @@ class Client:
         """Get stream ID (legacy camelCase alias)"""
         ...
 
+    @property
+    def stats(self) -> ClientStats:
+        """
+        Snapshot of native delivery metrics: frames, bytes and empty deliveries
+        per media type, plus poll and per-callback timings. Still readable after
+        leave(), reporting the final counts.
+        """
+        ...
+
     def enable_audio(self, enable: bool) -> None:
         """Enable/disable audio streaming"""
         ...
@@ -478,17 +657,29 @@ class Client:
         """Wrap a callback for executor or asyncio dispatch."""
         ...
 
-    def on_audio_data(self, callback: Callable[[bytes, int, int, Metadata], None]) -> None:
+    @overload
+    def on_audio_data(self, callback: Callable[[Frame, int, int, Metadata], None]) -> None:
         """Register audio data callback. Supports executor and async coroutines."""
         ...
+    @overload
+    def on_audio_data(self, callback: Callable[[Any, int, int, Metadata], None], dtype: Any) -> None:
+        """Register audio data callback that receives L16 audio as a numpy array.
+
+        dtype is 'int16' or 'float32' (or numpy.int16 / numpy.float32); the
+        array has shape (frames, channels) and float32 samples are scaled to
+        [-1, 1). Requires numpy and the L16 codec: join() raises ValueError
+        otherwise, and so does this call, or a later set_audio_params() that
+        picks another codec, once the client has joined.
+        """
+        ...
     onAudioData: Callable  # camelCase alias
 
-    def on_video_data(self, callback: Callable[[bytes, int, int, Metadata], None]) -> None:
+    def on_video_data(self, callback: Callable[[Frame, int, int, Metadata], None]) -> None:
         """Register video data callback. Supports executor and async coroutines."""
         ...
     onVideoData: Callable  # camelCase alias
 
-    def on_deskshare_data(self, callback: Callable[[bytes, int, int, Metadata], None]) -> None:
+    def on_deskshare_data(self, callback: Callable[[Frame, int, int, Metadata], None]) -> None:
         """Register deskshare data callback. Supports executor and async coroutines."""
         ...
     onDeskshareData: Callable  # camelCase alias
@@ -498,6 +689,30 @@ class Client:
         ...
     onTranscriptData: Callable  # camelCase alias
 
+    def on_audio_batch(self, callback: Callable[[List[Frame]], None]) -> None:
+        """Register a callback for each poll's audio frames, as a list of Frame.
+
+        Frames from every batch callback of one poll are delivered with a
+        single GIL acquisition, instead of one per frame.
+        """
+        ...
+    onAudioBatch: Callable  # camelCase alias
+
+    def on_video_batch(self, callback: Callable[[List[Frame]], None]) -> None:
+        """Register a callback for each poll's video frames, as a list of Frame."""
+        ...
+    onVideoBatch: Callable  # camelCase alias
+
+    def on_deskshare_batch(self, callback: Callable[[List[Frame]], None]) -> None:
+        """Register a callback for each poll's deskshare frames, as a list of Frame."""
+        ...
+    onDeskshareBatch: Callable  # camelCase alias
+
+    def on_transcript_batch(self, callback: Callable[[List[Frame]], None]) -> None:
+        """Register a callback for each poll's transcript frames, as a list of Frame."""
+        ...
+    onTranscriptBatch: Callable  # camelCase alias
+
     def on_leave(self, callback: Callable[[int], None]) -> None:
         """Register leave callback"""
         ...
@@ -636,6 +851,32 @@ class Client:
         """Unsubscribe from event types (legacy camelCase alias)"""
         ...
 
+    def shm_ring(self, media: Literal['audio', 'video', 'deskshare', 'transcript'],
+                 bytes: int = 4 << 20, name: str = '') -> str:
+        """
+        Copy this client's frames of one media type into a named POSIX
+        shared-memory ring on the polling thread.
+
+        Worker processes (multiprocessing, Node.js or C++) attach by name,
+        e.g. with ShmRingReader, without frames being pickled or piped. The
+        segment is removed when the ring is closed or the client leaves;
+        attached readers can still drain it. Not available on Windows.
+
+        Args:
+            media: The media type to publish
+            bytes: Size of the ring's data area, a power of two from 4 KiB to 1 GiB
+            name: Segment name, '/' followed by a name without '/'. Defaults to
+                '/rtms-<stream id>-<media>', which needs the client to have joined
+
+        Returns:
+            The segment name; the same name again if the ring already exists
+        """
+        ...
+    def close_shm_ring(self, media: Literal['audio', 'video', 'deskshare', 'transcript']) -> bool:
+        """Stop writing a media type's shared-memory ring and remove its
+        name. Returns False if there was none."""
+        ...
+
     def on_webhook_event(
         self,
         callback: Optional[Callable[[Dict[str, Any]], None]] = None,
@@ -808,6 +1049,9 @@ def onWebhookEvent(
     When a webhook event is received, it parses the JSON payload and passes it to
     the provided callback function.
 
+    Set ZM_RTMS_METRICS_PATH (e.g. '/metrics') to also serve render_metrics()
+    output to GET requests on that path.
+
     Can be used as a decorator or a direct function call.
 
     Args:
@@ -823,6 +1067,80 @@ def onWebhookEvent(
 # Alias for backwards compatibility
 on_webhook_event = onWebhookEvent
 
+# ============================================================================
+# Prometheus Metrics
+# ============================================================================
+
+def render_metrics() -> str:
+    """
+    Render every live client and event loop in the Prometheus text format.
+
+    Includes per-media frame and byte counters, time since each stream's last
+    frame, and poll/callback latency histograms labelled by meeting_uuid and
+    stream_id. Serve it with Content-Type 'text/plain; version=0.0.4'.
+    """
+    ...
+
+def start_metrics_server(port: int = 9464, host: str = "127.0.0.1") -> int:
+    """
+    Serve render_metrics() at http://host:port/metrics from a native thread.
+
+    Scrapes never take the GIL. Starting again replaces the previous listener.
+
+    Args:
+        port: Port to listen on; 0 picks a free port
+        host: Address to bind
+
+    Returns:
+        The port the listener is bound to
+
+    Raises:
+        RTMSException: If the address cannot be bound
+    """
+    ...
+
+def stop_metrics_server() -> bool:
+    """Stop the listener started by start_metrics_server(). Returns True if one was running."""
+    ...
+
+def gil_acquisitions() -> int:
+    """Number of times native callbacks have taken the GIL since the module was loaded.
+
+    Sample it twice to get acquisitions per second, e.g. to compare per-frame
+    data callbacks with the batch callbacks.
+    """
+    ...
+
+# ============================================================================
+# Hot-path Tracing
+# ============================================================================
+
+TRACE_ENABLED: bool
+"""True when the extension was built with RTMS_TRACE=ON."""
+
+@overload
+def dump_trace(path: None = None) -> str:
+    """
+    Export the hot-path trace recorded by an RTMS_TRACE build.
+
+    Spans cover each SDK sink, poll, config and join call, the wait for the GIL
+    and the Python callback, in the Chrome trace event format (open in
+    chrome://tracing or ui.perfetto.dev). Without RTMS_TRACE the trace is empty.
+
+    Args:
+        path: File to write the trace to; when omitted the JSON is returned
+
+    Returns:
+        The trace JSON, or True once it has been written to path
+    """
+    ...
+@overload
+def dump_trace(path: str) -> bool: ...
+
+def clear_trace() -> None:
+    """Discard every event recorded so far."""
+    ...
+
 # ============================================================================
 # Event Loop Functions
 # ============================================================================
@@ -0,0 +1,250 @@
+#include "shared_ring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace rtms {
+
+namespace {
+
+// Upper bound on one blocking wait, so a writer that died without closing
+// the ring cannot hold a reader forever between deadline checks
+constexpr std::chrono::milliseconds kWaitSlice(100);
+
+std::atomic_ref<uint32_t> field(const uint8_t* memory, SharedRing::Field index) {
+    // Header words are shared with other threads and, through Atomics, with JS
+    return std::atomic_ref<uint32_t>(*reinterpret_cast<uint32_t*>(const_cast<uint8_t*>(memory) + index * 4));
+}
+
+uint32_t validCapacity(const void* memory, size_t size) {
+    if (!memory || reinterpret_cast<uintptr_t>(memory) % 8 != 0) {
+        throw std::invalid_argument("SharedRing memory must be 8-byte aligned");
+    }
+    size_t capacity = size > SharedRing::kHeaderSize ? size - SharedRing::kHeaderSize : 0;
+    if (capacity < SharedRing::kMinCapacity || capacity > SharedRing::kMaxCapacity ||
+        (capacity & (capacity - 1)) != 0) {
+        throw std::invalid_argument("SharedRing needs a header plus a power-of-two data area of 4 KiB to 1 GiB, got " +
+                                    std::to_string(size) + " bytes");
+    }
+    return static_cast<uint32_t>(capacity);
+}
+
+#ifdef __linux__
+// Shared (not FUTEX_PRIVATE) operations, so they work across processes
+void futexWake(const uint8_t* memory, SharedRing::Field index) {
+    syscall(SYS_futex, memory + index * 4, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+void futexWait(const uint8_t* memory, SharedRing::Field index, uint32_t expected, std::chrono::nanoseconds timeout) {
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+    ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+    syscall(SYS_futex, memory + index * 4, FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+#endif
+
+} // namespace
+
+SharedRing::SharedRing(void* memory, size_t size)
+    : memory_(static_cast<uint8_t*>(memory)), capacity_(validCapacity(memory, size)) {
+    std::memset(memory_, 0, kHeaderSize);
+    store(Capacity, capacity_);
+    store(Magic, kMagic);
+}
+
+uint32_t SharedRing::load(Field index) const {
+    return field(memory_, index).load();
+}
+
+void SharedRing::store(Field index, uint32_t value) {
+    field(memory_, index).store(value);
+}
+
+bool SharedRing::write(const uint8_t* data, size_t size, uint64_t timestamp, int user_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) return false;
+
+    size_t need = recordSize(size);
+    if (need > capacity_) {
+        store(Dropped, load(Dropped) + 1);
+        return false;
+    }
+
+    uint32_t offset = position_ & (capacity_ - 1);
+    uint32_t skip = offset + need > capacity_ ? capacity_ - offset : 0;
+    uint32_t end = position_ + skip + static_cast<uint32_t>(need);
+
+    // Readers that copy anything this record overwrites will see the new
+    // reserve afterwards and discard the copy
+    store(Reserve, end);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint8_t* data_area = memory_ + kHeaderSize;
+    if (skip) {
+        std::memcpy(data_area + offset, &kWrapMarker, 4);
+        offset = 0;
+    }
+    uint32_t size32 = static_cast<uint32_t>(size);
+    int32_t user32 = static_cast<int32_t>(user_id);
+    double ts = static_cast<double>(timestamp);
+    uint64_t sequence = written_;
+    std::memcpy(data_area + offset, &size32, 4);
+    std::memcpy(data_area + offset + 4, &user32, 4);
+    std::memcpy(data_area + offset + 8, &ts, 8);
+    std::memcpy(data_area + offset + 16, &sequence, 8);
+    if (size) std::memcpy(data_area + offset + kRecordHeaderSize, data, size);
+
+    position_ = end;
+    ++written_;
+    store(Commit, end);
+    wakeReaders();
+    return true;
+}
+
+void SharedRing::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) return;
+    closed_ = true;
+    store(Closed, 1);
+    wakeReaders();
+}
+
+void SharedRing::wakeReaders() {
+    // Readers raise Waiters before their last look at Commit and Closed, so
+    // one that missed this store is counted here (both sides are seq_cst)
+#ifdef __linux__
+    if (load(Waiters) != 0) futexWake(memory_, Commit);
+#endif
+}
+
+uint64_t SharedRing::written() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+SharedRing::Reader::Reader(const void* memory, size_t size)
+    : memory_(static_cast<const uint8_t*>(memory)), capacity_(validCapacity(memory, size)) {
+    if (field(memory_, Magic).load() != kMagic || field(memory_, Capacity).load() != capacity_) {
+        throw std::invalid_argument("Memory does not hold a SharedRing of this size");
+    }
+    position_ = field(memory_, Commit).load();
+}
+
+bool SharedRing::Reader::closed() const {
+    return field(memory_, Closed).load() != 0;
+}
+
+bool SharedRing::Reader::next(Frame& frame) {
+    View view;
+    while (peek(view)) {
+        frame.sequence = view.sequence;
+        frame.user_id = view.user_id;
+        frame.timestamp = view.timestamp;
+        frame.data.assign(view.data, view.data + view.size);
+        if (consume()) return true;
+    }
+    return false;
+}
+
+bool SharedRing::Reader::peek(View& view) {
+    const uint8_t* data_area = memory_ + kHeaderSize;
+    advance_ = 0;
+    for (;;) {
+        uint32_t commit = field(memory_, Commit).load();
+        if (position_ == commit) return false;
+
+        uint32_t offset = position_ & (capacity_ - 1);
+        uint32_t size;
+        std::memcpy(&size, data_area + offset, 4);
+
+        bool wrap = size == kWrapMarker;
+        size_t advance = wrap ? capacity_ - offset : recordSize(size);
+        bool intact = uint32_t(commit - position_) <= capacity_ && advance <= capacity_ - offset;
+        if (intact && !wrap) {
+            int32_t user_id;
+            double ts;
+            std::memcpy(&user_id, data_area + offset + 4, 4);
+            std::memcpy(&ts, data_area + offset + 8, 8);
+            std::memcpy(&peeked_, data_area + offset + 16, 8);
+            view.sequence = peeked_;
+            view.user_id = user_id;
+            view.timestamp = static_cast<uint64_t>(ts);
+            view.data = data_area + offset + kRecordHeaderSize;
+            view.size = size;
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (!intact || uint32_t(field(memory_, Reserve).load() - position_) > capacity_) {
+            // Lapped: what was read may be overwritten; start again at the writer
+            resync();
+            continue;
+        }
+
+        if (wrap) {
+            position_ += static_cast<uint32_t>(advance);
+            continue;
+        }
+        advance_ = static_cast<uint32_t>(advance);
+        return true;
+    }
+}
+
+bool SharedRing::Reader::consume() {
+    if (advance_ == 0) return false;
+
+    // The payload was good if the writer has still not started overwriting it
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (uint32_t(field(memory_, Reserve).load() - position_) > capacity_) {
+        resync();
+        return false;
+    }
+
+    if (started_ && peeked_ > sequence_) lost_ += peeked_ - sequence_;
+    sequence_ = peeked_ + 1;
+    started_ = true;
+
+    position_ += advance_;
+    advance_ = 0;
+    return true;
+}
+
+bool SharedRing::Reader::wait(std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        uint32_t commit = field(memory_, Commit).load();
+        if (commit != position_ || closed()) return true;
+
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::steady_clock::duration::zero()) return false;
+        auto slice = std::min<std::chrono::nanoseconds>(remaining, kWaitSlice);
+#ifdef __linux__
+        auto waiters = field(memory_, Waiters);
+        waiters.fetch_add(1);
+        if (field(memory_, Commit).load() == commit && !closed()) futexWait(memory_, Commit, commit, slice);
+        waiters.fetch_sub(1);
+#else
+        // No cross-process wakeup here; check again at a short interval
+        std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(slice, std::chrono::milliseconds(1)));
+#endif
+    }
+}
+
+void SharedRing::Reader::resync() {
+    position_ = field(memory_, Commit).load();
+    advance_ = 0;
+    ++lapped_;
+}
+
+} // namespace rtms
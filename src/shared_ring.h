@@ -0,0 +1,184 @@
+#ifndef RTMS_SHARED_RING_H
+#define RTMS_SHARED_RING_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace rtms {
+
+/**
+ * Broadcast ring of media frames in memory the caller provides, such as a
+ * JavaScript SharedArrayBuffer or a shared-memory segment (see ShmRing).
+ *
+ * One writer appends records and never waits; any number of readers follow
+ * it independently. A reader that falls a whole ring behind loses frames
+ * rather than slowing the writer down. The layout is fixed so readers in
+ * other languages can follow it (little-endian, byte offsets):
+ *
+ *     0   uint32  kMagic
+ *     4   uint32  capacity of the data area, a power of two
+ *     8   uint32  commit: end of the last complete record
+ *     12  uint32  reserve: end of the record being written
+ *     16  uint32  frames dropped for not fitting in the ring
+ *     20  uint32  1 once the writer has closed the ring
+ *     24  uint32  readers blocked in Reader::wait(); the only word readers write
+ *     64  data area
+ *
+ * commit and reserve are byte positions that grow without bound and wrap at
+ * 2^32; a position's offset in the data area is position % capacity. Each
+ * record is a 24-byte header (uint32 size, int32 user id, float64 timestamp,
+ * uint64 sequence) followed by the payload, padded to 8 bytes. Sequence
+ * numbers count the frames written from 0, so a gap tells a reader exactly
+ * how many frames it missed. Records never straddle the end
+ * of the data area: the tail is skipped with a record whose size is
+ * kWrapMarker instead.
+ *
+ * A reader copies a record and then checks reserve: if the writer has come
+ * within a ring of the record's start, the copy may be torn and the reader
+ * must resynchronise at commit. Readers that work on the payload in place
+ * make the same check once they are done with it.
+ *
+ * On Linux the writer wakes readers blocked on the commit word with a
+ * futex, which works across processes that map the same memory.
+ */
+class SharedRing {
+public:
+    static constexpr uint32_t kMagic = 0x524D5452;   // "RTMR"
+    static constexpr size_t kHeaderSize = 64;
+    static constexpr size_t kRecordHeaderSize = 24;
+    static constexpr size_t kMinCapacity = 4096;
+    static constexpr size_t kMaxCapacity = size_t(1) << 30;
+    static constexpr uint32_t kWrapMarker = 0xFFFFFFFF;
+
+    enum Field : size_t { Magic = 0, Capacity = 1, Commit = 2, Reserve = 3, Dropped = 4, Closed = 5, Waiters = 6 };
+
+    /**
+     * Format size bytes at memory as an empty ring. memory must be 8-byte
+     * aligned and outlive the ring; size minus kHeaderSize must be a power
+     * of two between kMinCapacity and kMaxCapacity. Throws
+     * std::invalid_argument otherwise.
+     */
+    SharedRing(void* memory, size_t size);
+
+    SharedRing(const SharedRing&) = delete;
+    SharedRing& operator=(const SharedRing&) = delete;
+
+    /**
+     * Append one frame. Returns false, without writing, if the ring is
+     * closed or the frame is larger than the ring can hold.
+     */
+    bool write(const uint8_t* data, size_t size, uint64_t timestamp, int user_id);
+
+    /**
+     * Mark the ring closed for readers. After close() returns, write() no
+     * longer touches the memory.
+     */
+    void close();
+
+    size_t capacity() const { return capacity_; }
+
+    /** Frames written since construction. */
+    uint64_t written() const;
+
+    /** Bytes needed for a ring with this data-area capacity. */
+    static constexpr size_t bytesFor(size_t capacity) { return kHeaderSize + capacity; }
+
+    /** A record's footprint in the data area. */
+    static constexpr size_t recordSize(size_t payload) { return (kRecordHeaderSize + payload + 7) & ~size_t(7); }
+
+    /**
+     * Follows a ring from its current commit position. Used by native
+     * consumers and tests; JavaScript readers implement the same steps.
+     */
+    class Reader {
+    public:
+        struct Frame {
+            uint64_t sequence = 0;
+            int user_id = 0;
+            uint64_t timestamp = 0;
+            std::vector<uint8_t> data;
+        };
+
+        /** A frame in place in the ring; see peek(). */
+        struct View {
+            uint64_t sequence = 0;
+            int user_id = 0;
+            uint64_t timestamp = 0;
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+        };
+
+        /**
+         * Throws std::invalid_argument if memory does not hold a ring. wait()
+         * writes the header's waiters word, so memory must be writable for it.
+         */
+        Reader(const void* memory, size_t size);
+
+        /** Copy the next frame into frame. Returns false if none is ready. */
+        bool next(Frame& frame);
+
+        /**
+         * Point view at the next frame without copying it. Returns false if
+         * none is ready. The writer may overwrite the payload once it laps
+         * the reader, so call consume() when done with it.
+         */
+        bool peek(View& view);
+
+        /**
+         * Move past the frame from the last peek(). Returns false if the
+         * writer overwrote it while it was in use: whatever was read from it
+         * must be discarded, and the reader has skipped ahead to the writer.
+         */
+        bool consume();
+
+        /**
+         * Block until a frame may be ready or the ring is closed, for at most
+         * timeout. Returns false on timeout.
+         */
+        bool wait(std::chrono::milliseconds timeout);
+
+        /** The writer has closed the ring; frames already written can still be read. */
+        bool closed() const;
+
+        /** Times this reader was lapped and skipped ahead to the writer. */
+        uint64_t lapped() const { return lapped_; }
+
+        /**
+         * Frames the reader skipped between ones it consumed, from gaps in
+         * the sequence numbers.
+         */
+        uint64_t lost() const { return lost_; }
+
+    private:
+        void resync();
+
+        const uint8_t* memory_;
+        uint32_t capacity_;
+        uint32_t position_;
+        uint32_t advance_ = 0;   // footprint of the peeked frame; 0 when none
+        uint64_t peeked_ = 0;    // sequence of the peeked frame
+        uint64_t sequence_ = 0;  // the next frame expected
+        bool started_ = false;   // sequence_ is known
+        uint64_t lapped_ = 0;
+        uint64_t lost_ = 0;
+    };
+
+private:
+    uint32_t load(Field field) const;
+    void store(Field field, uint32_t value);
+    void wakeReaders();
+
+    uint8_t* memory_;
+    uint32_t capacity_;
+    uint32_t position_ = 0;   // == commit; only the writer moves it
+    uint64_t written_ = 0;
+    bool closed_ = false;
+    mutable std::mutex mutex_;   // held by write() so close() can wait it out
+};
+
+} // namespace rtms
+
+#endif // RTMS_SHARED_RING_H
@@ -0,0 +1,135 @@
+#include "shm_ring.h"
+#include "rtms.h"
+
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace rtms {
+
+#ifdef _WIN32
+
+ShmSegment::ShmSegment(const std::string& name, size_t) : name_(name) {
+    throw Exception(RTMS_SDK_FAILURE, "ShmSegment: POSIX shared memory is not available on Windows");
+}
+
+ShmSegment::ShmSegment(const std::string& name) : name_(name) {
+    throw Exception(RTMS_SDK_FAILURE, "ShmSegment: POSIX shared memory is not available on Windows");
+}
+
+ShmSegment::~ShmSegment() = default;
+
+#else
+
+namespace {
+
+void checkName(const std::string& name) {
+    if (name.size() < 2 || name[0] != '/' || name.find('/', 1) != std::string::npos) {
+        throw std::invalid_argument("Shared memory name must be '/' followed by a name without '/', got '" +
+                                    name + "'");
+    }
+}
+
+[[noreturn]] void fail(const std::string& name, const char* call) {
+    throw Exception(RTMS_SDK_FAILURE, std::string("ShmSegment: ") + call + "(" + name + ") failed: " +
+                                      std::strerror(errno));
+}
+
+} // namespace
+
+ShmSegment::ShmSegment(const std::string& name, size_t size) : name_(name), size_(size) {
+    checkName(name);
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) fail(name, "shm_open");
+
+    // ftruncate() zero-fills, which is what SharedRing expects of fresh memory
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        int error = errno;
+        close(fd);
+        shm_unlink(name.c_str());
+        errno = error;
+        fail(name, "ftruncate");
+    }
+    data_ = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int error = errno;
+    close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        shm_unlink(name.c_str());
+        errno = error;
+        fail(name, "mmap");
+    }
+    owner_ = true;
+}
+
+ShmSegment::ShmSegment(const std::string& name) : name_(name) {
+    checkName(name);
+    // Read-write: readers register in the ring header while they wait
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) fail(name, "shm_open");
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int error = errno;
+        close(fd);
+        errno = error;
+        fail(name, "fstat");
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    data_ = size_ ? mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    int error = size_ ? errno : EINVAL;
+    close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        errno = error;
+        fail(name, "mmap");
+    }
+}
+
+ShmSegment::~ShmSegment() {
+    if (data_) munmap(data_, size_);
+    if (owner_) shm_unlink(name_.c_str());
+}
+
+#endif
+
+ShmRing::ShmRing(const std::string& name, size_t capacity)
+    : segment_(name, SharedRing::bytesFor(capacity)), ring_(segment_.data(), segment_.size()) {}
+
+ShmRing::~ShmRing() {
+    close();
+}
+
+bool ShmRing::write(const MediaFrameView& frame) {
+    return ring_.write(frame.data(), frame.size(), frame.timestamp(), frame.userId());
+}
+
+bool ShmRing::write(const uint8_t* data, size_t size, uint64_t timestamp, int user_id) {
+    return ring_.write(data, size, timestamp, user_id);
+}
+
+void ShmRing::close() {
+    ring_.close();
+}
+
+std::string ShmRing::nameFor(const std::string& stream_id, ClientMetrics::Media media) {
+    std::string name = "/rtms-";
+    for (char c : stream_id) {
+        bool safe = std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_';
+        name += safe ? c : '_';
+    }
+    return name + "-" + ClientMetrics::name(media);
+}
+
+ShmRing::Reader::Reader(const std::string& name)
+    : ShmSegment(name), SharedRing::Reader(ShmSegment::data(), ShmSegment::size()) {}
+
+} // namespace rtms
@@ -0,0 +1,103 @@
+#ifndef RTMS_SHM_RING_H
+#define RTMS_SHM_RING_H
+
+#include "metrics.h"
+#include "shared_ring.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace rtms {
+
+class MediaFrameView;
+
+/**
+ * A mapped POSIX shared-memory segment. Creating one fails if the name is
+ * taken; the creator unlinks the name when it is destroyed, while processes
+ * that already have the segment mapped keep it until they unmap it.
+ *
+ * Names start with '/' and contain no other '/'. Throws
+ * std::invalid_argument for a bad name and rtms::Exception if the segment
+ * cannot be created or opened, including on Windows, which has no POSIX
+ * shared memory.
+ */
+class ShmSegment {
+public:
+    /** Create name with size bytes, zero-filled. */
+    ShmSegment(const std::string& name, size_t size);
+
+    /** Map an existing segment, all of it, read-write. */
+    explicit ShmSegment(const std::string& name);
+
+    ~ShmSegment();
+
+    ShmSegment(const ShmSegment&) = delete;
+    ShmSegment& operator=(const ShmSegment&) = delete;
+
+    void* data() const { return data_; }
+    size_t size() const { return size_; }
+    const std::string& name() const { return name_; }
+
+private:
+    std::string name_;
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    bool owner_ = false;
+};
+
+/**
+ * A SharedRing in its own shared-memory segment, so that one process can
+ * run the Clients and publish their frames while worker processes attach by
+ * name and read them in place, without a pipe or a copy per worker.
+ *
+ * One ShmRing per stream and media type is the intended layout; nameFor()
+ * gives the conventional name. The ring is closed and its name unlinked
+ * when the ShmRing is destroyed, and attached readers can still drain what
+ * was written.
+ */
+class ShmRing {
+public:
+    /**
+     * Create name with a data area of capacity bytes (a power of two, see
+     * SharedRing). Throws as ShmSegment and SharedRing do.
+     */
+    ShmRing(const std::string& name, size_t capacity);
+    ~ShmRing();
+
+    ShmRing(const ShmRing&) = delete;
+    ShmRing& operator=(const ShmRing&) = delete;
+
+    /** Append one frame; see SharedRing::write(). Safe to call from a frame callback. */
+    bool write(const MediaFrameView& frame);
+    bool write(const uint8_t* data, size_t size, uint64_t timestamp, int user_id);
+
+    /** Mark the ring closed for readers; later writes are refused. */
+    void close();
+
+    const std::string& name() const { return segment_.name(); }
+    SharedRing& ring() { return ring_; }
+
+    /**
+     * "/rtms-<stream id>-<media>", with characters other than letters,
+     * digits, '-' and '_' in the stream id replaced by '_'.
+     */
+    static std::string nameFor(const std::string& stream_id, ClientMetrics::Media media);
+
+    /** Follows a ShmRing from another process (or thread) by name. */
+    class Reader : private ShmSegment, public SharedRing::Reader {
+    public:
+        /** Throws as ShmSegment does, or std::invalid_argument if name does not hold a ring. */
+        explicit Reader(const std::string& name);
+
+        using ShmSegment::name;
+    };
+
+private:
+    ShmSegment segment_;
+    SharedRing ring_;
+};
+
+} // namespace rtms
+
+#endif // RTMS_SHM_RING_H
@@ -0,0 +1,186 @@
+#include "trace.h"
+#include "rtms.h"
+
+#include <fstream>
+
+#ifdef RTMS_TRACE
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#endif
+#endif
+
+namespace rtms {
+namespace trace {
+
+#ifdef RTMS_TRACE
+
+namespace {
+
+void writeString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* p = text; *p; ++p) {
+        char c = *p;
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// Fields are atomics so a dump racing with the owning thread is well defined;
+// every access is relaxed and ordered by Ring::head.
+struct Event {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> stamp{0};   // steady_clock ns << 1, low bit set for an end event
+};
+
+struct Ring {
+    uint32_t tid = 0;
+    std::string thread_name;
+    std::atomic<uint64_t> head{0};    // events ever written; only the owner stores it
+    std::atomic<uint64_t> floor{0};   // events before this index were discarded by clear()
+    std::array<Event, kRingCapacity> events;
+};
+
+// Rings outlive their threads so a dump still shows threads that have exited.
+// A process that keeps creating traced threads grows by one ring per thread.
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+};
+
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+Ring* createRing() {
+    auto ring = std::make_unique<Ring>();
+#ifdef __linux__
+    char name[16] = {};
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0) ring->thread_name = name;
+#endif
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    ring->tid = static_cast<uint32_t>(reg.rings.size() + 1);
+    if (ring->thread_name.empty()) ring->thread_name = "thread-" + std::to_string(ring->tid);
+    reg.rings.push_back(std::move(ring));
+    return reg.rings.back().get();
+}
+
+void record(const char* name, bool is_end) {
+    thread_local Ring* ring = createRing();
+    uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    uint64_t index = ring->head.load(std::memory_order_relaxed);
+    Event& event = ring->events[index % kRingCapacity];
+    event.name.store(name, std::memory_order_relaxed);
+    event.stamp.store((ns << 1) | (is_end ? 1 : 0), std::memory_order_relaxed);
+    ring->head.store(index + 1, std::memory_order_release);
+}
+
+} // namespace
+
+void begin(const char* name) { record(name, false); }
+void end(const char* name) { record(name, true); }
+
+std::string chromeJson() {
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&] {
+        if (!first) out << ',';
+        first = false;
+        out << '\n';
+    };
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& ring : reg.rings) {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->tid << ",\"args\":{\"name\":";
+        writeString(out, ring->thread_name.c_str());
+        out << "}}";
+
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t start = std::max(ring->floor.load(std::memory_order_relaxed),
+                                  head > kRingCapacity ? head - kRingCapacity : 0);
+        struct Copy {
+            const char* name;
+            uint64_t stamp;
+        };
+        std::vector<Copy> copies;
+        copies.reserve(head - start);
+        for (uint64_t i = start; i < head; ++i) {
+            const Event& event = ring->events[i % kRingCapacity];
+            copies.push_back({event.name.load(std::memory_order_relaxed),
+                              event.stamp.load(std::memory_order_relaxed)});
+        }
+
+        // Drop anything the owner may have overwritten while we were copying,
+        // including the slot it is writing now.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = ring->head.load(std::memory_order_relaxed);
+        uint64_t valid_from = after >= kRingCapacity ? after - kRingCapacity + 1 : 0;
+
+        for (uint64_t i = std::max(start, valid_from); i < head; ++i) {
+            const Copy& copy = copies[i - start];
+            if (!copy.name) continue;
+            char ts[32];
+            std::snprintf(ts, sizeof(ts), "%.3f", static_cast<double>(copy.stamp >> 1) / 1000.0);
+            separator();
+            out << "{\"name\":";
+            writeString(out, copy.name);
+            out << ",\"cat\":\"rtms\",\"ph\":\"" << ((copy.stamp & 1) ? 'E' : 'B')
+                << "\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << ring->tid << '}';
+        }
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+void clear() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& ring : reg.rings) {
+        ring->floor.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+#else
+
+std::string chromeJson() {
+    return "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n";
+}
+
+void clear() {}
+
+#endif // RTMS_TRACE
+
+void writeChromeJson(const std::string& path) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw Exception(RTMS_SDK_FAILURE, "Cannot open trace file " + path);
+    }
+    file << chromeJson();
+    if (!file.flush()) {
+        throw Exception(RTMS_SDK_FAILURE, "Failed to write trace file " + path);
+    }
+}
+
+} // namespace trace
+} // namespace rtms
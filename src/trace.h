@@ -0,0 +1,83 @@
+#ifndef RTMS_TRACE_H
+#define RTMS_TRACE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Hot-path tracing, compiled in with -DRTMS_TRACE=ON.
+ *
+ * RTMS_TRACE_SCOPE("name") records a begin event where it appears and the
+ * matching end event when the enclosing scope exits. Events go into a
+ * fixed-size ring owned by the recording thread, so recording takes no lock
+ * and never allocates after the thread's first event; once a ring is full the
+ * oldest events are overwritten. Names must be string literals (or otherwise
+ * outlive the trace), since only the pointer is stored.
+ *
+ * Without RTMS_TRACE the macros expand to nothing and the dump functions
+ * return an empty trace.
+ */
+
+#ifdef RTMS_TRACE
+#define RTMS_TRACE_CONCAT_INNER(a, b) a##b
+#define RTMS_TRACE_CONCAT(a, b) RTMS_TRACE_CONCAT_INNER(a, b)
+#define RTMS_TRACE_SCOPE(name) ::rtms::trace::Scope RTMS_TRACE_CONCAT(rtms_trace_scope_, __LINE__)(name)
+#define RTMS_TRACE_BEGIN(name) ::rtms::trace::begin(name)
+#define RTMS_TRACE_END(name) ::rtms::trace::end(name)
+#else
+#define RTMS_TRACE_SCOPE(name) ((void)0)
+#define RTMS_TRACE_BEGIN(name) ((void)0)
+#define RTMS_TRACE_END(name) ((void)0)
+#endif
+
+namespace rtms {
+namespace trace {
+
+/** Events kept per thread before the oldest are overwritten. */
+constexpr size_t kRingCapacity = 1 << 16;
+
+/** True when the library was built with RTMS_TRACE. */
+constexpr bool enabled() {
+#ifdef RTMS_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef RTMS_TRACE
+void begin(const char* name);
+void end(const char* name);
+
+class Scope {
+public:
+    explicit Scope(const char* name) : name_(name) { begin(name_); }
+    ~Scope() { end(name_); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name_;
+};
+#endif
+
+/**
+ * Every thread's buffered events in the Chrome trace event format, loadable
+ * in chrome://tracing and ui.perfetto.dev. Timestamps are microseconds of the
+ * steady clock. Safe to call while other threads are recording.
+ */
+std::string chromeJson();
+
+/**
+ * Write chromeJson() to a file. Throws rtms::Exception if it cannot be
+ * written.
+ */
+void writeChromeJson(const std::string& path);
+
+/** Discard every buffered event. */
+void clear();
+
+} // namespace trace
+} // namespace rtms
+
+#endif // RTMS_TRACE_H
@@ -4,8 +4,15 @@
  */
 
 #include "mock_sdk.h"
-#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
 #include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 // Required by rtms_sdk.h extern declaration
 std::string g_agent;
@@ -13,21 +20,291 @@ std::string g_agent;
 // Global mock state — reset in each test
 MockSdkState g_mock_state;
 
+// Serialises recording into g_mock_state when clients join and leave on
+// several loop threads; poll() only touches its own instance and an atomic.
+static std::mutex g_mock_mutex;
+
+// ============================================================================
+// MockScenario
+// ============================================================================
+
+MockScenario MockScenario::parse(const std::string& spec) {
+    MockScenario scenario;
+    const std::pair<const char*, int*> fields[] = {
+        {"participants", &scenario.participants},
+        {"audio_interval_ms", &scenario.audio_interval_ms},
+        {"audio_bytes", &scenario.audio_bytes},
+        {"video_fps", &scenario.video_fps},
+        {"video_senders", &scenario.video_senders},
+        {"video_bytes", &scenario.video_bytes},
+        {"video_keyframe_bytes", &scenario.video_keyframe_bytes},
+        {"video_keyframe_interval", &scenario.video_keyframe_interval},
+        {"transcript_interval_ms", &scenario.transcript_interval_ms},
+        {"transcript_burst", &scenario.transcript_burst},
+        {"churn_interval_ms", &scenario.churn_interval_ms},
+        {"duration_ms", &scenario.duration_ms},
+        {"max_backlog_ms", &scenario.max_backlog_ms},
+    };
+
+    size_t pos = 0;
+    while (pos < spec.size()) {
+        size_t end = spec.find(',', pos);
+        if (end == std::string::npos) end = spec.size();
+        std::string item = spec.substr(pos, end - pos);
+        pos = end + 1;
+        if (item.empty()) continue;
+
+        size_t eq = item.find('=');
+        std::string key = item.substr(0, eq);
+        auto field = std::find_if(std::begin(fields), std::end(fields),
+                                  [&](const auto& f) { return key == f.first; });
+        if (field == std::end(fields)) {
+            throw std::invalid_argument("Unknown mock scenario key: " + key);
+        }
+
+        std::string value = eq == std::string::npos ? "" : item.substr(eq + 1);
+        char* parsed_end = nullptr;
+        long number = std::strtol(value.c_str(), &parsed_end, 10);
+        if (value.empty() || *parsed_end != '\0' || number < 0 || number > 1000000000) {
+            throw std::invalid_argument("Invalid value for mock scenario key " + key + ": " + value);
+        }
+        *field->second = static_cast<int>(number);
+    }
+    return scenario;
+}
+
+namespace {
+
+uint64_t steadyMs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Read once; a malformed RTMS_MOCK_SCENARIO fails the first join loudly
+const std::optional<MockScenario>& environmentScenario() {
+    static const std::optional<MockScenario> scenario = []() -> std::optional<MockScenario> {
+        const char* spec = std::getenv("RTMS_MOCK_SCENARIO");
+        if (!spec || !*spec) return std::nullopt;
+        return MockScenario::parse(spec);
+    }();
+    return scenario;
+}
+
+std::vector<unsigned char> patterned(int size, unsigned seed) {
+    std::vector<unsigned char> bytes(static_cast<size_t>(std::max(size, 0)));
+    for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<unsigned char>((i * 131 + seed) & 0xff);
+    return bytes;
+}
+
+// One simulated meeting, owned by the SDK instance that joined it and driven
+// only from that instance's poll().
+class MockMeeting {
+public:
+    MockMeeting(MockScenario scenario, const std::string& meeting_uuid, const std::string& stream_id)
+        : scenario_(std::move(scenario)),
+          stream_id_(stream_id),
+          session_id_("mock-session-" + meeting_uuid),
+          audio_(patterned(scenario_.audio_bytes, 1)),
+          video_(patterned(scenario_.video_bytes, 2)),
+          keyframe_(patterned(scenario_.video_keyframe_bytes, 3)) {
+        if (!scenario_.clock) scenario_.clock = steadyMs;
+        start_ = scenario_.clock();
+        next_audio_ = start_;
+        next_transcript_ = start_;
+        next_churn_ = start_ + static_cast<uint64_t>(scenario_.churn_interval_ms);
+
+        std::memset(&session_, 0, sizeof(session_));
+        session_.session_id = const_cast<char*>(session_id_.c_str());
+        session_.stream_id = const_cast<char*>(stream_id_.c_str());
+        std::strncpy(session_.meeting_id, meeting_uuid.c_str(), MAX_MEETING_ID_LEN - 1);
+        session_.stat_time = static_cast<int>(start_ / 1000);
+        session_.status = SESS_STATUS_ACTIVE;
+
+        for (int i = 0; i < scenario_.participants; ++i) addParticipant();
+    }
+
+    void stop() { active_ = false; }
+
+    void poll(rtms_sdk_sink* sink) {
+        if (!active_ || !sink) return;
+        uint64_t now = scenario_.clock();
+
+        if (!confirmed_) {
+            confirmed_ = true;
+            sink->on_join_confirm(RTMS_SDK_OK);
+            sink->on_session_update(SESSION_ADD, &session_);
+            for (auto& p : participants_) userUpdate(sink, USER_JOIN, p);
+        }
+
+        // Frames are due strictly before `until`
+        uint64_t until = now + 1;
+        bool ending = false;
+        if (scenario_.duration_ms > 0 && until >= start_ + static_cast<uint64_t>(scenario_.duration_ms)) {
+            until = start_ + static_cast<uint64_t>(scenario_.duration_ms);
+            ending = true;
+        }
+
+        deliverChurn(sink, until);
+        deliverAudio(sink, until);
+        deliverVideo(sink, until);
+        deliverTranscript(sink, until);
+
+        if (ending && active_) {
+            active_ = false;
+            sink->on_session_update(SESSION_STOP, &session_);
+            sink->on_leave(RTMS_SDK_OK);
+        }
+    }
+
+private:
+    struct Participant {
+        int id;
+        std::string name;
+    };
+
+    void addParticipant() {
+        int id = 16778240 + next_participant_++;
+        participants_.push_back({id, "Participant " + std::to_string(next_participant_)});
+    }
+
+    void userUpdate(rtms_sdk_sink* sink, int op, Participant& p) {
+        participant_info info{};
+        info.participant_id = p.id;
+        info.participant_name = const_cast<char*>(p.name.c_str());
+        sink->on_user_update(op, &info);
+    }
+
+    rtms_metadata metadata(Participant& p, uint64_t ts, uint64_t length_ms) {
+        rtms_metadata md{};
+        md.user_name = const_cast<char*>(p.name.c_str());
+        md.user_id = p.id;
+        md.start_ts = ts;
+        md.end_ts = ts + length_ms;
+        return md;
+    }
+
+    // Skip ahead rather than flood the sink after a long stall
+    void skipBacklog(uint64_t& next, uint64_t interval, uint64_t until) {
+        uint64_t backlog = static_cast<uint64_t>(scenario_.max_backlog_ms);
+        if (until > next + backlog + interval) {
+            next += (until - backlog - next) / interval * interval;
+        }
+    }
+
+    void deliverChurn(rtms_sdk_sink* sink, uint64_t until) {
+        if (scenario_.churn_interval_ms <= 0) return;
+        uint64_t interval = static_cast<uint64_t>(scenario_.churn_interval_ms);
+        skipBacklog(next_churn_, interval, until);
+        for (; active_ && next_churn_ < until; next_churn_ += interval) {
+            if (!participants_.empty()) {
+                Participant leaving = participants_.front();
+                participants_.erase(participants_.begin());
+                userUpdate(sink, USER_LEAVE, leaving);
+            }
+            addParticipant();
+            userUpdate(sink, USER_JOIN, participants_.back());
+        }
+    }
+
+    void deliverAudio(rtms_sdk_sink* sink, uint64_t until) {
+        if (scenario_.audio_interval_ms <= 0 || audio_.empty()) return;
+        uint64_t interval = static_cast<uint64_t>(scenario_.audio_interval_ms);
+        skipBacklog(next_audio_, interval, until);
+        for (; active_ && next_audio_ < until; next_audio_ += interval) {
+            for (size_t i = 0; active_ && i < participants_.size(); ++i) {
+                rtms_metadata md = metadata(participants_[i], next_audio_, interval);
+                sink->on_audio_data(audio_.data(), static_cast<int>(audio_.size()), next_audio_, &md);
+            }
+        }
+    }
+
+    void deliverVideo(rtms_sdk_sink* sink, uint64_t until) {
+        if (scenario_.video_fps <= 0 || video_.empty()) return;
+        const uint64_t fps = static_cast<uint64_t>(scenario_.video_fps);
+        auto due = [&](uint64_t frame) { return start_ + frame * 1000 / fps; };
+
+        uint64_t backlog = static_cast<uint64_t>(scenario_.max_backlog_ms);
+        if (until > due(video_frame_) + backlog + 1000 / fps) {
+            video_frame_ = (until - backlog - start_) * fps / 1000;
+        }
+
+        for (; active_ && due(video_frame_) < until; ++video_frame_) {
+            bool key = scenario_.video_keyframe_interval <= 0 ||
+                       video_frame_ % static_cast<uint64_t>(scenario_.video_keyframe_interval) == 0;
+            std::vector<unsigned char>& frame = key && !keyframe_.empty() ? keyframe_ : video_;
+            uint64_t ts = due(video_frame_);
+            size_t senders = std::min(participants_.size(), static_cast<size_t>(std::max(scenario_.video_senders, 0)));
+            for (size_t i = 0; active_ && i < senders; ++i) {
+                rtms_metadata md = metadata(participants_[i], ts, 1000 / fps);
+                sink->on_video_data(frame.data(), static_cast<int>(frame.size()), ts, &md);
+            }
+        }
+    }
+
+    void deliverTranscript(rtms_sdk_sink* sink, uint64_t until) {
+        if (scenario_.transcript_interval_ms <= 0 || participants_.empty()) return;
+        uint64_t interval = static_cast<uint64_t>(scenario_.transcript_interval_ms);
+        skipBacklog(next_transcript_, interval, until);
+        for (; active_ && next_transcript_ < until; next_transcript_ += interval) {
+            for (int i = 0; active_ && i < scenario_.transcript_burst && !participants_.empty(); ++i) {
+                Participant& speaker = participants_[transcript_segment_ % participants_.size()];
+                text_ = "Segment " + std::to_string(++transcript_segment_) + " from " + speaker.name +
+                        ": let's pick this up again after the release review next week.";
+                rtms_metadata md = metadata(speaker, next_transcript_, interval);
+                sink->on_transcript_data(reinterpret_cast<unsigned char*>(&text_[0]), static_cast<int>(text_.size()),
+                                         next_transcript_, &md);
+            }
+        }
+    }
+
+    MockScenario scenario_;
+    std::string stream_id_;
+    std::string session_id_;
+    session_info session_;
+    std::vector<Participant> participants_;
+    std::vector<unsigned char> audio_;
+    std::vector<unsigned char> video_;
+    std::vector<unsigned char> keyframe_;
+    std::string text_;
+
+    uint64_t start_ = 0;
+    uint64_t next_audio_ = 0;
+    uint64_t next_transcript_ = 0;
+    uint64_t next_churn_ = 0;
+    uint64_t video_frame_ = 0;
+    uint64_t transcript_segment_ = 0;
+    int next_participant_ = 0;
+    bool confirmed_ = false;
+    bool active_ = true;
+};
+
+} // namespace
+
 // ============================================================================
 // rtms_sdk stubs
-// rtms_sdk_impl is only forward-declared; m_impl is never used in the mock.
+// rtms_sdk_impl is only forward-declared by the SDK header; the mock uses it
+// to hold per-instance state.
 // ============================================================================
 
-rtms_sdk::rtms_sdk() : m_impl(nullptr) {}
-rtms_sdk::~rtms_sdk() {}
+class rtms_sdk_impl {
+public:
+    rtms_sdk_sink* sink = nullptr;
+    std::unique_ptr<MockMeeting> meeting;
+};
+
+rtms_sdk::rtms_sdk() : m_impl(new rtms_sdk_impl()) {}
+rtms_sdk::~rtms_sdk() { delete m_impl; }
 
 int rtms_sdk::open(rtms_sdk_sink* sink) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
     ++g_mock_state.open_calls;
     g_mock_state.last_sink = sink;
+    m_impl->sink = sink;
     return g_mock_state.open_result;
 }
 
 int rtms_sdk::config(struct media_parameters* params, int media_types, int ale, int feature_ids) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
     ++g_mock_state.config_calls;
     g_mock_state.last_media_types = media_types;
     g_mock_state.last_ale         = ale;
@@ -35,6 +312,7 @@ int rtms_sdk::config(struct media_parameters* params, int media_types, int ale,
 }
 
 int rtms_sdk::set_proxy(std::string proxy_type, std::string proxy_url) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
     ++g_mock_state.proxy_calls;
     g_mock_state.last_proxy_type = std::move(proxy_type);
     g_mock_state.last_proxy_url  = std::move(proxy_url);
@@ -43,12 +321,20 @@ int rtms_sdk::set_proxy(std::string proxy_type, std::string proxy_url) {
 
 int rtms_sdk::join(const char* meeting_uuid, const char* rtms_stream_id,
                    const char* signature, const char* server_url, int timeout) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
     ++g_mock_state.join_calls;
     g_mock_state.last_meeting_uuid = meeting_uuid  ? meeting_uuid  : "";
     g_mock_state.last_stream_id    = rtms_stream_id ? rtms_stream_id : "";
     g_mock_state.last_signature    = signature     ? signature     : "";
     g_mock_state.last_server_url   = server_url    ? server_url    : "";
     g_mock_state.last_timeout      = timeout;
+
+    const std::optional<MockScenario>& scenario =
+        g_mock_state.scenario ? g_mock_state.scenario : environmentScenario();
+    if (g_mock_state.join_result == RTMS_SDK_OK && scenario) {
+        m_impl->meeting = std::make_unique<MockMeeting>(*scenario, g_mock_state.last_meeting_uuid,
+                                                        g_mock_state.last_stream_id);
+    }
     return g_mock_state.join_result;
 }
 
@@ -57,28 +343,36 @@ int rtms_sdk::send_data(int, unsigned char*, int, uint64_t, void*) {
 }
 
 int rtms_sdk::leave(int) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
     ++g_mock_state.leave_calls;
+    // Stopped rather than destroyed: leave() may be called from inside a sink
+    if (m_impl->meeting) m_impl->meeting->stop();
     return g_mock_state.leave_result;
 }
 
 int rtms_sdk::poll() {
     ++g_mock_state.poll_calls;
+    if (g_mock_state.on_poll) g_mock_state.on_poll();
+    if (m_impl->meeting) m_impl->meeting->poll(m_impl->sink);
     return g_mock_state.poll_result;
 }
 
 int rtms_sdk::subscribe_event(int events[], int len) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
     ++g_mock_state.subscribe_calls;
     g_mock_state.last_subscribed_events.assign(events, events + len);
     return g_mock_state.subscribe_result;
 }
 
 int rtms_sdk::unsubscribe_event(int events[], int len) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
     ++g_mock_state.unsubscribe_calls;
     g_mock_state.last_unsubscribed_events.assign(events, events + len);
     return g_mock_state.unsubscribe_result;
 }
 
 int rtms_sdk::send_subscript_video(int user_id, bool is_sub) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
     ++g_mock_state.subscript_video_calls;
     g_mock_state.last_subscript_user_id = user_id;
     g_mock_state.last_subscript_is_sub  = is_sub;
@@ -102,6 +396,7 @@ rtms_sdk_provider* rtms_sdk_provider::instance() {
 }
 
 int rtms_sdk_provider::init(const char* ca_path, bool is_verify_cert) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
     ++g_mock_state.init_calls;
     g_mock_state.last_ca_path      = ca_path ? ca_path : "";
     g_mock_state.last_verify_cert  = is_verify_cert;
@@ -109,18 +404,21 @@ int rtms_sdk_provider::init(const char* ca_path, bool is_verify_cert) {
 }
 
 rtms_sdk* rtms_sdk_provider::create_sdk() {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
     ++g_mock_state.create_calls;
     if (g_mock_state.create_result != 0) return nullptr;
     return new rtms_sdk();
 }
 
 int rtms_sdk_provider::release_sdk(rtms_sdk* sdk) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
     ++g_mock_state.release_calls;
     delete sdk;
     return RTMS_SDK_OK;
 }
 
 void rtms_sdk_provider::uninit() {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
     ++g_mock_state.uninit_calls;
 }
 
@@ -4,20 +4,94 @@
  * Provides:
  *   - g_mock_state  — per-test configurable return values and call records
  *   - mock_trigger_*  — helpers to fire SDK callbacks on the registered sink
+ *   - MockScenario  — synthetic meeting traffic generated inside poll()
  *
  * Usage in tests:
  *   g_mock_state.reset();           // called in each test fixture
  *   g_mock_state.join_result = RTMS_SDK_FAILURE;   // inject failure
  *   mock_trigger_join_confirm(0);   // simulate SDK firing a callback
+ *
+ *   MockScenario scenario;          // load testing: every joined SDK instance
+ *   scenario.participants = 25;     // now produces 25 audio streams at 20 ms
+ *   scenario.video_fps = 30;
+ *   g_mock_state.scenario = scenario;
+ *
+ * Recording and counters are safe to update from several polling threads
+ * (e.g. an EventLoopPool); read them once those threads have stopped.
  */
 
 #pragma once
 
 #include "rtms_sdk.h"
+#include <atomic>
+#include <functional>
+#include <optional>
 #include <string>
 #include <vector>
 #include <cstdint>
 
+/**
+ * Synthetic meeting traffic. When g_mock_state.scenario is set, each SDK
+ * instance that joins successfully replays a meeting from its own poll():
+ * join confirmation, the session and its participants, then audio, video and
+ * transcript frames due by the scenario clock, plus optional join/leave
+ * churn. Everything is delivered on the polling thread, as with the real SDK.
+ *
+ * Setting RTMS_MOCK_SCENARIO (see parse()) enables a scenario for processes
+ * that cannot set g_mock_state directly.
+ */
+struct MockScenario {
+    int participants = 4;
+
+    // Audio: one frame per participant every audio_interval_ms (0 disables)
+    int audio_interval_ms = 20;
+    int audio_bytes       = 160;        // 20 ms of 64 kbit/s Opus
+
+    // Video: video_senders participants at video_fps (0 disables)
+    int video_fps          = 0;
+    int video_senders      = 1;
+    int video_bytes        = 8 * 1024;
+    int video_keyframe_bytes    = 64 * 1024;
+    int video_keyframe_interval = 60;   // frames; the first frame is a keyframe
+
+    // Transcript: transcript_burst segments every transcript_interval_ms (0 disables)
+    int transcript_interval_ms = 2000;
+    int transcript_burst       = 2;
+
+    // Churn: every churn_interval_ms the longest-present participant leaves
+    // and a new one joins (0 disables)
+    int churn_interval_ms = 0;
+
+    // Meeting length; on expiry the session stops and on_leave fires (0 = unlimited)
+    int duration_ms = 0;
+
+    // When polls fall further behind than this, older frames are skipped
+    // rather than delivered in one burst
+    int max_backlog_ms = 1000;
+
+    // Milliseconds on a monotonic clock; defaults to std::chrono::steady_clock.
+    // Tests substitute a manual clock for deterministic output.
+    std::function<uint64_t()> clock;
+
+    /**
+     * Parse "key=value,key=value" using the field names above, e.g.
+     * "participants=50,video_fps=30,churn_interval_ms=5000".
+     * Throws std::invalid_argument on unknown keys or bad values.
+     */
+    static MockScenario parse(const std::string& spec);
+};
+
+// Call counter that may be bumped from several polling threads at once
+struct MockCounter {
+    std::atomic<int> value{0};
+
+    MockCounter() = default;
+    MockCounter(const MockCounter& other) : value(other.value.load()) {}
+    MockCounter& operator=(const MockCounter& other) { value = other.value.load(); return *this; }
+    MockCounter& operator++() { ++value; return *this; }
+    operator int() const { return value.load(); }
+};
+
 struct MockSdkState {
     // --- Configurable return values ---
     int create_result   = 0;        // 0 = return real sdk, non-zero = return nullptr
@@ -40,13 +114,19 @@ struct MockSdkState {
     int open_calls       = 0;
     int config_calls     = 0;
     int join_calls       = 0;
-    int poll_calls       = 0;
+    MockCounter poll_calls;
     int leave_calls      = 0;
     int subscribe_calls  = 0;
     int unsubscribe_calls = 0;
     int proxy_calls      = 0;
     int subscript_video_calls = 0;
 
+    // --- Hooks ---
+    std::function<void()> on_poll;  // runs inside poll(), where the real SDK fires its sinks
+
+    // --- Synthetic traffic (read by join()) ---
+    std::optional<MockScenario> scenario;
+
     // --- Recorded arguments ---
     rtms_sdk_sink* last_sink = nullptr;
 
@@ -0,0 +1,394 @@
+/**
+ * Dispatch benchmark for rtms::Client, driven by the mock SDK.
+ *
+ * Measures, for realistic payloads (20 ms Opus and PCM audio, HD H.264 video,
+ * transcript text):
+ *   - dispatch      ns and heap allocations per frame from SDK sink to user
+ *                   callback, for each callback flavour
+ *   - throughput    frames per second when one thread polls 1 to 1000 clients
+ *
+ * Results are written as JSON so runs can be compared across commits:
+ *
+ *   rtms_bench [--out results.json] [--quick]
+ */
+
+#include "rtms.h"
+#include "mock_sdk.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace rtms;
+
+// ============================================================================
+// Allocation counting
+// ============================================================================
+
+namespace {
+
+std::atomic<bool> g_counting{false};
+std::atomic<uint64_t> g_allocs{0};
+std::atomic<uint64_t> g_alloc_bytes{0};
+
+void* countedAlloc(std::size_t size) {
+    if (g_counting.load(std::memory_order_relaxed)) {
+        g_allocs.fetch_add(1, std::memory_order_relaxed);
+        g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAlloc(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAlloc(size); } catch (...) { return nullptr; }
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// ============================================================================
+// Payloads
+// ============================================================================
+
+struct Payload {
+    const char* name;
+    ClientMetrics::Media media;
+    std::vector<unsigned char> bytes;
+};
+
+std::vector<unsigned char> filled(size_t size, unsigned seed) {
+    std::vector<unsigned char> bytes(size);
+    for (size_t i = 0; i < size; ++i) bytes[i] = static_cast<unsigned char>((i * 131 + seed) & 0xff);
+    return bytes;
+}
+
+std::vector<Payload> payloads() {
+    std::string text = "So the plan for the next sprint is to finish the dispatch work and then "
+                       "look at the webhook retry logic.";
+    return {
+        // 960 samples = 20 ms at 48 kHz; ~64 kbit/s Opus
+        {"audio_opus_960", ClientMetrics::Media::Audio, filled(160, 1)},
+        // The same 20 ms as 16-bit mono PCM
+        {"audio_pcm_960", ClientMetrics::Media::Audio, filled(960 * 2, 2)},
+        // 720p H.264 at ~2 Mbit/s: a typical P-frame and a keyframe
+        {"video_h264_hd", ClientMetrics::Media::Video, filled(8 * 1024, 3)},
+        {"video_h264_hd_key", ClientMetrics::Media::Video, filled(64 * 1024, 4)},
+        {"transcript_text", ClientMetrics::Media::Transcript,
+         std::vector<unsigned char>(text.begin(), text.end())},
+    };
+}
+
+void deliver(rtms_sdk_sink* sink, const Payload& payload, rtms_metadata* md, uint64_t ts) {
+    unsigned char* data = const_cast<unsigned char*>(payload.bytes.data());
+    int size = static_cast<int>(payload.bytes.size());
+    switch (payload.media) {
+        case ClientMetrics::Media::Audio:      sink->on_audio_data(data, size, ts, md); break;
+        case ClientMetrics::Media::Video:      sink->on_video_data(data, size, ts, md); break;
+        case ClientMetrics::Media::Deskshare:  sink->on_ds_data(data, size, ts, md); break;
+        case ClientMetrics::Media::Transcript: sink->on_transcript_data(data, size, ts, md); break;
+    }
+}
+
+// ============================================================================
+// Callback flavours
+// ============================================================================
+
+// Keeps the optimiser from discarding callback bodies
+std::atomic<uint64_t> g_sink{0};
+
+enum class Flavour {
+    View,     // setOn*Frame, reads the view in place
+    Retain,   // setOn*Frame, retains an owning MediaFrame from the pool
+    Vector,   // setOn*Data, the copying std::vector callback
+};
+
+const char* flavourName(Flavour flavour) {
+    switch (flavour) {
+        case Flavour::View:   return "view";
+        case Flavour::Retain: return "retain";
+        case Flavour::Vector: return "vector";
+    }
+    return "unknown";
+}
+
+void registerCallback(Client& client, ClientMetrics::Media media, Flavour flavour) {
+    Client::MediaFrameFn on_frame;
+    Client::AudioDataFn on_data;
+    if (flavour == Flavour::View) {
+        on_frame = [](const MediaFrameView& frame) {
+            g_sink.fetch_add(frame.data()[frame.size() - 1], std::memory_order_relaxed);
+        };
+    } else if (flavour == Flavour::Retain) {
+        on_frame = [](const MediaFrameView& frame) {
+            MediaFrame owned = frame.retain();
+            g_sink.fetch_add(owned.data()[owned.size() - 1], std::memory_order_relaxed);
+        };
+    } else {
+        on_data = [](const std::vector<uint8_t>& data, uint64_t, const Metadata&) {
+            g_sink.fetch_add(data.back(), std::memory_order_relaxed);
+        };
+    }
+
+    switch (media) {
+        case ClientMetrics::Media::Audio:
+            if (on_frame) client.setOnAudioFrame(on_frame); else client.setOnAudioData(on_data);
+            break;
+        case ClientMetrics::Media::Video:
+            if (on_frame) client.setOnVideoFrame(on_frame); else client.setOnVideoData(on_data);
+            break;
+        case ClientMetrics::Media::Deskshare:
+            if (on_frame) client.setOnDeskshareFrame(on_frame); else client.setOnDeskshareData(on_data);
+            break;
+        case ClientMetrics::Media::Transcript:
+            if (on_frame) client.setOnTranscriptFrame(on_frame); else client.setOnTranscriptData(on_data);
+            break;
+    }
+}
+
+// ============================================================================
+// Measurements
+// ============================================================================
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    bool quick = false;
+    std::string out;
+};
+
+struct DispatchResult {
+    std::string name;
+    size_t payload_bytes;
+    uint64_t frames;
+    double ns_per_frame;        // median of the repeats
+    double ns_per_frame_min;
+    double allocs_per_frame;
+    double alloc_bytes_per_frame;
+};
+
+struct ThroughputResult {
+    size_t clients;
+    uint64_t frames;
+    double frames_per_sec;
+    double ns_per_frame;
+};
+
+// A name past the small-string buffer and two interpreter targets, so a
+// retain that copied the metadata would show up in the allocation count
+rtms_metadata makeMetadata() {
+    static char name[] = "Participant Number 0001 (Guest)";
+    rtms_metadata md{};
+    md.user_name = name;
+    md.user_id = 16778240;
+    md.aii.lid = 1;
+    md.aii.channel_num = 1;
+    md.aii.sample_rate = 16000;
+    md.aii.target_size = 2;
+    const char* voices[] = {"es-ES-standard-voice-a", "fr-FR-standard-voice-b"};
+    for (int i = 0; i < 2; ++i) {
+        md.aii.atl[i].lid = 2 + i;
+        std::snprintf(md.aii.atl[i].voice_id, sizeof(md.aii.atl[i].voice_id), "%s", voices[i]);
+        std::snprintf(md.aii.atl[i].engine, sizeof(md.aii.atl[i].engine), "%s", "neural-translation-engine");
+    }
+    return md;
+}
+
+DispatchResult measureDispatch(const Payload& payload, Flavour flavour, const Options& options) {
+    g_mock_state.reset();
+    Client client;
+    registerCallback(client, payload.media, flavour);
+    client.join("bench-meeting", "bench-stream", "sig", "wss://bench");
+    rtms_sdk_sink* sink = g_mock_state.last_sink;
+    rtms_metadata md = makeMetadata();
+
+    // Keep each repeat around 50 MB of payload, within sensible frame counts
+    uint64_t frames = std::clamp<uint64_t>((50ull << 20) / payload.bytes.size(), 20000, 500000);
+    if (options.quick) frames /= 10;
+    const int repeats = options.quick ? 3 : 7;
+
+    // Warm the frame pool and caches
+    for (uint64_t i = 0; i < frames / 10; ++i) deliver(sink, payload, &md, i);
+
+    std::vector<double> samples;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < frames; ++i) deliver(sink, payload, &md, i);
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        samples.push_back(elapsed.count() / static_cast<double>(frames));
+    }
+
+    g_allocs = 0;
+    g_alloc_bytes = 0;
+    g_counting = true;
+    for (uint64_t i = 0; i < frames; ++i) deliver(sink, payload, &md, i);
+    g_counting = false;
+
+    std::sort(samples.begin(), samples.end());
+    std::string name = std::string(payload.name) + "/" + flavourName(flavour);
+    return {name, payload.bytes.size(), frames, samples[samples.size() / 2], samples.front(),
+            static_cast<double>(g_allocs.load()) / static_cast<double>(frames),
+            static_cast<double>(g_alloc_bytes.load()) / static_cast<double>(frames)};
+}
+
+// One thread polls every client in turn; each poll delivers one Opus frame
+// through the mock SDK, as the real SDK does from inside poll().
+ThroughputResult measureThroughput(size_t client_count, const Options& options) {
+    g_mock_state.reset();
+    const Payload audio = payloads().front();
+    rtms_metadata md = makeMetadata();
+
+    std::vector<std::unique_ptr<Client>> clients;
+    std::vector<rtms_sdk_sink*> sinks;
+    clients.reserve(client_count);
+    for (size_t i = 0; i < client_count; ++i) {
+        clients.push_back(std::make_unique<Client>());
+        registerCallback(*clients.back(), audio.media, Flavour::View);
+        clients.back()->join("bench-meeting-" + std::to_string(i), "bench-stream", "sig", "wss://bench");
+        sinks.push_back(g_mock_state.last_sink);
+    }
+
+    rtms_sdk_sink* polling = nullptr;
+    uint64_t ts = 0;
+    g_mock_state.on_poll = [&] { deliver(polling, audio, &md, ts++); };
+
+    uint64_t target = options.quick ? 100000 : 1000000;
+    uint64_t rounds = std::max<uint64_t>(1, target / client_count);
+    auto round = [&] {
+        for (size_t i = 0; i < client_count; ++i) {
+            polling = sinks[i];
+            clients[i]->poll();
+        }
+    };
+
+    for (uint64_t r = 0; r < std::max<uint64_t>(1, rounds / 10); ++r) round();
+    auto start = Clock::now();
+    for (uint64_t r = 0; r < rounds; ++r) round();
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    g_mock_state.on_poll = nullptr;
+    uint64_t frames = rounds * client_count;
+    return {client_count, frames, frames / elapsed.count(), elapsed.count() * 1e9 / frames};
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+std::string toJson(const std::vector<DispatchResult>& dispatch, const std::vector<ThroughputResult>& throughput,
+                   const Options& options) {
+    std::ostringstream out;
+    out.precision(6);
+    out << "{\n";
+    out << "  \"benchmark\": \"rtms_bench\",\n";
+    out << "  \"schema\": 1,\n";
+    out << "  \"build\": {\n";
+#ifdef __VERSION__
+    out << "    \"compiler\": \"" << __VERSION__ << "\",\n";
+#endif
+#ifdef NDEBUG
+    out << "    \"optimized\": true,\n";
+#else
+    out << "    \"optimized\": false,\n";
+#endif
+#ifdef RTMS_TRACE
+    out << "    \"trace\": true,\n";
+#else
+    out << "    \"trace\": false,\n";
+#endif
+    out << "    \"quick\": " << (options.quick ? "true" : "false") << "\n";
+    out << "  },\n";
+
+    out << "  \"dispatch\": [\n";
+    for (size_t i = 0; i < dispatch.size(); ++i) {
+        const DispatchResult& r = dispatch[i];
+        out << "    {\"name\": \"" << r.name << "\", \"payload_bytes\": " << r.payload_bytes
+            << ", \"frames\": " << r.frames << ", \"ns_per_frame\": " << r.ns_per_frame
+            << ", \"ns_per_frame_min\": " << r.ns_per_frame_min << ", \"allocs_per_frame\": " << r.allocs_per_frame
+            << ", \"alloc_bytes_per_frame\": " << r.alloc_bytes_per_frame << "}"
+            << (i + 1 < dispatch.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n";
+
+    out << "  \"throughput\": [\n";
+    for (size_t i = 0; i < throughput.size(); ++i) {
+        const ThroughputResult& r = throughput[i];
+        out << "    {\"clients\": " << r.clients << ", \"frames\": " << r.frames
+            << ", \"frames_per_sec\": " << r.frames_per_sec << ", \"ns_per_frame\": " << r.ns_per_frame << "}"
+            << (i + 1 < throughput.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return out.str();
+}
+
+void usage() {
+    std::cerr << "usage: rtms_bench [--out FILE] [--quick]\n"
+                 "  --out FILE   write JSON results to FILE instead of stdout\n"
+                 "  --quick      a tenth of the iterations, for smoke runs\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            options.quick = true;
+        } else if (arg == "--out" && i + 1 < argc) {
+            options.out = argv[++i];
+        } else {
+            usage();
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    std::vector<DispatchResult> dispatch;
+    for (const Payload& payload : payloads()) {
+        for (Flavour flavour : {Flavour::View, Flavour::Retain, Flavour::Vector}) {
+            dispatch.push_back(measureDispatch(payload, flavour, options));
+            std::cerr << dispatch.back().name << ": " << dispatch.back().ns_per_frame << " ns/frame, "
+                      << dispatch.back().allocs_per_frame << " allocs/frame\n";
+        }
+    }
+
+    std::vector<ThroughputResult> throughput;
+    for (size_t clients : {1, 10, 100, 1000}) {
+        throughput.push_back(measureThroughput(clients, options));
+        std::cerr << clients << " clients: " << static_cast<uint64_t>(throughput.back().frames_per_sec)
+                  << " frames/s\n";
+    }
+
+    std::string json = toJson(dispatch, throughput, options);
+    if (options.out.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream file(options.out);
+        if (!(file << json)) {
+            std::cerr << "rtms_bench: cannot write " << options.out << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,235 @@
+/**
+ * C++ tests for lock-free callback dispatch in rtms::Client.
+ *
+ * The SDK sinks read an immutable callback table without taking
+ * Client::mutex_, so a slow user callback must never block registration or
+ * accessors on other threads, and a callback may safely call back into the
+ * client that is dispatching it.
+ *
+ * Test coverage:
+ *   - setOn* / uuid() / subscribeEvent() do not wait on an in-flight callback
+ *   - Re-registering callbacks from inside a callback
+ *   - Replaced callbacks stay alive until dispatch finishes, then are freed
+ *   - Concurrent registration while frames are dispatched
+ *   - [.][benchmark] dispatch cost with and without registration contention
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "rtms.h"
+#include "mock_sdk.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace rtms;
+using namespace std::chrono_literals;
+
+struct R { R() { g_mock_state.reset(); } };
+
+namespace {
+
+// Fires an audio frame from a separate thread, standing in for the SDK poll thread
+std::thread dispatchAudioAsync(unsigned char* buf, int size, rtms_metadata* md) {
+    return std::thread([=] { mock_trigger_audio_data(buf, size, 0, md); });
+}
+
+} // namespace
+
+// ============================================================================
+// Registration never waits on an in-flight callback
+// ============================================================================
+
+TEST_CASE("setOn* and accessors do not block on a slow callback", "[client][dispatch]") {
+    R _;
+    Client c;
+    c.join("meeting-1", "stream-1", "sig", "url");
+
+    std::promise<void> entered;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    c.setOnAudioFrame([&](const MediaFrameView&) {
+        entered.set_value();
+        released.wait();
+    });
+
+    unsigned char buf[] = {0x01};
+    rtms_metadata md{};
+    std::thread poller = dispatchAudioAsync(buf, 1, &md);
+    entered.get_future().wait();
+
+    // Each of these used to contend on Client::mutex_ with the running callback
+    auto other = std::async(std::launch::async, [&] {
+        c.setOnVideoData([](const std::vector<uint8_t>&, uint64_t, const Metadata&) {});
+        c.setOnAudioFrame([](const MediaFrameView&) {});
+        c.subscribeEvent({(int)EVENT_TYPE::ACTIVE_SPEAKER_CHANGE});
+        return c.uuid() + "/" + c.streamId();
+    });
+    bool completed = other.wait_for(2s) == std::future_status::ready;
+
+    release.set_value();
+    poller.join();
+
+    REQUIRE(completed);
+    CHECK(other.get() == "meeting-1/stream-1");
+}
+
+TEST_CASE("A callback can re-register callbacks on its own client", "[client][dispatch]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    int first_calls = 0;
+    int second_calls = 0;
+    c.setOnTranscriptFrame([&](const MediaFrameView&) {
+        ++first_calls;
+        c.setOnTranscriptFrame([&](const MediaFrameView&) { ++second_calls; });
+    });
+
+    unsigned char buf[] = {'x'};
+    rtms_metadata md{};
+    mock_trigger_transcript_data(buf, 1, 0, &md);
+    mock_trigger_transcript_data(buf, 1, 0, &md);
+
+    CHECK(first_calls == 1);
+    CHECK(second_calls == 1);
+}
+
+TEST_CASE("on_join_confirm callback may subscribe to events", "[client][dispatch]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    c.setOnJoinConfirm([&](int) {
+        c.subscribeEvent({(int)EVENT_TYPE::SHARING_START});
+    });
+    mock_trigger_join_confirm(0);
+
+    CHECK(g_mock_state.subscribe_calls == 1);
+    REQUIRE(g_mock_state.last_subscribed_events.size() == 1);
+    CHECK(g_mock_state.last_subscribed_events[0] == (int)EVENT_TYPE::SHARING_START);
+}
+
+// ============================================================================
+// Retired callback tables
+// ============================================================================
+
+TEST_CASE("Replaced callback outlives the dispatch that is using it", "[client][dispatch]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    auto sentinel = std::make_shared<int>(7);
+    std::weak_ptr<int> watch = sentinel;
+
+    int seen = 0;
+    c.setOnAudioFrame([&, sentinel](const MediaFrameView&) {
+        // Replace ourselves mid-dispatch; our captures must survive until we return
+        c.setOnAudioFrame(nullptr);
+        seen = *sentinel;
+    });
+    sentinel.reset();
+
+    unsigned char buf[] = {0x01};
+    rtms_metadata md{};
+    mock_trigger_audio_data(buf, 1, 0, &md);
+    CHECK(seen == 7);
+
+    // Still retired: nothing has reached a quiescent point since the swap
+    CHECK_FALSE(watch.expired());
+
+    c.poll();
+    CHECK(watch.expired());
+}
+
+TEST_CASE("Replacing a callback outside dispatch frees the old one immediately", "[client][dispatch]") {
+    R _;
+    Client c;
+
+    auto sentinel = std::make_shared<int>(1);
+    std::weak_ptr<int> watch = sentinel;
+    c.setOnLeave([sentinel](int) {});
+    sentinel.reset();
+    CHECK_FALSE(watch.expired());
+
+    c.setOnLeave(nullptr);
+    CHECK(watch.expired());
+}
+
+TEST_CASE("Concurrent registration while frames are dispatched", "[client][dispatch][threads]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    std::atomic<int> delivered{0};
+    auto counter = [&](const MediaFrameView& f) { delivered.fetch_add(static_cast<int>(f.size())); };
+    c.setOnAudioFrame(counter);
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&] {
+        while (!stop.load()) {
+            c.setOnAudioFrame(counter);
+            c.setOnVideoFrame([](const MediaFrameView&) {});
+        }
+    });
+
+    unsigned char buf[] = {0x01};
+    rtms_metadata md{};
+    constexpr int kFrames = 20000;
+    for (int i = 0; i < kFrames; ++i) {
+        mock_trigger_audio_data(buf, 1, 0, &md);
+        if (i % 256 == 0) c.poll();
+    }
+    stop.store(true);
+    writer.join();
+
+    CHECK(delivered.load() == kFrames);
+}
+
+// ============================================================================
+// Benchmark (hidden; run with: rtms_tests "[benchmark]")
+// ============================================================================
+
+TEST_CASE("Callback dispatch under registration contention", "[.][benchmark][dispatch]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    std::atomic<uint64_t> bytes{0};
+    c.setOnVideoFrame([&](const MediaFrameView& f) { bytes.fetch_add(f.size(), std::memory_order_relaxed); });
+
+    std::vector<unsigned char> frame(4096, 0x42);
+    rtms_metadata md{};
+    auto dispatch = [&] {
+        mock_trigger_video_data(frame.data(), static_cast<int>(frame.size()), 0, &md);
+    };
+
+    BENCHMARK("dispatch, uncontended") {
+        dispatch();
+    };
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> contenders;
+    for (int t = 0; t < 3; ++t) {
+        contenders.emplace_back([&, t] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (t == 0) c.setOnAudioFrame([](const MediaFrameView&) {});
+                else if (t == 1) (void)c.uuid();
+                else c.subscribeEvent({(int)EVENT_TYPE::ACTIVE_SPEAKER_CHANGE});
+            }
+        });
+    }
+
+    BENCHMARK("dispatch, 3 threads registering / reading state") {
+        dispatch();
+    };
+
+    stop.store(true);
+    for (auto& th : contenders) th.join();
+    c.poll();
+}
@@ -0,0 +1,164 @@
+/**
+ * C++ tests for CallbackSlot (src/callback_slot.h).
+ *
+ * Test coverage:
+ *   - set/get/reset/empty
+ *   - The replaced handle is destroyed outside the slot's lock
+ *   - Stress: mock clients on an EventLoopPool invoke a slot while other
+ *     threads keep replacing it, as Python callbacks are on free-threaded
+ *     builds
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "callback_slot.h"
+#include "event_loop.h"
+#include "mock_sdk.h"
+#include "rtms.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rtms;
+using namespace std::chrono_literals;
+
+struct R { R() { g_mock_state.reset(); } };
+
+namespace {
+
+// A callback whose state is poisoned when it is destroyed, so a call through
+// a freed handle is caught even without a sanitizer
+struct Probe {
+    static constexpr uint64_t kAlive = 0xA11CE;
+    static constexpr uint64_t kDead = 0xDEAD;
+
+    std::atomic<uint64_t> state{kAlive};
+    std::atomic<uint64_t> calls{0};
+
+    ~Probe() { state.store(kDead); }
+
+    bool call() {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        return state.load() == kAlive;
+    }
+};
+
+using ProbeSlot = CallbackSlot<std::shared_ptr<Probe>>;
+
+} // namespace
+
+// ============================================================================
+// Basics
+// ============================================================================
+
+TEST_CASE("CallbackSlot stores, returns and clears a callback", "[callback_slot]") {
+    ProbeSlot slot;
+    CHECK(slot.empty());
+    CHECK(slot.get() == nullptr);
+
+    auto probe = std::make_shared<Probe>();
+    slot.set(probe);
+    CHECK_FALSE(slot.empty());
+    CHECK(slot.get() == probe);
+    CHECK(probe.use_count() == 2);
+
+    slot.reset();
+    CHECK(slot.empty());
+    CHECK(slot.get() == nullptr);
+    CHECK(probe.use_count() == 1);
+}
+
+TEST_CASE("CallbackSlot destroys the replaced handle outside its lock", "[callback_slot]") {
+    ProbeSlot slot;
+    bool saw_replacement = false;
+
+    // The deleter reads the slot; under the lock this would deadlock
+    auto replacement = std::make_shared<Probe>();
+    slot.set(std::shared_ptr<Probe>(new Probe, [&](Probe* probe) {
+        saw_replacement = slot.get() == replacement;
+        delete probe;
+    }));
+    slot.set(replacement);
+    CHECK(saw_replacement);
+}
+
+// ============================================================================
+// Stress
+// ============================================================================
+
+TEST_CASE("CallbackSlot survives replacement while an EventLoopPool dispatches", "[callback_slot][threads]") {
+    R _;
+    MockScenario scenario;
+    scenario.participants = 8;
+    scenario.audio_interval_ms = 5;
+    scenario.video_fps = 50;
+    scenario.transcript_interval_ms = 0;
+    g_mock_state.scenario = scenario;
+
+    constexpr int kClients = 16;
+    constexpr int kWriters = 4;
+    ProbeSlot slot;
+    slot.set(std::make_shared<Probe>());
+
+    std::atomic<uint64_t> invoked{0};
+    std::atomic<uint64_t> skipped{0};
+    std::atomic<uint64_t> dead_calls{0};
+    auto dispatch = [&](const MediaFrameView&) {
+        if (slot.empty()) {
+            skipped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // Emptied between the check and the copy: skipped like an unset slot
+        std::shared_ptr<Probe> callback = slot.get();
+        if (!callback) {
+            skipped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (!callback->call()) dead_calls.fetch_add(1, std::memory_order_relaxed);
+        invoked.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    EventLoopPool pool(4, 1ms);
+    for (int i = 0; i < kClients; ++i) {
+        auto client = std::make_shared<Client>(true);
+        client->setOnAudioFrame(dispatch);
+        client->setOnVideoFrame(dispatch);
+        pool.add(std::make_shared<ClientSession>(client, "meeting-" + std::to_string(i), "s", "sig", "url"));
+    }
+    pool.start();
+
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> replacements{0};
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; ++w) {
+        writers.emplace_back([&, w] {
+            for (uint64_t n = 0; !done.load(); ++n) {
+                // Mostly swaps, with the odd clear as when a callback is removed
+                if ((n + w) % 16 == 0) {
+                    slot.reset();
+                } else {
+                    slot.set(std::make_shared<Probe>());
+                }
+                replacements.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while ((invoked.load() < 20000 || replacements.load() < 20000) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(5ms);
+    }
+    done = true;
+    for (auto& writer : writers) writer.join();
+    pool.stop();
+    pool.join();
+
+    CHECK(invoked.load() >= 20000);
+    CHECK(replacements.load() >= 20000);
+    CHECK(dead_calls.load() == 0);
+    CHECK(g_mock_state.release_calls == kClients);
+}
@@ -8,8 +8,9 @@
  *   - AudioParams / VideoParams / DeskshareParams validation
  *   - Session / Participant / Metadata data classes
  *   - MediaParams composition and toNative()
- *   - Client lifecycle (create, initialize, join, poll, release)
+ *   - Client lifecycle (create, deferred alloc, initialize, join, poll, release)
  *   - Callback dispatch (via mock_trigger_* helpers)
+ *   - Batched delivery at the end of poll()
  *   - Event subscription deferral / on-confirm flush
  *   - Media type auto-enable on callback registration
  *   - setProxy forwarding and error handling
@@ -430,6 +431,48 @@ TEST_CASE("Client constructor throws when create_sdk returns null", "[client][li
     REQUIRE_THROWS_AS(Client(), Exception);
 }
 
+TEST_CASE("Client with defer_alloc creates the SDK handle on join", "[client][lifecycle]") {
+    R _;
+    Client c(true);
+    CHECK_FALSE(c.allocated());
+    CHECK(g_mock_state.create_calls == 0);
+
+    c.join("uuid", "stream", "sig", "url");
+    CHECK(c.allocated());
+    CHECK(g_mock_state.create_calls == 1);
+    CHECK(g_mock_state.join_calls == 1);
+}
+
+TEST_CASE("Deferred Client buffers proxy and event subscriptions until alloc", "[client][lifecycle]") {
+    R _;
+    Client c(true);
+    c.setProxy("https", "https://proxy:443");
+    c.subscribeEvent({(int)EVENT_TYPE::ACTIVE_SPEAKER_CHANGE});
+    CHECK(g_mock_state.proxy_calls == 0);
+    REQUIRE_THROWS_AS(c.subscribeVideo(1, true), Exception);
+
+    c.alloc();
+    CHECK(g_mock_state.proxy_calls == 1);
+    CHECK(g_mock_state.last_proxy_type == "https");
+
+    c.join("uuid", "stream", "sig", "url");
+    mock_trigger_join_confirm(0);
+    REQUIRE(g_mock_state.last_subscribed_events.size() == 1);
+    CHECK(g_mock_state.last_subscribed_events[0] == (int)EVENT_TYPE::ACTIVE_SPEAKER_CHANGE);
+}
+
+TEST_CASE("Releasing a deferred Client that was never allocated is a no-op", "[client][lifecycle]") {
+    R _;
+    {
+        Client c(true);
+        c.release();
+        REQUIRE_THROWS_AS(c.join("uuid", "stream", "sig", "url"), Exception);
+    }
+    CHECK(g_mock_state.create_calls == 0);
+    CHECK(g_mock_state.leave_calls == 0);
+    CHECK(g_mock_state.release_calls == 0);
+}
+
 TEST_CASE("Client::initialize calls provider->init with correct args", "[client][lifecycle]") {
     R _;
     Client::initialize("/path/to/ca.pem", 1, nullptr);
@@ -645,6 +688,247 @@ TEST_CASE("on_audio_data does not fire callback on null metadata", "[client][cal
     CHECK_FALSE(called);
 }
 
+TEST_CASE("on_audio_data frame callback borrows the SDK buffer", "[client][callbacks][frame]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    const uint8_t* received_ptr = nullptr;
+    size_t received_size = 0;
+    uint64_t received_ts = 0;
+    int received_uid = -1;
+    std::string received_name;
+    c.setOnAudioFrame([&](const MediaFrameView& frame) {
+        received_ptr  = frame.data();
+        received_size = frame.size();
+        received_ts   = frame.timestamp();
+        received_uid  = frame.userId();
+        received_name = frame.userName();
+    });
+
+    unsigned char buf[] = {0x0A, 0x0B, 0x0C, 0x0D};
+    char name[] = "alice";
+    rtms_metadata md{}; md.user_id = 7; md.user_name = name;
+    mock_trigger_audio_data(buf, 4, 1234ULL, &md);
+
+    CHECK(received_ptr  == buf);
+    CHECK(received_size == 4);
+    CHECK(received_ts   == 1234ULL);
+    CHECK(received_uid  == 7);
+    CHECK(received_name == "alice");
+}
+
+TEST_CASE("MediaFrameView userName is empty when SDK sends null", "[data][frame]") {
+    R _;
+    unsigned char buf[] = {0x01};
+    rtms_metadata md{}; md.user_name = nullptr;
+    MediaFrameView frame(buf, 1, 0, md);
+    REQUIRE(frame.userName() != nullptr);
+    CHECK(std::string(frame.userName()).empty());
+    CHECK(frame.metadata().userName().empty());
+}
+
+TEST_CASE("MediaFrameView retain() outlives the SDK buffer", "[client][callbacks][frame]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    std::vector<MediaFrame> kept;
+    c.setOnVideoFrame([&](const MediaFrameView& frame) {
+        kept.push_back(frame.retain());
+    });
+
+    {
+        unsigned char buf[] = {0x10, 0x20, 0x30};
+        char name[] = "bob";
+        rtms_metadata md{}; md.user_id = 3; md.user_name = name;
+        mock_trigger_video_data(buf, 3, 55ULL, &md);
+        buf[0] = 0xFF;  // SDK reuses its buffer after the callback returns
+        name[0] = 'X';
+    }
+
+    REQUIRE(kept.size() == 1);
+    const MediaFrame& f = kept[0];
+    REQUIRE(f.size() == 3);
+    CHECK(f.data()[0] == 0x10);
+    CHECK(f.data()[2] == 0x30);
+    CHECK(f.timestamp() == 55ULL);
+    CHECK(f.metadata().userId() == 3);
+    CHECK(f.metadata().userName() == "bob");
+}
+
+TEST_CASE("retained frames share a user's metadata until it changes", "[client][callbacks][frame][metadata]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    std::vector<MediaFrame> kept;
+    c.setOnAudioFrame([&](const MediaFrameView& frame) {
+        kept.push_back(frame.retain());
+    });
+
+    unsigned char buf[] = {0x01};
+    char name[] = "Participant Number 0041 (Guest)";
+    rtms_metadata md{}; md.user_id = 41; md.user_name = name;
+    md.aii.target_size = 1;
+    md.aii.atl[0].lid = 2;
+    std::strcpy(md.aii.atl[0].voice_id, "voice-a");
+    mock_trigger_audio_data(buf, 1, 1ULL, &md);
+    mock_trigger_audio_data(buf, 1, 2ULL, &md);
+    md.aii.atl[0].lid = 3;
+    mock_trigger_audio_data(buf, 1, 3ULL, &md);
+    md.user_id = 42;
+    mock_trigger_audio_data(buf, 1, 4ULL, &md);
+
+    REQUIRE(kept.size() == 4);
+    CHECK(&kept[0].metadata().aiInterpreter() == &kept[1].metadata().aiInterpreter());
+    CHECK(&kept[1].metadata().aiInterpreter() != &kept[2].metadata().aiInterpreter());
+    CHECK(&kept[2].metadata().aiInterpreter() != &kept[3].metadata().aiInterpreter());
+    CHECK(kept[1].metadata().aiInterpreter().targets().at(0).lid() == 2);
+    CHECK(kept[2].metadata().aiInterpreter().targets().at(0).lid() == 3);
+    CHECK(kept[3].metadata().userId() == 42);
+    CHECK(kept[3].metadata().userName() == "Participant Number 0041 (Guest)");
+
+    MediaFrame copy = kept[0];
+    CHECK(&copy.metadata().aiInterpreter() == &kept[0].metadata().aiInterpreter());
+}
+
+TEST_CASE("data and frame callbacks replace each other", "[client][callbacks][frame]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    int vector_calls = 0;
+    int frame_calls = 0;
+    c.setOnTranscriptData([&](const std::vector<uint8_t>&, uint64_t, const Metadata&) { ++vector_calls; });
+    c.setOnTranscriptFrame([&](const MediaFrameView&) { ++frame_calls; });
+
+    unsigned char buf[] = {'h', 'i'};
+    rtms_metadata md{};
+    mock_trigger_transcript_data(buf, 2, 0, &md);
+    CHECK(vector_calls == 0);
+    CHECK(frame_calls  == 1);
+
+    c.setOnTranscriptData([&](const std::vector<uint8_t>& d, uint64_t, const Metadata&) {
+        ++vector_calls;
+        CHECK(std::string(d.begin(), d.end()) == "hi");
+    });
+    mock_trigger_transcript_data(buf, 2, 0, &md);
+    CHECK(vector_calls == 1);
+    CHECK(frame_calls  == 1);
+}
+
+TEST_CASE("setOnDeskshareFrame enables deskshare media", "[client][callbacks][frame]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    int calls = 0;
+    c.setOnDeskshareFrame([&](const MediaFrameView&) { ++calls; });
+    CHECK((g_mock_state.last_media_types & Client::DESKSHARE) != 0);
+
+    unsigned char buf[] = {0x01};
+    rtms_metadata md{};
+    mock_trigger_ds_data(buf, 1, 0, &md);
+    CHECK(calls == 1);
+}
+
+TEST_CASE("Batch callback receives every frame of one poll in a single call", "[client][callbacks][batch]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    std::vector<std::vector<MediaFrame>> batches;
+    int frame_calls = 0;
+    c.setOnAudioFrame([&](const MediaFrameView&) { ++frame_calls; });
+    c.setOnAudioBatch([&](std::vector<MediaFrame>& frames) { batches.push_back(std::move(frames)); });
+    CHECK((g_mock_state.last_media_types & Client::AUDIO) != 0);
+
+    unsigned char buf[] = {0x01, 0x02, 0x03};
+    char name[] = "carol";
+    rtms_metadata md{}; md.user_id = 9; md.user_name = name;
+    g_mock_state.on_poll = [&] {
+        mock_trigger_audio_data(buf, 3, 100, &md);
+        buf[0] = 0x7F;   // the SDK reuses its buffer between frames
+        mock_trigger_audio_data(buf, 2, 120, &md);
+        CHECK(batches.empty());   // nothing until poll() returns
+    };
+    CHECK(c.poll());
+
+    REQUIRE(batches.size() == 1);
+    REQUIRE(batches[0].size() == 2);
+    CHECK(batches[0][0].data()[0] == 0x01);
+    CHECK(batches[0][0].size() == 3);
+    CHECK(batches[0][0].timestamp() == 100);
+    CHECK(batches[0][0].metadata().userName() == "carol");
+    CHECK(batches[0][1].data()[0] == 0x7F);
+    CHECK(batches[0][1].timestamp() == 120);
+    CHECK(frame_calls == 2);   // per-frame delivery is unaffected
+
+    // An idle poll delivers no empty batch
+    g_mock_state.on_poll = nullptr;
+    CHECK_FALSE(c.poll());
+    CHECK(batches.size() == 1);
+
+    auto stats = c.metrics().snapshot();
+    CHECK(stats.callbacks[static_cast<size_t>(ClientMetrics::Callback::AudioBatch)].count == 1);
+}
+
+TEST_CASE("Batches are per media type and frames outside poll() wait for the next one", "[client][callbacks][batch]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    std::vector<std::pair<std::string, size_t>> calls;
+    c.setOnVideoBatch([&](std::vector<MediaFrame>& f) { calls.emplace_back("video", f.size()); });
+    c.setOnTranscriptBatch([&](std::vector<MediaFrame>& f) { calls.emplace_back("transcript", f.size()); });
+    c.setOnDeskshareBatch([&](std::vector<MediaFrame>& f) { calls.emplace_back("deskshare", f.size()); });
+
+    unsigned char buf[] = {0x01};
+    rtms_metadata md{};
+    mock_trigger_video_data(buf, 1, 0, &md);
+    mock_trigger_transcript_data(buf, 1, 0, &md);
+    mock_trigger_video_data(buf, 1, 0, &md);
+    CHECK(calls.empty());
+
+    c.poll();
+    std::vector<std::pair<std::string, size_t>> expected = {{"video", 2}, {"transcript", 1}};
+    CHECK(calls == expected);   // deskshare had no frames
+
+    // Clearing the callback drops frames instead of holding them
+    c.setOnVideoBatch(nullptr);
+    mock_trigger_video_data(buf, 1, 0, &md);
+    c.poll();
+    CHECK(calls.size() == 2);
+}
+
+TEST_CASE("Batches-done callback runs once per poll after every batch", "[client][callbacks][batch]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    std::vector<std::string> calls;
+    c.setOnAudioBatch([&](std::vector<MediaFrame>&) { calls.push_back("audio"); });
+    c.setOnVideoBatch([&](std::vector<MediaFrame>&) { calls.push_back("video"); });
+    c.setOnBatchesDone([&] { calls.push_back("done"); });
+
+    unsigned char buf[] = {0x01};
+    rtms_metadata md{};
+    g_mock_state.on_poll = [&] {
+        mock_trigger_video_data(buf, 1, 0, &md);
+        mock_trigger_audio_data(buf, 1, 0, &md);
+        mock_trigger_audio_data(buf, 1, 0, &md);
+    };
+    c.poll();
+    std::vector<std::string> expected = {"audio", "video", "done"};
+    CHECK(calls == expected);
+
+    // Not called when no batch was delivered
+    g_mock_state.on_poll = nullptr;
+    c.poll();
+    CHECK(calls.size() == 3);
+}
+
 TEST_CASE("on_session_update fires with correct Session object", "[client][callbacks]") {
     R _;
     Client c;
@@ -1125,3 +1409,24 @@ TEST_CASE("AiInterpreter construction — one target populated correctly", "[dat
     CHECK(tgt.voiceId() == "voice-de-1");
     CHECK(tgt.engine()  == "engine-A");
 }
+
+TEST_CASE("AiInterpreter equality compares every field and target", "[data][metadata]") {
+    R _;
+    rtms_metadata md{};
+    md.aii.lid         = 9;
+    md.aii.sample_rate = 16000;
+    md.aii.target_size = 1;
+    md.aii.atl[0].lid  = 14;
+    strncpy(md.aii.atl[0].voice_id, "voice-de-1", MAX_VOICE_ID_LEN - 1);
+
+    rtms_metadata other = md;
+    other.start_ts = 5000ULL;   // not part of the interpreter
+    CHECK(Metadata(md).aiInterpreter() == Metadata(other).aiInterpreter());
+
+    other.aii.atl[0].voice_id[0] = 'V';
+    CHECK(Metadata(md).aiInterpreter() != Metadata(other).aiInterpreter());
+
+    other = md;
+    other.aii.target_size = 0;
+    CHECK(Metadata(md).aiInterpreter() != Metadata(other).aiInterpreter());
+}
@@ -0,0 +1,366 @@
+/**
+ * C++ unit tests for bounded delivery queues (src/delivery_queue.h / src/delivery_queue.cpp).
+ *
+ * Test coverage:
+ *   - One drain is requested per idle-to-busy transition
+ *   - drop-oldest, drop-newest and unbounded queues
+ *   - block waits for a drain, times out into dropping, and never waits
+ *     on the consumer's own thread
+ *   - close() releases a blocked producer
+ *   - pause() holds back drains until resume(), then the policy applies;
+ *     block drops the oldest instead of waiting while paused
+ *   - A paused queue does not stall other clients on a shared EventLoop
+ *   - Batches count as their frames; configure() changes limits in place
+ *   - Policy names and audio-priority resolution
+ *   - Client::recordDropped() shows up in the metrics snapshot
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "rtms.h"
+#include "delivery_queue.h"
+#include "event_loop.h"
+#include "mock_sdk.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace rtms;
+using namespace std::chrono_literals;
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+TEST_CASE("DeliveryQueue asks for one drain until it is drained", "[delivery]") {
+    DeliveryQueue<int> q(8, DeliveryPolicy::Block);
+
+    CHECK(q.push(1).schedule);
+    CHECK_FALSE(q.push(2).schedule);
+    CHECK_FALSE(q.push(3).schedule);
+
+    std::vector<int> out;
+    CHECK(q.drain(out) == 3);
+    CHECK(out == std::vector<int>{1, 2, 3});
+    CHECK(q.size() == 0);
+
+    CHECK(q.push(4).schedule);
+}
+
+// ============================================================================
+// Drop policies
+// ============================================================================
+
+TEST_CASE("DeliveryQueue drop-oldest keeps the newest frames", "[delivery]") {
+    DeliveryQueue<int> q(3, DeliveryPolicy::DropOldest);
+    for (int i = 1; i <= 3; ++i) CHECK(q.push(i).dropped == 0);
+    CHECK(q.push(4).dropped == 1);
+    CHECK(q.push(5).dropped == 1);
+
+    std::vector<int> out;
+    q.drain(out);
+    CHECK(out == std::vector<int>{3, 4, 5});
+    CHECK(q.dropped() == 2);
+}
+
+TEST_CASE("DeliveryQueue drop-newest keeps the oldest frames", "[delivery]") {
+    DeliveryQueue<int> q(3, DeliveryPolicy::DropNewest);
+    for (int i = 1; i <= 3; ++i) q.push(i);
+    auto result = q.push(4);
+    CHECK(result.dropped == 1);
+    CHECK_FALSE(result.schedule);
+
+    std::vector<int> out;
+    q.drain(out);
+    CHECK(out == std::vector<int>{1, 2, 3});
+    CHECK(q.dropped() == 1);
+}
+
+TEST_CASE("DeliveryQueue with depth 0 is unbounded", "[delivery]") {
+    DeliveryQueue<int> q(0, DeliveryPolicy::DropNewest);
+    for (int i = 0; i < 5000; ++i) q.push(i);
+    CHECK(q.size() == 5000);
+    CHECK(q.dropped() == 0);
+}
+
+// ============================================================================
+// Block
+// ============================================================================
+
+TEST_CASE("DeliveryQueue block waits for the consumer to drain", "[delivery]") {
+    DeliveryQueue<int> q(2, DeliveryPolicy::Block, 10s);
+    q.push(1);
+    q.push(2);
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&] {
+        q.push(3);
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(20ms);
+    CHECK_FALSE(pushed);
+
+    std::vector<int> out;
+    q.drain(out);
+    producer.join();
+    CHECK(pushed);
+    CHECK(out == std::vector<int>{1, 2});
+
+    out.clear();
+    q.drain(out);
+    CHECK(out == std::vector<int>{3});
+    CHECK(q.dropped() == 0);
+}
+
+TEST_CASE("DeliveryQueue block drops after the timeout until the next drain", "[delivery]") {
+    DeliveryQueue<int> q(1, DeliveryPolicy::Block, 20ms);
+    q.push(1);
+
+    auto start = std::chrono::steady_clock::now();
+    CHECK(q.push(2).dropped == 1);
+    CHECK(std::chrono::steady_clock::now() - start >= 20ms);
+
+    // Stalled: further pushes into the full queue fail without waiting
+    start = std::chrono::steady_clock::now();
+    CHECK(q.push(3).dropped == 1);
+    CHECK(std::chrono::steady_clock::now() - start < 20ms);
+
+    std::vector<int> out;
+    q.drain(out);
+    CHECK(out == std::vector<int>{1});
+    CHECK(q.push(4).dropped == 0);
+    CHECK(q.dropped() == 2);
+}
+
+TEST_CASE("DeliveryQueue block queues past the depth when the caller cannot wait", "[delivery]") {
+    DeliveryQueue<int> q(2, DeliveryPolicy::Block, 10s);
+    for (int i = 0; i < 4; ++i) CHECK(q.push(i, false).dropped == 0);
+    CHECK(q.size() == 4);
+}
+
+TEST_CASE("DeliveryQueue close() releases a blocked producer and rejects later pushes", "[delivery]") {
+    DeliveryQueue<int> q(1, DeliveryPolicy::Block, 10s);
+    q.push(1);
+
+    size_t dropped = 0;
+    std::thread producer([&] { dropped = q.push(2).dropped; });
+    std::this_thread::sleep_for(20ms);
+    q.close();
+    producer.join();
+
+    CHECK(dropped == 1);
+    CHECK(q.push(3).dropped == 1);
+    std::vector<int> out;
+    q.drain(out);
+    CHECK(out == std::vector<int>{1});   // queued frames survive close()
+}
+
+TEST_CASE("DeliveryQueue block loses nothing between a producer and a slow consumer", "[delivery]") {
+    DeliveryQueue<int> q(4, DeliveryPolicy::Block, 10s);
+    constexpr int kFrames = 20000;
+
+    std::thread producer([&] {
+        for (int i = 0; i < kFrames; ++i) q.push(i);
+    });
+
+    std::vector<int> out;
+    while (static_cast<int>(out.size()) < kFrames) {
+        q.drain(out);
+        std::this_thread::yield();
+    }
+    producer.join();
+
+    REQUIRE(out.size() == kFrames);
+    for (int i = 0; i < kFrames; ++i) REQUIRE(out[i] == i);
+    CHECK(q.dropped() == 0);
+}
+
+// ============================================================================
+// Pause
+// ============================================================================
+
+TEST_CASE("DeliveryQueue pause() holds drains until resume()", "[delivery]") {
+    DeliveryQueue<int> q(2, DeliveryPolicy::DropOldest);
+    q.pause();
+    CHECK_FALSE(q.push(1).schedule);
+    CHECK_FALSE(q.push(2).schedule);
+    CHECK(q.push(3).dropped == 1);     // full while paused: the policy applies
+
+    CHECK(q.resume());
+    CHECK_FALSE(q.resume());           // the drain is already requested
+    CHECK_FALSE(q.push(4).schedule);
+
+    std::vector<int> out;
+    q.drain(out);
+    CHECK(out == std::vector<int>{3, 4});
+    CHECK_FALSE(q.resume());           // nothing queued
+}
+
+TEST_CASE("DeliveryQueue paused under block drops the oldest instead of waiting", "[delivery]") {
+    DeliveryQueue<int> q(2, DeliveryPolicy::Block, 1000ms);
+    CHECK(q.push(1).schedule);         // a drain requested before the pause
+    q.pause();
+
+    std::vector<int> out;
+    q.drain(out);                      // ...still runs
+    CHECK_FALSE(q.push(2).schedule);
+    CHECK_FALSE(q.push(3).schedule);
+
+    auto start = std::chrono::steady_clock::now();
+    CHECK(q.push(4).dropped == 1);
+    CHECK(q.push(5).dropped == 1);
+    CHECK(std::chrono::steady_clock::now() - start < 500ms);
+    CHECK(q.dropped() == 2);
+
+    CHECK(q.resume());
+    out.clear();
+    q.drain(out);
+    CHECK(out == std::vector<int>{4, 5});
+
+    // Once resumed, a full queue makes the producer wait again
+    q.push(6);
+    q.push(7);
+    std::thread consumer([&] {
+        std::this_thread::sleep_for(20ms);
+        std::vector<int> taken;
+        q.drain(taken);
+    });
+    CHECK(q.push(8).dropped == 0);
+    consumer.join();
+}
+
+namespace {
+
+// Pushes every poll into a paused queue, as a client whose stream nobody
+// reads does from its frame callbacks.
+struct UnreadStreamClient : LoopClient {
+    DeliveryQueue<int> queue{4, DeliveryPolicy::Block};
+    std::atomic<int> polls{0};
+
+    UnreadStreamClient() { queue.pause(); }
+    void start() override {}
+    PollResult poll() override {
+        queue.push(polls.fetch_add(1));
+        return PollResult::Delivered;
+    }
+    void stop() noexcept override {}
+};
+
+struct TimedClient : LoopClient {
+    std::mutex mutex;
+    std::vector<std::chrono::steady_clock::time_point> polls;
+
+    void start() override {}
+    PollResult poll() override {
+        std::lock_guard<std::mutex> lk(mutex);
+        polls.push_back(std::chrono::steady_clock::now());
+        return PollResult::Idle;
+    }
+    void stop() noexcept override {}
+
+    size_t count() {
+        std::lock_guard<std::mutex> lk(mutex);
+        return polls.size();
+    }
+};
+
+} // namespace
+
+TEST_CASE("A paused queue on a shared EventLoop does not delay other clients' polls", "[delivery][eventloop]") {
+    EventLoop loop(1ms, "shared");
+    auto stream = std::make_shared<UnreadStreamClient>();
+    auto other = std::make_shared<TimedClient>();
+    loop.add(stream);
+    loop.add(other);
+    loop.start();
+
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (other->count() < 200 && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(5ms);
+    loop.stop();
+    loop.join();
+
+    REQUIRE(other->polls.size() >= 200);
+    CHECK(stream->polls.load() >= 200);
+    CHECK(stream->queue.dropped() > 0);
+    CHECK(stream->queue.size() == 4);  // the newest frames are kept for the reader
+
+    // Nothing close to the 1 s block timeout between consecutive polls
+    std::chrono::steady_clock::duration longest{};
+    for (size_t i = 1; i < other->polls.size(); ++i) {
+        longest = std::max(longest, other->polls[i] - other->polls[i - 1]);
+    }
+    CHECK(longest < 250ms);
+}
+
+// ============================================================================
+// Batches and configuration
+// ============================================================================
+
+TEST_CASE("DeliveryQueue counts a dropped batch as its frames", "[delivery]") {
+    DeliveryQueue<std::vector<int>> q(1, DeliveryPolicy::DropOldest);
+    q.push({1, 2, 3});
+    CHECK(q.push({4}).dropped == 3);
+    CHECK(q.dropped() == 3);
+    CHECK(DeliveryQueue<std::vector<int>>::frameCount(std::vector<int>{}) == 0);
+    CHECK(DeliveryQueue<int>::frameCount(7) == 1);
+}
+
+TEST_CASE("DeliveryQueue::configure() changes depth and policy in place", "[delivery]") {
+    DeliveryQueue<int> q(4, DeliveryPolicy::DropNewest);
+    for (int i = 0; i < 4; ++i) q.push(i);
+
+    q.configure(2, DeliveryPolicy::DropOldest);
+    CHECK(q.size() == 4);              // nothing is dropped by configure() itself
+    CHECK(q.push(4).dropped == 3);     // the next push makes room
+
+    std::vector<int> out;
+    q.drain(out);
+    CHECK(out == std::vector<int>{3, 4});
+
+    REQUIRE_THROWS_AS(q.configure(2, DeliveryPolicy::AudioPriority), std::invalid_argument);
+}
+
+// ============================================================================
+// Policies
+// ============================================================================
+
+TEST_CASE("Delivery policy names round-trip", "[delivery]") {
+    for (auto policy : {DeliveryPolicy::Block, DeliveryPolicy::DropOldest,
+                        DeliveryPolicy::DropNewest, DeliveryPolicy::AudioPriority}) {
+        CHECK(parseDeliveryPolicy(name(policy)) == policy);
+    }
+    CHECK(std::string(name(DeliveryPolicy::DropOldest)) == "drop-oldest");
+    REQUIRE_THROWS_AS(parseDeliveryPolicy("drop_oldest"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parseDeliveryPolicy(""), std::invalid_argument);
+}
+
+TEST_CASE("audio-priority blocks audio and sheds everything else", "[delivery]") {
+    using Media = ClientMetrics::Media;
+    CHECK(effectivePolicy(DeliveryPolicy::AudioPriority, Media::Audio) == DeliveryPolicy::Block);
+    CHECK(effectivePolicy(DeliveryPolicy::AudioPriority, Media::Video) == DeliveryPolicy::DropOldest);
+    CHECK(effectivePolicy(DeliveryPolicy::AudioPriority, Media::Deskshare) == DeliveryPolicy::DropOldest);
+    CHECK(effectivePolicy(DeliveryPolicy::AudioPriority, Media::Transcript) == DeliveryPolicy::DropOldest);
+    CHECK(effectivePolicy(DeliveryPolicy::DropNewest, Media::Audio) == DeliveryPolicy::DropNewest);
+}
+
+// ============================================================================
+// Client stats
+// ============================================================================
+
+TEST_CASE("Client::recordDropped() is reported per media type", "[delivery][metrics]") {
+    g_mock_state.reset();
+    Client c;
+    c.recordDropped(ClientMetrics::Media::Video, 5);
+    c.recordDropped(ClientMetrics::Media::Video, 2);
+
+    auto stats = c.metrics().snapshot();
+    CHECK(stats.of(ClientMetrics::Media::Video).dropped == 7);
+    CHECK(stats.of(ClientMetrics::Media::Audio).dropped == 0);
+}
@@ -0,0 +1,594 @@
+/**
+ * C++ tests for the native reactor (src/event_loop.h / src/event_loop.cpp).
+ *
+ * Test coverage:
+ *   - start/poll/stop run on the loop thread for every client
+ *   - The cycle-end hook runs once after each cycle that delivered
+ *   - readyFd() signals delivering cycles and shutdown; stoppedFd() only shutdown
+ *   - remove() waits for stop(), drops unstarted clients, schedules from callbacks
+ *   - Failed start()/poll() detach the client
+ *   - stop() releases remaining clients and rejects new ones
+ *   - PollPolicy schedules and per-client adaptive intervals
+ *   - ClientSession allocates, joins, polls and releases on the loop thread
+ *   - EventLoopPool routing strategies
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "event_loop.h"
+#include "mock_sdk.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
+using namespace rtms;
+using namespace std::chrono_literals;
+
+struct R { R() { g_mock_state.reset(); } };
+
+namespace {
+
+// Records which thread each lifecycle call ran on. The thread ids are written
+// by the loop thread and read by the test after remove()/join(), which
+// synchronise with it.
+struct FakeClient : LoopClient {
+    std::atomic<int> starts{0};
+    std::atomic<int> polls{0};
+    std::atomic<int> stops{0};
+    std::thread::id start_thread;
+    std::thread::id poll_thread;
+    std::thread::id stop_thread;
+
+    bool fail_start = false;
+    bool throw_on_poll = false;
+    std::atomic<bool> delivering{false};  // report PollResult::Delivered
+    int polls_before_done = -1;           // -1: never ask to be detached
+    std::function<void()> on_poll;
+
+    void start() override {
+        start_thread = std::this_thread::get_id();
+        starts.fetch_add(1);
+        if (fail_start) throw std::runtime_error("start failed");
+    }
+
+    PollResult poll() override {
+        poll_thread = std::this_thread::get_id();
+        int n = polls.fetch_add(1) + 1;
+        if (on_poll) on_poll();
+        if (throw_on_poll) throw Exception(RTMS_SDK_FAILURE, "poll failed");
+        if (polls_before_done >= 0 && n >= polls_before_done) return PollResult::Detach;
+        return delivering.load() ? PollResult::Delivered : PollResult::Idle;
+    }
+
+    void stop() noexcept override {
+        stop_thread = std::this_thread::get_id();
+        stops.fetch_add(1);
+    }
+};
+
+template <typename Pred>
+bool waitUntil(Pred pred, std::chrono::milliseconds timeout = 2s) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+std::thread::id loopThreadOf(EventLoop& loop) {
+    auto probe = std::make_shared<FakeClient>();
+    loop.add(probe);
+    waitUntil([&] { return probe->polls.load() > 0; });
+    loop.remove(probe);
+    return probe->poll_thread;
+}
+
+} // namespace
+
+// ============================================================================
+// Thread affinity
+// ============================================================================
+
+TEST_CASE("EventLoop runs start, poll and stop on its own thread", "[eventloop]") {
+    EventLoop loop(1ms, "rtms-test");
+    auto client = std::make_shared<FakeClient>();
+    loop.add(client);
+    loop.start();
+
+    REQUIRE(waitUntil([&] { return client->polls.load() >= 3; }));
+    CHECK(loop.running());
+    CHECK(loop.clientCount() == 1);
+    REQUIRE(loop.remove(client));
+
+    CHECK(client->starts.load() == 1);
+    CHECK(client->stops.load() == 1);
+    CHECK(client->start_thread != std::this_thread::get_id());
+    CHECK(client->start_thread == client->poll_thread);
+    CHECK(client->stop_thread == client->poll_thread);
+    CHECK(loop.clientCount() == 0);
+}
+
+TEST_CASE("EventLoop drives many clients from one thread", "[eventloop]") {
+    EventLoop loop(1ms);
+    loop.start();
+
+    std::vector<std::shared_ptr<FakeClient>> clients;
+    for (int i = 0; i < 200; ++i) {
+        clients.push_back(std::make_shared<FakeClient>());
+        loop.add(clients.back());
+    }
+    REQUIRE(waitUntil([&] {
+        for (auto& c : clients) if (c->polls.load() == 0) return false;
+        return true;
+    }));
+    CHECK(loop.clientCount() == 200);
+
+    loop.stop();
+    loop.join();
+    CHECK_FALSE(loop.running());
+    CHECK(loop.clientCount() == 0);
+
+    const auto owner = clients.front()->poll_thread;
+    for (auto& c : clients) {
+        CHECK(c->stops.load() == 1);
+        CHECK(c->poll_thread == owner);
+    }
+}
+
+TEST_CASE("EventLoop runs the cycle-end hook only after cycles that delivered", "[eventloop]") {
+    EventLoop busy_loop(1ms);
+    EventLoop idle_loop(1ms);
+    auto busy = std::make_shared<FakeClient>();
+    auto idle = std::make_shared<FakeClient>();
+    busy->delivering = true;
+
+    // Written on busy_loop's thread, read after join()
+    int busy_hooks = 0;
+    int polls_at_last_hook = 0;
+    bool one_hook_per_poll = true;
+    std::thread::id hook_thread;
+    busy_loop.setOnCycleEnd([&] {
+        int polls = busy->polls.load();
+        one_hook_per_poll = one_hook_per_poll && polls == polls_at_last_hook + 1;
+        polls_at_last_hook = polls;
+        hook_thread = std::this_thread::get_id();
+        ++busy_hooks;
+    });
+    std::atomic<int> idle_hooks{0};
+    idle_loop.setOnCycleEnd([&] { idle_hooks.fetch_add(1); });
+
+    busy_loop.add(busy);
+    idle_loop.add(idle);
+    busy_loop.start();
+    idle_loop.start();
+    REQUIRE(waitUntil([&] { return busy->polls.load() >= 5 && idle->polls.load() >= 5; }));
+    busy_loop.stop();
+    idle_loop.stop();
+    busy_loop.join();
+    idle_loop.join();
+
+    CHECK(busy_hooks == busy->polls.load());
+    CHECK(one_hook_per_poll);
+    CHECK(hook_thread == busy->poll_thread);
+    CHECK(idle_hooks.load() == 0);
+}
+
+#ifndef _WIN32
+TEST_CASE("EventLoop::readyFd signals delivering cycles and shutdown", "[eventloop]") {
+    auto readable = [](int fd, int timeout_ms) {
+        pollfd pfd{fd, POLLIN, 0};
+        return ::poll(&pfd, 1, timeout_ms) == 1;
+    };
+
+    EventLoop loop(1ms);
+    auto client = std::make_shared<FakeClient>();
+    int fd = loop.readyFd();
+    REQUIRE(fd >= 0);
+    CHECK(loop.readyFd() == fd);
+    loop.add(client);
+    loop.start();
+
+    REQUIRE(waitUntil([&] { return client->polls.load() >= 3; }));
+    CHECK_FALSE(readable(fd, 0));   // idle cycles do not signal
+
+    client->delivering = true;
+    CHECK(readable(fd, 2000));
+    CHECK(loop.clearReady());
+
+    client->delivering = false;
+    REQUIRE(waitUntil([&] { return client->polls.load() >= 10; }));
+    loop.clearReady();
+    loop.stop();
+    CHECK(readable(fd, 2000));
+    loop.join();
+    CHECK_FALSE(loop.running());
+
+    // A loop that has already shut down is readable from the start
+    EventLoop stopped(1ms);
+    stopped.stop();
+    CHECK(readable(stopped.readyFd(), 0));
+}
+
+TEST_CASE("EventLoop::stoppedFd signals shutdown only", "[eventloop]") {
+    auto readable = [](int fd, int timeout_ms) {
+        pollfd pfd{fd, POLLIN, 0};
+        return ::poll(&pfd, 1, timeout_ms) == 1;
+    };
+
+    EventLoop loop(1ms);
+    auto client = std::make_shared<FakeClient>();
+    client->delivering = true;
+    int fd = loop.stoppedFd();
+    REQUIRE(fd >= 0);
+    CHECK(loop.stoppedFd() == fd);
+    CHECK(loop.stoppedFd() != loop.readyFd());
+    loop.add(client);
+    loop.start();
+
+    REQUIRE(waitUntil([&] { return client->polls.load() >= 10; }));
+    CHECK(readable(loop.readyFd(), 0));
+    CHECK_FALSE(readable(fd, 0));   // delivering cycles do not signal
+
+    loop.stop();
+    CHECK(readable(fd, 2000));
+    loop.join();
+    CHECK_FALSE(loop.running());
+    loop.clearReady();
+    CHECK(readable(fd, 0));         // clearReady() leaves it alone
+
+    EventLoop stopped(1ms);
+    stopped.stop();
+    CHECK(readable(stopped.stoppedFd(), 0));
+}
+#endif
+
+// ============================================================================
+// remove()
+// ============================================================================
+
+TEST_CASE("EventLoop::remove drops clients that never started", "[eventloop]") {
+    EventLoop loop;
+    auto client = std::make_shared<FakeClient>();
+    loop.add(client);
+    CHECK(loop.clientCount() == 1);
+
+    CHECK(loop.remove(client));
+    CHECK_FALSE(loop.remove(client));
+    CHECK(loop.clientCount() == 0);
+    CHECK(client->starts.load() == 0);
+    CHECK(client->stops.load() == 0);
+}
+
+TEST_CASE("EventLoop::remove returns false for a client it does not own", "[eventloop]") {
+    EventLoop loop(1ms);
+    loop.start();
+    CHECK_FALSE(loop.remove(std::make_shared<FakeClient>()));
+    CHECK_FALSE(loop.remove(nullptr));
+}
+
+TEST_CASE("A client can remove itself from inside poll()", "[eventloop]") {
+    EventLoop loop(1ms);
+    auto client = std::make_shared<FakeClient>();
+    std::atomic<bool> scheduled{false};
+    client->on_poll = [&] {
+        if (!scheduled.exchange(true)) loop.remove(client);
+    };
+    loop.add(client);
+    loop.start();
+
+    REQUIRE(waitUntil([&] { return client->stops.load() == 1; }));
+    CHECK(client->polls.load() == 1);
+    CHECK(loop.clientCount() == 0);
+}
+
+// ============================================================================
+// Failures
+// ============================================================================
+
+TEST_CASE("EventLoop detaches clients whose start() or poll() fails", "[eventloop]") {
+    EventLoop loop(1ms);
+    auto bad_start = std::make_shared<FakeClient>();
+    bad_start->fail_start = true;
+    auto bad_poll = std::make_shared<FakeClient>();
+    bad_poll->throw_on_poll = true;
+    auto done = std::make_shared<FakeClient>();
+    done->polls_before_done = 3;
+    auto healthy = std::make_shared<FakeClient>();
+
+    for (auto& c : {bad_start, bad_poll, done, healthy}) loop.add(c);
+    loop.start();
+
+    REQUIRE(waitUntil([&] { return loop.clientCount() == 1; }));
+    CHECK(loop.remove(healthy));
+
+    CHECK(bad_start->polls.load() == 0);
+    CHECK(bad_start->stops.load() == 0);   // never started, nothing to release
+    CHECK(bad_poll->polls.load() == 1);
+    CHECK(bad_poll->stops.load() == 1);
+    CHECK(done->polls.load() == 3);
+    CHECK(done->stops.load() == 1);
+}
+
+// ============================================================================
+// stop() / run()
+// ============================================================================
+
+TEST_CASE("EventLoop::stop releases remaining clients and rejects new ones", "[eventloop]") {
+    EventLoop loop(1ms);
+    auto started = std::make_shared<FakeClient>();
+    loop.add(started);
+    loop.start();
+    REQUIRE(waitUntil([&] { return started->polls.load() > 0; }));
+
+    CHECK_FALSE(loop.wait(5ms));
+    loop.stop();
+    CHECK(loop.wait(2s));
+    loop.join();
+    CHECK(started->stops.load() == 1);
+    CHECK_FALSE(loop.remove(started));
+    REQUIRE_THROWS_AS(loop.add(std::make_shared<FakeClient>()), Exception);
+    REQUIRE_THROWS_AS(loop.start(), Exception);
+}
+
+TEST_CASE("EventLoop::start rejects a second start", "[eventloop]") {
+    EventLoop loop(1ms);
+    loop.start();
+    REQUIRE_THROWS_AS(loop.start(), Exception);
+    REQUIRE_THROWS_AS(loop.run(), Exception);
+}
+
+TEST_CASE("EventLoop::run with stop_when_empty returns once clients leave", "[eventloop]") {
+    EventLoop loop(0ms);
+    auto client = std::make_shared<FakeClient>();
+    client->polls_before_done = 5;
+    loop.add(client);
+
+    loop.run(true);   // on this thread
+
+    CHECK(client->start_thread == std::this_thread::get_id());
+    CHECK(client->polls.load() == 5);
+    CHECK(client->stops.load() == 1);
+    CHECK_FALSE(loop.running());
+}
+
+TEST_CASE("EventLoop rejects a negative poll interval and null clients", "[eventloop]") {
+    REQUIRE_THROWS_AS(EventLoop(-1ms), std::invalid_argument);
+    EventLoop loop;
+    REQUIRE_THROWS_AS(loop.add(nullptr), std::invalid_argument);
+}
+
+// ============================================================================
+// Adaptive polling
+// ============================================================================
+
+TEST_CASE("PollPolicy spins, yields, then backs off to max_interval", "[eventloop][policy]") {
+    PollPolicy policy;
+    policy.spin_polls = 2;
+    policy.yield_polls = 1;
+    policy.min_interval = 1ms;
+    policy.max_interval = 5ms;
+    policy.polls_per_doubling = 2;
+
+    using Phase = PollPolicy::Phase;
+    CHECK(policy.step(0).phase == Phase::Spin);
+    CHECK(policy.step(1).phase == Phase::Spin);
+    CHECK(policy.step(2).phase == Phase::Yield);
+    CHECK(policy.step(2).interval == 0us);
+    CHECK(policy.step(3).phase == Phase::Sleep);
+    CHECK(policy.step(3).interval == 1ms);
+    CHECK(policy.step(4).interval == 1ms);
+    CHECK(policy.step(5).interval == 2ms);
+    CHECK(policy.step(7).interval == 4ms);
+    CHECK(policy.step(9).interval == 5ms);
+    CHECK(policy.step(UINT32_MAX).interval == 5ms);
+}
+
+TEST_CASE("PollPolicy modes tighten busy clients and relax idle ones", "[eventloop][policy]") {
+    for (PollMode mode : {PollMode::Latency, PollMode::Balanced, PollMode::Power}) {
+        CAPTURE(pollModeName(mode));
+        PollPolicy policy = PollPolicy::forMode(mode);
+        REQUIRE_NOTHROW(policy.validate());
+        CHECK(policy.step(0).interval <= policy.min_interval);
+        CHECK(policy.step(1000).interval == policy.max_interval);
+        CHECK(policy.min_interval < policy.max_interval);
+        CHECK(parsePollMode(pollModeName(mode)) == mode);
+    }
+
+    CHECK(PollPolicy::forMode(PollMode::Latency).step(0).phase == PollPolicy::Phase::Spin);
+    CHECK(PollPolicy::forMode(PollMode::Power).step(0).interval >
+          PollPolicy::forMode(PollMode::Balanced).step(0).interval);
+    CHECK(PollPolicy::fixed(10ms).step(0).interval == 10ms);
+    CHECK(PollPolicy::fixed(10ms).step(1000).interval == 10ms);
+    REQUIRE_THROWS_AS(parsePollMode("turbo"), std::invalid_argument);
+}
+
+TEST_CASE("EventLoop rejects an invalid PollPolicy", "[eventloop][policy]") {
+    PollPolicy policy;
+    policy.min_interval = 5ms;
+    policy.max_interval = 1ms;
+    REQUIRE_THROWS_AS(EventLoop(policy), std::invalid_argument);
+
+    policy.max_interval = 5ms;
+    policy.polls_per_doubling = 0;
+    REQUIRE_THROWS_AS(EventLoop(policy), std::invalid_argument);
+}
+
+TEST_CASE("EventLoop polls busy clients more often than idle ones", "[eventloop][policy]") {
+    PollPolicy policy;
+    policy.min_interval = 1ms;
+    policy.max_interval = 16ms;
+    policy.polls_per_doubling = 1;
+    EventLoop loop(policy);
+
+    auto busy = std::make_shared<FakeClient>();
+    busy->delivering = true;
+    auto idle = std::make_shared<FakeClient>();
+    loop.add(busy);
+    loop.add(idle);
+    loop.start();
+
+    REQUIRE(waitUntil([&] { return idle->pollInterval() == 16ms; }));
+    CHECK(busy->pollInterval() == 1ms);
+
+    int busy_before = busy->polls.load();
+    int idle_before = idle->polls.load();
+    std::this_thread::sleep_for(100ms);
+    int busy_polls = busy->polls.load() - busy_before;
+    int idle_polls = idle->polls.load() - idle_before;
+    CHECK(idle_polls <= 8);
+    CHECK(busy_polls > idle_polls * 3);
+
+    // Activity resets the backoff
+    idle->delivering = true;
+    REQUIRE(waitUntil([&] { return idle->pollInterval() == 1ms; }));
+}
+
+TEST_CASE("Latency mode re-polls a busy client without sleeping", "[eventloop][policy]") {
+    EventLoop loop(PollMode::Latency);
+    auto client = std::make_shared<FakeClient>();
+    client->delivering = true;
+    loop.add(client);
+    loop.start();
+
+    // At the 1 ms floor this would take ten seconds
+    REQUIRE(waitUntil([&] { return client->polls.load() >= 10000; }));
+    CHECK(client->pollInterval() == 0us);
+
+    client->delivering = false;
+    REQUIRE(waitUntil([&] { return client->pollInterval() == loop.policy().max_interval; }));
+}
+
+// ============================================================================
+// ClientSession
+// ============================================================================
+
+TEST_CASE("ClientSession allocates, joins, polls and releases on the loop thread", "[eventloop][session]") {
+    R _;
+    auto client = std::make_shared<Client>(true);
+    client->setProxy("http", "http://proxy:3128");
+    CHECK(g_mock_state.create_calls == 0);
+    CHECK(g_mock_state.proxy_calls == 0);
+
+    EventLoop loop(1ms);
+    auto session = std::make_shared<ClientSession>(client, "uuid-1", "stream-1", "sig", "wss://srv", 1000);
+    loop.add(session);
+    loop.start();
+
+    // The probe is polled after the session has started, so once it has been
+    // removed the session's join is visible to this thread.
+    CHECK(loopThreadOf(loop) != std::this_thread::get_id());
+    CHECK(client->allocated());
+    REQUIRE(loop.remove(session));
+
+    CHECK(g_mock_state.create_calls == 1);
+    CHECK(g_mock_state.proxy_calls == 1);
+    CHECK(g_mock_state.last_proxy_url == "http://proxy:3128");
+    CHECK(g_mock_state.join_calls == 1);
+    CHECK(g_mock_state.last_meeting_uuid == "uuid-1");
+    CHECK(g_mock_state.last_timeout == 1000);
+    CHECK(g_mock_state.poll_calls >= 1);
+    CHECK(g_mock_state.leave_calls == 1);
+    CHECK(g_mock_state.release_calls == 1);
+    CHECK_FALSE(client->allocated());
+}
+
+TEST_CASE("ClientSession reports whether a poll delivered anything", "[eventloop][session]") {
+    R _;
+    auto client = std::make_shared<Client>();
+    ClientSession session(client, "u", "s", "sig", "url");
+    session.start();
+
+    int frames = 0;
+    client->setOnAudioFrame([&](const MediaFrameView&) { ++frames; });
+    CHECK(session.poll() == PollResult::Idle);
+
+    unsigned char buf[] = {0x01};
+    rtms_metadata md{};
+    g_mock_state.on_poll = [&] { mock_trigger_audio_data(buf, 1, 0, &md); };
+    CHECK(session.poll() == PollResult::Delivered);
+    CHECK(frames == 1);
+
+    g_mock_state.on_poll = nullptr;
+    CHECK(session.poll() == PollResult::Idle);
+    session.stop();
+}
+
+TEST_CASE("ClientSession that fails to join reports it and is dropped without a poll", "[eventloop][session]") {
+    R _;
+    g_mock_state.join_result = RTMS_SDK_FAILURE;
+    auto client = std::make_shared<Client>(true);
+    auto session = std::make_shared<ClientSession>(client, "u", "s", "sig", "url");
+    std::vector<int> failures;
+    session->setOnJoinFailed([&](int reason) { failures.push_back(reason); });
+
+    EventLoop loop(0ms);
+    loop.add(session);
+    loop.run(true);
+
+    CHECK(g_mock_state.join_calls == 1);
+    CHECK(g_mock_state.poll_calls == 0);
+    CHECK(failures == std::vector<int>{RTMS_SDK_FAILURE});
+}
+
+// ============================================================================
+// EventLoopPool
+// ============================================================================
+
+TEST_CASE("EventLoopPool round-robin spreads clients evenly", "[eventloop][pool]") {
+    EventLoopPool pool(3, 1ms, EventLoopPool::Strategy::RoundRobin);
+    std::vector<std::shared_ptr<FakeClient>> clients;
+    for (int i = 0; i < 9; ++i) {
+        clients.push_back(std::make_shared<FakeClient>());
+        pool.add(clients.back());
+    }
+    CHECK(pool.size() == 3);
+    CHECK(pool.clientCount() == 9);
+    for (size_t i = 0; i < pool.size(); ++i) CHECK(pool.loop(i).clientCount() == 3);
+}
+
+TEST_CASE("EventLoopPool least-loaded fills the emptiest loop", "[eventloop][pool]") {
+    EventLoopPool pool(2, 1ms, EventLoopPool::Strategy::LeastLoaded);
+    auto a = std::make_shared<FakeClient>();
+    auto b = std::make_shared<FakeClient>();
+    auto c = std::make_shared<FakeClient>();
+
+    EventLoop& first = pool.add(a);
+    EventLoop& second = pool.add(b);
+    CHECK(&first != &second);
+
+    CHECK(pool.remove(a));
+    CHECK(&pool.add(c) == &first);
+    CHECK_FALSE(pool.remove(a));
+}
+
+TEST_CASE("EventLoopPool runs each loop on its own thread", "[eventloop][pool]") {
+    EventLoopPool pool(2, 1ms, EventLoopPool::Strategy::RoundRobin);
+    auto a = std::make_shared<FakeClient>();
+    auto b = std::make_shared<FakeClient>();
+    pool.add(a);
+    pool.add(b);
+    pool.start();
+
+    REQUIRE(waitUntil([&] { return a->polls.load() > 0 && b->polls.load() > 0; }));
+    pool.stop();
+    pool.join();
+
+    CHECK(a->poll_thread != b->poll_thread);
+    CHECK(a->stops.load() == 1);
+    CHECK(b->stops.load() == 1);
+    CHECK(pool.clientCount() == 0);
+}
+
+TEST_CASE("EventLoopPool rejects zero threads", "[eventloop][pool]") {
+    REQUIRE_THROWS_AS(EventLoopPool(0), std::invalid_argument);
+}
@@ -0,0 +1,189 @@
+/**
+ * C++ tests for per-client metrics (src/metrics.h / src/metrics.cpp).
+ *
+ * Test coverage:
+ *   - LatencyHistogram bucket layout, percentiles and cumulative counts
+ *   - Concurrent record() from several threads
+ *   - Client counts frames, bytes and empty deliveries per media type
+ *   - Client times poll() and every registered callback
+ *   - Media names round-trip through ClientMetrics::parse()
+ *   - [.][benchmark] cost of record() and of a timed callback
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "rtms.h"
+#include "mock_sdk.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rtms;
+using namespace std::chrono_literals;
+using Catch::Matchers::WithinRel;
+
+struct R { R() { g_mock_state.reset(); } };
+
+// ============================================================================
+// LatencyHistogram
+// ============================================================================
+
+TEST_CASE("LatencyHistogram buckets are contiguous and within 12.5%", "[metrics]") {
+    CHECK(LatencyHistogram::bucketLow(0) == 0);
+    for (int i = 0; i + 1 < LatencyHistogram::kBuckets; ++i) {
+        REQUIRE(LatencyHistogram::bucketHigh(i) + 1 == LatencyHistogram::bucketLow(i + 1));
+    }
+
+    for (uint64_t v : {0ull, 1ull, 7ull, 8ull, 9ull, 15ull, 16ull, 1000ull, 123456789ull, (1ull << 39) + 5}) {
+        int b = LatencyHistogram::bucketFor(v);
+        CAPTURE(v, b);
+        CHECK(LatencyHistogram::bucketLow(b) <= v);
+        CHECK(v <= LatencyHistogram::bucketHigh(b));
+        CHECK(LatencyHistogram::bucketHigh(b) - LatencyHistogram::bucketLow(b) <= v / 8);
+    }
+
+    // Out-of-range values land in the top bucket
+    CHECK(LatencyHistogram::bucketFor(~0ull) == LatencyHistogram::kBuckets - 1);
+}
+
+TEST_CASE("LatencyHistogram reports count, mean, max and percentiles", "[metrics]") {
+    LatencyHistogram h;
+    CHECK(h.snapshot().count == 0);
+    CHECK(h.snapshot().percentileNs(0.5) == 0);
+
+    for (uint64_t us = 1; us <= 1000; ++us) h.record(us * 1000);
+    auto snap = h.snapshot();
+
+    CHECK(snap.count == 1000);
+    CHECK(snap.max_ns == 1000000);
+    CHECK_THAT(snap.meanNs(), WithinRel(500500.0, 1e-9));
+    CHECK_THAT(static_cast<double>(snap.percentileNs(0.5)), WithinRel(500000.0, 0.125));
+    CHECK_THAT(static_cast<double>(snap.percentileNs(0.99)), WithinRel(990000.0, 0.125));
+    CHECK(snap.percentileNs(1.0) == 1000000);
+    CHECK(snap.percentileNs(0.0) <= 1000 + 125);
+
+    CHECK(snap.countAtOrBelow(0) == 0);
+    CHECK(snap.countAtOrBelow(~0ull) == 1000);
+    CHECK_THAT(static_cast<double>(snap.countAtOrBelow(100000)), WithinRel(100.0, 0.125));
+}
+
+TEST_CASE("LatencyHistogram::record is safe from many threads", "[metrics][threads]") {
+    LatencyHistogram h;
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 50000;
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&h, t] {
+            for (int i = 0; i < kPerThread; ++i) h.record(static_cast<uint64_t>(t * 1000 + i % 1000));
+        });
+    }
+    for (auto& w : writers) w.join();
+
+    auto snap = h.snapshot();
+    CHECK(snap.count == kThreads * kPerThread);
+    CHECK(snap.max_ns == (kThreads - 1) * 1000 + 999);
+}
+
+// ============================================================================
+// Client metrics
+// ============================================================================
+
+TEST_CASE("Client counts frames, bytes and empty deliveries per media type", "[metrics][client]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    unsigned char buf[64] = {};
+    rtms_metadata md{};
+    mock_trigger_audio_data(buf, 10, 0, &md);
+    mock_trigger_audio_data(buf, 20, 0, &md);
+    mock_trigger_video_data(buf, 64, 0, &md);
+    mock_trigger_transcript_data(buf, 5, 0, &md);
+    mock_trigger_audio_data(buf, 0, 0, &md);         // empty
+    mock_trigger_video_data(nullptr, 8, 0, &md);     // no buffer
+    mock_trigger_ds_data(buf, 8, 0, nullptr);        // no metadata
+
+    auto stats = c.metrics().snapshot();
+    using Media = ClientMetrics::Media;
+    CHECK(stats.of(Media::Audio).frames == 2);
+    CHECK(stats.of(Media::Audio).bytes == 30);
+    CHECK(stats.of(Media::Audio).empty == 1);
+    CHECK(stats.of(Media::Video).frames == 1);
+    CHECK(stats.of(Media::Video).bytes == 64);
+    CHECK(stats.of(Media::Video).empty == 1);
+    CHECK(stats.of(Media::Deskshare).frames == 0);
+    CHECK(stats.of(Media::Deskshare).empty == 1);
+    CHECK(stats.of(Media::Transcript).frames == 1);
+    CHECK(stats.of(Media::Transcript).bytes == 5);
+}
+
+TEST_CASE("Client times poll() and registered callbacks", "[metrics][client]") {
+    R _;
+    Client c;
+    c.join("u", "s", "sig", "url");
+
+    c.setOnAudioFrame([](const MediaFrameView&) { std::this_thread::sleep_for(2ms); });
+    c.setOnLeave([](int) {});
+
+    unsigned char buf[] = {0x01};
+    rtms_metadata md{};
+    mock_trigger_audio_data(buf, 1, 0, &md);
+    mock_trigger_audio_data(buf, 1, 0, &md);
+    mock_trigger_video_data(buf, 1, 0, &md);   // no video callback: counted, not timed
+    mock_trigger_leave(0);
+    c.poll();
+    c.poll();
+    c.poll();
+
+    auto stats = c.metrics().snapshot();
+    using Callback = ClientMetrics::Callback;
+    CHECK(stats.of(Callback::Audio).count == 2);
+    CHECK(stats.of(Callback::Audio).percentileNs(0.5) >= 1000000);
+    CHECK(stats.of(Callback::Video).count == 0);
+    CHECK(stats.of(Callback::Leave).count == 1);
+    CHECK(stats.of(ClientMetrics::Media::Video).frames == 1);
+    CHECK(stats.poll.count == 3);
+
+    CHECK(std::string(ClientMetrics::name(Callback::ParticipantVideo)) == "participant_video");
+    CHECK(std::string(ClientMetrics::name(ClientMetrics::Media::Deskshare)) == "deskshare");
+}
+
+TEST_CASE("Media names round-trip through ClientMetrics::parse", "[metrics]") {
+    for (size_t i = 0; i < ClientMetrics::kMediaCount; ++i) {
+        auto media = static_cast<ClientMetrics::Media>(i);
+        CHECK(ClientMetrics::parse(ClientMetrics::name(media)) == media);
+    }
+    CHECK_THROWS_AS(ClientMetrics::parse("Audio"), std::invalid_argument);
+    CHECK_THROWS_AS(ClientMetrics::parse(""), std::invalid_argument);
+    CHECK_THROWS_AS(ClientMetrics::parse("unknown"), std::invalid_argument);
+}
+
+// ============================================================================
+// Benchmark (hidden; run with: rtms_tests "[benchmark]")
+// ============================================================================
+
+TEST_CASE("Metrics recording cost", "[.][benchmark][metrics]") {
+    LatencyHistogram h;
+    uint64_t v = 1;
+    BENCHMARK("LatencyHistogram::record") {
+        h.record(v);
+        v = v * 6364136223846793005ull + 1442695040888963407ull;
+        return v;
+    };
+
+    LatencyHistogram t;
+    BENCHMARK("LatencyHistogram::Timer around an empty scope") {
+        LatencyHistogram::Timer timer(t);
+    };
+
+    BENCHMARK("ClientMetrics::snapshot") {
+        return ClientMetrics().snapshot().poll.count;
+    };
+}
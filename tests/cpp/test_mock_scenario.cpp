@@ -0,0 +1,327 @@
+/**
+ * C++ tests for the mock SDK's synthetic traffic (tests/cpp/mock_sdk.h MockScenario).
+ *
+ * Test coverage:
+ *   - Join confirmation, session and participants arrive on the first poll
+ *   - Audio cadence, video fps and keyframes, transcript bursts
+ *   - Join/leave churn and meeting duration
+ *   - Stalled polls skip the backlog instead of bursting
+ *   - MockScenario::parse()
+ *   - Many clients on an EventLoopPool, driven in real time
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "rtms.h"
+#include "event_loop.h"
+#include "mock_sdk.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rtms;
+using namespace std::chrono_literals;
+
+struct R { R() { g_mock_state.reset(); } };
+
+namespace {
+
+// A scenario with every stream off and a clock the test advances by hand
+struct ManualScenario {
+    uint64_t now = 1000;
+    MockScenario scenario;
+
+    ManualScenario() {
+        scenario.participants = 2;
+        scenario.audio_interval_ms = 0;
+        scenario.transcript_interval_ms = 0;
+        scenario.clock = [this] { return now; };
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// Meeting start
+// ============================================================================
+
+TEST_CASE("Scenario confirms the join and announces participants on the first poll", "[mock][scenario]") {
+    R _;
+    ManualScenario m;
+    m.scenario.participants = 3;
+    g_mock_state.scenario = m.scenario;
+
+    Client c;
+    std::vector<int> confirms;
+    std::vector<Session> sessions;
+    std::vector<Participant> joined;
+    c.setOnJoinConfirm([&](int reason) { confirms.push_back(reason); });
+    c.setOnSessionUpdate([&](int op, const Session& s) { if (op == SESSION_ADD) sessions.push_back(s); });
+    c.setOnUserUpdate([&](int op, const Participant& p) { if (op == USER_JOIN) joined.push_back(p); });
+    c.join("meeting-uuid", "stream-id", "sig", "url");
+
+    CHECK(confirms.empty());   // nothing until the SDK is polled
+    c.poll();
+    REQUIRE(confirms == std::vector<int>{RTMS_SDK_OK});
+    REQUIRE(sessions.size() == 1);
+    CHECK(sessions[0].meetingId() == "meeting-uuid");
+    CHECK(sessions[0].streamId() == "stream-id");
+    CHECK(sessions[0].isActive());
+    REQUIRE(joined.size() == 3);
+    CHECK(joined[0].name() == "Participant 1");
+    CHECK(joined[0].id() != joined[1].id());
+
+    c.poll();
+    CHECK(confirms.size() == 1);
+}
+
+TEST_CASE("Scenario is not started when the join fails", "[mock][scenario]") {
+    R _;
+    ManualScenario m;
+    g_mock_state.scenario = m.scenario;
+    g_mock_state.join_result = RTMS_SDK_FAILURE;
+
+    Client c;
+    int confirms = 0;
+    c.setOnJoinConfirm([&](int) { ++confirms; });
+    REQUIRE_THROWS_AS(c.join("u", "s", "sig", "url"), Exception);
+    CHECK(confirms == 0);
+}
+
+// ============================================================================
+// Media
+// ============================================================================
+
+TEST_CASE("Scenario delivers audio per participant at the configured cadence", "[mock][scenario]") {
+    R _;
+    ManualScenario m;
+    m.scenario.audio_interval_ms = 20;
+    m.scenario.audio_bytes = 160;
+    g_mock_state.scenario = m.scenario;
+
+    Client c;
+    std::map<int, std::vector<uint64_t>> frames;   // user id -> timestamps
+    c.setOnAudioFrame([&](const MediaFrameView& f) {
+        CHECK(f.size() == 160);
+        frames[f.metadata().userId()].push_back(f.timestamp());
+    });
+    c.join("u", "s", "sig", "url");
+
+    c.poll();                 // t = 0
+    m.now += 100;
+    c.poll();                 // t = 20 .. 100
+    m.now += 10;
+    c.poll();                 // nothing new is due
+
+    REQUIRE(frames.size() == 2);
+    for (auto& [user, ts] : frames) {
+        CAPTURE(user);
+        CHECK(ts == std::vector<uint64_t>{1000, 1020, 1040, 1060, 1080, 1100});
+    }
+}
+
+TEST_CASE("Scenario delivers video at fps with periodic keyframes", "[mock][scenario]") {
+    R _;
+    ManualScenario m;
+    m.scenario.participants = 3;
+    m.scenario.video_fps = 30;
+    m.scenario.video_senders = 2;
+    m.scenario.video_bytes = 1000;
+    m.scenario.video_keyframe_bytes = 5000;
+    m.scenario.video_keyframe_interval = 15;
+    g_mock_state.scenario = m.scenario;
+
+    Client c;
+    size_t frames = 0;
+    size_t keyframes = 0;
+    std::map<int, int> senders;
+    c.setOnVideoFrame([&](const MediaFrameView& f) {
+        ++frames;
+        if (f.size() == 5000) ++keyframes;
+        ++senders[f.metadata().userId()];
+    });
+    c.join("u", "s", "sig", "url");
+
+    c.poll();
+    m.now += 999;
+    c.poll();
+
+    CHECK(frames == 60);       // 30 frames from each of 2 senders
+    CHECK(keyframes == 4);     // frames 0 and 15
+    CHECK(senders.size() == 2);
+}
+
+TEST_CASE("Scenario delivers transcript bursts from rotating speakers", "[mock][scenario]") {
+    R _;
+    ManualScenario m;
+    m.scenario.transcript_interval_ms = 2000;
+    m.scenario.transcript_burst = 2;
+    g_mock_state.scenario = m.scenario;
+
+    Client c;
+    std::vector<std::string> segments;
+    c.setOnTranscriptFrame([&](const MediaFrameView& f) {
+        std::string text(reinterpret_cast<const char*>(f.data()), f.size());
+        CHECK(text.find(f.metadata().userName()) != std::string::npos);
+        segments.push_back(text);
+    });
+    c.join("u", "s", "sig", "url");
+
+    c.poll();
+    m.now += 4000;
+    c.poll();
+
+    REQUIRE(segments.size() == 6);
+    CHECK(segments[0].find("Participant 1") != std::string::npos);
+    CHECK(segments[1].find("Participant 2") != std::string::npos);
+}
+
+// ============================================================================
+// Churn, duration, backlog
+// ============================================================================
+
+TEST_CASE("Scenario churns participants", "[mock][scenario]") {
+    R _;
+    ManualScenario m;
+    m.scenario.churn_interval_ms = 1000;
+    g_mock_state.scenario = m.scenario;
+
+    Client c;
+    std::vector<std::pair<int, std::string>> updates;
+    c.setOnUserUpdate([&](int op, const Participant& p) { updates.emplace_back(op, p.name()); });
+    c.join("u", "s", "sig", "url");
+
+    c.poll();
+    m.now += 2500;
+    c.poll();
+
+    std::vector<std::pair<int, std::string>> expected = {
+        {USER_JOIN, "Participant 1"}, {USER_JOIN, "Participant 2"},
+        {USER_LEAVE, "Participant 1"}, {USER_JOIN, "Participant 3"},
+        {USER_LEAVE, "Participant 2"}, {USER_JOIN, "Participant 4"},
+    };
+    CHECK(updates == expected);
+}
+
+TEST_CASE("Scenario ends the meeting after its duration", "[mock][scenario]") {
+    R _;
+    ManualScenario m;
+    m.scenario.participants = 1;
+    m.scenario.audio_interval_ms = 20;
+    m.scenario.duration_ms = 100;
+    g_mock_state.scenario = m.scenario;
+
+    Client c;
+    int audio = 0;
+    std::vector<int> session_ops;
+    std::vector<int> leaves;
+    c.setOnAudioFrame([&](const MediaFrameView&) { ++audio; });
+    c.setOnSessionUpdate([&](int op, const Session&) { session_ops.push_back(op); });
+    c.setOnLeave([&](int reason) { leaves.push_back(reason); });
+    c.join("u", "s", "sig", "url");
+
+    c.poll();
+    m.now += 500;
+    c.poll();
+    m.now += 500;
+    c.poll();
+
+    CHECK(audio == 5);         // t = 0, 20, 40, 60, 80
+    CHECK(session_ops == std::vector<int>{SESSION_ADD, SESSION_STOP});
+    CHECK(leaves == std::vector<int>{RTMS_SDK_OK});
+}
+
+TEST_CASE("Scenario skips frames older than max_backlog_ms", "[mock][scenario]") {
+    R _;
+    ManualScenario m;
+    m.scenario.participants = 1;
+    m.scenario.audio_interval_ms = 20;
+    m.scenario.max_backlog_ms = 100;
+    g_mock_state.scenario = m.scenario;
+
+    Client c;
+    std::vector<uint64_t> ts;
+    c.setOnAudioFrame([&](const MediaFrameView& f) { ts.push_back(f.timestamp()); });
+    c.join("u", "s", "sig", "url");
+
+    c.poll();
+    m.now += 10000;
+    c.poll();
+
+    REQUIRE(ts.size() > 1);
+    CHECK(ts.size() <= 8);
+    CHECK(ts[1] >= m.now - 120);
+    CHECK(ts.back() == m.now);
+}
+
+// ============================================================================
+// MockScenario::parse()
+// ============================================================================
+
+TEST_CASE("MockScenario::parse reads key=value pairs", "[mock][scenario]") {
+    MockScenario s = MockScenario::parse("participants=50,video_fps=30,,churn_interval_ms=5000");
+    CHECK(s.participants == 50);
+    CHECK(s.video_fps == 30);
+    CHECK(s.churn_interval_ms == 5000);
+    CHECK(s.audio_interval_ms == 20);   // default kept
+
+    CHECK(MockScenario::parse("").participants == MockScenario{}.participants);
+    REQUIRE_THROWS_AS(MockScenario::parse("speakers=3"), std::invalid_argument);
+    REQUIRE_THROWS_AS(MockScenario::parse("participants=many"), std::invalid_argument);
+    REQUIRE_THROWS_AS(MockScenario::parse("participants=-1"), std::invalid_argument);
+    REQUIRE_THROWS_AS(MockScenario::parse("participants"), std::invalid_argument);
+}
+
+// ============================================================================
+// Load
+// ============================================================================
+
+TEST_CASE("Scenario drives many clients on an EventLoopPool in real time", "[mock][scenario][eventloop]") {
+    R _;
+    MockScenario scenario;
+    scenario.participants = 5;
+    scenario.video_fps = 25;
+    scenario.transcript_interval_ms = 50;
+    scenario.churn_interval_ms = 30;
+    g_mock_state.scenario = scenario;
+
+    constexpr int kClients = 24;
+    std::atomic<int> confirmed{0};
+    std::atomic<int> audio{0};
+    std::atomic<int> video{0};
+    std::atomic<int> transcript{0};
+
+    EventLoopPool pool(3, 1ms);
+    std::vector<std::shared_ptr<ClientSession>> sessions;
+    for (int i = 0; i < kClients; ++i) {
+        auto client = std::make_shared<Client>(true);
+        client->setOnJoinConfirm([&](int) { ++confirmed; });
+        client->setOnAudioFrame([&](const MediaFrameView&) { ++audio; });
+        client->setOnVideoFrame([&](const MediaFrameView&) { ++video; });
+        client->setOnTranscriptFrame([&](const MediaFrameView&) { ++transcript; });
+        sessions.push_back(std::make_shared<ClientSession>(client, "meeting-" + std::to_string(i), "s", "sig", "url"));
+        pool.add(sessions.back());
+    }
+    pool.start();
+
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while ((confirmed < kClients || audio < kClients * 5 * 5 || video < kClients * 2 || transcript < kClients) &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(5ms);
+    }
+    pool.stop();
+    pool.join();
+
+    CHECK(confirmed == kClients);
+    CHECK(audio >= kClients * 5 * 5);
+    CHECK(video >= kClients * 2);
+    CHECK(transcript >= kClients);
+    CHECK(g_mock_state.join_calls == kClients);
+    CHECK(g_mock_state.release_calls == kClients);
+}
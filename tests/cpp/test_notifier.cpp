@@ -0,0 +1,71 @@
+/**
+ * C++ unit tests for the readiness descriptor (src/notifier.h / src/notifier.cpp).
+ *
+ * Test coverage:
+ *   - fd() is readable after notify() and not after clear()
+ *   - Notifications coalesce until clear()
+ *   - notify() from another thread wakes a poll() on fd()
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "notifier.h"
+
+#include <chrono>
+#include <thread>
+
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
+using namespace rtms;
+
+#ifndef _WIN32
+
+namespace {
+
+bool readable(int fd, int timeout_ms = 0) {
+    pollfd pfd{fd, POLLIN, 0};
+    return ::poll(&pfd, 1, timeout_ms) == 1 && (pfd.revents & POLLIN);
+}
+
+} // namespace
+
+TEST_CASE("Notifier is readable after notify() until clear()", "[notifier]") {
+    Notifier notifier;
+    REQUIRE(notifier.fd() >= 0);
+    CHECK_FALSE(readable(notifier.fd()));
+    CHECK_FALSE(notifier.clear());
+
+    notifier.notify();
+    CHECK(readable(notifier.fd()));
+    CHECK(notifier.clear());
+    CHECK_FALSE(readable(notifier.fd()));
+}
+
+TEST_CASE("Notifier coalesces notifications until clear()", "[notifier]") {
+    Notifier notifier;
+    for (int i = 0; i < 100000; ++i) notifier.notify();
+    CHECK(readable(notifier.fd()));
+
+    CHECK(notifier.clear());
+    CHECK_FALSE(readable(notifier.fd()));
+    CHECK_FALSE(notifier.clear());
+
+    // Works again after a clear
+    notifier.notify();
+    CHECK(readable(notifier.fd()));
+}
+
+TEST_CASE("Notifier wakes a poll() from another thread", "[notifier]") {
+    Notifier notifier;
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        notifier.notify();
+    });
+    CHECK(readable(notifier.fd(), 2000));
+    producer.join();
+    CHECK(notifier.clear());
+}
+
+#endif // _WIN32
@@ -0,0 +1,59 @@
+/**
+ * C++ unit tests for PCM conversion (src/pcm.h / src/pcm.cpp).
+ *
+ * Test coverage:
+ *   - Every int16 value converts to sample / 32768 exactly
+ *   - Unaligned input and every remainder length
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "pcm.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace rtms;
+
+TEST_CASE("pcm16ToFloat converts every sample value exactly", "[pcm]") {
+    std::vector<int16_t> samples;
+    for (int v = -32768; v <= 32767; ++v) samples.push_back(static_cast<int16_t>(v));
+
+    std::vector<float> out(samples.size());
+    pcm16ToFloat(samples.data(), out.data(), samples.size());
+
+    bool exact = true;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        exact = exact && out[i] == static_cast<float>(samples[i]) / 32768.0f;
+    }
+    CHECK(exact);
+    CHECK(out.front() == -1.0f);
+    CHECK(out.back() < 1.0f);
+}
+
+TEST_CASE("pcm16ToFloat handles unaligned samples and remainders", "[pcm]") {
+    // A one-byte offset puts the samples off their natural alignment
+    std::vector<uint8_t> in(2 * 40 + 1);
+    std::vector<float> out(41);
+    for (size_t i = 0; i < 40; ++i) {
+        int16_t v = static_cast<int16_t>((i * 2731) - 20000);
+        std::memcpy(in.data() + 1 + i * 2, &v, 2);
+    }
+
+    for (size_t n = 0; n <= 40; ++n) {
+        CAPTURE(n);
+        std::fill(out.begin(), out.end(), 7.0f);
+        pcm16ToFloat(in.data() + 1, out.data(), n);
+
+        bool exact = true;
+        for (size_t i = 0; i < n; ++i) {
+            int16_t v;
+            std::memcpy(&v, in.data() + 1 + i * 2, 2);
+            exact = exact && out[i] == static_cast<float>(v) / 32768.0f;
+        }
+        CHECK(exact);
+        CHECK(out[n] == 7.0f);   // nothing past the last sample is written
+    }
+}
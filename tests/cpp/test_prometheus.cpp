@@ -0,0 +1,180 @@
+/**
+ * C++ tests for the Prometheus exporter (src/prometheus.h / src/prometheus.cpp).
+ *
+ * Test coverage:
+ *   - Clients and event loops register and unregister themselves
+ *   - Per-client media counters, frame age and latency histograms are rendered
+ *   - Label values are escaped; unjoined clients are left out
+ *   - MetricsServer serves GET /metrics and rejects other requests
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "prometheus.h"
+#include "event_loop.h"
+#include "mock_sdk.h"
+
+#include <memory>
+#include <string>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace rtms;
+
+struct R { R() { g_mock_state.reset(); } };
+
+namespace {
+
+bool contains(const std::string& text, const std::string& needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+size_t registeredClients() {
+    size_t count = 0;
+    MetricsRegistry::global().visit([&](const std::vector<const Client*>& clients,
+                                        const std::vector<const EventLoop*>&) { count = clients.size(); });
+    return count;
+}
+
+#ifndef _WIN32
+std::string httpRequest(uint16_t port, const std::string& request) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return "";
+    }
+    ::send(fd, request.data(), request.size(), 0);
+
+    std::string response;
+    char buf[4096];
+    ssize_t n;
+    while ((n = ::recv(fd, buf, sizeof(buf), 0)) > 0) response.append(buf, static_cast<size_t>(n));
+    ::close(fd);
+    return response;
+}
+#endif
+
+} // namespace
+
+// ============================================================================
+// Registry
+// ============================================================================
+
+TEST_CASE("Clients register with MetricsRegistry for their lifetime", "[prometheus]") {
+    R _;
+    size_t before = registeredClients();
+    {
+        Client a;
+        Client b(true);
+        CHECK(registeredClients() == before + 2);
+    }
+    CHECK(registeredClients() == before);
+}
+
+// ============================================================================
+// renderPrometheus()
+// ============================================================================
+
+TEST_CASE("renderPrometheus exports media counters and latency histograms", "[prometheus]") {
+    R _;
+    Client c;
+    c.join("meeting-1", "stream-1", "sig", "url");
+    c.setOnAudioFrame([](const MediaFrameView&) {});
+
+    unsigned char buf[32] = {};
+    rtms_metadata md{};
+    mock_trigger_audio_data(buf, 32, 0, &md);
+    mock_trigger_audio_data(buf, 16, 0, &md);
+    mock_trigger_video_data(nullptr, 8, 0, &md);
+    c.poll();
+    c.recordDropped(ClientMetrics::Media::Video, 3);
+
+    std::string text = renderPrometheus();
+    const std::string labels = "meeting_uuid=\"meeting-1\",stream_id=\"stream-1\"";
+
+    CHECK(contains(text, "# TYPE rtms_media_frames_total counter\n"));
+    CHECK(contains(text, "rtms_media_frames_total{" + labels + ",media=\"audio\"} 2\n"));
+    CHECK(contains(text, "rtms_media_bytes_total{" + labels + ",media=\"audio\"} 48\n"));
+    CHECK(contains(text, "rtms_media_empty_total{" + labels + ",media=\"video\"} 1\n"));
+    CHECK(contains(text, "rtms_media_dropped_total{" + labels + ",media=\"video\"} 3\n"));
+    CHECK(contains(text, "rtms_media_last_frame_age_seconds{" + labels + ",media=\"audio\"} "));
+    CHECK_FALSE(contains(text, "rtms_media_last_frame_age_seconds{" + labels + ",media=\"video\"}"));
+
+    CHECK(contains(text, "# TYPE rtms_poll_duration_seconds histogram\n"));
+    CHECK(contains(text, "rtms_poll_duration_seconds_bucket{" + labels + ",le=\"+Inf\"} 1\n"));
+    CHECK(contains(text, "rtms_poll_duration_seconds_count{" + labels + "} 1\n"));
+    CHECK(contains(text, "rtms_callback_duration_seconds_count{" + labels + ",callback=\"audio\"} 2\n"));
+    CHECK_FALSE(contains(text, "callback=\"video\""));   // never registered
+}
+
+TEST_CASE("renderPrometheus escapes labels and skips clients that have not joined", "[prometheus]") {
+    R _;
+    Client joined;
+    joined.join("a\"b\\c\nd", "s", "sig", "url");
+    Client idle;
+
+    std::string text = renderPrometheus();
+    CHECK(contains(text, "meeting_uuid=\"a\\\"b\\\\c\\nd\""));
+    CHECK(contains(text, "rtms_clients "));
+    CHECK_FALSE(contains(text, "meeting_uuid=\"\""));
+}
+
+TEST_CASE("renderPrometheus reports event loops", "[prometheus][eventloop]") {
+    R _;
+    EventLoop loop(std::chrono::milliseconds(1), "rtms-scrape");
+    auto client = std::make_shared<Client>(true);
+    loop.add(std::make_shared<ClientSession>(client, "u", "s", "sig", "url"));
+
+    std::string text = renderPrometheus();
+    CHECK(contains(text, "rtms_eventloop_clients{loop=\"rtms-scrape\"} 1\n"));
+    CHECK(contains(text, "rtms_eventloop_running{loop=\"rtms-scrape\"} 0\n"));
+    CHECK(contains(text, "rtms_eventloop_polls_total{loop=\"rtms-scrape\"} 0\n"));
+}
+
+// ============================================================================
+// MetricsServer
+// ============================================================================
+
+#ifndef _WIN32
+TEST_CASE("MetricsServer serves GET /metrics on localhost", "[prometheus][server]") {
+    R _;
+    Client c;
+    c.join("served", "s", "sig", "url");
+
+    MetricsServer server("127.0.0.1", 0);
+    server.start();
+    REQUIRE(server.running());
+    REQUIRE(server.port() != 0);
+    REQUIRE_THROWS_AS(server.start(), Exception);
+
+    std::string ok = httpRequest(server.port(), "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    CHECK(contains(ok, "HTTP/1.1 200 OK\r\n"));
+    CHECK(contains(ok, "Content-Type: text/plain; version=0.0.4"));
+    CHECK(contains(ok, "meeting_uuid=\"served\""));
+
+    CHECK(contains(httpRequest(server.port(), "GET /other HTTP/1.1\r\n\r\n"), "HTTP/1.1 404"));
+    CHECK(contains(httpRequest(server.port(), "POST /metrics HTTP/1.1\r\n\r\n"), "HTTP/1.1 405"));
+
+    uint16_t port = server.port();
+    server.stop();
+    CHECK_FALSE(server.running());
+    CHECK(httpRequest(port, "GET /metrics HTTP/1.1\r\n\r\n").empty());
+    server.stop();
+}
+
+TEST_CASE("MetricsServer reports a port that cannot be bound", "[prometheus][server]") {
+    MetricsServer first("127.0.0.1", 0);
+    first.start();
+    MetricsServer second("127.0.0.1", first.port());
+    REQUIRE_THROWS_AS(second.start(), Exception);
+}
+#endif
@@ -0,0 +1,372 @@
+/**
+ * C++ tests for the local fan-out relay (src/relay.h / src/relay.cpp).
+ *
+ * Test coverage:
+ *   - Subscribers get the frames their meeting/user/media filter matches
+ *   - Commands are answered; other commands go to the command handler
+ *   - A subscriber that falls behind has frames dropped and is told how many
+ *   - One that sends commands without reading the replies is disconnected
+ *   - Queued records go out in a few gathering writes
+ *   - Stale socket files are replaced; live ones and bad paths are refused
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "relay.h"
+#include "rtms.h"
+
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace rtms;
+using Media = ClientMetrics::Media;
+
+namespace {
+
+std::string socketPath(const char* tag) {
+    return "/tmp/rtms-relay-test-" + std::to_string(getpid()) + "-" + tag + ".sock";
+}
+
+struct Record {
+    uint8_t media = 0;
+    int user_id = 0;
+    uint64_t timestamp = 0;
+    uint32_t dropped = 0;
+    std::string meeting;
+    std::string payload;
+};
+
+class Subscriber {
+public:
+    explicit Subscriber(const std::string& path) {
+        fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        if (::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd_);
+            throw std::runtime_error("connect failed");
+        }
+    }
+    ~Subscriber() { ::close(fd_); }
+
+    void send(const std::string& line) {
+        std::string data = line + "\n";
+        REQUIRE(::send(fd_, data.data(), data.size(), 0) == static_cast<ssize_t>(data.size()));
+    }
+
+    // Send a command and return the payload of its reply
+    std::string command(const std::string& line) {
+        send(line);
+        Record record;
+        REQUIRE(read(record));
+        REQUIRE(record.media == Relay::kReplyMedia);
+        return record.payload;
+    }
+
+    bool read(Record& record, int timeout_ms = 2000) {
+        uint8_t header[Relay::kRecordHeaderSize];
+        if (!readAll(header, sizeof(header), timeout_ms)) return false;
+        uint32_t size;
+        int32_t user;
+        uint16_t meeting;
+        std::memcpy(&size, header, 4);
+        std::memcpy(&user, header + 4, 4);
+        std::memcpy(&record.timestamp, header + 8, 8);
+        std::memcpy(&meeting, header + 16, 2);
+        std::memcpy(&record.dropped, header + 20, 4);
+        record.media = header[18];
+        record.user_id = user;
+        record.meeting.resize(meeting);
+        record.payload.resize(size);
+        return readAll(record.meeting.data(), meeting, timeout_ms) &&
+               readAll(record.payload.data(), size, timeout_ms);
+    }
+
+private:
+    bool readAll(void* out, size_t size, int timeout_ms) {
+        auto p = static_cast<char*>(out);
+        while (size > 0) {
+            pollfd pfd{fd_, POLLIN, 0};
+            if (::poll(&pfd, 1, timeout_ms) <= 0) return false;
+            ssize_t n = ::recv(fd_, p, size, 0);
+            if (n <= 0) return false;
+            p += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    int fd_;
+};
+
+void publish(Relay& relay, const std::string& meeting, Media media, int user_id, const std::string& payload,
+             uint64_t timestamp = 0) {
+    relay.publish(meeting, media, reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), timestamp,
+                  user_id);
+}
+
+template <typename Predicate>
+bool eventually(Predicate predicate) {
+    for (int i = 0; i < 200; ++i) {
+        if (predicate()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+} // namespace
+
+// ============================================================================
+// Subscriptions
+// ============================================================================
+
+TEST_CASE("Relay delivers frames that match each subscriber's filter", "[relay]") {
+    Relay relay(socketPath("filter"));
+    relay.start();
+    REQUIRE(relay.running());
+
+    Subscriber audio(relay.path());
+    Subscriber user(relay.path());
+    Subscriber idle(relay.path());
+    CHECK(audio.command("SUBSCRIBE meeting=m1 media=audio") == "OK");
+    CHECK(user.command("SUBSCRIBE user=7 media=audio,video") == "OK");
+    CHECK(eventually([&] { return relay.subscribers() == 3; }));
+
+    publish(relay, "m1", Media::Audio, 7, "a");
+    publish(relay, "m1", Media::Video, 8, "b");
+    publish(relay, "m2", Media::Audio, 7, "c", 42);
+    publish(relay, "m1", Media::Transcript, 7, "d");
+
+    Record record;
+    REQUIRE(audio.read(record));
+    CHECK(record.payload == "a");
+    CHECK(record.meeting == "m1");
+    CHECK(record.user_id == 7);
+    CHECK(record.media == static_cast<uint8_t>(Media::Audio));
+    CHECK(record.dropped == 0);
+    CHECK_FALSE(audio.read(record, 100));
+
+    REQUIRE(user.read(record));
+    CHECK(record.payload == "a");
+    REQUIRE(user.read(record));
+    CHECK(record.payload == "c");
+    CHECK(record.meeting == "m2");
+    CHECK(record.timestamp == 42);
+    CHECK_FALSE(user.read(record, 100));
+    CHECK_FALSE(idle.read(record, 100));
+
+    // A new SUBSCRIBE replaces the filter; UNSUBSCRIBE stops frames
+    CHECK(audio.command("SUBSCRIBE media=transcript") == "OK");
+    CHECK(user.command("UNSUBSCRIBE") == "OK");
+    publish(relay, "m3", Media::Transcript, 1, "e");
+    publish(relay, "m3", Media::Audio, 7, "f");
+    REQUIRE(audio.read(record));
+    CHECK(record.payload == "e");
+    CHECK_FALSE(audio.read(record, 100));
+    CHECK_FALSE(user.read(record, 100));
+
+    CHECK(relay.stats().frames == 4);
+}
+
+TEST_CASE("Relay answers bad commands and passes others to the handler", "[relay]") {
+    Relay relay(socketPath("commands"));
+    relay.setOnCommand([](const std::vector<std::string>& words) -> std::string {
+        if (words[0] == "PING") return "OK PONG " + std::to_string(words.size() - 1);
+        throw std::runtime_error("boom");
+    });
+    relay.start();
+
+    Subscriber client(relay.path());
+    CHECK(client.command("PING a b") == "OK PONG 2");
+    CHECK(client.command("JOIN x") == "ERR boom");
+    CHECK(client.command("SUBSCRIBE media=smell").rfind("ERR Unknown media type", 0) == 0);
+    CHECK(client.command("SUBSCRIBE user=seven").rfind("ERR bad user id", 0) == 0);
+    CHECK(client.command("SUBSCRIBE colour=red").rfind("ERR unknown key", 0) == 0);
+    CHECK(client.command("SUBSCRIBE meeting").rfind("ERR expected key=value", 0) == 0);
+
+    // Blank lines are ignored and \r\n is accepted
+    client.send("");
+    CHECK(client.command("PING\r") == "OK PONG 0");
+
+    // Without a handler, unknown commands are refused
+    Relay plain(socketPath("plain"));
+    plain.start();
+    Subscriber other(plain.path());
+    CHECK(other.command("JOIN x") == "ERR unknown command JOIN");
+}
+
+TEST_CASE("Relay forgets subscribers that disconnect", "[relay]") {
+    Relay relay(socketPath("disconnect"));
+    relay.start();
+    {
+        Subscriber client(relay.path());
+        CHECK(client.command("SUBSCRIBE") == "OK");
+        CHECK(relay.subscribers() == 1);
+    }
+    CHECK(eventually([&] { return relay.subscribers() == 0; }));
+    publish(relay, "m", Media::Audio, 1, "x");
+    CHECK(relay.stats().frames == 0);
+}
+
+// ============================================================================
+// Backpressure and batching
+// ============================================================================
+
+TEST_CASE("Relay drops frames for a subscriber that falls behind and reports them", "[relay]") {
+    constexpr int kFrames = 5000;
+    Relay relay(socketPath("slow"), 16 * 1024);
+    relay.start();
+
+    Subscriber slow(relay.path());
+    REQUIRE(slow.command("SUBSCRIBE") == "OK");
+
+    // Far more than the socket buffer and queue hold while nobody reads
+    std::string payload(1000, 'x');
+    for (int i = 0; i < kFrames; ++i) publish(relay, "m", Media::Video, i, payload);
+
+    uint64_t received = 0;
+    uint64_t reported = 0;
+    int last = -1;
+    Record record;
+    while (slow.read(record, 200)) {
+        CHECK(record.user_id > last);
+        last = record.user_id;
+        ++received;
+        reported += record.dropped;
+    }
+    // The next record carries the drops since the last one delivered
+    publish(relay, "m", Media::Video, kFrames, "end");
+    REQUIRE(slow.read(record));
+    CHECK(record.payload == "end");
+    reported += record.dropped;
+
+    CHECK(received > 0);
+    CHECK(reported > 0);
+    CHECK(received + reported == kFrames);
+    CHECK(relay.stats().dropped == reported);
+}
+
+TEST_CASE("Relay disconnects a subscriber that does not read its replies", "[relay]") {
+    constexpr int kCommands = 100;
+    const std::string big(64 * 1024, 'r');
+    Relay relay(socketPath("replies"), 256 * 1024);
+    relay.setOnCommand([&big](const std::vector<std::string>&) -> std::string { return "OK " + big; });
+    relay.start();
+
+    Subscriber reader(relay.path());
+    Subscriber greedy(relay.path());
+    REQUIRE(reader.command("SUBSCRIBE") == "OK");
+    CHECK(eventually([&] { return relay.subscribers() == 2; }));
+
+    // Far more reply bytes than the socket buffer and queue_bytes hold
+    std::string commands;
+    for (int i = 0; i < kCommands; ++i) commands += "BIG\n";
+    greedy.send(commands.substr(0, commands.size() - 1));
+    CHECK(eventually([&] { return relay.subscribers() == 1; }));
+
+    int replies = 0;
+    Record record;
+    while (greedy.read(record, 200)) {
+        CHECK(record.payload.size() == big.size() + 3);
+        ++replies;
+    }
+    CHECK(replies < kCommands);
+
+    // Everyone else is unaffected
+    publish(relay, "m", Media::Audio, 1, "x");
+    REQUIRE(reader.read(record));
+    CHECK(record.payload == "x");
+}
+
+TEST_CASE("Relay sends queued records in a few gathering writes", "[relay]") {
+    constexpr int kFrames = 100;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    Relay relay(socketPath("batch"));
+    relay.setOnCommand([released](const std::vector<std::string>&) -> std::string {
+        released.wait();   // holds the relay thread while frames queue up
+        return "OK";
+    });
+    relay.start();
+
+    Subscriber reader(relay.path());
+    Subscriber control(relay.path());
+    REQUIRE(reader.command("SUBSCRIBE") == "OK");
+    uint64_t writes = relay.stats().writes;
+
+    control.send("HOLD");
+    // Give the relay thread time to reach the handler
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    for (int i = 0; i < kFrames; ++i) publish(relay, "m", Media::Audio, i, std::string(160, 'a'));
+    release.set_value();
+
+    Record record;
+    for (int i = 0; i < kFrames; ++i) {
+        REQUIRE(reader.read(record));
+        CHECK(record.user_id == i);
+    }
+    // 32 records per call at most, plus the reply to HOLD
+    CHECK(relay.stats().writes - writes <= 6);
+    CHECK(relay.stats().bytes >= kFrames * (Relay::kRecordHeaderSize + 1 + 160));
+}
+
+// ============================================================================
+// Socket lifecycle
+// ============================================================================
+
+TEST_CASE("Relay replaces stale sockets and refuses live ones and bad paths", "[relay]") {
+    std::string path = socketPath("lifecycle");
+    {
+        Relay first(path);
+        first.start();
+        REQUIRE_THROWS_AS(first.start(), Exception);
+
+        Relay second(path);
+        REQUIRE_THROWS_AS(second.start(), Exception);
+        CHECK(first.running());
+        CHECK(::access(path.c_str(), F_OK) == 0);
+    }
+    CHECK(::access(path.c_str(), F_OK) != 0);
+
+    // A socket file whose listener is gone is replaced
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    REQUIRE(::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    ::close(fd);
+    {
+        Relay relay(path);
+        REQUIRE_NOTHROW(relay.start());
+        Subscriber client(path);
+        CHECK(client.command("UNSUBSCRIBE") == "OK");
+        relay.stop();
+        relay.stop();
+        CHECK_FALSE(relay.running());
+    }
+
+    // A file that is not a socket is left alone
+    FILE* file = std::fopen(path.c_str(), "w");
+    REQUIRE(file);
+    std::fclose(file);
+    REQUIRE_THROWS_AS(Relay(path).start(), Exception);
+    CHECK(::access(path.c_str(), F_OK) == 0);
+    ::unlink(path.c_str());
+
+    REQUIRE_THROWS_AS(Relay("").start(), std::invalid_argument);
+    REQUIRE_THROWS_AS(Relay("/tmp/" + std::string(200, 'r')).start(), std::invalid_argument);
+}
+
+#endif // _WIN32
@@ -0,0 +1,317 @@
+/**
+ * C++ unit tests for the shared frame ring (src/shared_ring.h / src/shared_ring.cpp).
+ *
+ * Test coverage:
+ *   - Frames are read back in order with their user id, timestamp and sequence
+ *   - Records skip the tail of the data area instead of straddling it
+ *   - A lapped reader resynchronises at the writer and counts it
+ *   - Frames a lapped reader missed are counted from the sequence gap
+ *   - peek() reads in place; consume() reports a frame overwritten during use
+ *   - wait() returns when a frame is written or the ring closes
+ *   - Oversized frames are dropped and counted in the header
+ *   - Size, alignment and format validation; close() is visible to readers
+ *   - One writer and several concurrent readers see intact frames in order
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shared_ring.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace rtms;
+
+namespace {
+
+constexpr size_t kCapacity = 4096;
+
+// 8-byte aligned backing memory, as a SharedArrayBuffer would be
+struct Memory {
+    std::vector<uint64_t> words;
+    explicit Memory(size_t bytes) : words((bytes + 7) / 8) {}
+    void* data() { return words.data(); }
+    uint32_t header(SharedRing::Field field) const {
+        uint32_t value;
+        std::memcpy(&value, reinterpret_cast<const uint8_t*>(words.data()) + field * 4, 4);
+        return value;
+    }
+};
+
+std::vector<uint8_t> payload(size_t size, uint8_t seed) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) data[i] = static_cast<uint8_t>(seed + i);
+    return data;
+}
+
+} // namespace
+
+// ============================================================================
+// Reading and writing
+// ============================================================================
+
+TEST_CASE("SharedRing frames are read back in order", "[shared_ring]") {
+    Memory memory(SharedRing::bytesFor(kCapacity));
+    SharedRing ring(memory.data(), SharedRing::bytesFor(kCapacity));
+    SharedRing::Reader reader(memory.data(), SharedRing::bytesFor(kCapacity));
+
+    SharedRing::Reader::Frame frame;
+    CHECK_FALSE(reader.next(frame));
+
+    auto first = payload(5, 1);
+    auto second = payload(0, 0);
+    REQUIRE(ring.write(first.data(), first.size(), 1700000000123ULL, 16778240));
+    REQUIRE(ring.write(second.data(), second.size(), 7, -1));
+
+    REQUIRE(reader.next(frame));
+    CHECK(frame.data == first);
+    CHECK(frame.user_id == 16778240);
+    CHECK(frame.timestamp == 1700000000123ULL);
+    CHECK(frame.sequence == 0);
+
+    REQUIRE(reader.next(frame));
+    CHECK(frame.data.empty());
+    CHECK(frame.user_id == -1);
+    CHECK(frame.sequence == 1);
+    CHECK_FALSE(reader.next(frame));
+    CHECK(reader.lost() == 0);
+
+    CHECK(ring.written() == 2);
+    CHECK(memory.header(SharedRing::Magic) == SharedRing::kMagic);
+    CHECK(memory.header(SharedRing::Capacity) == kCapacity);
+    CHECK(memory.header(SharedRing::Commit) == SharedRing::recordSize(5) + SharedRing::recordSize(0));
+}
+
+TEST_CASE("SharedRing records skip the tail instead of straddling the end", "[shared_ring]") {
+    Memory memory(SharedRing::bytesFor(kCapacity));
+    SharedRing ring(memory.data(), SharedRing::bytesFor(kCapacity));
+    SharedRing::Reader reader(memory.data(), SharedRing::bytesFor(kCapacity));
+
+    // 990-byte frames take 1016 bytes; the fifth cannot fit in what is left
+    SharedRing::Reader::Frame frame;
+    for (uint8_t i = 0; i < 12; ++i) {
+        auto data = payload(990, i);
+        REQUIRE(ring.write(data.data(), data.size(), i, i));
+        REQUIRE(reader.next(frame));
+        CHECK(frame.data == data);
+        CHECK(frame.timestamp == i);
+    }
+    CHECK(reader.lapped() == 0);
+    CHECK(memory.header(SharedRing::Commit) > 2 * kCapacity);
+}
+
+TEST_CASE("SharedRing reader that falls a ring behind skips to the writer", "[shared_ring]") {
+    Memory memory(SharedRing::bytesFor(kCapacity));
+    SharedRing ring(memory.data(), SharedRing::bytesFor(kCapacity));
+    SharedRing::Reader reader(memory.data(), SharedRing::bytesFor(kCapacity));
+
+    auto data = payload(500, 0);
+    for (int i = 0; i < 20; ++i) ring.write(data.data(), data.size(), i, 1);
+
+    SharedRing::Reader::Frame frame;
+    CHECK_FALSE(reader.next(frame));
+    CHECK(reader.lapped() == 1);
+
+    ring.write(data.data(), data.size(), 99, 1);
+    REQUIRE(reader.next(frame));
+    CHECK(frame.timestamp == 99);
+    CHECK(frame.sequence == 20);
+}
+
+TEST_CASE("SharedRing reader counts the frames it missed", "[shared_ring]") {
+    Memory memory(SharedRing::bytesFor(kCapacity));
+    SharedRing ring(memory.data(), SharedRing::bytesFor(kCapacity));
+    SharedRing::Reader reader(memory.data(), SharedRing::bytesFor(kCapacity));
+
+    // 500-byte frames take 528 bytes, so seven fit in the ring
+    auto data = payload(500, 0);
+    SharedRing::Reader::Frame frame;
+    ring.write(data.data(), data.size(), 0, 1);
+    REQUIRE(reader.next(frame));
+
+    for (int i = 1; i <= 20; ++i) ring.write(data.data(), data.size(), i, 1);
+    CHECK_FALSE(reader.next(frame));
+    CHECK(reader.lapped() == 1);
+
+    ring.write(data.data(), data.size(), 21, 1);
+    REQUIRE(reader.next(frame));
+    CHECK(frame.sequence == 21);
+    CHECK(reader.lost() == 20);
+}
+
+TEST_CASE("SharedRing::Reader::peek() reads in place until consumed", "[shared_ring]") {
+    Memory memory(SharedRing::bytesFor(kCapacity));
+    SharedRing ring(memory.data(), SharedRing::bytesFor(kCapacity));
+    SharedRing::Reader reader(memory.data(), SharedRing::bytesFor(kCapacity));
+
+    auto data = payload(500, 3);
+    ring.write(data.data(), data.size(), 10, 7);
+    ring.write(data.data(), data.size(), 11, 7);
+
+    SharedRing::Reader::View view;
+    REQUIRE(reader.peek(view));
+    CHECK(view.data == static_cast<const uint8_t*>(memory.data()) + SharedRing::kHeaderSize +
+                       SharedRing::kRecordHeaderSize);
+    CHECK(std::vector<uint8_t>(view.data, view.data + view.size) == data);
+    CHECK(view.sequence == 0);
+    CHECK(view.user_id == 7);
+
+    // Peeking again without consuming sees the same frame
+    REQUIRE(reader.peek(view));
+    CHECK(view.timestamp == 10);
+    CHECK(reader.consume());
+    CHECK_FALSE(reader.consume());   // nothing peeked
+
+    REQUIRE(reader.peek(view));
+    CHECK(view.timestamp == 11);
+
+    // The writer laps the frame while it is in use
+    for (int i = 0; i < 8; ++i) ring.write(data.data(), data.size(), 20 + i, 7);
+    CHECK_FALSE(reader.consume());
+    CHECK(reader.lapped() == 1);
+
+    ring.write(data.data(), data.size(), 30, 7);
+    REQUIRE(reader.peek(view));
+    CHECK(view.timestamp == 30);
+    CHECK(reader.consume());
+    CHECK(reader.lost() == 9);   // the lapped frame and the eight that overwrote it
+}
+
+TEST_CASE("SharedRing::Reader::wait() wakes for a write and for close()", "[shared_ring]") {
+    Memory memory(SharedRing::bytesFor(kCapacity));
+    SharedRing ring(memory.data(), SharedRing::bytesFor(kCapacity));
+    SharedRing::Reader reader(memory.data(), SharedRing::bytesFor(kCapacity));
+    using namespace std::chrono;
+
+    CHECK_FALSE(reader.wait(milliseconds(5)));
+
+    uint8_t byte = 1;
+    std::thread writer([&] {
+        std::this_thread::sleep_for(milliseconds(20));
+        ring.write(&byte, 1, 0, 0);
+    });
+    auto start = steady_clock::now();
+    CHECK(reader.wait(seconds(10)));
+    CHECK(steady_clock::now() - start < seconds(5));
+    writer.join();
+    CHECK(memory.header(SharedRing::Waiters) == 0);
+
+    SharedRing::Reader::Frame frame;
+    REQUIRE(reader.next(frame));
+    std::thread closer([&] {
+        std::this_thread::sleep_for(milliseconds(20));
+        ring.close();
+    });
+    CHECK(reader.wait(seconds(10)));
+    CHECK(reader.closed());
+    closer.join();
+}
+
+TEST_CASE("SharedRing drops frames larger than the ring", "[shared_ring]") {
+    Memory memory(SharedRing::bytesFor(kCapacity));
+    SharedRing ring(memory.data(), SharedRing::bytesFor(kCapacity));
+
+    auto big = payload(kCapacity, 0);
+    CHECK_FALSE(ring.write(big.data(), big.size(), 0, 1));
+    CHECK(memory.header(SharedRing::Dropped) == 1);
+    CHECK(memory.header(SharedRing::Commit) == 0);
+
+    auto fits = payload(kCapacity - SharedRing::kRecordHeaderSize, 0);
+    CHECK(ring.write(fits.data(), fits.size(), 0, 1));
+}
+
+// ============================================================================
+// Validation
+// ============================================================================
+
+TEST_CASE("SharedRing validates its memory", "[shared_ring]") {
+    Memory memory(SharedRing::bytesFor(2 * kCapacity) + 8);
+
+    REQUIRE_THROWS_AS(SharedRing(memory.data(), SharedRing::bytesFor(3000)), std::invalid_argument);
+    REQUIRE_THROWS_AS(SharedRing(memory.data(), SharedRing::bytesFor(2048)), std::invalid_argument);
+    REQUIRE_THROWS_AS(SharedRing(static_cast<uint8_t*>(memory.data()) + 4, SharedRing::bytesFor(kCapacity)),
+                      std::invalid_argument);
+
+    // A reader needs a formatted ring of the same size
+    REQUIRE_THROWS_AS(SharedRing::Reader(memory.data(), SharedRing::bytesFor(kCapacity)), std::invalid_argument);
+    SharedRing ring(memory.data(), SharedRing::bytesFor(kCapacity));
+    REQUIRE_THROWS_AS(SharedRing::Reader(memory.data(), SharedRing::bytesFor(2 * kCapacity)), std::invalid_argument);
+    CHECK_NOTHROW(SharedRing::Reader(memory.data(), SharedRing::bytesFor(kCapacity)));
+}
+
+TEST_CASE("SharedRing::close() stops writes and tells readers", "[shared_ring]") {
+    Memory memory(SharedRing::bytesFor(kCapacity));
+    SharedRing ring(memory.data(), SharedRing::bytesFor(kCapacity));
+    SharedRing::Reader reader(memory.data(), SharedRing::bytesFor(kCapacity));
+    uint8_t byte = 1;
+    CHECK(ring.write(&byte, 1, 0, 0));
+    CHECK_FALSE(reader.closed());
+
+    ring.close();
+    CHECK(reader.closed());
+    CHECK_FALSE(ring.write(&byte, 1, 0, 0));
+    CHECK(ring.written() == 1);
+
+    SharedRing::Reader::Frame frame;
+    CHECK(reader.next(frame));   // written before close()
+    CHECK_FALSE(reader.next(frame));
+}
+
+// ============================================================================
+// Concurrency
+// ============================================================================
+
+TEST_CASE("SharedRing readers on other threads see intact frames in order", "[shared_ring]") {
+    constexpr size_t kBytes = SharedRing::bytesFor(64 * 1024);
+    constexpr uint64_t kFrames = 20000;
+    Memory memory(kBytes);
+    SharedRing ring(memory.data(), kBytes);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> ready{0};
+    auto read = [&](uint64_t& received, bool& ordered, bool& intact) {
+        SharedRing::Reader reader(memory.data(), kBytes);
+        SharedRing::Reader::Frame frame;
+        ++ready;
+        uint64_t last = 0;
+        for (;;) {
+            bool finished = done.load();
+            while (reader.next(frame)) {
+                ++received;
+                ordered = ordered && frame.timestamp > last;
+                last = frame.timestamp;
+                intact = intact && frame.data == payload(frame.data.size(), static_cast<uint8_t>(frame.timestamp));
+            }
+            if (finished) return;
+        }
+    };
+
+    uint64_t received[2] = {0, 0};
+    bool ordered[2] = {true, true};
+    bool intact[2] = {true, true};
+    std::thread a(read, std::ref(received[0]), std::ref(ordered[0]), std::ref(intact[0]));
+    std::thread b(read, std::ref(received[1]), std::ref(ordered[1]), std::ref(intact[1]));
+
+    while (ready < 2) std::this_thread::yield();
+    for (uint64_t i = 1; i <= kFrames; ++i) {
+        auto data = payload(16 + i % 700, static_cast<uint8_t>(i));
+        ring.write(data.data(), data.size(), i, static_cast<int>(i % 30));
+        // Roughly media pace, so readers are not lapped on every frame
+        if (i % 16 == 0) std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+    done = true;
+    a.join();
+    b.join();
+
+    for (int r = 0; r < 2; ++r) {
+        CAPTURE(r);
+        CHECK(received[r] > 0);
+        CHECK(received[r] <= kFrames);
+        CHECK(ordered[r]);
+        CHECK(intact[r]);
+    }
+}
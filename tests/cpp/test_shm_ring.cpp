@@ -0,0 +1,173 @@
+/**
+ * C++ unit tests for shared-memory rings (src/shm_ring.h / src/shm_ring.cpp).
+ *
+ * Test coverage:
+ *   - A reader attached by name sees frames written after it attached
+ *   - Names are validated, taken names are refused, and the writer unlinks
+ *   - nameFor() builds a safe per-stream, per-media name
+ *   - A forked reader process reads every frame in order, or counts what it lost
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_ring.h"
+#include "rtms.h"
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace rtms;
+
+namespace {
+
+constexpr size_t kCapacity = 64 * 1024;
+
+// Unique per test process, so parallel test runs do not collide
+std::string uniqueName(const char* tag) {
+    return "/rtms-test-" + std::to_string(getpid()) + "-" + tag;
+}
+
+} // namespace
+
+// ============================================================================
+// Attaching
+// ============================================================================
+
+TEST_CASE("ShmRing::Reader attaches by name and reads frames in order", "[shm_ring]") {
+    ShmRing ring(uniqueName("attach"), kCapacity);
+    ShmRing::Reader reader(ring.name());
+    CHECK(reader.name() == ring.name());
+
+    std::vector<uint8_t> data = {1, 2, 3, 4, 5};
+    REQUIRE(ring.write(data.data(), data.size(), 1000, 42));
+    REQUIRE(ring.write(data.data(), 2, 1001, 43));
+
+    SharedRing::Reader::View view;
+    REQUIRE(reader.peek(view));
+    CHECK(std::vector<uint8_t>(view.data, view.data + view.size) == data);
+    CHECK(view.user_id == 42);
+    CHECK(view.sequence == 0);
+    CHECK(reader.consume());
+
+    SharedRing::Reader::Frame frame;
+    REQUIRE(reader.next(frame));
+    CHECK(frame.data.size() == 2);
+    CHECK(frame.sequence == 1);
+    CHECK_FALSE(reader.next(frame));
+
+    ring.close();
+    CHECK(reader.closed());
+}
+
+TEST_CASE("ShmRing validates names and owns its segment", "[shm_ring]") {
+    REQUIRE_THROWS_AS(ShmRing("no-slash", kCapacity), std::invalid_argument);
+    REQUIRE_THROWS_AS(ShmRing("/a/b", kCapacity), std::invalid_argument);
+    REQUIRE_THROWS_AS(ShmRing::Reader(uniqueName("missing")), Exception);
+
+    std::string name = uniqueName("owner");
+    auto ring = std::make_unique<ShmRing>(name, kCapacity);
+    REQUIRE_THROWS_AS(ShmRing(name, kCapacity), Exception);
+
+    // A reader keeps its mapping after the writer goes away
+    ShmRing::Reader reader(name);
+    uint8_t byte = 9;
+    ring->write(&byte, 1, 0, 0);
+    ring.reset();
+    REQUIRE_THROWS_AS(ShmRing::Reader(name), Exception);
+
+    SharedRing::Reader::Frame frame;
+    REQUIRE(reader.next(frame));
+    CHECK(frame.data == std::vector<uint8_t>{9});
+    CHECK(reader.closed());
+
+    // A bad capacity leaves no segment behind
+    REQUIRE_THROWS_AS(ShmRing(name, 3000), std::invalid_argument);
+    REQUIRE_THROWS_AS(ShmRing::Reader(name), Exception);
+}
+
+TEST_CASE("ShmRing::nameFor() gives one safe name per stream and media", "[shm_ring]") {
+    CHECK(ShmRing::nameFor("a1B2-c_d", ClientMetrics::Media::Audio) == "/rtms-a1B2-c_d-audio");
+    CHECK(ShmRing::nameFor("ab/c+d==", ClientMetrics::Media::Video) == "/rtms-ab_c_d__-video");
+    CHECK(ShmRing::nameFor("x", ClientMetrics::Media::Transcript) == "/rtms-x-transcript");
+}
+
+// ============================================================================
+// Across processes
+// ============================================================================
+
+TEST_CASE("ShmRing frames reach a reader in another process", "[shm_ring]") {
+    constexpr int kFrames = 5000;
+    ShmRing ring(uniqueName("fork"), kCapacity);
+
+    // The child attaches by name, reads until the ring closes, and reports
+    // through its exit status: 0 if every frame it consumed was intact and
+    // in sequence order, and every frame after the first was either read or
+    // counted as lost
+    int ready[2];
+    REQUIRE(pipe(ready) == 0);
+    pid_t child = fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        int status = 1;
+        try {
+            ShmRing::Reader reader(ring.name());
+            char byte = 0;
+            if (write(ready[1], &byte, 1) != 1) _exit(3);
+
+            uint64_t consumed = 0;
+            uint64_t first = 0;
+            uint64_t next = 0;
+            bool good = true;
+            SharedRing::Reader::View view;
+            for (;;) {
+                bool closed = reader.closed();
+                while (reader.peek(view)) {
+                    bool intact = view.size == 64 + view.sequence % 512 && view.user_id == int(view.sequence % 30);
+                    for (size_t i = 0; intact && i < view.size; ++i) {
+                        intact = view.data[i] == static_cast<uint8_t>(view.sequence + i);
+                    }
+                    if (!reader.consume()) continue;   // overwritten while checked; discarded
+                    if (consumed == 0) first = view.sequence;
+                    good = good && intact && view.sequence >= next;
+                    next = view.sequence + 1;
+                    ++consumed;
+                }
+                if (closed) break;
+                reader.wait(std::chrono::milliseconds(100));
+            }
+            good = good && consumed > 0 && next == kFrames && first + consumed + reader.lost() == kFrames;
+            status = good ? 0 : 2;
+        } catch (...) {
+            status = 4;
+        }
+        _exit(status);
+    }
+
+    char byte;
+    REQUIRE(read(ready[0], &byte, 1) == 1);
+    close(ready[0]);
+    close(ready[1]);
+
+    std::vector<uint8_t> data(64 + 512);
+    for (int n = 0; n < kFrames; ++n) {
+        size_t size = 64 + n % 512;
+        for (size_t i = 0; i < size; ++i) data[i] = static_cast<uint8_t>(n + i);
+        ring.write(data.data(), size, n, n % 30);
+        if (n % 32 == 0) usleep(50);
+    }
+    ring.close();
+
+    int status = 0;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    CHECK(WEXITSTATUS(status) == 0);
+}
+
+#endif // _WIN32
@@ -0,0 +1,128 @@
+/**
+ * C++ tests for hot-path tracing (src/trace.h / src/trace.cpp).
+ *
+ * Test coverage:
+ *   - Without RTMS_TRACE the macros compile away and the trace is empty
+ *   - Sink, poll, join and config spans are recorded as begin/end pairs
+ *   - Each thread writes its own ring; the oldest events are overwritten
+ *   - clear() and writeChromeJson()
+ *
+ * Build with -DRTMS_TRACE=ON to run the recording tests.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "trace.h"
+#include "rtms.h"
+#include "mock_sdk.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace rtms;
+
+struct R { R() { g_mock_state.reset(); trace::clear(); } };
+
+#ifndef RTMS_TRACE
+
+TEST_CASE("Tracing compiles away without RTMS_TRACE", "[trace]") {
+    R _;
+    STATIC_REQUIRE_FALSE(trace::enabled());
+    RTMS_TRACE_SCOPE("unused");
+    RTMS_TRACE_BEGIN("unused");
+    RTMS_TRACE_END("unused");
+    CHECK(trace::chromeJson().find("\"ph\"") == std::string::npos);
+}
+
+#else
+
+namespace {
+
+size_t countOf(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) ++count;
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("Client records sink, poll, join and config spans", "[trace]") {
+    R _;
+    Client c;
+    c.setOnAudioFrame([](const MediaFrameView&) {});
+    c.join("u", "s", "sig", "url");
+
+    unsigned char buf[] = {0x01};
+    rtms_metadata md{};
+    g_mock_state.on_poll = [&] { mock_trigger_audio_data(buf, 1, 0, &md); };
+    c.poll();
+
+    std::string json = trace::chromeJson();
+    for (const char* name : {"sdk.join", "sdk.config", "sdk.poll", "sink.audio"}) {
+        CAPTURE(name);
+        std::string key = std::string("{\"name\":\"") + name + "\",\"cat\":\"rtms\",\"ph\":";
+        CHECK(countOf(json, key + "\"B\"") == 1);
+        CHECK(countOf(json, key + "\"E\"") == 1);
+    }
+
+    // The sink runs inside poll()
+    CHECK(json.find("\"sdk.poll\",\"cat\":\"rtms\",\"ph\":\"B\"") <
+          json.find("\"sink.audio\",\"cat\":\"rtms\",\"ph\":\"B\""));
+    CHECK(json.find("\"sink.audio\",\"cat\":\"rtms\",\"ph\":\"E\"") <
+          json.find("\"sdk.poll\",\"cat\":\"rtms\",\"ph\":\"E\""));
+}
+
+TEST_CASE("Each thread records into its own ring", "[trace]") {
+    R _;
+    std::thread other([] {
+        RTMS_TRACE_SCOPE("test.other_thread");
+    });
+    other.join();
+    {
+        RTMS_TRACE_SCOPE("test.this_thread");
+    }
+
+    std::string json = trace::chromeJson();
+    auto tidOf = [&](const std::string& name) {
+        size_t at = json.find("\"" + name + "\"");
+        size_t tid = json.find("\"tid\":", at);
+        return json.substr(tid, json.find('}', tid) - tid);
+    };
+    CHECK(tidOf("test.other_thread") != tidOf("test.this_thread"));
+    CHECK(countOf(json, "\"ph\":\"M\"") >= 2);   // thread_name metadata
+}
+
+TEST_CASE("A full ring keeps the newest events", "[trace]") {
+    R _;
+    for (size_t i = 0; i < trace::kRingCapacity; ++i) RTMS_TRACE_BEGIN("test.old");
+    for (size_t i = 0; i < 10; ++i) RTMS_TRACE_BEGIN("test.new");
+
+    std::string json = trace::chromeJson();
+    CHECK(countOf(json, "\"test.new\"") == 10);
+    CHECK(countOf(json, "\"test.old\"") < trace::kRingCapacity);
+}
+
+TEST_CASE("clear() discards events and writeChromeJson() writes a file", "[trace]") {
+    R _;
+    RTMS_TRACE_BEGIN("test.cleared");
+    trace::clear();
+    RTMS_TRACE_BEGIN("test.kept");
+
+    std::string path = "rtms_trace_test.json";
+    trace::writeChromeJson(path);
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::remove(path.c_str());
+
+    CHECK(contents.str().find("\"test.cleared\"") == std::string::npos);
+    CHECK(contents.str().find("\"test.kept\"") != std::string::npos);
+    CHECK(contents.str().rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) == 0);
+
+    REQUIRE_THROWS_AS(trace::writeChromeJson("/nonexistent-dir/trace.json"), Exception);
+}
+
+#endif // RTMS_TRACE
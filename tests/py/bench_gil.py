@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""
+GIL benchmark for the Python binding's per-frame and batch callbacks.
+
+Joins a live RTMS stream once per phase, alternating between per-frame
+callbacks (on_audio_data / on_video_data) and batch callbacks
+(on_audio_batch / on_video_batch), and samples rtms.gil_acquisitions() and
+the frames received once a second. Phases alternate on the same stream so
+they see comparable traffic; acquisitions per frame absorbs what differs.
+
+The mock SDK only drives the C++ tests, so this needs a real meeting: set
+ZM_RTMS_CLIENT and ZM_RTMS_SECRET, point the app's webhook at this process,
+and start RTMS in a meeting with people talking and video on. Results are
+printed and, with --out, written as JSON so runs can be compared:
+
+    python tests/py/bench_gil.py [--seconds 30] [--rounds 2] [--port 8080]
+                                 [--path /] [--out results.json]
+"""
+
+import argparse
+import json
+import sys
+import threading
+import time
+
+import rtms
+
+MODES = ('frame', 'batch')
+
+# How long a phase waits for its first frame after join() before giving up
+FIRST_FRAME_TIMEOUT = 30.0
+
+# Pause between leaving one phase and joining the next
+REJOIN_DELAY = 2.0
+
+
+class Counter:
+    """Frames received by a phase's callbacks, which run under the GIL."""
+
+    def __init__(self):
+        self.frames = 0
+
+    def on_frame(self, *args):
+        self.frames += 1
+
+    def on_batch(self, frames):
+        self.frames += len(frames)
+
+
+def measure(join_payload, mode, seconds):
+    """Join with one callback mode and sample GIL acquisitions for `seconds`."""
+    counter = Counter()
+    client = rtms.Client()
+    if mode == 'frame':
+        client.on_audio_data(counter.on_frame)
+        client.on_video_data(counter.on_frame)
+    else:
+        client.on_audio_batch(counter.on_batch)
+        client.on_video_batch(counter.on_batch)
+    client.join(join_payload)
+
+    try:
+        deadline = time.monotonic() + FIRST_FRAME_TIMEOUT
+        while counter.frames == 0:
+            if time.monotonic() > deadline:
+                raise RuntimeError(f'{mode}: no frames within {FIRST_FRAME_TIMEOUT:.0f} s of join()')
+            time.sleep(0.1)
+
+        per_second = []
+        start = time.monotonic()
+        start_acquisitions, start_frames = rtms.gil_acquisitions(), counter.frames
+        last_acquisitions, last_frames = start_acquisitions, start_frames
+        for i in range(1, seconds + 1):
+            time.sleep(max(0.0, start + i - time.monotonic()))
+            acquisitions, frames = rtms.gil_acquisitions(), counter.frames
+            per_second.append({'acquisitions': acquisitions - last_acquisitions,
+                               'frames': frames - last_frames})
+            last_acquisitions, last_frames = acquisitions, frames
+        elapsed = time.monotonic() - start
+    finally:
+        client.leave()
+
+    acquisitions = last_acquisitions - start_acquisitions
+    frames = last_frames - start_frames
+    return {
+        'mode': mode,
+        'seconds': elapsed,
+        'frames': frames,
+        'acquisitions': acquisitions,
+        'acquisitions_per_sec': acquisitions / elapsed,
+        'frames_per_sec': frames / elapsed,
+        'acquisitions_per_frame': acquisitions / frames if frames else None,
+        'per_second': per_second,
+    }
+
+
+def run_phases(join_payload, options):
+    """Alternate the modes for `options.rounds` rounds, then stop rtms.run()."""
+    phases = []
+    try:
+        for round_index in range(options.rounds):
+            for mode in MODES:
+                if phases:
+                    time.sleep(REJOIN_DELAY)
+                result = measure(join_payload, mode, options.seconds)
+                result['round'] = round_index
+                phases.append(result)
+                per_frame = result['acquisitions_per_frame']
+                per_frame = f'{per_frame:.3f}' if per_frame is not None else 'n/a'
+                print(f"{mode}[{round_index}]: {result['acquisitions_per_sec']:.1f} GIL acquisitions/s, "
+                      f"{result['frames_per_sec']:.1f} frames/s, {per_frame} per frame", flush=True)
+    except Exception as e:
+        print(f'bench_gil: {e}', file=sys.stderr)
+    finally:
+        if options.out and phases:
+            with open(options.out, 'w') as f:
+                json.dump({'benchmark': 'bench_gil', 'schema': 1,
+                           'seconds_per_phase': options.seconds, 'phases': phases}, f, indent=2)
+        rtms.stop()
+
+
+def parse_args(argv):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('--seconds', type=int, default=30, help='length of each phase (default 30)')
+    parser.add_argument('--rounds', type=int, default=2, help='frame/batch phase pairs to run (default 2)')
+    parser.add_argument('--port', type=int, default=None, help='webhook port (default ZM_RTMS_PORT or 8080)')
+    parser.add_argument('--path', default=None, help="webhook path (default ZM_RTMS_PATH or '/')")
+    parser.add_argument('--out', default=None, help='write the phases as JSON to this file')
+    return parser.parse_args(argv)
+
+
+def main(argv=None):
+    options = parse_args(argv)
+    started = threading.Event()
+
+    @rtms.on_webhook_event(port=options.port, path=options.path)
+    def handle_webhook(payload):
+        # Benchmark the first stream to start; later ones are ignored
+        if 'rtms_started' not in payload.get('event', '') or started.is_set():
+            return
+        started.set()
+        threading.Thread(target=run_phases, args=(payload['payload'], options),
+                         name='bench-gil', daemon=True).start()
+
+    print('bench_gil: waiting for an rtms_started webhook', flush=True)
+    rtms.run()
+
+
+if __name__ == '__main__':
+    main()
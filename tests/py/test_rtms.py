@@ -5,6 +5,8 @@ Comprehensive test suite for Python RTMS SDK
 Mirrors the Node.js test coverage in tests/rtms.test.ts
 """
 
+import os
+import sys
 import pytest
 import rtms
 from unittest.mock import Mock, patch, MagicMock
@@ -306,6 +308,101 @@ class TestDataClasses:
         """Test Metadata class exists"""
         assert hasattr(rtms, 'Metadata')
 
+    def test_frame_class_exists(self):
+        """Test Frame is exported with the buffer and release API"""
+        assert 'Frame' in rtms.__all__
+        for name in ('release', 'released', 'tobytes', '__bytes__', '__len__', '__enter__', '__exit__'):
+            assert hasattr(rtms.Frame, name)
+
+    def test_frame_not_constructible(self):
+        """Frames only come from media callbacks"""
+        with pytest.raises(TypeError):
+            rtms.Frame()
+
+
+class TestFrameBuffer:
+    """Tests Frame's buffer protocol and release() over native memory"""
+
+    @staticmethod
+    def make(data=b'\x01\x00\x02\x00\x03\x00', timestamp=7, user_id=42):
+        from rtms._rtms import _frame_from_bytes
+        return _frame_from_bytes(data, timestamp, user_id)
+
+    def test_properties(self):
+        frame = self.make()
+        assert len(frame) == 6
+        assert bytes(frame) == b'\x01\x00\x02\x00\x03\x00'
+        assert frame.tobytes() == bytes(frame)
+        assert frame.timestamp == 7
+        assert frame.metadata.userId == 42
+        assert frame.sequence is None
+        assert not frame.released
+        assert repr(frame) == '<rtms.Frame 6 bytes>'
+
+    def test_memoryview_is_read_only(self):
+        frame = self.make()
+        view = memoryview(frame)
+        assert view.readonly
+        assert view.nbytes == 6
+        assert view.tobytes() == bytes(frame)
+        with pytest.raises(TypeError):
+            view[0] = 9
+        view.release()
+
+    def test_numpy_frombuffer(self):
+        np = pytest.importorskip('numpy')
+        frame = self.make()
+        samples = np.frombuffer(frame, dtype=np.int16)
+        assert samples.tolist() == [1, 2, 3]
+        assert not samples.flags.writeable
+        with pytest.raises(BufferError):
+            frame.release()
+        del samples
+        frame.release()
+        assert frame.released
+
+    def test_release_refused_while_a_view_is_alive(self):
+        frame = self.make()
+        view = memoryview(frame)
+        with pytest.raises(BufferError):
+            frame.release()
+        assert not frame.released
+        assert view.tobytes() == bytes(frame)
+        view.release()
+        frame.release()
+        assert frame.released
+
+    def test_access_after_release_raises(self):
+        frame = self.make()
+        frame.release()
+        frame.release()   # a second release is a no-op
+        assert frame.released
+        assert repr(frame) == '<rtms.Frame released>'
+        for access in (len, bytes, memoryview, lambda f: f.tobytes()):
+            with pytest.raises(ValueError):
+                access(frame)
+        assert frame.timestamp == 7
+        assert frame.metadata.userId == 42
+
+    def test_context_manager_releases(self):
+        with self.make() as frame:
+            assert bytes(frame)[:1] == b'\x01'
+        assert frame.released
+
+    def test_context_manager_refuses_with_live_view(self):
+        frame = self.make()
+        with pytest.raises(BufferError):
+            with frame:
+                view = memoryview(frame)
+        view.release()
+        frame.release()
+
+    def test_empty_frame(self):
+        frame = self.make(b'')
+        assert len(frame) == 0
+        assert bytes(frame) == b''
+        assert memoryview(frame).nbytes == 0
+
 
 class TestModuleExports:
     """Test that all expected exports are available"""
@@ -375,6 +472,34 @@ class TestThreadSafety:
         assert hasattr(client, '_do_alloc_and_join')
         assert hasattr(client, '_pending_join_params')
 
+    def test_concurrent_callback_registration(self):
+        """Replacing callbacks and params from many threads at once is safe,
+        which free-threaded builds no longer get from the GIL"""
+        import threading
+        client = rtms.Client()
+        errors = []
+
+        def worker(n):
+            try:
+                for i in range(500):
+                    client.on_audio_data(lambda *args: None)
+                    client.on_video_batch(lambda frames: None)
+                    client.on_transcript_data(lambda *args: n + i)
+                    params = rtms.AudioParams()
+                    params.channel = 1 + (i % 2)
+                    client.set_audio_params(params)
+                    client.stats
+            except Exception as e:  # pragma: no cover - reported below
+                errors.append(e)
+
+        threads = [threading.Thread(target=worker, args=(n,)) for n in range(8)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join(timeout=30)
+        assert errors == []
+        assert not any(t.is_alive() for t in threads)
+
 
 class TestTranscriptParams:
     """Test TranscriptParams class and setTranscriptParams/set_transcript_params.
@@ -810,6 +935,47 @@ class TestRunAsync:
         asyncio.run(test())
         assert 'side_task_ran' in results
 
+    def test_event_loop_fileno_readable_after_stop(self):
+        import select
+        loop = rtms.EventLoop()
+        fd = loop.fileno()
+        if fd < 0:
+            pytest.skip("No readiness descriptor on this platform")
+        assert select.select([fd], [], [], 0)[0] == []
+        loop.start()
+        loop.stop()
+        loop.join()
+        assert select.select([fd], [], [], 1.0)[0] == [fd]
+        assert loop.clear_ready() is True
+        assert select.select([fd], [], [], 0)[0] == []
+
+    def test_event_loop_stopped_fileno_readable_only_after_stop(self):
+        import select
+        loop = rtms.EventLoop()
+        fd = loop._native.stopped_fileno()
+        if fd < 0:
+            pytest.skip("No readiness descriptor on this platform")
+        assert fd != loop.fileno()
+        loop.start()
+        assert select.select([fd], [], [], 0.05)[0] == []
+        loop.stop()
+        loop.join()
+        assert select.select([fd], [], [], 1.0)[0] == [fd]
+        loop.clear_ready()
+        assert select.select([fd], [], [], 0)[0] == [fd]
+
+    def test_event_loop_run_async_wakes_on_stop(self):
+        import time
+
+        async def run_and_stop():
+            loop = rtms.EventLoop(poll_interval=1.0)
+            asyncio.get_running_loop().call_later(0.05, loop.stop)
+            start = time.monotonic()
+            await loop.run_async()
+            return time.monotonic() - start
+
+        assert asyncio.run(run_and_stop()) < 1.0
+
 
 class TestExecutorSupport:
     """Tests executor-based callback dispatch."""
@@ -1019,6 +1185,30 @@ class TestSnakeCaseCallbacks:
         client = rtms.Client()
         client.onVideoData(lambda *_: None)
 
+    def test_on_audio_data_dtype(self):
+        np = pytest.importorskip('numpy')
+        client = rtms.Client()
+        client.on_audio_data(lambda *_: None, dtype='float32')
+        client.on_audio_data(lambda *_: None, dtype=np.int16)
+        with pytest.raises(ValueError):
+            client.on_audio_data(lambda *_: None, dtype='int32')
+
+    def test_on_batch_canonical(self):
+        client = rtms.Client()
+        client.on_audio_batch(lambda frames: None)
+        client.on_video_batch(lambda frames: None)
+        client.on_deskshare_batch(lambda frames: None)
+        client.on_transcript_batch(lambda frames: None)
+
+    def test_onAudioBatch_alias_works(self):
+        client = rtms.Client()
+        client.onAudioBatch(lambda frames: None)
+        assert rtms.Client.onAudioBatch is rtms.Client.on_audio_batch
+
+    def test_gil_acquisitions_counter(self):
+        assert 'gil_acquisitions' in rtms.__all__
+        assert isinstance(rtms.gil_acquisitions(), int)
+
     def test_onLeave_alias_works(self):
         client = rtms.Client()
         client.onLeave(lambda _: None)
@@ -1032,6 +1222,57 @@ class TestSnakeCaseCallbacks:
         assert rtms.Client.onAudioData is rtms.Client.on_audio_data
 
 
+@pytest.mark.skipif(sys.platform == 'win32', reason='POSIX shared memory only')
+class TestShmRing:
+    """Client.shm_ring() publishes frames in a named segment that ShmRingReader follows."""
+
+    def _name(self, tag):
+        return '/rtms-pytest-%d-%s' % (os.getpid(), tag)
+
+    def test_exports(self):
+        assert 'ShmRingReader' in rtms.__all__
+        assert hasattr(rtms.Client, 'shm_ring')
+        assert hasattr(rtms.Client, 'close_shm_ring')
+
+    def test_reader_attaches_and_sees_close(self):
+        client = rtms.Client()
+        name = client.shm_ring('audio', bytes=4096, name=self._name('attach'))
+        assert name == self._name('attach')
+        # A second call returns the ring already attached
+        assert client.shm_ring('audio', bytes=4096, name=self._name('other')) == name
+
+        reader = rtms.ShmRingReader(name)
+        assert reader.name == name
+        assert reader.try_read() is None
+        assert not reader.closed
+        assert reader.lapped == 0
+        assert reader.lost == 0
+
+        assert client.close_shm_ring('audio') is True
+        assert client.close_shm_ring('audio') is False
+        assert reader.closed
+        assert reader.read(0.01) is None
+        assert list(reader) == []
+
+    def test_invalid_arguments(self):
+        client = rtms.Client()
+        with pytest.raises(ValueError):
+            client.shm_ring('smell', name=self._name('media'))
+        with pytest.raises(ValueError):
+            client.shm_ring('audio', bytes=3000, name=self._name('bytes'))
+        with pytest.raises(ValueError):
+            client.shm_ring('audio', name='no-slash')
+
+    def test_name_needed_before_join(self):
+        client = rtms.Client()
+        with pytest.raises(RuntimeError):
+            client.shm_ring('video')
+
+    def test_missing_segment(self):
+        with pytest.raises(Exception):
+            rtms.ShmRingReader(self._name('missing'))
+
+
 # Run tests
 if __name__ == '__main__':
     pytest.main([__file__, '-v'])
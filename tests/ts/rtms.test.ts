@@ -251,6 +251,21 @@ describe('RTMS Node.JS Addon Comprehensive Test Suite', () => {
         expect(result).toBe(true);
       });
 
+      test('client.join accepts a polling mode', () => {
+        const joinParams = {
+          meeting_uuid: "uuid",
+          rtms_stream_id: "session_id",
+          server_urls: "server_url",
+          signature: "signature",
+          polling: 'timer' as const,
+          pollInterval: 20
+        };
+
+        const result = client.join(joinParams);
+        expect(client.join).toHaveBeenCalledWith(joinParams);
+        expect(result).toBe(true);
+      });
+
       // ZCC engagement_id tests
       // NOTE: The test module is fully mocked so client.join always returns true
       // regardless of params. These tests document the expected API contract.
@@ -91,6 +91,18 @@ describe('index.ts wrapper — real built module', () => {
     test('setProxy does not throw for https', () => {
       expect(run("(c.setProxy('https', 'https://proxy.example.com:8080'), true)")).toBe(true);
     });
+
+    test('setDeliveryQueue accepts a policy and depths', () => {
+      expect(run("c.setDeliveryQueue({ policy: 'audio-priority', video: 30, audio: 0 })")).toBe(true);
+    });
+
+    test('setDeliveryQueue rejects an unknown policy', () => {
+      expect(run("(() => { try { c.setDeliveryQueue({ policy: 'drop-all' }); return false; } catch (e) { return e instanceof RangeError; } })()")).toBe(true);
+    });
+
+    test('setDeliveryPaused rejects an unknown media type', () => {
+      expect(run("(() => { try { c.setDeliveryPaused('screen', true); return false; } catch (e) { return e instanceof RangeError; } })()")).toBe(true);
+    });
   });
 
   // --------------------------------------------------------------------------
@@ -99,6 +111,7 @@ describe('index.ts wrapper — real built module', () => {
       'onJoinConfirm', 'onSessionUpdate', 'onUserUpdate',
       'onParticipantEvent', 'onActiveSpeakerEvent', 'onSharingEvent', 'onEventEx',
       'onAudioData', 'onVideoData', 'onDeskshareData', 'onTranscriptData', 'onLeave',
+      'onAudioBatch', 'onVideoBatch', 'onDeskshareBatch', 'onTranscriptBatch',
     ];
 
     for (const method of callbacks) {
@@ -108,6 +121,54 @@ describe('index.ts wrapper — real built module', () => {
     }
   });
 
+  // --------------------------------------------------------------------------
+  describe('Client — media streams', () => {
+    for (const method of ['audioStream', 'videoStream', 'deskshareStream', 'transcriptStream']) {
+      test(`${method} returns an object-mode Readable`, () => {
+        expect(run(`(() => { const s = c.${method}(); return typeof s.pipe === 'function' && s.readableObjectMode && typeof s[Symbol.asyncIterator] === 'function'; })()`)).toBe(true);
+      });
+    }
+
+    test('byte-mode streams honour highWaterMark', () => {
+      expect(run("(() => { const s = c.audioStream({ objectMode: false, highWaterMark: 4096 }); return !s.readableObjectMode && s.readableHighWaterMark === 4096; })()")).toBe(true);
+    });
+
+    test('onAudioData still rejects a non-function', () => {
+      expect(run("(() => { try { c.onAudioData(42); return false; } catch (e) { return e instanceof TypeError; } })()")).toBe(true);
+    });
+  });
+
+  // --------------------------------------------------------------------------
+  describe('Client — shared rings', () => {
+    test('sharedRing returns the same SharedArrayBuffer per media type', () => {
+      expect(run("(() => { const r = c.sharedRing('audio', { bytes: 65536 }); return r instanceof SharedArrayBuffer && r.byteLength === 65536 + 64 && c.sharedRing('audio') === r; })()")).toBe(true);
+    });
+
+    test('sharedRing rejects a size that is not a power of two', () => {
+      expect(run("(() => { try { c.sharedRing('video', { bytes: 5000 }); return false; } catch (e) { return e instanceof RangeError; } })()")).toBe(true);
+    });
+
+    test('a reader on a new ring is empty and sees it closed', () => {
+      expect(run("(() => { const r = new rtms.SharedRingReader(c.sharedRing('audio', { bytes: 4096 })); const empty = r.tryRead() === null && !r.closed; c.closeSharedRing('audio'); return empty && r.closed && r.read(10) === null; })()")).toBe(true);
+    });
+
+    test('SharedRingReader rejects a buffer that is not a ring', () => {
+      expect(runModule("(() => { try { new rtms.SharedRingReader(new SharedArrayBuffer(4160)); return false; } catch (e) { return e instanceof RangeError; } })()")).toBe(true);
+    });
+
+    test('shmRing creates a named segment that a ShmRingReader attaches to', () => {
+      expect(run("(() => { const name = '/rtms-wrapper-' + process.pid; const shm = c.shmRing('audio', { bytes: 4096, name }); const r = new rtms.ShmRingReader(shm); const empty = shm === name && c.shmRing('audio') === name && r.tryRead() === null && !r.closed; c.closeSharedRing('audio'); return empty && r.closed && r.read(10) === null; })()")).toBe(true);
+    });
+
+    test('shmRing needs a name before the client has joined', () => {
+      expect(run("(() => { try { c.shmRing('video'); return false; } catch (e) { return e instanceof Error; } })()")).toBe(true);
+    });
+
+    test('ShmRingReader rejects a name with no ring', () => {
+      expect(runModule("(() => { try { new rtms.ShmRingReader('/rtms-wrapper-missing-' + process.pid); return false; } catch (e) { return e instanceof Error; } })()")).toBe(true);
+    });
+  });
+
   // --------------------------------------------------------------------------
   describe('Client — event subscription methods', () => {
     test('subscribeEvent is a function', () => {